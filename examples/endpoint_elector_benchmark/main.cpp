@@ -0,0 +1,165 @@
+#include <src/client/impl/endpoints/endpoints.h>
+
+#include <library/cpp/getopt/last_getopt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NYdb;
+
+namespace {
+
+enum class EMode {
+    // TEndpointRecord copied out of the elector, as every RPC used to do
+    Record,
+    // Shared record of the published snapshot
+    Handle,
+};
+
+const char* ToString(EMode mode) {
+    switch (mode) {
+        case EMode::Record:
+            return "record";
+        case EMode::Handle:
+            return "handle";
+    }
+    return "unknown";
+}
+
+struct TResult {
+    EMode Mode = EMode::Record;
+    std::uint32_t Threads = 0;
+    std::uint64_t Operations = 0;
+    std::uint64_t Updates = 0;
+    double DurationMs = 0.0;
+    std::uint64_t Checksum = 0;
+};
+
+std::vector<TEndpointRecord> MakeRecords(std::uint32_t endpoints) {
+    std::vector<TEndpointRecord> records;
+    records.reserve(endpoints);
+    for (std::uint32_t i = 0; i < endpoints; ++i) {
+        records.emplace_back("ipv4:10.0." + std::to_string(i / 256) + "." + std::to_string(i % 256) + ":2135", 0,
+            "ydb-node-" + std::to_string(i) + ".example.net", i + 1, "zone-" + std::to_string(i % 3));
+    }
+    return records;
+}
+
+// Every thread chooses an endpoint the way the gRPC connections do before an RPC,
+// a quarter of the lookups ask for the node of a session, the rest take any best endpoint.
+// Optionally the discovery thread republishes the endpoint set meanwhile.
+TResult RunWorkload(EMode mode, std::uint32_t threads, std::uint64_t iterations, std::uint32_t endpoints,
+    std::uint32_t updateIntervalMs)
+{
+    TEndpointElectorSafe elector;
+    elector.SetNewState(MakeRecords(endpoints));
+
+    std::atomic<bool> start{false};
+    std::atomic<std::uint32_t> running{threads};
+    std::atomic<std::uint64_t> checksum{0};
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (std::uint32_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const TEndpointKey key = (i % 4 == 0) ? TEndpointKey((t + i) % endpoints + 1) : TEndpointKey();
+                if (mode == EMode::Record) {
+                    auto endpoint = elector.GetEndpoint(key);
+                    sum += endpoint.Endpoint.size() + endpoint.NodeId;
+                } else {
+                    auto endpoint = elector.GetEndpointHandle(key);
+                    sum += endpoint->Endpoint.size() + endpoint->NodeId;
+                }
+            }
+            checksum.fetch_add(sum, std::memory_order_relaxed);
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    TResult r;
+    const auto t0 = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    if (updateIntervalMs) {
+        while (running.load(std::memory_order_acquire)) {
+            elector.SetNewState(MakeRecords(endpoints));
+            ++r.Updates;
+            std::this_thread::sleep_for(std::chrono::milliseconds(updateIntervalMs));
+        }
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    r.Mode = mode;
+    r.Threads = threads;
+    r.DurationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    r.Operations = static_cast<std::uint64_t>(threads) * iterations;
+    r.Checksum = checksum.load();
+    return r;
+}
+
+void PrintRow(const TResult& r) {
+    std::cout
+        << "lookup=" << std::left << std::setw(8) << ToString(r.Mode)
+        << "  threads=" << std::setw(4) << r.Threads
+        << "  duration_ms=" << std::fixed << std::setprecision(2) << std::setw(9) << r.DurationMs
+        << "  ns/op=" << std::setprecision(1) << std::setw(8) << r.DurationMs * 1e6 / r.Operations
+        << "  Mops/s=" << std::setprecision(2) << std::setw(8) << r.Operations / r.DurationMs / 1e3
+        << "  updates=" << std::setw(5) << r.Updates
+        << "  checksum=" << r.Checksum
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::uint64_t iterations = 1'000'000;
+    std::uint32_t endpoints = 16;
+    std::uint32_t updateIntervalMs = 10;
+
+    NLastGetopt::TOpts opts;
+    opts.AddLongOption("threads", "Maximum number of looking up threads, runs go 1, 2, 4, ... up to it")
+        .DefaultValue(std::to_string(maxThreads)).StoreResult(&maxThreads);
+    opts.AddLongOption("iterations", "Number of lookups per thread")
+        .DefaultValue(std::to_string(iterations)).StoreResult(&iterations);
+    opts.AddLongOption("endpoints", "Number of endpoints known to the elector")
+        .DefaultValue(std::to_string(endpoints)).StoreResult(&endpoints);
+    opts.AddLongOption("update-interval-ms", "Interval of endpoint set updates during the run, 0 disables them")
+        .DefaultValue(std::to_string(updateIntervalMs)).StoreResult(&updateIntervalMs);
+    NLastGetopt::TOptsParseResult(&opts, argc, argv);
+
+    maxThreads = std::max(maxThreads, 1u);
+    iterations = std::max<std::uint64_t>(iterations, 1);
+    endpoints = std::max(endpoints, 1u);
+
+    std::cout
+        << "Endpoint elector lookup benchmark\n"
+        << "  max_threads           = " << maxThreads << "\n"
+        << "  iterations/thread     = " << iterations << "\n"
+        << "  endpoints             = " << endpoints << "\n"
+        << "  update_interval_ms    = " << updateIntervalMs << "\n"
+        << "  (record: GetEndpoint copy, handle: GetEndpointHandle on the published snapshot)\n"
+        << std::endl;
+
+    for (std::uint32_t threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        PrintRow(RunWorkload(EMode::Record, threads, iterations, endpoints, updateIntervalMs));
+        PrintRow(RunWorkload(EMode::Handle, threads, iterations, endpoints, updateIntervalMs));
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <src/client/impl/endpoints/endpoints.h>
+
+#include <library/cpp/getopt/last_getopt.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NYdb;
+
+namespace {
+
+enum class EMode {
+    Disabled,
+    LookupByHost,
+    Cached,
+};
+
+const char* ToString(EMode mode) {
+    switch (mode) {
+        case EMode::Disabled:
+            return "disabled";
+        case EMode::LookupByHost:
+            return "lookup_by_host";
+        case EMode::Cached:
+            return "cached";
+    }
+    return "unknown";
+}
+
+struct TResult {
+    EMode Mode = EMode::Disabled;
+    std::uint64_t Operations = 0;
+    double DurationMs = 0.0;
+};
+
+// Emulates the stats work done by the gRPC connections around one RPC:
+// choose an endpoint, then increment and decrement the in-flight gauges
+TResult RunWorkload(EMode mode, std::uint32_t threads, std::uint64_t iterations, std::uint32_t endpoints) {
+    const std::string database = "/Root/benchmark";
+    auto registry = std::make_unique<NMonitoring::TMetricRegistry>();
+    NSdkStats::TStatCollector statCollector(database, mode == EMode::Disabled ? nullptr : registry.get());
+
+    TEndpointElectorSafe elector;
+    std::vector<TEndpointRecord> records;
+    for (std::uint32_t i = 0; i < endpoints; ++i) {
+        records.emplace_back("ipv4:10.0.0." + std::to_string(i) + ":2135", 0, "", i + 1);
+    }
+    elector.SetNewState(std::move(records));
+    if (statCollector.IsCollecting()) {
+        elector.SetStatCollector(statCollector.GetEndpointElectorStatCollector());
+    }
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (std::uint32_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                auto endpoint = elector.GetEndpoint(TEndpointKey());
+                NSdkStats::TEndpointCounters counters = endpoint.Counters;
+                if (mode == EMode::LookupByHost) {
+                    // What every request used to pay: label set construction and registry lookup
+                    counters = NSdkStats::TStatCollector::ResolveEndpointCounters(registry.get(), database,
+                        endpoint.Endpoint);
+                }
+                statCollector.IncGRpcInFlight();
+                counters.IncGRpcInFlight();
+                statCollector.DecGRpcInFlight();
+                counters.DecGRpcInFlight();
+            }
+        });
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    TResult r;
+    r.Mode = mode;
+    r.DurationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    r.Operations = static_cast<std::uint64_t>(threads) * iterations;
+    return r;
+}
+
+void PrintRow(const TResult& r) {
+    std::cout
+        << "stats=" << std::left << std::setw(16) << ToString(r.Mode)
+        << "  duration_ms=" << std::fixed << std::setprecision(2) << std::setw(9) << r.DurationMs
+        << "  ns/rpc=" << std::setprecision(1) << std::setw(8) << r.DurationMs * 1e6 / r.Operations
+        << "  Mrpc/s=" << std::setprecision(2) << r.Operations / r.DurationMs / 1e3
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::uint64_t iterations = 1'000'000;
+    std::uint32_t endpoints = 16;
+
+    NLastGetopt::TOpts opts;
+    opts.AddLongOption("threads", "Number of threads issuing emulated RPCs")
+        .DefaultValue(std::to_string(threads)).StoreResult(&threads);
+    opts.AddLongOption("iterations", "Number of emulated RPCs per thread")
+        .DefaultValue(std::to_string(iterations)).StoreResult(&iterations);
+    opts.AddLongOption("endpoints", "Number of endpoints known to the elector")
+        .DefaultValue(std::to_string(endpoints)).StoreResult(&endpoints);
+    NLastGetopt::TOptsParseResult(&opts, argc, argv);
+
+    threads = std::max(threads, 1u);
+    iterations = std::max<std::uint64_t>(iterations, 1);
+    endpoints = std::max(endpoints, 1u);
+
+    std::cout
+        << "Per-RPC stats overhead benchmark\n"
+        << "  threads               = " << threads << "\n"
+        << "  iterations/thread     = " << iterations << "\n"
+        << "  endpoints             = " << endpoints << "\n"
+        << "  (one rpc is endpoint election + in-flight gauges increment and decrement)\n"
+        << std::endl;
+
+    PrintRow(RunWorkload(EMode::Disabled, threads, iterations, endpoints));
+    PrintRow(RunWorkload(EMode::LookupByHost, threads, iterations, endpoints));
+    PrintRow(RunWorkload(EMode::Cached, threads, iterations, endpoints));
+
+    return 0;
+}
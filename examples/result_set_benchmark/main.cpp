@@ -0,0 +1,199 @@
+#include <ydb-cpp-sdk/client/result/result.h>
+
+#include <src/api/protos/ydb_value.pb.h>
+
+#include <library/cpp/getopt/last_getopt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+
+namespace {
+
+std::atomic<std::uint64_t> AllocatedBytes{0};
+std::atomic<std::uint64_t> AllocationsCount{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    AllocationsCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+using namespace NYdb;
+
+namespace {
+
+Ydb::ResultSet MakeResultSet(std::uint64_t rows, std::uint64_t payloadSize) {
+    Ydb::ResultSet proto;
+
+    auto* idColumn = proto.add_columns();
+    idColumn->set_name("id");
+    idColumn->mutable_type()->set_type_id(Ydb::Type::UINT64);
+
+    auto* payloadColumn = proto.add_columns();
+    payloadColumn->set_name("payload");
+    payloadColumn->mutable_type()->set_type_id(Ydb::Type::STRING);
+
+    const std::string payload(payloadSize, 'x');
+    for (std::uint64_t i = 0; i < rows; ++i) {
+        auto* row = proto.add_rows();
+        row->add_items()->set_uint64_value(i);
+        row->add_items()->set_bytes_value(payload);
+    }
+
+    return proto;
+}
+
+struct TResult {
+    std::string Mode;
+    std::uint64_t Bytes = 0;
+    std::uint64_t Allocations = 0;
+    double DurationMs = 0.0;
+};
+
+template <typename TMakeResultSet>
+TResult RunWorkload(const std::string& mode, std::uint64_t rows, std::uint64_t payloadSize, TMakeResultSet&& makeResultSet) {
+    auto response = std::make_shared<Ydb::ResultSet>(MakeResultSet(rows, payloadSize));
+
+    const auto bytesBefore = AllocatedBytes.load();
+    const auto allocationsBefore = AllocationsCount.load();
+    const auto t0 = std::chrono::steady_clock::now();
+
+    std::uint64_t checksum = 0;
+    {
+        TResultSet resultSet = makeResultSet(response);
+        TResultSetParser parser(resultSet);
+        while (parser.TryNextRow()) {
+            checksum += parser.ColumnParser(0).GetUint64();
+            checksum += parser.ColumnParser(1).GetString().size();
+        }
+    }
+
+    TResult r;
+    r.Mode = mode;
+    r.DurationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    r.Bytes = AllocatedBytes.load() - bytesBefore;
+    r.Allocations = AllocationsCount.load() - allocationsBefore;
+
+    if (checksum == 0 && rows > 1) {
+        std::cerr << "unexpected checksum" << std::endl;
+    }
+
+    return r;
+}
+
+void PrintRow(const TResult& r, std::uint64_t rows) {
+    std::cout
+        << std::left << std::setw(8) << r.Mode
+        << "  duration_ms=" << std::fixed << std::setprecision(2) << std::setw(9) << r.DurationMs
+        << "  bytes/row=" << std::setprecision(1) << std::setw(9) << static_cast<double>(r.Bytes) / rows
+        << "  allocs/row=" << std::setprecision(3) << static_cast<double>(r.Allocations) / rows
+        << std::endl;
+}
+
+double MeasureParser(const TResultSet& resultSet, bool columnar, std::uint64_t& checksum) {
+    const auto t0 = std::chrono::steady_clock::now();
+
+    TResultSetParser parser(resultSet);
+    if (columnar) {
+        auto ids = parser.GetUint64Column(0);
+        auto payloads = parser.GetStringColumn(1);
+        for (size_t i = 0; i < ids.Values.size(); ++i) {
+            checksum += ids.Values[i];
+            checksum += payloads.Values[i].size();
+        }
+    } else {
+        auto& idParser = parser.ColumnParser(0);
+        auto& payloadParser = parser.ColumnParser(1);
+        while (parser.TryNextRow()) {
+            checksum += idParser.GetUint64();
+            checksum += payloadParser.GetString().size();
+        }
+    }
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void RunParserWorkload(std::uint64_t rows, std::uint64_t payloadSize, int iterations) {
+    const TResultSet resultSet(MakeResultSet(rows, payloadSize));
+
+    for (bool columnar : {false, true}) {
+        std::uint64_t checksum = 0;
+        double durationMs = 0.0;
+        for (int i = 0; i < iterations; ++i) {
+            durationMs += MeasureParser(resultSet, columnar, checksum);
+        }
+
+        const double cells = static_cast<double>(rows) * 2 * iterations;
+        std::cout
+            << std::left << std::setw(8) << (columnar ? "columnar" : "row")
+            << "  duration_ms=" << std::fixed << std::setprecision(2) << std::setw(9) << durationMs
+            << "  ns/cell=" << std::setprecision(2) << durationMs * 1e6 / cells
+            << "  checksum=" << checksum
+            << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t rows = 100'000;
+    std::uint64_t payloadSize = 128;
+    int iterations = 10;
+
+    NLastGetopt::TOpts opts;
+    opts.AddLongOption("rows", "Number of rows in the result set")
+        .DefaultValue(std::to_string(rows)).StoreResult(&rows);
+    opts.AddLongOption("payload", "Size of the string column value in bytes")
+        .DefaultValue(std::to_string(payloadSize)).StoreResult(&payloadSize);
+    opts.AddLongOption("iterations", "Number of passes over the result set in the parser benchmark")
+        .DefaultValue(std::to_string(iterations)).StoreResult(&iterations);
+    NLastGetopt::TOptsParseResult(&opts, argc, argv);
+
+    rows = std::max<std::uint64_t>(rows, 1);
+
+    std::cout
+        << "TResultSet construction benchmark\n"
+        << "  rows                  = " << rows << "\n"
+        << "  payload_bytes         = " << payloadSize << "\n"
+        << "  (bytes allocated while building the result set and parsing every row)\n"
+        << std::endl;
+
+    PrintRow(RunWorkload("copy", rows, payloadSize, [](const std::shared_ptr<Ydb::ResultSet>& response) {
+        return TResultSet(*response);
+    }), rows);
+
+    PrintRow(RunWorkload("shared", rows, payloadSize, [](const std::shared_ptr<Ydb::ResultSet>& response) {
+        return TResultSet(response);
+    }), rows);
+
+    std::cout
+        << "\nTResultSetParser benchmark\n"
+        << "  iterations            = " << iterations << "\n"
+        << "  (row: TryNextRow + ColumnParser getters, columnar: Get*Column)\n"
+        << std::endl;
+
+    RunParserWorkload(rows, payloadSize, iterations);
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+#define INCLUDE_YDB_INTERNAL_H
+#include <src/client/impl/session/session_pool.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
+#include <library/cpp/getopt/last_getopt.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NYdb;
+using namespace NYdb::NSessionPool;
+
+namespace {
+
+struct TReply {
+    TKqpSessionCommon* Session = nullptr;
+    bool Error = false;
+};
+
+class TBenchGetSessionCtx : public IGetSessionCtx {
+public:
+    TBenchGetSessionCtx(TReply& reply, std::atomic<std::uint64_t>& created)
+        : Reply_(reply)
+        , Created_(created)
+    {}
+
+    void ReplySessionToUser(TKqpSessionCommon* session) override {
+        Reply_.Session = session;
+    }
+
+    void ReplyError(TStatus) override {
+        Reply_.Error = true;
+    }
+
+    void ReplyNewSession() override {
+        const auto id = Created_.fetch_add(1, std::memory_order_relaxed);
+        auto* session = new TKqpSessionCommon("session-" + std::to_string(id), "localhost:2135", true);
+        session->MarkActive();
+        session->SetNeedUpdateActiveCounter(true);
+        Reply_.Session = session;
+    }
+
+    void ScheduleOnDeadlineWaiterCleanup() override {
+    }
+
+    TDeadline GetDeadline() const override {
+        return TDeadline::AfterDuration(MAX_WAIT_SESSION_TIMEOUT);
+    }
+
+private:
+    TReply& Reply_;
+    std::atomic<std::uint64_t>& Created_;
+};
+
+struct TResult {
+    std::uint32_t Shards = 0;
+    std::uint64_t Operations = 0;
+    std::uint64_t Errors = 0;
+    std::uint64_t Created = 0;
+    double DurationMs = 0.0;
+};
+
+TResult RunWorkload(std::uint32_t shards, std::uint32_t threads, std::uint64_t iterations, std::uint32_t maxActiveSessions) {
+    TSessionPool pool(maxActiveSessions, 0, shards);
+    std::atomic<std::uint64_t> created{0};
+    std::atomic<std::uint64_t> errors{0};
+    std::atomic<bool> start{false};
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (std::uint32_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                TReply reply;
+                pool.GetSession(std::make_unique<TBenchGetSessionCtx>(reply, created));
+                if (!reply.Session) {
+                    errors.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                reply.Session->MarkIdle();
+                if (!pool.ReturnSession(reply.Session, true)) {
+                    delete reply.Session;
+                }
+            }
+        });
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    TResult r;
+    r.Shards = shards;
+    r.DurationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    r.Operations = static_cast<std::uint64_t>(threads) * iterations;
+    r.Errors = errors.load();
+    r.Created = created.load();
+
+    pool.Drain([](std::unique_ptr<TKqpSessionCommon>&&) { return true; }, true);
+    return r;
+}
+
+void PrintRow(const TResult& r) {
+    std::cout
+        << "shards=" << std::left << std::setw(4) << r.Shards
+        << "  duration_ms=" << std::fixed << std::setprecision(2) << std::setw(9) << r.DurationMs
+        << "  ns/op=" << std::setprecision(1) << std::setw(8) << r.DurationMs * 1e6 / r.Operations
+        << "  Mops/s=" << std::setprecision(2) << std::setw(7) << r.Operations / r.DurationMs / 1e3
+        << "  sessions_created=" << r.Created
+        << "  errors=" << r.Errors
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::uint64_t iterations = 200'000;
+    std::uint32_t maxActiveSessions = 1000;
+    std::uint32_t shards = threads;
+
+    NLastGetopt::TOpts opts;
+    opts.AddLongOption("threads", "Number of threads getting and returning sessions")
+        .DefaultValue(std::to_string(threads)).StoreResult(&threads);
+    opts.AddLongOption("iterations", "Number of GetSession/ReturnSession pairs per thread")
+        .DefaultValue(std::to_string(iterations)).StoreResult(&iterations);
+    opts.AddLongOption("max-active", "Max active sessions of the pool")
+        .DefaultValue(std::to_string(maxActiveSessions)).StoreResult(&maxActiveSessions);
+    opts.AddLongOption("shards", "Number of shards of the sharded pool")
+        .DefaultValue(std::to_string(shards)).StoreResult(&shards);
+    NLastGetopt::TOptsParseResult(&opts, argc, argv);
+
+    threads = std::max(threads, 1u);
+    iterations = std::max<std::uint64_t>(iterations, 1);
+
+    std::cout
+        << "TSessionPool contention benchmark\n"
+        << "  threads               = " << threads << "\n"
+        << "  iterations/thread     = " << iterations << "\n"
+        << "  max_active_sessions   = " << maxActiveSessions << "\n"
+        << "  (one op is GetSession + ReturnSession of an idle session)\n"
+        << std::endl;
+
+    PrintRow(RunWorkload(1, threads, iterations, maxActiveSessions));
+    if (shards > 1) {
+        PrintRow(RunWorkload(shards, threads, iterations, maxActiveSessions));
+    }
+
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include <ydb-cpp-sdk/client/topic/codecs.h>
+
+#include <library/cpp/getopt/last_getopt.h>
+#include <library/cpp/streams/zstd/zstd.h>
+
+#include <util/stream/zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<std::uint64_t> AllocationsCount{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    AllocationsCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+using namespace NYdb::NTopic;
+
+namespace {
+
+// Any id from the custom range, writers and readers only have to agree on it
+constexpr ECodec ZSTD_DICT_CODEC = static_cast<ECodec>(static_cast<std::uint32_t>(ECodec::CUSTOM) + 100);
+constexpr size_t DICTIONARY_SAMPLES = 5000;
+
+struct TCompressedMessage {
+    std::string Data;
+    size_t UncompressedSize = 0;
+};
+
+struct TResult {
+    std::string Codec;
+    double Ratio = 0.0;
+    std::string Mix;
+    std::string Mode;
+    std::uint64_t Messages = 0;
+    std::uint64_t Bytes = 0;
+    std::uint64_t Allocations = 0;
+    double DurationMs = 0.0;
+};
+
+// JSON-like event, similar to what typical topics hold
+std::string MakeEvent(std::mt19937& rng, size_t targetSize) {
+    static const char* const levels[] = {"debug", "info", "warning", "error"};
+    static const char* const services[] = {"frontend", "billing", "storage", "auth", "search"};
+
+    std::string event;
+    event.reserve(targetSize + 128);
+    while (event.size() < targetSize) {
+        event += "{\"ts\":";
+        event += std::to_string(1700000000000ull + rng() % 1000000);
+        event += ",\"level\":\"";
+        event += levels[rng() % 4];
+        event += "\",\"service\":\"";
+        event += services[rng() % 5];
+        event += "\",\"request_id\":\"";
+        event += std::to_string(rng());
+        event += "\",\"latency_us\":";
+        event += std::to_string(rng() % 100000);
+        event += ",\"message\":\"request processed\"}\n";
+    }
+    return event;
+}
+
+std::vector<TCompressedMessage> MakeMessages(const ICodec& codec, const std::string& mix, size_t count, std::mt19937& rng) {
+    std::vector<TCompressedMessage> messages;
+    messages.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t size = 0;
+        if (mix == "small") {
+            size = 100 + rng() % 900;
+        } else if (mix == "large") {
+            size = 256 * 1024 + rng() % (768 * 1024);
+        } else {
+            // 95% of small events and a few large batches
+            size = rng() % 20 ? 100 + rng() % 900 : 256 * 1024 + rng() % (768 * 1024);
+        }
+        const std::string raw = MakeEvent(rng, size);
+
+        TBuffer buffer;
+        {
+            auto coder = codec.CreateCoder(buffer, -1);
+            coder->Write(raw.data(), raw.size());
+            coder->Finish();
+        }
+        messages.push_back({std::string(buffer.Data(), buffer.Size()), raw.size()});
+    }
+    return messages;
+}
+
+// Decompression through util streams with a growing string, as it was done before DecompressInto
+std::string DecompressWithStream(ECodec codec, const std::string& data) {
+    TMemoryInput input(data.data(), data.size());
+    TString result;
+    TStringOutput resultOutput(result);
+    if (codec == ECodec::GZIP) {
+        TZLibDecompress decompress(&input);
+        TransferData(&decompress, &resultOutput);
+    } else {
+        TZstdDecompress decompress(&input);
+        TransferData(&decompress, &resultOutput);
+    }
+    return result;
+}
+
+TResult Run(ECodec codecId, const std::string& codecName, const std::string& mix, const std::string& mode,
+    const std::vector<TCompressedMessage>& messages, std::uint64_t iterations)
+{
+    const ICodec* codec = TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<std::uint32_t>(codecId));
+
+    TResult r;
+    r.Codec = codecName;
+    r.Mix = mix;
+    r.Mode = mode;
+
+    std::uint64_t compressedBytes = 0;
+    std::uint64_t uncompressedBytes = 0;
+    for (const auto& message : messages) {
+        compressedBytes += message.Data.size();
+        uncompressedBytes += message.UncompressedSize;
+    }
+    r.Ratio = static_cast<double>(uncompressedBytes) / std::max<std::uint64_t>(compressedBytes, 1);
+
+    const auto allocationsBefore = AllocationsCount.load();
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::uint64_t it = 0; it < iterations; ++it) {
+        for (const auto& message : messages) {
+            std::string result;
+            if (mode == "stream") {
+                result = DecompressWithStream(codecId, message.Data);
+            } else if (mode == "into_no_hint") {
+                codec->DecompressInto(message.Data, 0, result);
+            } else {
+                codec->DecompressInto(message.Data, message.UncompressedSize, result);
+            }
+            r.Bytes += result.size();
+            ++r.Messages;
+        }
+    }
+    r.DurationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    r.Allocations = AllocationsCount.load() - allocationsBefore;
+    return r;
+}
+
+void PrintRow(const TResult& r) {
+    std::cout
+        << "codec=" << std::left << std::setw(9) << r.Codec
+        << "  ratio=" << std::right << std::fixed << std::setprecision(2) << std::setw(6) << r.Ratio << std::left
+        << "  mix=" << std::setw(6) << r.Mix
+        << "  mode=" << std::setw(13) << r.Mode
+        << "  duration_ms=" << std::fixed << std::setprecision(2) << std::setw(9) << r.DurationMs
+        << "  ns/msg=" << std::setprecision(1) << std::setw(10) << r.DurationMs * 1e6 / r.Messages
+        << "  MB/s=" << std::setprecision(1) << std::setw(8) << r.Bytes / r.DurationMs / 1e3
+        << "  allocs/msg=" << std::setprecision(2) << static_cast<double>(r.Allocations) / r.Messages
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t messagesCount = 2000;
+    std::uint64_t iterations = 5;
+    std::uint32_t seed = 42;
+
+    NLastGetopt::TOpts opts;
+    opts.AddLongOption("messages", "Number of messages in each mix")
+        .DefaultValue(std::to_string(messagesCount)).StoreResult(&messagesCount);
+    opts.AddLongOption("iterations", "Number of passes over the messages")
+        .DefaultValue(std::to_string(iterations)).StoreResult(&iterations);
+    opts.AddLongOption("seed", "Random seed of the generated messages")
+        .DefaultValue(std::to_string(seed)).StoreResult(&seed);
+    NLastGetopt::TOptsParseResult(&opts, argc, argv);
+
+    messagesCount = std::max<std::uint64_t>(messagesCount, 1);
+    iterations = std::max<std::uint64_t>(iterations, 1);
+
+    std::cout
+        << "Topic codecs decompression benchmark\n"
+        << "  messages    = " << messagesCount << "\n"
+        << "  iterations  = " << iterations << "\n"
+        << "  mixes       = small (0.1-1 KB events), large (0.25-1 MB batches), mixed (95% small)\n"
+        << "  modes       = stream (util streams, gzip and zstd only), into_no_hint, into_hint (DecompressInto with uncompressed size)\n"
+        << "  zstd_dict   = zstd with a dictionary trained on " << DICTIONARY_SAMPLES << " small events\n"
+        << std::endl;
+
+    {
+        // Samples are generated with another seed, so the dictionary does not see the measured messages
+        std::mt19937 rng(seed + 1);
+        std::vector<std::string> samples;
+        for (size_t i = 0; i < DICTIONARY_SAMPLES; ++i) {
+            samples.push_back(MakeEvent(rng, 100 + rng() % 900));
+        }
+        TCodecMap::GetTheCodecMap().Set(static_cast<std::uint32_t>(ZSTD_DICT_CODEC),
+            std::make_unique<TZstdDictCodec>(TZstdDictCodec::TrainDictionary(samples)));
+    }
+
+    // LZ4 is not registered by default
+    TCodecMap::GetTheCodecMap().Set(static_cast<std::uint32_t>(ECodec::LZ4), std::make_unique<TLz4Codec>());
+
+    const std::vector<std::pair<ECodec, std::string>> codecs = {
+        {ECodec::GZIP, "gzip"},
+        {ECodec::ZSTD, "zstd"},
+        {ECodec::LZ4, "lz4"},
+        {ZSTD_DICT_CODEC, "zstd_dict"},
+    };
+    for (const auto& [codecId, codecName] : codecs) {
+        const ICodec* codec = TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<std::uint32_t>(codecId));
+        for (const std::string mix : {"small", "large", "mixed"}) {
+            std::mt19937 rng(seed);
+            const auto messages = MakeMessages(*codec, mix, mix == "large" ? std::max<std::uint64_t>(messagesCount / 20, 1) : messagesCount, rng);
+            for (const std::string mode : {"stream", "into_no_hint", "into_hint"}) {
+                if (mode == "stream" && codecId != ECodec::GZIP && codecId != ECodec::ZSTD) {
+                    continue;
+                }
+                PrintRow(Run(codecId, codecName, mix, mode, messages, iterations));
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,285 @@
+#include <ydb-cpp-sdk/client/topic/codecs.h>
+#include <ydb-cpp-sdk/client/topic/executor.h>
+
+#include <library/cpp/getopt/last_getopt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NYdb;
+using namespace NYdb::NTopic;
+
+namespace {
+
+using TClock = std::chrono::steady_clock;
+
+// Same chunk size as the write session uses for parallel compression
+constexpr size_t CHUNK_SIZE = 1 << 20;
+constexpr size_t MAX_IN_FLIGHT_BLOCKS = 8;
+
+enum class EMode {
+    ThreadPool,
+    Shared,
+};
+
+const char* ToString(EMode mode) {
+    switch (mode) {
+        case EMode::ThreadPool:
+            return "thread_pool";
+        case EMode::Shared:
+            return "shared";
+    }
+    return "unknown";
+}
+
+struct TResult {
+    EMode Mode = EMode::ThreadPool;
+    std::uint32_t Sessions = 0;
+    std::uint64_t Blocks = 0;
+    std::uint64_t Bytes = 0;
+    double DurationMs = 0.0;
+    double AvgBlockLatencyMs = 0.0;
+    double MaxBlockLatencyMs = 0.0;
+    TCompressionExecutorStats ExecutorStats;
+};
+
+std::string MakeCorpus(size_t size, std::uint32_t seed) {
+    static const char* const levels[] = {"debug", "info", "warning", "error"};
+    static const char* const services[] = {"frontend", "billing", "storage", "auth", "search"};
+
+    std::mt19937 rng(seed);
+    std::string corpus;
+    corpus.reserve(size + 256);
+    while (corpus.size() < size) {
+        corpus += "{\"ts\":";
+        corpus += std::to_string(1700000000000ull + rng() % 1000000);
+        corpus += ",\"level\":\"";
+        corpus += levels[rng() % 4];
+        corpus += "\",\"service\":\"";
+        corpus += services[rng() % 5];
+        corpus += "\",\"request_id\":\"";
+        corpus += std::to_string(rng());
+        corpus += "\",\"latency_us\":";
+        corpus += std::to_string(rng() % 100000);
+        corpus += "}\n";
+    }
+    return corpus;
+}
+
+void CompressData(const ICodec& codec, std::string_view data, TBuffer& result) {
+    auto coder = codec.CreateCoder(result, 4);
+    coder->Write(data.data(), data.size());
+    coder->Finish();
+}
+
+// Emulates one write session: keeps a few blocks in flight on the compression executor
+class TSession {
+public:
+    TSession(const ICodec& codec, IExecutor::TPtr executor, bool chunked)
+        : Codec_(codec)
+        , Executor_(std::move(executor))
+        , Chunked_(chunked)
+    {}
+
+    void Compress(std::string_view data) {
+        {
+            std::unique_lock lock(Lock_);
+            CondVar_.wait(lock, [this] { return InFlight_ < MAX_IN_FLIGHT_BLOCKS; });
+            ++InFlight_;
+        }
+
+        const auto postedAt = TClock::now();
+        if (!Chunked_ || data.size() < 2 * CHUNK_SIZE) {
+            Executor_->Post([this, data, postedAt] {
+                TBuffer result;
+                CompressData(Codec_, data, result);
+                OnBlockDone(postedAt);
+            });
+            return;
+        }
+
+        const size_t chunks = (data.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        auto left = std::make_shared<std::atomic<size_t>>(chunks);
+        for (size_t i = 0; i < chunks; ++i) {
+            Executor_->Post([this, chunk = data.substr(i * CHUNK_SIZE, CHUNK_SIZE), left, postedAt] {
+                TBuffer result;
+                CompressData(Codec_, chunk, result);
+                if (left->fetch_sub(1) == 1) {
+                    OnBlockDone(postedAt);
+                }
+            });
+        }
+    }
+
+    void Wait() {
+        std::unique_lock lock(Lock_);
+        CondVar_.wait(lock, [this] { return InFlight_ == 0; });
+    }
+
+    std::uint64_t GetBlocks() const {
+        return Blocks_;
+    }
+
+    double GetTotalLatencyMs() const {
+        return TotalLatencyMs_;
+    }
+
+    double GetMaxLatencyMs() const {
+        return MaxLatencyMs_;
+    }
+
+private:
+    void OnBlockDone(TClock::time_point postedAt) {
+        const double latencyMs = std::chrono::duration<double, std::milli>(TClock::now() - postedAt).count();
+        std::lock_guard lock(Lock_);
+        --InFlight_;
+        ++Blocks_;
+        TotalLatencyMs_ += latencyMs;
+        MaxLatencyMs_ = std::max(MaxLatencyMs_, latencyMs);
+        CondVar_.notify_all();
+    }
+
+private:
+    const ICodec& Codec_;
+    IExecutor::TPtr Executor_;
+    const bool Chunked_;
+
+    std::mutex Lock_;
+    std::condition_variable CondVar_;
+    size_t InFlight_ = 0;
+    std::uint64_t Blocks_ = 0;
+    double TotalLatencyMs_ = 0.0;
+    double MaxLatencyMs_ = 0.0;
+};
+
+TResult RunWorkload(EMode mode, std::uint32_t sessionsCount, std::uint64_t blocksPerSession, const std::string& corpus,
+    std::uint32_t poolThreads, std::uint32_t seed)
+{
+    const ICodec* codec = TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<std::uint32_t>(ECodec::ZSTD));
+    // Sessions of one client share its default compression executor
+    auto executor = mode == EMode::Shared ? GetSharedCompressionExecutor() : CreateThreadPoolExecutor(poolThreads);
+    executor->Start();
+    const auto statsBefore = GetSharedCompressionExecutorStats();
+
+    std::vector<std::unique_ptr<TSession>> sessions;
+    for (std::uint32_t i = 0; i < sessionsCount; ++i) {
+        sessions.push_back(std::make_unique<TSession>(*codec, executor, mode == EMode::Shared));
+    }
+
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> writers;
+    writers.reserve(sessionsCount);
+    for (std::uint32_t i = 0; i < sessionsCount; ++i) {
+        writers.emplace_back([&, i] {
+            std::mt19937 rng(seed + i);
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::uint64_t b = 0; b < blocksPerSession; ++b) {
+                // Mostly small blocks with a few large batches
+                const size_t size = rng() % 10 ? 16 * 1024 + rng() % (48 * 1024) : 4 * CHUNK_SIZE + rng() % (4 * CHUNK_SIZE);
+                const size_t offset = rng() % (corpus.size() - size);
+                sessions[i]->Compress(std::string_view(corpus).substr(offset, size));
+                bytes.fetch_add(size, std::memory_order_relaxed);
+            }
+            sessions[i]->Wait();
+        });
+    }
+
+    const auto t0 = TClock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    TResult r;
+    r.Mode = mode;
+    r.Sessions = sessionsCount;
+    r.DurationMs = std::chrono::duration<double, std::milli>(TClock::now() - t0).count();
+    r.Bytes = bytes.load();
+    double totalLatencyMs = 0.0;
+    for (const auto& session : sessions) {
+        r.Blocks += session->GetBlocks();
+        totalLatencyMs += session->GetTotalLatencyMs();
+        r.MaxBlockLatencyMs = std::max(r.MaxBlockLatencyMs, session->GetMaxLatencyMs());
+    }
+    r.AvgBlockLatencyMs = totalLatencyMs / std::max<std::uint64_t>(r.Blocks, 1);
+
+    if (mode == EMode::Shared) {
+        const auto statsAfter = GetSharedCompressionExecutorStats();
+        r.ExecutorStats.TasksExecuted = statsAfter.TasksExecuted - statsBefore.TasksExecuted;
+        r.ExecutorStats.TasksStolen = statsAfter.TasksStolen - statsBefore.TasksStolen;
+        r.ExecutorStats.TotalWaitTime = statsAfter.TotalWaitTime - statsBefore.TotalWaitTime;
+    } else {
+        executor->Stop();
+    }
+    return r;
+}
+
+void PrintRow(const TResult& r) {
+    std::cout
+        << "executor=" << std::left << std::setw(12) << ToString(r.Mode)
+        << "  sessions=" << std::setw(3) << r.Sessions
+        << "  duration_ms=" << std::fixed << std::setprecision(2) << std::setw(9) << r.DurationMs
+        << "  MB/s=" << std::setprecision(1) << std::setw(8) << r.Bytes / r.DurationMs / 1e3
+        << "  avg_block_ms=" << std::setprecision(2) << std::setw(8) << r.AvgBlockLatencyMs
+        << "  max_block_ms=" << std::setw(8) << r.MaxBlockLatencyMs;
+    if (r.Mode == EMode::Shared) {
+        std::cout
+            << "  tasks=" << r.ExecutorStats.TasksExecuted
+            << "  stolen=" << r.ExecutorStats.TasksStolen
+            << "  avg_queue_wait_us=" << std::setprecision(1)
+            << static_cast<double>(r.ExecutorStats.TotalWaitTime.MicroSeconds()) / std::max<std::uint64_t>(r.ExecutorStats.TasksExecuted, 1);
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t blocks = 200;
+    std::uint32_t poolThreads = 2;
+    std::uint32_t seed = 42;
+
+    NLastGetopt::TOpts opts;
+    opts.AddLongOption("blocks", "Number of blocks compressed by each session")
+        .DefaultValue(std::to_string(blocks)).StoreResult(&blocks);
+    opts.AddLongOption("pool-threads", "Threads of the per-client thread pool executor (the default compression executor has 2)")
+        .DefaultValue(std::to_string(poolThreads)).StoreResult(&poolThreads);
+    opts.AddLongOption("seed", "Random seed of the block sizes")
+        .DefaultValue(std::to_string(seed)).StoreResult(&seed);
+    NLastGetopt::TOptsParseResult(&opts, argc, argv);
+
+    blocks = std::max<std::uint64_t>(blocks, 1);
+    poolThreads = std::max(poolThreads, 1u);
+
+    const std::string corpus = MakeCorpus(16 * CHUNK_SIZE, seed);
+
+    std::cout
+        << "Topic compression executors benchmark (zstd)\n"
+        << "  blocks/session        = " << blocks << "\n"
+        << "  pool_threads          = " << poolThreads << "\n"
+        << "  cores                 = " << std::thread::hardware_concurrency() << "\n"
+        << "  blocks                = 90% 16-64 KB, 10% 4-8 MB, at most " << MAX_IN_FLIGHT_BLOCKS << " in flight per session\n"
+        << "  (shared executor splits large blocks into " << (CHUNK_SIZE >> 20) << " MB chunks)\n"
+        << std::endl;
+
+    for (std::uint32_t sessions : {1u, 8u, 64u}) {
+        PrintRow(RunWorkload(EMode::ThreadPool, sessions, blocks, corpus, poolThreads, seed));
+        PrintRow(RunWorkload(EMode::Shared, sessions, blocks, corpus, poolThreads, seed));
+    }
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include <src/client/topic/impl/write_session_impl.h>
+
+#include <library/cpp/getopt/last_getopt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NYdb;
+using namespace NYdb::NTopic;
+
+namespace {
+
+enum class EPush {
+    Locked,
+    LockFree,
+};
+
+enum class EConsume {
+    GetEvents,
+    WaitEvent,
+};
+
+const char* ToString(EPush mode) {
+    switch (mode) {
+        case EPush::Locked:
+            return "locked";
+        case EPush::LockFree:
+            return "lock_free";
+    }
+    return "unknown";
+}
+
+const char* ToString(EConsume mode) {
+    switch (mode) {
+        case EConsume::GetEvents:
+            return "get_events";
+        case EConsume::WaitEvent:
+            return "wait_event";
+    }
+    return "unknown";
+}
+
+class TBenchmarkQueue : public TWriteSessionEventsQueue {
+public:
+    using TWriteSessionEventsQueue::TWriteSessionEventsQueue;
+
+    // The push path used before lock-free pushes: every producer takes the consumer's lock
+    void PushEventLocked(TEventInfo eventInfo) {
+        TWaiter waiter;
+        {
+            std::lock_guard guard(Mutex);
+            Events.emplace(std::move(eventInfo));
+            waiter = PopWaiterImpl();
+        }
+        waiter.Signal();
+    }
+};
+
+struct TResult {
+    EPush Push = EPush::Locked;
+    EConsume Consume = EConsume::GetEvents;
+    std::uint32_t Producers = 0;
+    std::uint64_t Events = 0;
+    std::uint64_t Wakeups = 0;
+    double DurationMs = 0.0;
+};
+
+// Emulates gRPC callbacks pushing acks into the write session queue while the user thread reads them
+TResult RunWorkload(EPush push, EConsume consume, std::uint32_t producers, std::uint64_t eventsPerProducer) {
+    TWriteSessionSettings settings;
+    TBenchmarkQueue queue(settings);
+
+    const std::uint64_t total = static_cast<std::uint64_t>(producers) * eventsPerProducer;
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    threads.reserve(producers);
+    for (std::uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::uint64_t i = 0; i < eventsPerProducer; ++i) {
+                TWriteSessionEvent::TAcksEvent acks;
+                acks.Acks.push_back({
+                    .SeqNo = p * eventsPerProducer + i + 1,
+                    .State = TWriteSessionEvent::TWriteAck::EES_WRITTEN,
+                });
+                if (push == EPush::Locked) {
+                    queue.PushEventLocked(TWriteSessionEvent::TEvent(std::move(acks)));
+                } else {
+                    queue.PushEvent(TWriteSessionEvent::TEvent(std::move(acks)));
+                }
+            }
+        });
+    }
+
+    TResult r;
+    r.Push = push;
+    r.Consume = consume;
+    r.Producers = producers;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    while (r.Events < total) {
+        if (consume == EConsume::WaitEvent) {
+            queue.WaitEvent().Wait();
+        }
+        r.Events += queue.GetEvents(consume == EConsume::GetEvents).size();
+        ++r.Wakeups;
+    }
+    r.DurationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return r;
+}
+
+void PrintRow(const TResult& r) {
+    std::cout
+        << "push=" << std::left << std::setw(10) << ToString(r.Push)
+        << "  consume=" << std::setw(11) << ToString(r.Consume)
+        << "  producers=" << std::setw(3) << r.Producers
+        << "  duration_ms=" << std::fixed << std::setprecision(2) << std::setw(9) << r.DurationMs
+        << "  ns/event=" << std::setprecision(1) << std::setw(8) << r.DurationMs * 1e6 / r.Events
+        << "  Mevents/s=" << std::setprecision(2) << std::setw(6) << r.Events / r.DurationMs / 1e3
+        << "  events/wakeup=" << std::setprecision(1) << static_cast<double>(r.Events) / std::max<std::uint64_t>(r.Wakeups, 1)
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint32_t maxProducers = std::max(1u, std::thread::hardware_concurrency());
+    std::uint64_t events = 200'000;
+
+    NLastGetopt::TOpts opts;
+    opts.AddLongOption("max-producers", "Max number of threads pushing events")
+        .DefaultValue(std::to_string(maxProducers)).StoreResult(&maxProducers);
+    opts.AddLongOption("events", "Number of events pushed by each producer")
+        .DefaultValue(std::to_string(events)).StoreResult(&events);
+    NLastGetopt::TOptsParseResult(&opts, argc, argv);
+
+    maxProducers = std::max(maxProducers, 1u);
+    events = std::max<std::uint64_t>(events, 1);
+
+    std::cout
+        << "Write session events queue benchmark\n"
+        << "  events/producer       = " << events << "\n"
+        << "  max_producers         = " << maxProducers << "\n"
+        << "  (one event is an acks event pushed by a producer and retrieved by the single consumer)\n"
+        << std::endl;
+
+    for (std::uint32_t producers = 1; producers <= maxProducers; producers *= 4) {
+        for (auto consume : {EConsume::GetEvents, EConsume::WaitEvent}) {
+            PrintRow(RunWorkload(EPush::Locked, consume, producers, events));
+            PrintRow(RunWorkload(EPush::LockFree, consume, producers, events));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include <ydb-cpp-sdk/client/result/typed_row.h>
+#include <ydb-cpp-sdk/client/value/typed_row.h>
+
+#include <src/api/protos/ydb_value.pb.h>
+
+#include <library/cpp/getopt/last_getopt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<std::uint64_t> AllocatedBytes{0};
+std::atomic<std::uint64_t> AllocationsCount{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    AllocationsCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+using namespace NYdb;
+
+namespace {
+
+struct TBenchRow {
+    std::uint64_t Id = 0;
+    std::string Name;
+    std::optional<double> Score;
+    TInstant UpdatedAt;
+};
+
+} // namespace
+
+template <>
+struct NYdb::TRowTraits<TBenchRow> {
+    static constexpr auto Members = std::make_tuple(
+        NYdb::RowMember("id", &TBenchRow::Id),
+        NYdb::RowMember<NYdb::EPrimitiveType::Utf8>("name", &TBenchRow::Name),
+        NYdb::RowMember("score", &TBenchRow::Score),
+        NYdb::RowMember("updated_at", &TBenchRow::UpdatedAt));
+};
+
+namespace {
+
+std::vector<TBenchRow> MakeRows(std::uint64_t rows, std::uint64_t nameSize) {
+    std::vector<TBenchRow> result;
+    result.reserve(rows);
+    for (std::uint64_t i = 0; i < rows; ++i) {
+        TBenchRow row;
+        row.Id = i;
+        row.Name = std::string(nameSize, 'a' + i % 26);
+        if (i % 4 != 0) {
+            row.Score = static_cast<double>(i) / 2;
+        }
+        row.UpdatedAt = TInstant::MicroSeconds(1'700'000'000'000'000ull + i);
+        result.push_back(std::move(row));
+    }
+    return result;
+}
+
+TValue BuildDynamic(const std::vector<TBenchRow>& rows) {
+    TValueBuilder builder;
+    builder.BeginList();
+    for (const auto& row : rows) {
+        builder.AddListItem()
+            .BeginStruct()
+            .AddMember("id").Uint64(row.Id)
+            .AddMember("name").Utf8(row.Name)
+            .AddMember("score").OptionalDouble(row.Score)
+            .AddMember("updated_at").Timestamp(row.UpdatedAt)
+            .EndStruct();
+    }
+    builder.EndList();
+    return builder.Build();
+}
+
+TValue BuildTyped(const std::vector<TBenchRow>& rows) {
+    TTypedRowsBuilder<TBenchRow> builder;
+    builder.Reserve(rows.size());
+    for (const auto& row : rows) {
+        builder.AddRow(row);
+    }
+    return builder.Build();
+}
+
+// Same layout as a query response: struct members become columns, list items become rows.
+TResultSet MakeResultSet(const TValue& list) {
+    Ydb::ResultSet proto;
+    for (const auto& member : GetRowType<TBenchRow>().GetProto().struct_type().members()) {
+        auto* column = proto.add_columns();
+        column->set_name(member.name());
+        *column->mutable_type() = member.type();
+    }
+    for (const auto& item : list.GetProto().items()) {
+        *proto.add_rows() = item;
+    }
+    return TResultSet(std::move(proto));
+}
+
+std::uint64_t ParseDynamic(const TResultSet& resultSet) {
+    std::uint64_t checksum = 0;
+    TResultSetParser parser(resultSet);
+    auto& idParser = parser.ColumnParser("id");
+    auto& nameParser = parser.ColumnParser("name");
+    auto& scoreParser = parser.ColumnParser("score");
+    auto& updatedAtParser = parser.ColumnParser("updated_at");
+    while (parser.TryNextRow()) {
+        checksum += idParser.GetUint64();
+        checksum += nameParser.GetUtf8().size();
+        checksum += static_cast<std::uint64_t>(scoreParser.GetOptionalDouble().value_or(0));
+        checksum += updatedAtParser.GetTimestamp().MicroSeconds();
+    }
+    return checksum;
+}
+
+std::uint64_t ParseTyped(const TResultSet& resultSet) {
+    std::uint64_t checksum = 0;
+    TTypedResultSetParser<TBenchRow> parser(resultSet);
+    TBenchRow row;
+    while (parser.TryNextRow(row)) {
+        checksum += row.Id;
+        checksum += row.Name.size();
+        checksum += static_cast<std::uint64_t>(row.Score.value_or(0));
+        checksum += row.UpdatedAt.MicroSeconds();
+    }
+    return checksum;
+}
+
+struct TResult {
+    std::string Mode;
+    double DurationMs = 0.0;
+    std::uint64_t Allocations = 0;
+    std::uint64_t Checksum = 0;
+};
+
+template <typename TFunc>
+TResult Measure(const std::string& mode, int iterations, TFunc&& func) {
+    TResult r;
+    r.Mode = mode;
+
+    const auto allocationsBefore = AllocationsCount.load();
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        r.Checksum += func();
+    }
+    r.DurationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    r.Allocations = AllocationsCount.load() - allocationsBefore;
+
+    return r;
+}
+
+void PrintRow(const TResult& r, std::uint64_t rows, int iterations) {
+    const double totalRows = static_cast<double>(rows) * iterations;
+    std::cout
+        << std::left << std::setw(14) << r.Mode
+        << "  duration_ms=" << std::fixed << std::setprecision(2) << std::setw(9) << r.DurationMs
+        << "  ns/row=" << std::setprecision(1) << std::setw(7) << r.DurationMs * 1e6 / totalRows
+        << "  allocs/row=" << std::setprecision(3) << std::setw(7) << r.Allocations / totalRows
+        << "  checksum=" << r.Checksum
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t rows = 100'000;
+    std::uint64_t nameSize = 16;
+    int iterations = 10;
+
+    NLastGetopt::TOpts opts;
+    opts.AddLongOption("rows", "Number of rows per iteration")
+        .DefaultValue(std::to_string(rows)).StoreResult(&rows);
+    opts.AddLongOption("name", "Size of the Utf8 column value in bytes")
+        .DefaultValue(std::to_string(nameSize)).StoreResult(&nameSize);
+    opts.AddLongOption("iterations", "Number of passes in every mode")
+        .DefaultValue(std::to_string(iterations)).StoreResult(&iterations);
+    NLastGetopt::TOptsParseResult(&opts, argc, argv);
+
+    rows = std::max<std::uint64_t>(rows, 1);
+    iterations = std::max(iterations, 1);
+
+    const auto source = MakeRows(rows, nameSize);
+    const TResultSet resultSet = MakeResultSet(BuildTyped(source));
+
+    std::cout
+        << "Typed row benchmark\n"
+        << "  rows                  = " << rows << "\n"
+        << "  name_bytes            = " << nameSize << "\n"
+        << "  iterations            = " << iterations << "\n"
+        << "  (dynamic: TValueBuilder / TResultSetParser, typed: TTypedRowsBuilder / TTypedResultSetParser)\n"
+        << std::endl;
+
+    PrintRow(Measure("build_dynamic", iterations, [&] {
+        return BuildDynamic(source).GetProto().items_size();
+    }), rows, iterations);
+
+    PrintRow(Measure("build_typed", iterations, [&] {
+        return BuildTyped(source).GetProto().items_size();
+    }), rows, iterations);
+
+    PrintRow(Measure("parse_dynamic", iterations, [&] {
+        return ParseDynamic(resultSet);
+    }), rows, iterations);
+
+    PrintRow(Measure("parse_typed", iterations, [&] {
+        return ParseTyped(resultSet);
+    }), rows, iterations);
+
+    return 0;
+}
@@ -36,6 +36,7 @@ namespace NQuery {
 
 class TParams {
     friend class TParamsBuilder;
+    friend class TParamsTemplate;
     friend class NTable::TTableClient;
     friend class NTable::TSession;
     friend class NTable::TDataQuery;
@@ -53,10 +54,12 @@ public:
 private:
     TParams(::google::protobuf::Map<TStringType, Ydb::TypedValue>&& protoMap);
 
+    class TImpl;
+    TParams(std::shared_ptr<TImpl> impl);
+
     ::google::protobuf::Map<TStringType, Ydb::TypedValue>* GetProtoMapPtr();
     const ::google::protobuf::Map<TStringType, Ydb::TypedValue>& GetProtoMap() const;
 
-    class TImpl;
     std::shared_ptr<TImpl> Impl_;
 };
 
@@ -96,4 +99,56 @@ private:
     std::unique_ptr<TImpl> Impl_;
 };
 
+class TParamTemplateValueBuilder : public TValueBuilderBase<TParamTemplateValueBuilder> {
+    friend class TParamsTemplate;
+public:
+    TParamsTemplate& Build();
+
+private:
+    TParamTemplateValueBuilder(TParamsTemplate& owner, size_t index, Ydb::Type& typeProto, Ydb::Value& valueProto);
+
+    TParamsTemplate* Owner_;
+    size_t Index_;
+};
+
+//! Parameters of a statement executed many times. Names and types are declared once, every
+//! request only binds values by parameter index:
+//!
+//!     TParamsTemplate paramsTemplate({
+//!         {"$id", TTypeBuilder().Primitive(EPrimitiveType::Uint64).Build()},
+//!         {"$name", TTypeBuilder().Primitive(EPrimitiveType::Utf8).Build()}});
+//!     const size_t id = paramsTemplate.GetParamIndex("$id");
+//!     const size_t name = paramsTemplate.GetParamIndex("$name");
+//!
+//!     TParams params = paramsTemplate
+//!         .Param(id).Uint64(42).Build()
+//!         .Param(name).Utf8("abc").Build()
+//!         .Build();
+//!
+//! Parameter keys, types and values live on an arena that is reused for later requests once
+//! all TParams built from it are destroyed, so binding does not allocate in steady state.
+//! Passing the built TParams by rvalue reference detaches them from the arena with a copy.
+class TParamsTemplate : public TMoveOnly {
+    friend class TParamTemplateValueBuilder;
+public:
+    TParamsTemplate(TParamsTemplate&&);
+    TParamsTemplate(const std::vector<std::pair<std::string, TType>>& typeInfo);
+
+    ~TParamsTemplate();
+
+    size_t ParamsCount() const;
+    size_t GetParamIndex(const std::string& name) const;
+
+    //! Binds the value of the parameter for the next Build(), the value has to match the declared type
+    TParamTemplateValueBuilder& Param(size_t index);
+    TParamsTemplate& Param(size_t index, const TValue& value);
+
+    //! Every parameter has to be bound since the previous Build()
+    TParams Build();
+
+private:
+    class TImpl;
+    std::unique_ptr<TImpl> Impl_;
+};
+
 } // namespace NYdb
@@ -39,6 +39,8 @@ public:
     static const Ydb::Type& GetProto(const TType& type);
     static const Ydb::Value& GetProto(const TValue& value);
     static const Ydb::ResultSet& GetProto(const TResultSet& resultSet);
+    //! Allows to move rows out of a result set owned by the caller only
+    static Ydb::ResultSet* GetProtoPtr(TResultSet& resultSet);
     static const ::google::protobuf::Map<TStringType, Ydb::TypedValue>& GetProtoMap(const TParams& params);
     static ::google::protobuf::Map<TStringType, Ydb::TypedValue>* GetProtoMapPtr(TParams& params);
     static const Ydb::TableStats::QueryStats& GetProto(const NTable::TQueryStats& queryStats);
@@ -51,6 +51,11 @@ struct TSessionPoolSettings {
     // Min number of session in session pool.
     // Sessions will not be closed by CloseIdleThreshold if the number of sessions less then this limit.
     FLUENT_SETTING_DEFAULT(uint32_t, MinPoolSize, 10);
+
+    // Number of shards of idle sessions. With more than one shard threads take and return sessions
+    // to their own shards and the pool-wide lock is taken only if there are waiters.
+    // Useful when many threads get sessions at high rate.
+    FLUENT_SETTING_DEFAULT(uint32_t, ShardsCount, 1);
 };
 
 struct TClientSettings : public TCommonClientSettingsBase<TClientSettings> {
@@ -113,6 +113,7 @@ struct TExecuteQuerySettings : public TRequestSettings<TExecuteQuerySettings> {
     FLUENT_SETTING_DEFAULT(ESchemaInclusionMode, SchemaInclusionMode, ESchemaInclusionMode::Unspecified);
     FLUENT_SETTING_DEFAULT(TResultSet::EFormat, Format, TResultSet::EFormat::Unspecified);
     FLUENT_SETTING_OPTIONAL(TArrowFormatSettings, ArrowFormatSettings);
+    FLUENT_SETTING_OPTIONAL(TReadAheadSettings, ReadAhead);
 };
 
 struct TBeginTxSettings : public TRequestSettings<TBeginTxSettings> {};
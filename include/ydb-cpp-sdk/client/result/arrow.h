@@ -0,0 +1,205 @@
+#pragma once
+
+#include "result.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace NYdb::inline V3 {
+
+//! Provides access to raw Arrow IPC messages of a result set received in EFormat::Arrow
+class TArrowAccessor {
+public:
+    //! Returns serialized schema message
+    static const std::string& GetSchema(const TResultSet& resultSet);
+
+    //! Returns serialized record batch messages
+    static const std::vector<std::string>& GetBatches(const TResultSet& resultSet);
+};
+
+namespace NArrow {
+
+enum class EType {
+    Null,
+    Bool,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    Uint8,
+    Uint16,
+    Uint32,
+    Uint64,
+    HalfFloat,
+    Float,
+    Double,
+    Binary,
+    Utf8,
+    LargeBinary,
+    LargeUtf8,
+    FixedSizeBinary,
+    Decimal,
+    Date32,
+    Date64,
+    Time32,
+    Time64,
+    Timestamp,
+    Duration,
+    Struct,
+    List,
+};
+
+enum class ETimeUnit {
+    Second = 0,
+    Millisecond = 1,
+    Microsecond = 2,
+    Nanosecond = 3,
+};
+
+struct TField {
+    std::string Name;
+    EType Type = EType::Null;
+    bool Nullable = true;
+
+    //! Size of a single value in bytes for fixed-width types, 0 otherwise
+    size_t ByteWidth = 0;
+
+    //! Decimal
+    int32_t Precision = 0;
+    int32_t Scale = 0;
+
+    //! Time32, Time64, Timestamp, Duration
+    ETimeUnit Unit = ETimeUnit::Second;
+    std::string Timezone;
+
+    //! Struct members or list item
+    std::vector<TField> Children;
+};
+
+struct TSchema {
+    std::vector<TField> Fields;
+};
+
+//! Parses encapsulated Arrow IPC schema message
+TSchema ParseSchema(std::string_view message);
+
+class TColumnViewBuilder;
+
+//! Read-only view of a single column of a record batch.
+//! Points into the message it was parsed from, no data is copied unless the body is compressed.
+class TColumnView {
+    friend class TColumnViewBuilder;
+
+public:
+    const TField& GetField() const;
+
+    size_t Size() const;
+    size_t NullCount() const;
+
+    bool IsNull(size_t row) const;
+
+    //! Getters of values throw if the row is out of bounds
+
+    //! Returns value of fixed-width column, T must match the field byte width
+    template <typename T>
+    T GetValue(size_t row) const {
+        static_assert(std::is_trivially_copyable_v<T>);
+        CheckRow(row);
+        CheckValueWidth(sizeof(T));
+
+        T value;
+        std::memcpy(&value, Values_ + row * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    bool GetBool(size_t row) const;
+
+    //! Binary, Utf8, LargeBinary, LargeUtf8 and FixedSizeBinary columns
+    std::string_view GetString(size_t row) const;
+
+    //! Bit-packed validity bitmap, nullptr if column has no nulls
+    const uint8_t* GetValidityBitmap() const;
+
+    //! Raw values buffer of fixed-width and varlen columns
+    const uint8_t* GetValues() const;
+
+    //! Offsets buffer of varlen and list columns (int32 or int64 for large types)
+    const uint8_t* GetOffsets() const;
+
+    //! Struct members or list items
+    size_t ChildrenCount() const;
+    const TColumnView& GetChild(size_t index) const;
+
+private:
+    void CheckRow(size_t row) const;
+    void CheckValueWidth(size_t width) const;
+    void CheckOffset(size_t index, size_t width) const;
+    size_t GetItemOffset(size_t index) const;
+
+private:
+    const TField* Field_ = nullptr;
+    size_t Size_ = 0;
+    size_t NullCount_ = 0;
+
+    const uint8_t* Validity_ = nullptr;
+    const uint8_t* Offsets_ = nullptr;
+    size_t OffsetsSize_ = 0;
+    const uint8_t* Values_ = nullptr;
+    size_t ValuesSize_ = 0;
+
+    std::vector<TColumnView> Children_;
+};
+
+//! Record batch parsed from encapsulated Arrow IPC message.
+//! Valid while both the message and the schema it was parsed with are alive.
+class TRecordBatchView {
+public:
+    TRecordBatchView() = default;
+    TRecordBatchView(const TSchema& schema, std::string_view message);
+
+    size_t RowsCount() const;
+    size_t ColumnsCount() const;
+
+    const TColumnView& GetColumn(size_t columnIndex) const;
+
+private:
+    size_t RowsCount_ = 0;
+    std::vector<TColumnView> Columns_;
+
+    //! Decompressed buffers of compressed bodies
+    std::shared_ptr<std::vector<std::string>> Decompressed_;
+};
+
+} // namespace NArrow
+
+//! Arrow counterpart of TResultSetParser, iterates over record batches of a result set
+//! received in EFormat::Arrow without converting cells to Ydb::Value.
+//! Note: batches and columns returned by the parser are valid while the parser is alive.
+class TArrowResultSetParser : public TMoveOnly {
+public:
+    TArrowResultSetParser(TArrowResultSetParser&&);
+    TArrowResultSetParser(const TResultSet& resultSet);
+
+    ~TArrowResultSetParser();
+
+    const NArrow::TSchema& GetSchema() const;
+
+    //! Returns index for column with specified name.
+    //! If there is no column with such name, then -1 is returned.
+    ssize_t ColumnIndex(const std::string& columnName) const;
+
+    //! Returns number of record batches
+    size_t BatchesCount() const;
+
+    //! Set iterator to the next record batch.
+    //! Batch is invalid before the first TryNextBatch call.
+    bool TryNextBatch();
+
+    const NArrow::TRecordBatchView& GetBatch() const;
+
+private:
+    class TImpl;
+    std::unique_ptr<TImpl> Impl_;
+};
+
+} // namespace NYdb
@@ -4,7 +4,10 @@
 
 #include <ydb-cpp-sdk/client/value/value.h>
 
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace Ydb {
     class ResultSet;
@@ -18,6 +21,7 @@ namespace NQuery {
 
 class TProtoAccessor;
 class TArrowAccessor;
+class TTypedResultSetParserBase;
 
 struct TColumn {
     std::string Name;
@@ -39,6 +43,7 @@ class TResultSet {
     friend class TResultSetParser;
     friend class NYdb::TProtoAccessor;
     friend class NYdb::TArrowAccessor;
+    friend class NYdb::TTypedResultSetParserBase;
     friend struct NQuery::TExecuteQueryBuffer;
 
 public:
@@ -52,6 +57,11 @@ public:
     TResultSet(const Ydb::ResultSet& proto);
     TResultSet(Ydb::ResultSet&& proto);
 
+    //! Shares ownership of the proto instead of copying it.
+    //! The pointer may alias a larger message (e.g. the whole gRPC response) which
+    //! is kept alive as long as any copy of the result set or its parser exists.
+    explicit TResultSet(std::shared_ptr<Ydb::ResultSet> proto);
+
     TResultSet(const Ydb::ResultSet& proto, const std::string& arrowSchema, const std::vector<std::string>& bytesData);
     TResultSet(Ydb::ResultSet&& proto, std::string&& arrowSchema, std::vector<std::string>&& bytesData);
 
@@ -87,6 +97,14 @@ private:
     std::shared_ptr<TImpl> Impl_;
 };
 
+//! Values of a single primitive column extracted from the result set in one pass.
+//! Nulls[i] is set for NULL cells of optional columns, Values[i] is default-initialized for them.
+template <typename T>
+struct TColumnValues {
+    std::vector<T> Values;
+    std::vector<bool> Nulls;
+};
+
 //! Note: TResultSetParser - mutable object, iteration thougth it changes internal state
 class TResultSetParser : public TMoveOnly {
 public:
@@ -130,6 +148,23 @@ public:
     //! direct TValueParser constructed by ColumnParser call
     TValue GetValue(const std::string& columnName) const;
 
+    //! Columnar access to primitive and optional primitive columns.
+    //! Column type is validated once per call instead of once per cell, values are read
+    //! directly from the result set without touching column parsers or the row position.
+    //! Each getter accepts all primitive types with the same wire representation,
+    //! e.g. GetUint32Column accepts Uint8, Uint16, Uint32, Date and Datetime columns.
+    TColumnValues<bool> GetBoolColumn(size_t columnIndex) const;
+    TColumnValues<int32_t> GetInt32Column(size_t columnIndex) const;
+    TColumnValues<uint32_t> GetUint32Column(size_t columnIndex) const;
+    TColumnValues<int64_t> GetInt64Column(size_t columnIndex) const;
+    TColumnValues<uint64_t> GetUint64Column(size_t columnIndex) const;
+    TColumnValues<float> GetFloatColumn(size_t columnIndex) const;
+    TColumnValues<double> GetDoubleColumn(size_t columnIndex) const;
+
+    //! Returned views point into the result set and stay valid while it is alive
+    TColumnValues<std::string_view> GetStringColumn(size_t columnIndex) const;
+    TColumnValues<std::string_view> GetUtf8Column(size_t columnIndex) const;
+
 private:
     class TImpl;
     std::unique_ptr<TImpl> Impl_;
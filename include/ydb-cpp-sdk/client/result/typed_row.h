@@ -0,0 +1,67 @@
+#pragma once
+
+#include "result.h"
+
+#include <ydb-cpp-sdk/client/value/typed_row.h>
+
+#include <utility>
+#include <vector>
+
+namespace NYdb::inline V3 {
+
+//! Matches members of the row type with the result set columns, see TTypedResultSetParser
+class TTypedResultSetParserBase {
+protected:
+    //! rowType is a struct type, its members are looked up in the columns by name.
+    //! Throws if a member has no column or the column type differs from the member type;
+    //! optional members may be read from non-optional columns.
+    TTypedResultSetParserBase(const TResultSet& resultSet, const TType& rowType);
+
+    //! Returns the next row, nullptr after the last one
+    const Ydb::Value* NextRow();
+
+    size_t RowsCount() const;
+
+    //! Column of the row holding the member with the given index
+    size_t ColumnIndex(size_t memberIndex) const {
+        return ColumnIndexes_[memberIndex];
+    }
+
+private:
+    TResultSet ResultSet_;
+    std::vector<size_t> ColumnIndexes_;
+    size_t RowIndex_ = 0;
+};
+
+//! Parses result set rows into row structs described by TRowTraits.
+//! Column types are checked once in the constructor, then members are read by index straight from the proto.
+template <typename TRow>
+class TTypedResultSetParser : private TTypedResultSetParserBase {
+public:
+    explicit TTypedResultSetParser(const TResultSet& resultSet)
+        : TTypedResultSetParserBase(resultSet, GetRowType<TRow>())
+    {}
+
+    size_t RowsCount() const {
+        return TTypedResultSetParserBase::RowsCount();
+    }
+
+    //! Fills the row with the values of the next result row, returns false after the last one.
+    //! Passing the same row object on every call reuses its string buffers.
+    bool TryNextRow(TRow& row) {
+        const Ydb::Value* value = NextRow();
+        if (!value) {
+            return false;
+        }
+        ReadMembers(*value, row, std::make_index_sequence<NTypedRow::MembersCount<TRow>()>());
+        return true;
+    }
+
+private:
+    template <size_t... Indexes>
+    void ReadMembers(const Ydb::Value& value, TRow& row, std::index_sequence<Indexes...>) {
+        (NTypedRow::GetMember(std::get<Indexes>(TRowTraits<TRow>::Members), value.items(ColumnIndex(Indexes)), row), ...);
+    }
+};
+
+} // namespace NYdb
@@ -27,7 +27,9 @@ struct TCreateSessionSettings;
 struct TSessionPoolSettings;
 struct TClientSettings;
 struct TBulkUpsertSettings;
+struct TBulkUpsertWriterSettings;
 struct TReadRowsSettings;
+struct TReadRowsParallelSettings;
 struct TStreamExecScanQuerySettings;
 struct TTxOnlineSettings;
 struct TCreateTableSettings;
@@ -47,6 +49,7 @@ struct TRollbackTxSettings;
 struct TCloseSessionSettings;
 struct TKeepAliveSettings;
 struct TReadTableSettings;
+struct TReadTableParallelSettings;
 
 class TPartitioningSettings;
 class TDateTypeColumnModeSettings;
@@ -99,6 +102,7 @@ class TSimpleStreamPart;
 class TScanQueryPart;
 
 class TTablePartIterator;
+class TParallelTablePartIterator;
 class TScanQueryPartIterator;
 
 class TReadTableSnapshot;
@@ -113,5 +117,6 @@ class TTxControl;
 
 class TSession;
 class TTableClient;
+class TBulkUpsertWriter;
 
 }  // namespace NYdb
@@ -1477,6 +1477,7 @@ using TAsyncDescribeSystemViewResult = NThreading::TFuture<TDescribeSystemViewRe
 using TAsyncBeginTransactionResult = NThreading::TFuture<TBeginTransactionResult>;
 using TAsyncCommitTransactionResult = NThreading::TFuture<TCommitTransactionResult>;
 using TAsyncTablePartIterator = NThreading::TFuture<TTablePartIterator>;
+using TAsyncParallelTablePartIterator = NThreading::TFuture<TParallelTablePartIterator>;
 using TAsyncKeepAliveResult = NThreading::TFuture<TKeepAliveResult>;
 using TAsyncBulkUpsertResult = NThreading::TFuture<TBulkUpsertResult>;
 using TAsyncReadRowsResult = NThreading::TFuture<TReadRowsResult>;
@@ -1509,6 +1510,11 @@ struct TSessionPoolSettings {
     // Min number of session in session pool.
     // Sessions will not be closed by CloseIdleThreshold if the number of sessions less then this limit.
     FLUENT_SETTING_DEFAULT(uint32_t, MinPoolSize, 10);
+
+    // Number of shards of idle sessions. With more than one shard threads take and return sessions
+    // to their own shards and the pool-wide lock is taken only if there are waiters.
+    // Useful when many threads get sessions at high rate.
+    FLUENT_SETTING_DEFAULT(uint32_t, ShardsCount, 1);
 };
 
 struct TClientSettings : public TCommonClientSettingsBase<TClientSettings> {
@@ -1558,6 +1564,62 @@ struct TBulkUpsertSettings : public TOperationRequestSettings<TBulkUpsertSetting
 struct TReadRowsSettings : public TOperationRequestSettings<TReadRowsSettings> {
 };
 
+struct TReadRowsParallelSettings {
+    using TSelf = TReadRowsParallelSettings;
+
+    // Settings of every ReadRows request
+    FLUENT_SETTING(TReadRowsSettings, ReadRowsSettings);
+
+    // Maximum number of keys sent in a single ReadRows request
+    FLUENT_SETTING_DEFAULT(size_t, MaxKeysPerRequest, 1000);
+
+    FLUENT_SETTING_DEFAULT(size_t, MaxConcurrentRequests, 4);
+};
+
+struct TReadTableSettings : public TRequestSettings<TReadTableSettings> {
+
+    using TSelf = TReadTableSettings;
+
+    FLUENT_SETTING_OPTIONAL(TKeyBound, From);
+
+    FLUENT_SETTING_OPTIONAL(TKeyBound, To);
+
+    FLUENT_SETTING_VECTOR(std::string, Columns);
+
+    FLUENT_SETTING_FLAG(Ordered);
+
+    FLUENT_SETTING_OPTIONAL(uint64_t, RowLimit);
+
+    FLUENT_SETTING_OPTIONAL(bool, UseSnapshot);
+
+    FLUENT_SETTING_OPTIONAL(uint64_t, BatchLimitBytes);
+
+    FLUENT_SETTING_OPTIONAL(uint64_t, BatchLimitRows);
+
+    FLUENT_SETTING_OPTIONAL(bool, ReturnNotNullAsOptional);
+
+    FLUENT_SETTING_OPTIONAL(TReadAheadSettings, ReadAhead);
+};
+
+struct TReadTableParallelSettings {
+    using TSelf = TReadTableParallelSettings;
+
+    // Settings of per-partition streams, RowLimit is applied to every partition.
+    // From and To must not be set, the table is split by its partition boundaries.
+    FLUENT_SETTING(TReadTableSettings, ReadTableSettings);
+
+    // Maximum number of partitions read at the same time, each on its own session
+    FLUENT_SETTING_DEFAULT(size_t, MaxConcurrentReaders, 4);
+
+    // Return parts in primary key order, i.e. partition after partition.
+    // Otherwise parts are returned as soon as any of the readers gets them.
+    FLUENT_SETTING_FLAG(KeyOrdered);
+
+    // Readers are paused while size of parts received but not yet consumed exceeds the limit
+    FLUENT_SETTING_DEFAULT(uint64_t, MaxBufferedBytes, 64_MB);
+};
+
+
 struct TStreamExecScanQuerySettings : public TRequestSettings<TStreamExecScanQuerySettings> {
     // Return query plan without actual query execution
     FLUENT_SETTING_DEFAULT(bool, Explain, false);
@@ -1568,6 +1630,9 @@ struct TStreamExecScanQuerySettings : public TRequestSettings<TStreamExecScanQue
     // Deprecated. Use CollectQueryStats >= ECollectQueryStatsMode::Full to get QueryMeta in QueryStats
     // Collect full query compilation diagnostics
     FLUENT_SETTING_DEFAULT(bool, CollectFullDiagnostics, false);
+
+    // Keep reading the stream while received parts are processed
+    FLUENT_SETTING_OPTIONAL(TReadAheadSettings, ReadAhead);
 };
 
 enum class EDataFormat {
@@ -1664,6 +1729,16 @@ public:
     TAsyncReadRowsResult ReadRows(const std::string& table, TValue&& keys, const std::vector<std::string>& columns = {},
         const TReadRowsSettings& settings = TReadRowsSettings());
 
+    //! Splits "keys" list into chunks and reads them with concurrent ReadRows requests.
+    //! Rows of the result set are in the order of chunks.
+    TAsyncReadRowsResult ReadRowsParallel(const std::string& table, TValue&& keys, const std::vector<std::string>& columns = {},
+        const TReadRowsParallelSettings& settings = TReadRowsParallelSettings());
+
+    //! Reads the table with several ReadTable streams, one per partition.
+    //! Partition boundaries are taken from DescribeTable key ranges.
+    TAsyncParallelTablePartIterator ReadTableParallel(const std::string& path,
+        const TReadTableParallelSettings& settings = TReadTableParallelSettings());
+
     TAsyncScanQueryPartIterator StreamExecuteScanQuery(const std::string& query,
         const TStreamExecScanQuerySettings& settings = TStreamExecScanQuerySettings());
 
@@ -1677,6 +1752,57 @@ private:
 
 ////////////////////////////////////////////////////////////////////////////////
 
+struct TBulkUpsertWriterSettings {
+    using TSelf = TBulkUpsertWriterSettings;
+
+    TBulkUpsertWriterSettings() {
+        RetrySettings_.Idempotent(true);
+    }
+
+    // Settings of every BulkUpsert request, Arena is managed by the writer
+    FLUENT_SETTING(TBulkUpsertSettings, BulkUpsertSettings);
+
+    // Failed requests are retried with these settings, BulkUpsert is idempotent
+    FLUENT_SETTING(TRetryOperationSettings, RetrySettings);
+
+    // Batch is sent as soon as it reaches any of the limits
+    FLUENT_SETTING_DEFAULT(size_t, MaxBatchRows, 1000);
+    FLUENT_SETTING_DEFAULT(uint64_t, MaxBatchBytes, 8_MB);
+
+    // Maximum number of BulkUpsert requests running at the same time
+    FLUENT_SETTING_DEFAULT(size_t, MaxInFlight, 4);
+};
+
+//! Accumulates rows and writes them to the table with BulkUpsert in batches.
+//! Batches are built on reusable arenas, failed requests are retried.
+//! The writer is closed on destruction: rows which are not sent yet are sent without waiting for the result.
+class TBulkUpsertWriter {
+public:
+    TBulkUpsertWriter(const TTableClient& client, const std::string& table,
+        const TBulkUpsertWriterSettings& settings = TBulkUpsertWriterSettings());
+    ~TBulkUpsertWriter();
+
+    //! Adds a row, all rows must be structs of the same type.
+    //! The future is ready when the writer can accept more rows: full batches which don't fit
+    //! into MaxInFlight are kept in memory until some request is finished.
+    //! After a failure rows are dropped and the error is returned by Flush.
+    NThreading::TFuture<void> AddRow(const TValue& row);
+
+    //! Sends the current batch, the status is ready when all rows added before the call are written.
+    //! Returns the first error of the writer, if any.
+    TAsyncStatus Flush();
+
+    //! Sends the current batch and stops accepting rows, AddRow throws after it.
+    //! The status is ready when all rows are written, it is the first error of the writer, if any.
+    TAsyncStatus Close();
+
+private:
+    class TImpl;
+    std::shared_ptr<TImpl> Impl_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 struct TTxOnlineSettings {
     using TSelf = TTxOnlineSettings;
 
@@ -2232,29 +2358,6 @@ struct TCloseSessionSettings : public TOperationRequestSettings<TCloseSessionSet
 
 struct TKeepAliveSettings : public TOperationRequestSettings<TKeepAliveSettings> {};
 
-struct TReadTableSettings : public TRequestSettings<TReadTableSettings> {
-
-    using TSelf = TReadTableSettings;
-
-    FLUENT_SETTING_OPTIONAL(TKeyBound, From);
-
-    FLUENT_SETTING_OPTIONAL(TKeyBound, To);
-
-    FLUENT_SETTING_VECTOR(std::string, Columns);
-
-    FLUENT_SETTING_FLAG(Ordered);
-
-    FLUENT_SETTING_OPTIONAL(uint64_t, RowLimit);
-
-    FLUENT_SETTING_OPTIONAL(bool, UseSnapshot);
-
-    FLUENT_SETTING_OPTIONAL(uint64_t, BatchLimitBytes);
-
-    FLUENT_SETTING_OPTIONAL(uint64_t, BatchLimitRows);
-
-    FLUENT_SETTING_OPTIONAL(bool, ReturnNotNullAsOptional);
-};
-
 //! Represents all session operations
 //! Session is transparent logic representation of connection
 class TSession {
@@ -2611,6 +2714,33 @@ private:
 
 using TReadTableResultPart = TSimpleStreamPart<TResultSet>;
 
+struct TReadTableParallelProgress {
+    size_t PartitionsTotal = 0;
+    size_t PartitionsFinished = 0;
+    uint64_t RowsRead = 0;
+    uint64_t BytesRead = 0;
+    // Size of parts received from the server but not yet returned by ReadNext
+    uint64_t BufferedBytes = 0;
+};
+
+class TParallelTablePartIterator : public TStatus {
+    friend class TTableClient;
+public:
+    //! Returns parts of all partitions, EOS part is returned after the last partition is finished.
+    //! The first failed part stops all readers and is returned as is.
+    TAsyncSimpleStreamPart<TResultSet> ReadNext();
+
+    TReadTableParallelProgress GetProgress() const;
+
+    class TReaderImpl;
+private:
+    TParallelTablePartIterator(
+        std::shared_ptr<TReaderImpl> impl,
+        TStatus&& status
+    );
+    std::shared_ptr<TReaderImpl> ReaderImpl_;
+};
+
 class TScanQueryPart : public TStreamPartStatus {
 public:
     bool HasResultSet() const { return ResultSet_.has_value(); }
@@ -15,6 +15,10 @@ struct TTopicClientSettings : public TCommonClientSettingsBase<TTopicClientSetti
 
     //! Default executor for callbacks.
     FLUENT_SETTING_DEFAULT(IExecutor::TPtr, DefaultHandlersExecutor, CreateThreadPoolExecutor(1));
+
+    //! Default memory pool of read sessions.
+    //! Set the same pool in the clients of a driver to limit memory of all their read sessions together.
+    FLUENT_SETTING(IReadSessionMemoryPool::TPtr, DefaultReadSessionMemoryPool);
 };
 
 // Topic client.
@@ -10,6 +10,8 @@
 
 #include <unordered_map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace NYdb::inline V3::NTopic {
 
@@ -19,6 +21,9 @@ enum class ECodec : uint32_t {
     LZOP = 3,
     ZSTD = 4,
     CUSTOM = 10000,
+    //! LZ4 frame format. The server has no built-in id for it, so id 10001 of the custom range is reserved for it.
+    //! The codec is not registered by default, provide TLz4Codec under this id to writers and readers
+    LZ4 = 10001,
 };
 
 inline const std::string& GetCodecId(const ECodec codec) {
@@ -37,20 +42,65 @@ public:
     virtual ~ICodec() = default;
     virtual std::string Decompress(const std::string& data) const = 0;
     virtual std::unique_ptr<IOutputStream> CreateCoder(TBuffer& result, int quality) const = 0;
+
+    //! Decompresses data into result, previous content of result is replaced.
+    //! uncompressedSizeHint is the expected size of decompressed data (e.g. sent by the server), 0 if unknown.
+    virtual void DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const {
+        Y_UNUSED(uncompressedSizeHint);
+        result = Decompress(data);
+    }
 };
 
+//! Built-in codecs keep decompression state per thread and decompress directly into the pre-sized output
 class TGzipCodec final : public ICodec {
+public:
     std::string Decompress(const std::string& data) const override;
+    void DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const override;
 
     std::unique_ptr<IOutputStream> CreateCoder(TBuffer& result, int quality) const override;
 };
 
 class TZstdCodec final : public ICodec {
+public:
     std::string Decompress(const std::string& data) const override;
+    void DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const override;
 
     std::unique_ptr<IOutputStream> CreateCoder(TBuffer& result, int quality) const override;
 };
 
+//! Levels below 9 compress in the fast mode (negative ones with acceleration), higher ones in the high compression mode
+class TLz4Codec final : public ICodec {
+public:
+    std::string Decompress(const std::string& data) const override;
+    void DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const override;
+
+    std::unique_ptr<IOutputStream> CreateCoder(TBuffer& result, int quality) const override;
+};
+
+//! ZSTD with a pre-trained dictionary, for topics with many small similar messages (e.g. JSON events).
+//! Dictionary id is stored in the header of every compressed message, so the reader picks the dictionary
+//! by the message itself. Previous dictionaries are only used to decompress messages written before retraining.
+//! The codec is not registered by default: provide it under the same custom codec id to writers and readers.
+class TZstdDictCodec final : public ICodec {
+public:
+    explicit TZstdDictCodec(const std::string& dictionary, const std::vector<std::string>& previousDictionaries = {});
+    ~TZstdDictCodec();
+
+    //! Trains a dictionary from a sample of messages, throws if the sample is not enough for training
+    static std::string TrainDictionary(const std::vector<std::string>& samples, size_t maxDictionarySize = 110 * 1024);
+
+    uint32_t GetDictionaryId() const;
+
+    std::string Decompress(const std::string& data) const override;
+    void DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const override;
+
+    std::unique_ptr<IOutputStream> CreateCoder(TBuffer& result, int quality) const override;
+
+private:
+    class TImpl;
+    std::unique_ptr<TImpl> Impl_;
+};
+
 class TUnsupportedCodec final : public ICodec {
     std::string Decompress(const std::string&) const override;
 
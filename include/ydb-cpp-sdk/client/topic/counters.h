@@ -23,6 +23,11 @@ struct TWriterCounters : public TThrRefBase {
         BytesInflightTotal = counters->GetCounter("bytesInflightTotal", false);
         MessagesInflight = counters->GetCounter("messagesInflight", false);
 
+        WriteRequests = counters->GetCounter("writeRequests", true);
+        BatchFlushIntervalUs = counters->GetCounter("batchFlushIntervalUs", false);
+        BatchFlushSizeBytes = counters->GetCounter("batchFlushSizeBytes", false);
+        BatchWriteLatencyP99Us = counters->GetCounter("batchWriteLatencyP99Us", false);
+
         TotalBytesInflightUsageByTime = counters->GetHistogram("totalBytesInflightUsageByTime", TOPIC_COUNTERS_HISTOGRAM_SETUP);
         UncompressedBytesInflightUsageByTime = counters->GetHistogram("uncompressedBytesInflightUsageByTime", TOPIC_COUNTERS_HISTOGRAM_SETUP);
         CompressedBytesInflightUsageByTime = counters->GetHistogram("compressedBytesInflightUsageByTime", TOPIC_COUNTERS_HISTOGRAM_SETUP);
@@ -40,6 +45,14 @@ struct TWriterCounters : public TThrRefBase {
     TCounterPtr BytesInflightTotal;
     TCounterPtr MessagesInflight;
 
+    //! Write requests sent to the server.
+    TCounterPtr WriteRequests;
+    //! Decisions of adaptive batching (see TWriteSessionSettings::BatchFlushLatencyTarget):
+    //! current flush interval, expected size of a write request and p99 write latency which they are based on.
+    TCounterPtr BatchFlushIntervalUs;
+    TCounterPtr BatchFlushSizeBytes;
+    TCounterPtr BatchWriteLatencyP99Us;
+
     //! Histograms reporting % usage of memory limit in time.
     //! Provides a histogram looking like: 10% : 100ms, 20%: 300ms, ... 50%: 200ms, ... 100%: 50ms
     //! Which means that < 10% memory usage was observed for 100ms during the period and 50% usage was observed for 200ms
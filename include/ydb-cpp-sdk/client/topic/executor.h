@@ -2,8 +2,24 @@
 
 #include <ydb-cpp-sdk/client/types/executor/executor.h>
 
+#include <util/datetime/base.h>
+
 namespace NYdb::inline V3::NTopic {
 
 IExecutor::TPtr CreateSyncExecutor();
 
+//! Process-wide compression executor with a work-stealing queue per core, shared by all the clients that use it.
+//! Write sessions running on it compress large messages in parallel chunks.
+IExecutor::TPtr GetSharedCompressionExecutor();
+
+struct TCompressionExecutorStats {
+    uint64_t QueueDepth = 0; //!< Tasks waiting for a worker
+    uint64_t TasksExecuted = 0;
+    uint64_t TasksStolen = 0; //!< Tasks executed by another worker than the one they were queued to
+    TDuration TotalWaitTime; //!< Sum of the times tasks spent in the queues
+    TDuration MaxWaitTime;
+};
+
+TCompressionExecutorStats GetSharedCompressionExecutorStats();
+
 } // namespace NYdb::NTopic
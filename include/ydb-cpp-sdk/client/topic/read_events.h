@@ -112,7 +112,7 @@ struct TReadSessionEvent {
 
         class TMessageBase: public TPrintable<TMessageBase> {
         public:
-            TMessageBase(const std::string& data, TMessageInformation info);
+            TMessageBase(std::string data, TMessageInformation info);
 
             virtual ~TMessageBase() = default;
 
@@ -154,7 +154,7 @@ struct TReadSessionEvent {
         struct TMessage: public TMessageBase, public TPartitionSessionAccessor, public TPrintable<TMessage> {
             using TPrintable<TMessage>::DebugString;
 
-            TMessage(const std::string& data, std::exception_ptr decompressionException, TMessageInformation information,
+            TMessage(std::string data, std::exception_ptr decompressionException, TMessageInformation information,
                      TPartitionSession::TPtr partitionSession);
 
             //! User data.
@@ -177,7 +177,7 @@ struct TReadSessionEvent {
                                    public TPrintable<TCompressedMessage> {
             using TPrintable<TCompressedMessage>::DebugString;
 
-            TCompressedMessage(ECodec codec, const std::string& data, TMessageInformation information,
+            TCompressedMessage(ECodec codec, std::string data, TMessageInformation information,
                                TPartitionSession::TPtr partitionSession);
 
             virtual ~TCompressedMessage() {
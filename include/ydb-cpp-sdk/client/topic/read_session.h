@@ -16,6 +16,25 @@
 
 namespace NYdb::inline V3::NTopic {
 
+//! Memory budget shared by read sessions, e.g. by all the read sessions of a process.
+//! All sessions of a pool together hold at most its budget of read data:
+//! each session is guaranteed an equal share of it and may also use the memory other sessions do not need.
+//! A session never exceeds its own MaxMemoryUsageBytes either.
+class IReadSessionMemoryPool {
+public:
+    using TPtr = std::shared_ptr<IReadSessionMemoryPool>;
+
+    virtual ~IReadSessionMemoryPool() = default;
+
+    //! Bytes of read data held by the sessions of the pool.
+    virtual size_t GetMemoryUsage() const = 0;
+
+    //! Number of read sessions using the pool.
+    virtual size_t GetSessionsCount() const = 0;
+};
+
+IReadSessionMemoryPool::TPtr CreateReadSessionMemoryPool(size_t maxMemoryUsageBytes);
+
 //! Read settings for single topic.
 struct TTopicReadSettings {
     using TSelf = TTopicReadSettings;
@@ -162,6 +181,10 @@ struct TReadSessionSettings: public TRequestSettings<TReadSessionSettings> {
     //! Maximum memory usage for read session.
     FLUENT_SETTING_DEFAULT(size_t, MaxMemoryUsageBytes, 100_MB);
 
+    //! Memory budget shared with other read sessions.
+    //! If not set, the session is limited by MaxMemoryUsageBytes only.
+    FLUENT_SETTING(IReadSessionMemoryPool::TPtr, MemoryPool);
+
     //! Max message time lag. All messages older that now - MaxLag will be ignored.
     FLUENT_SETTING_OPTIONAL(TDuration, MaxLag);
 
@@ -201,6 +224,13 @@ struct TReadSessionSettings: public TRequestSettings<TReadSessionSettings> {
 
     //! InFlightMemoryController.
     FLUENT_SETTING_OPTIONAL(std::uint64_t, PartitionMaxInFlightBytes);
+
+    //! Commits made within this window are sent to the server in one request.
+    //! Zero window sends every commit immediately.
+    FLUENT_SETTING_DEFAULT(TDuration, CommitBatchWindow, TDuration::Zero());
+
+    //! Pending commits are sent without waiting for the window end once they have so many offset ranges.
+    FLUENT_SETTING_DEFAULT(size_t, MaxCommitBatchRanges, 1000);
 };
 
 struct TReadSessionGetEventSettings : public TCommonClientSettingsBase<TReadSessionGetEventSettings> {
@@ -12,6 +12,9 @@
 
 #include <util/generic/size_literals.h>
 
+#include <functional>
+#include <optional>
+
 namespace NYdb::inline V3::NTopic {
 
 //! Result of close operation.
@@ -127,6 +130,13 @@ struct TWriteSessionSettings : public TRequestSettings<TWriteSessionSettings> {
     FLUENT_SETTING_OPTIONAL(TDuration, BatchFlushInterval);
     FLUENT_SETTING_OPTIONAL(uint64_t, BatchFlushSizeBytes);
 
+    //! Enables adaptive batching of write requests with the given target of p99 write latency.
+    //! Ready messages are sent at once if there are no unacknowledged requests, otherwise they are collected
+    //! into one request for a flush interval, which the writer adjusts to keep the latency below the target.
+    //! BatchFlushInterval and BatchFlushSizeBytes, if set, limit the interval and the size of the requests.
+    //! Decisions of the writer are reported by the batch* counters.
+    FLUENT_SETTING_OPTIONAL(TDuration, BatchFlushLatencyTarget);
+
     FLUENT_SETTING_DEFAULT(TDuration, ConnectTimeout, TDuration::Seconds(30));
 
     FLUENT_SETTING_OPTIONAL(TWriterCounters::TPtr, Counters);
@@ -199,6 +209,42 @@ private:
     //! This field is used to store serialized data.
     std::optional<std::string> DataHolder;
 
+    //! Data is public and may be reassigned by the user, so it views DataHolder only if it points into it.
+    std::optional<size_t> GetHeldDataOffset() const {
+        if (!DataHolder) {
+            return std::nullopt;
+        }
+        const std::less_equal<const char*> lessEqual;
+        const char* begin = DataHolder->data();
+        if (lessEqual(begin, Data.data()) && lessEqual(Data.data() + Data.size(), begin + DataHolder->size())) {
+            return Data.data() - begin;
+        }
+        return std::nullopt;
+    }
+
+    //! The holder is kept only while Data views it, the view is rebased onto the new copy of the holder.
+    void CopyData(const TWriteMessage& other) {
+        if (const auto offset = other.GetHeldDataOffset()) {
+            DataHolder = other.DataHolder;
+            Data = std::string_view(*DataHolder).substr(*offset, other.Data.size());
+        } else {
+            DataHolder.reset();
+            Data = other.Data;
+        }
+    }
+
+    void MoveData(TWriteMessage& other) noexcept {
+        if (const auto offset = other.GetHeldDataOffset()) {
+            DataHolder = std::move(other.DataHolder);
+            Data = std::string_view(*DataHolder).substr(*offset, other.Data.size());
+        } else {
+            DataHolder.reset();
+            Data = other.Data;
+        }
+        other.DataHolder.reset();
+        other.Data = {};
+    }
+
 public:
     TWriteMessage() = delete;
     TWriteMessage(std::string_view data)
@@ -215,10 +261,32 @@ public:
         , Partition(partition)
     {}
 
+    //! Messages made from an rvalue std::string own their body, it is moved through the write session without copying.
+    template <typename T>
+        requires std::same_as<T, std::string>
+    TWriteMessage(T&& data)
+        : DataHolder(std::move(data))
+        , Data(*DataHolder)
+    {}
+
+    template <typename T>
+        requires std::same_as<T, std::string>
+    TWriteMessage(const std::string& key, T&& data)
+        : DataHolder(std::move(data))
+        , Data(*DataHolder)
+        , Key(key)
+    {}
+
+    template <typename T>
+        requires std::same_as<T, std::string>
+    TWriteMessage(uint32_t partition, T&& data)
+        : DataHolder(std::move(data))
+        , Data(*DataHolder)
+        , Partition(partition)
+    {}
+
     TWriteMessage(const TWriteMessage& other)
-        : DataHolder(other.DataHolder)
-        , Data(other.DataHolder ? std::string_view(*DataHolder) : other.Data)
-        , Codec(other.Codec)
+        : Codec(other.Codec)
         , OriginalSize(other.OriginalSize)
         , SeqNo_(other.SeqNo_)
         , CreateTimestamp_(other.CreateTimestamp_)
@@ -226,12 +294,12 @@ public:
         , Tx_(other.Tx_)
         , Key(other.Key)
         , Partition(other.Partition)
-    {}
+    {
+        CopyData(other);
+    }
 
     TWriteMessage(TWriteMessage&& other) noexcept
-        : DataHolder(std::move(other.DataHolder))
-        , Data(DataHolder ? std::string_view(*DataHolder) : other.Data)
-        , Codec(std::move(other.Codec))
+        : Codec(std::move(other.Codec))
         , OriginalSize(other.OriginalSize)
         , SeqNo_(std::move(other.SeqNo_))
         , CreateTimestamp_(std::move(other.CreateTimestamp_))
@@ -239,15 +307,16 @@ public:
         , Tx_(std::move(other.Tx_))
         , Key(std::move(other.Key))
         , Partition(std::move(other.Partition))
-    {}
+    {
+        MoveData(other);
+    }
 
     TWriteMessage& operator=(const TWriteMessage& other) {
         if (this == &other) {
             return *this;
         }
 
-        DataHolder = other.DataHolder;
-        Data = DataHolder ? std::string_view(*DataHolder) : other.Data;
+        CopyData(other);
         Codec = other.Codec;
         OriginalSize = other.OriginalSize;
         SeqNo_ = other.SeqNo_;
@@ -265,8 +334,7 @@ public:
             return *this;
         }
 
-        DataHolder = std::move(other.DataHolder);
-        Data = DataHolder ? std::string_view(*DataHolder) : other.Data;
+        MoveData(other);
         Codec = std::move(other.Codec);
         OriginalSize = other.OriginalSize;
         SeqNo_ = std::move(other.SeqNo_);
@@ -297,6 +365,17 @@ public:
     bool Compressed() const {
         return Codec.has_value();
     }
+
+    //! Takes the message body out: moves it if Data still views the whole owned body, copies Data otherwise.
+    //! Data is empty after the call.
+    std::string ReleaseData() {
+        const auto offset = GetHeldDataOffset();
+        std::string result = offset == 0 && Data.size() == DataHolder->size() ? std::move(*DataHolder) : std::string(Data);
+        DataHolder.reset();
+        Data = {};
+        return result;
+    }
+
     //! Message body.
     std::string_view Data;
 
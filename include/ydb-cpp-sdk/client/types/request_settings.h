@@ -7,6 +7,7 @@
 #include <ydb-cpp-sdk/library/time/time.h>
 
 #include <util/datetime/base.h>
+#include <util/generic/size_literals.h>
 
 #include <vector>
 #include <utility>
@@ -27,6 +28,10 @@ struct TRequestSettings {
     FLUENT_SETTING(THeader, Header);
     FLUENT_SETTING(std::string, TraceParent);
 
+    //! By default TStatus::GetResponseMetadata returns all initial and trailing metadata sent by the server,
+    //! set to true to keep only YDB headers (x-ydb-*) and skip copying of the others
+    FLUENT_SETTING_DEFAULT(bool, YdbResponseMetadataOnly, false);
+
     TRequestSettings() = default;
 
     template <typename T>
@@ -37,9 +42,22 @@ struct TRequestSettings {
         , RequestType_(other.RequestType_)
         , Header_(other.Header_)
         , TraceParent_(other.TraceParent_)
+        , YdbResponseMetadataOnly_(other.YdbResponseMetadataOnly_)
     {}
 };
 
+//! Read-ahead of streaming results: the stream keeps being read into a bounded buffer
+//! while previously received parts are processed by the application
+struct TReadAheadSettings {
+    using TSelf = TReadAheadSettings;
+
+    //! Maximum number of buffered parts, 0 disables read-ahead
+    FLUENT_SETTING_DEFAULT(uint64_t, MaxParts, 4);
+
+    //! Reading from the stream is paused while buffered parts exceed this size, 0 disables read-ahead
+    FLUENT_SETTING_DEFAULT(uint64_t, MaxBytes, 64_MB);
+};
+
 template<typename TDerived>
 struct TSimpleRequestSettings : public TRequestSettings<TDerived> {
     using TSelf = TDerived;
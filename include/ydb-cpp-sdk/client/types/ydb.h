@@ -63,6 +63,11 @@ public:
     //! Use all available cluster nodes regardless datacenter locality
     static TBalancingPolicy UseAllNodes();
 
+    //! Use all available cluster nodes regardless datacenter locality,
+    //! every request goes to the less loaded of two random nodes judging by
+    //! the latency and the number of requests and open streams observed by this client
+    static TBalancingPolicy UseLeastLoadedNodes();
+
     //! EXPERIMENTAL
     //! Use pile with preferable state
     static TBalancingPolicy UsePreferablePileState(EPileState pileState = EPileState::PRIMARY);
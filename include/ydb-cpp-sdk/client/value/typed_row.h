@@ -0,0 +1,327 @@
+#pragma once
+
+#include "value.h"
+
+#include <src/api/protos/ydb_value.pb.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace NYdb::inline V3 {
+
+//! Compile-time description of a row struct, has to be specialized for every row type:
+//!
+//!     struct TUserRow {
+//!         uint64_t Id;
+//!         std::string Name;
+//!         std::optional<TInstant> LastSeen;
+//!     };
+//!
+//!     template <>
+//!     struct NYdb::TRowTraits<TUserRow> {
+//!         static constexpr auto Members = std::make_tuple(
+//!             NYdb::RowMember("id", &TUserRow::Id),
+//!             NYdb::RowMember<NYdb::EPrimitiveType::Utf8>("name", &TUserRow::Name),
+//!             NYdb::RowMember("last_seen", &TUserRow::LastSeen));
+//!     };
+//!
+//! Member types are primitive YDB types or optionals of them. The YDB type of a member is
+//! deduced from the C++ type (see NTypedRow::DefaultPrimitiveType) unless it is given explicitly.
+template <typename TRow>
+struct TRowTraits;
+
+template <EPrimitiveType Type, typename TRow, typename TField>
+struct TRowMember {
+    using TValueType = TField;
+    static constexpr EPrimitiveType PrimitiveType = Type;
+
+    std::string_view Name;
+    TField TRow::* Field;
+};
+
+namespace NTypedRow {
+
+template <typename T>
+struct TOptionalTraits {
+    using TItem = T;
+    static constexpr bool IsOptional = false;
+};
+
+template <typename T>
+struct TOptionalTraits<std::optional<T>> {
+    using TItem = T;
+    static constexpr bool IsOptional = true;
+};
+
+template <typename T>
+constexpr EPrimitiveType DefaultPrimitiveType() {
+    if constexpr (std::is_same_v<T, bool>) {
+        return EPrimitiveType::Bool;
+    } else if constexpr (std::is_same_v<T, int8_t>) {
+        return EPrimitiveType::Int8;
+    } else if constexpr (std::is_same_v<T, uint8_t>) {
+        return EPrimitiveType::Uint8;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        return EPrimitiveType::Int16;
+    } else if constexpr (std::is_same_v<T, uint16_t>) {
+        return EPrimitiveType::Uint16;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return EPrimitiveType::Int32;
+    } else if constexpr (std::is_same_v<T, uint32_t>) {
+        return EPrimitiveType::Uint32;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return EPrimitiveType::Int64;
+    } else if constexpr (std::is_same_v<T, uint64_t>) {
+        return EPrimitiveType::Uint64;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return EPrimitiveType::Float;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return EPrimitiveType::Double;
+    } else if constexpr (std::is_same_v<T, TInstant>) {
+        return EPrimitiveType::Timestamp;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return EPrimitiveType::String;
+    } else {
+        static_assert(!std::is_same_v<T, T>, "No default YDB type for the member, specify it explicitly");
+    }
+}
+
+// Whether values of the primitive type are stored in the C++ type T
+template <EPrimitiveType Type, typename T>
+constexpr bool IsCompatible() {
+    switch (Type) {
+        case EPrimitiveType::Bool:
+            return std::is_same_v<T, bool>;
+        case EPrimitiveType::Int8:
+            return std::is_same_v<T, int8_t>;
+        case EPrimitiveType::Uint8:
+            return std::is_same_v<T, uint8_t>;
+        case EPrimitiveType::Int16:
+            return std::is_same_v<T, int16_t>;
+        case EPrimitiveType::Uint16:
+            return std::is_same_v<T, uint16_t>;
+        case EPrimitiveType::Int32:
+            return std::is_same_v<T, int32_t>;
+        case EPrimitiveType::Uint32:
+            return std::is_same_v<T, uint32_t>;
+        case EPrimitiveType::Int64:
+        case EPrimitiveType::Interval:
+            return std::is_same_v<T, int64_t>;
+        case EPrimitiveType::Uint64:
+            return std::is_same_v<T, uint64_t>;
+        case EPrimitiveType::Float:
+            return std::is_same_v<T, float>;
+        case EPrimitiveType::Double:
+            return std::is_same_v<T, double>;
+        case EPrimitiveType::Date:
+        case EPrimitiveType::Datetime:
+        case EPrimitiveType::Timestamp:
+            return std::is_same_v<T, TInstant>;
+        case EPrimitiveType::String:
+        case EPrimitiveType::Utf8:
+        case EPrimitiveType::Yson:
+        case EPrimitiveType::Json:
+        case EPrimitiveType::JsonDocument:
+        case EPrimitiveType::DyNumber:
+            return std::is_same_v<T, std::string>;
+        default:
+            return false;
+    }
+}
+
+template <EPrimitiveType Type, typename T>
+void SetPrimitive(Ydb::Value& value, const T& field) {
+    if constexpr (Type == EPrimitiveType::Bool) {
+        value.set_bool_value(field);
+    } else if constexpr (Type == EPrimitiveType::Int8 || Type == EPrimitiveType::Int16 || Type == EPrimitiveType::Int32) {
+        value.set_int32_value(field);
+    } else if constexpr (Type == EPrimitiveType::Uint8 || Type == EPrimitiveType::Uint16 || Type == EPrimitiveType::Uint32) {
+        value.set_uint32_value(field);
+    } else if constexpr (Type == EPrimitiveType::Int64 || Type == EPrimitiveType::Interval) {
+        value.set_int64_value(field);
+    } else if constexpr (Type == EPrimitiveType::Uint64) {
+        value.set_uint64_value(field);
+    } else if constexpr (Type == EPrimitiveType::Float) {
+        value.set_float_value(field);
+    } else if constexpr (Type == EPrimitiveType::Double) {
+        value.set_double_value(field);
+    } else if constexpr (Type == EPrimitiveType::Date) {
+        value.set_uint32_value(field.Days());
+    } else if constexpr (Type == EPrimitiveType::Datetime) {
+        value.set_uint32_value(field.Seconds());
+    } else if constexpr (Type == EPrimitiveType::Timestamp) {
+        value.set_uint64_value(field.MicroSeconds());
+    } else if constexpr (Type == EPrimitiveType::String || Type == EPrimitiveType::Yson) {
+        value.set_bytes_value(field);
+    } else {
+        value.set_text_value(field);
+    }
+}
+
+template <EPrimitiveType Type, typename T>
+void GetPrimitive(const Ydb::Value& value, T& field) {
+    if constexpr (Type == EPrimitiveType::Bool) {
+        field = value.bool_value();
+    } else if constexpr (Type == EPrimitiveType::Int8 || Type == EPrimitiveType::Int16 || Type == EPrimitiveType::Int32) {
+        field = static_cast<T>(value.int32_value());
+    } else if constexpr (Type == EPrimitiveType::Uint8 || Type == EPrimitiveType::Uint16 || Type == EPrimitiveType::Uint32) {
+        field = static_cast<T>(value.uint32_value());
+    } else if constexpr (Type == EPrimitiveType::Int64 || Type == EPrimitiveType::Interval) {
+        field = value.int64_value();
+    } else if constexpr (Type == EPrimitiveType::Uint64) {
+        field = value.uint64_value();
+    } else if constexpr (Type == EPrimitiveType::Float) {
+        field = value.float_value();
+    } else if constexpr (Type == EPrimitiveType::Double) {
+        field = value.double_value();
+    } else if constexpr (Type == EPrimitiveType::Date) {
+        field = TInstant::Days(value.uint32_value());
+    } else if constexpr (Type == EPrimitiveType::Datetime) {
+        field = TInstant::Seconds(value.uint32_value());
+    } else if constexpr (Type == EPrimitiveType::Timestamp) {
+        field = TInstant::MicroSeconds(value.uint64_value());
+    } else if constexpr (Type == EPrimitiveType::String || Type == EPrimitiveType::Yson) {
+        field = value.bytes_value();
+    } else {
+        field = value.text_value();
+    }
+}
+
+template <typename TMember, typename TRow>
+void SetMember(const TMember& member, const TRow& row, Ydb::Value& value) {
+    using TTraits = TOptionalTraits<typename TMember::TValueType>;
+    const auto& field = row.*member.Field;
+    if constexpr (TTraits::IsOptional) {
+        if (field) {
+            SetPrimitive<TMember::PrimitiveType>(value, *field);
+        } else {
+            value.set_null_flag_value(::google::protobuf::NULL_VALUE);
+        }
+    } else {
+        SetPrimitive<TMember::PrimitiveType>(value, field);
+    }
+}
+
+template <typename TMember, typename TRow>
+void GetMember(const TMember& member, const Ydb::Value& value, TRow& row) {
+    using TTraits = TOptionalTraits<typename TMember::TValueType>;
+    auto& field = row.*member.Field;
+    if constexpr (TTraits::IsOptional) {
+        if (value.value_case() == Ydb::Value::kNullFlagValue) {
+            field.reset();
+        } else {
+            GetPrimitive<TMember::PrimitiveType>(value, field.emplace());
+        }
+    } else {
+        GetPrimitive<TMember::PrimitiveType>(value, field);
+    }
+}
+
+template <typename TRow>
+constexpr size_t MembersCount() {
+    return std::tuple_size_v<std::decay_t<decltype(TRowTraits<TRow>::Members)>>;
+}
+
+template <typename TRow>
+TType BuildRowType() {
+    TTypeBuilder builder;
+    builder.BeginStruct();
+    std::apply([&builder](const auto&... members) {
+        auto addMember = [&builder](const auto& member) {
+            using TMember = std::decay_t<decltype(member)>;
+            builder.AddMember(std::string(member.Name));
+            if constexpr (TOptionalTraits<typename TMember::TValueType>::IsOptional) {
+                builder.BeginOptional().Primitive(TMember::PrimitiveType).EndOptional();
+            } else {
+                builder.Primitive(TMember::PrimitiveType);
+            }
+        };
+        (addMember(members), ...);
+    }, TRowTraits<TRow>::Members);
+    builder.EndStruct();
+    return builder.Build();
+}
+
+} // namespace NTypedRow
+
+//! Member of a row struct with the YDB type deduced from the C++ type
+template <typename TRow, typename TField>
+constexpr auto RowMember(std::string_view name, TField TRow::* field) {
+    using TItem = typename NTypedRow::TOptionalTraits<TField>::TItem;
+    return TRowMember<NTypedRow::DefaultPrimitiveType<TItem>(), TRow, TField>{name, field};
+}
+
+//! Member of a row struct with the explicit YDB type, e.g. Utf8 for std::string or Date for TInstant
+template <EPrimitiveType Type, typename TRow, typename TField>
+constexpr auto RowMember(std::string_view name, TField TRow::* field) {
+    static_assert(NTypedRow::IsCompatible<Type, typename NTypedRow::TOptionalTraits<TField>::TItem>(),
+        "The C++ type of the member can't hold values of the YDB type");
+    return TRowMember<Type, TRow, TField>{name, field};
+}
+
+//! Struct type of the row, built once per row type
+template <typename TRow>
+const TType& GetRowType() {
+    static const TType type = NTypedRow::BuildRowType<TRow>();
+    return type;
+}
+
+//! Builds List<Struct<...>> values, e.g. for BulkUpsert or query parameters.
+//! Member values are written by index straight into the proto, without per-member name lookups and type checks.
+template <typename TRow>
+class TTypedRowsBuilder : public TMoveOnly {
+public:
+    TTypedRowsBuilder() = default;
+
+    //! The value is allocated on the arena, which has to outlive the built TValue
+    explicit TTypedRowsBuilder(google::protobuf::Arena* arena)
+        : Arena_(arena)
+        , ArenaValue_(google::protobuf::Arena::CreateMessage<Ydb::Value>(arena))
+    {}
+
+    TTypedRowsBuilder& Reserve(size_t rowsCount) {
+        GetValue().mutable_items()->Reserve(rowsCount);
+        return *this;
+    }
+
+    TTypedRowsBuilder& AddRow(const TRow& row) {
+        auto* item = GetValue().add_items();
+        item->mutable_items()->Reserve(NTypedRow::MembersCount<TRow>());
+        std::apply([&row, item](const auto&... members) {
+            (NTypedRow::SetMember(members, row, *item->add_items()), ...);
+        }, TRowTraits<TRow>::Members);
+        return *this;
+    }
+
+    size_t RowsCount() const {
+        return Arena_ ? ArenaValue_->items_size() : OwnedValue_.items_size();
+    }
+
+    //! Returns the rows and resets the builder
+    TValue Build() {
+        static const TType listType = TTypeBuilder().List(GetRowType<TRow>()).Build();
+        if (Arena_) {
+            TValue result(listType, ArenaValue_);
+            ArenaValue_ = google::protobuf::Arena::CreateMessage<Ydb::Value>(Arena_);
+            return result;
+        }
+        TValue result(listType, std::move(OwnedValue_));
+        OwnedValue_.Clear();
+        return result;
+    }
+
+private:
+    Ydb::Value& GetValue() {
+        return Arena_ ? *ArenaValue_ : OwnedValue_;
+    }
+
+private:
+    google::protobuf::Arena* Arena_ = nullptr;
+    Ydb::Value* ArenaValue_ = nullptr;
+    Ydb::Value OwnedValue_;
+};
+
+} // namespace NYdb
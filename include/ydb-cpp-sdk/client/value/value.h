@@ -29,6 +29,8 @@ class TTableClient;
 class TType {
     friend class TProtoAccessor;
     friend class NTable::TTableClient;
+    friend class TTypeInterner;
+    friend bool TypesEqual(const TType& t1, const TType& t2);
 public:
     TType(const Ydb::Type& typeProto);
     TType(Ydb::Type&& typeProto);
@@ -37,10 +39,13 @@ public:
     void Out(IOutputStream& o) const;
 
     const Ydb::Type& GetProto() const;
+    //! Interned types are shared between unrelated values, mutable access makes a private copy first
     Ydb::Type& GetProto();
 
 private:
     class TImpl;
+    explicit TType(std::shared_ptr<TImpl> impl);
+
     std::shared_ptr<TImpl> Impl_;
 };
 
@@ -5,11 +5,79 @@
 
 #include <util/random/random.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <set>
 #include <unordered_set>
 
 namespace NYdb::inline V3 {
 
+// Time for the observed latency to forget a slowdown, both while the endpoint serves requests and while it is idle
+static constexpr double LatencyDecayUs = 10'000'000;
+// Cost of an endpoint with requests in flight but no observed latency yet, keeps new endpoints to a single probe
+static constexpr double UnknownLatencyCost = 1e12;
+// Latency sample of a failed request: the observed latency scaled up, but not less than a second
+static constexpr double FailureLatencyFactor = 4;
+static constexpr double FailureLatencyUs = 1'000'000;
+
+void TEndpointLoad::OnRequestStarted() {
+    InFlight_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TEndpointLoad::OnRequestFinished(TDuration latency, TInstant now) {
+    InFlight_.fetch_sub(1, std::memory_order_relaxed);
+    AddSample(latency, now, false);
+}
+
+void TEndpointLoad::OnRequestFailed(TDuration latency, TInstant now) {
+    InFlight_.fetch_sub(1, std::memory_order_relaxed);
+    AddSample(latency, now, true);
+}
+
+void TEndpointLoad::OnStreamFinished(bool failed, TInstant now) {
+    InFlight_.fetch_sub(1, std::memory_order_relaxed);
+    if (failed) {
+        AddSample(TDuration::Zero(), now, true);
+    }
+}
+
+void TEndpointLoad::AddSample(TDuration latency, TInstant now, bool failed) {
+    const double latencyUs = std::max<double>(latency.MicroSeconds(), 1);
+    const ui64 nowUs = now.MicroSeconds();
+    const ui64 lastUpdateUs = LastUpdateUs_.exchange(nowUs, std::memory_order_relaxed);
+    const double weight = std::exp(-static_cast<double>(nowUs > lastUpdateUs ? nowUs - lastUpdateUs : 0) / LatencyDecayUs);
+
+    double current = LatencyUs_.load(std::memory_order_relaxed);
+    double next;
+    do {
+        // A quick rejection must not make the endpoint look cheap
+        const double sampleUs = failed
+            ? std::max({latencyUs, current * FailureLatencyFactor, FailureLatencyUs})
+            : latencyUs;
+        // Peak EWMA: slowdowns are taken at once, recovery is smoothed
+        next = sampleUs > current ? sampleUs : current * weight + sampleUs * (1 - weight);
+    } while (!LatencyUs_.compare_exchange_weak(current, next, std::memory_order_relaxed));
+}
+
+double TEndpointLoad::GetCost(TInstant now) const {
+    const double latencyUs = LatencyUs_.load(std::memory_order_relaxed);
+    const auto inFlight = std::max<std::int64_t>(InFlight_.load(std::memory_order_relaxed), 0);
+    if (latencyUs == 0) {
+        return inFlight ? UnknownLatencyCost : 0;
+    }
+
+    if (inFlight) {
+        return latencyUs * (inFlight + 1);
+    }
+
+    // Latency of an idle endpoint decays, so it is probed again after a slowdown
+    const ui64 nowUs = now.MicroSeconds();
+    const ui64 lastUpdateUs = LastUpdateUs_.load(std::memory_order_relaxed);
+    const double idleUs = nowUs > lastUpdateUs ? nowUs - lastUpdateUs : 0;
+    return latencyUs * std::exp(-idleUs / LatencyDecayUs);
+}
+
 class TEndpointElectorSafe::TObjRegistry : public IObjRegistryHandle {
 public:
     TObjRegistry(const std::uint64_t& nodeId)
@@ -52,6 +120,17 @@ private:
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// Number of electors (one per driver and database) a thread keeps cached snapshots for
+static constexpr size_t SnapshotCacheSize = 4;
+
+static std::atomic<ui64> ElectorIdCounter = 0;
+
+TEndpointElectorSafe::TEndpointElectorSafe(EEndpointSelection selection)
+    : Id_(++ElectorIdCounter)
+    , Snapshot_(std::make_shared<TSnapshot>())
+    , Selection_(selection)
+{}
+
 // Returns index of last resord with same priority or -1 in case of empty input
 static std::int32_t GetBestK(const std::vector<TEndpointRecord>& records) {
     if (records.empty()) {
@@ -109,6 +188,18 @@ std::vector<std::string> TEndpointElectorSafe::SetNewState(std::vector<TEndpoint
         }
         // Find endpoints which were added
         Records_ = std::move(uniqRec);
+        for (auto& record : Records_) {
+            auto it = KnownEndpoints_.find(record.Endpoint);
+            if (it != KnownEndpoints_.end()) {
+                record.Counters = it->second.Counters;
+                record.Load = it->second.Load;
+            } else {
+                record.Counters = StatCollector_.GetEndpointCounters(record.Endpoint);
+            }
+            if (Selection_ == EEndpointSelection::PowerOfTwoChoices && !record.Load) {
+                record.Load = std::make_shared<TEndpointLoad>();
+            }
+        }
         for (const auto& record : Records_) {
             KnownEndpoints_[record.Endpoint] = record;
             KnownEndpointsByNodeId_[record.NodeId].Record = record;
@@ -119,6 +210,7 @@ std::vector<std::string> TEndpointElectorSafe::SetNewState(std::vector<TEndpoint
         BestK_ = bestK;
         PessimizationRatio_.store(0);
         PessimizationRatioGauge_.SetValue(0);
+        PublishSnapshot();
     }
 
     for (auto& obj : notifyRemoved) {
@@ -129,40 +221,127 @@ std::vector<std::string> TEndpointElectorSafe::SetNewState(std::vector<TEndpoint
 }
 
 TEndpointRecord TEndpointElectorSafe::GetEndpoint(const TEndpointKey& preferredEndpoint, bool onlyPreferred) const {
-    std::shared_lock guard(Mutex_);
+    if (auto endpoint = GetEndpointHandle(preferredEndpoint, onlyPreferred)) {
+        return *endpoint;
+    }
+    return {};
+}
+
+TEndpointHandle TEndpointElectorSafe::GetEndpointHandle(const TEndpointKey& preferredEndpoint, bool onlyPreferred) const {
+    const TSnapshot& snapshot = GetSnapshot();
 
     if (preferredEndpoint.GetNodeId()) {
-        auto it = KnownEndpointsByNodeId_.find(preferredEndpoint.GetNodeId());
-        if (it != KnownEndpointsByNodeId_.end()) {
-            return it->second.Record;
+        auto it = snapshot.KnownEndpointsByNodeId.find(preferredEndpoint.GetNodeId());
+        if (it != snapshot.KnownEndpointsByNodeId.end()) {
+            return it->second;
         }
     }
 
     if (!preferredEndpoint.GetEndpoint().empty()) {
-        auto it = KnownEndpoints_.find(preferredEndpoint.GetEndpoint());
-        if (it != KnownEndpoints_.end()) {
+        auto it = snapshot.KnownEndpoints.find(preferredEndpoint.GetEndpoint());
+        if (it != snapshot.KnownEndpoints.end()) {
             return it->second;
         }
     }
 
     if(onlyPreferred)
-        return {};
-
-    if (BestK_ == -1) {
-        Y_ASSERT(Records_.empty());
-        return {};
+        return nullptr;
+
+    const auto& records = snapshot.Records;
+    if (snapshot.BestK == -1) {
+        Y_ASSERT(records.empty());
+        return nullptr;
+    } else if (Selection_ == EEndpointSelection::PowerOfTwoChoices && snapshot.BestK > 0) {
+        const size_t first = RandomNumber<size_t>(snapshot.BestK + 1);
+        size_t second = RandomNumber<size_t>(snapshot.BestK);
+        if (second >= first) {
+            ++second;
+        }
+        const auto now = TInstant::Now();
+        const bool firstIsLess = records[first]->Load->GetCost(now) <= records[second]->Load->GetCost(now);
+        return records[firstIsLess ? first : second];
     } else {
         // returns value in range [0, n)
-        auto idx = RandomNumber<size_t>(BestK_ + 1);
-        return Records_[idx];
+        auto idx = RandomNumber<size_t>(snapshot.BestK + 1);
+        return records[idx];
     }
 }
 
+void TEndpointElectorSafe::PublishSnapshot() {
+    auto snapshot = std::make_shared<TSnapshot>();
+    snapshot->Records.reserve(Records_.size());
+    for (const auto& record : Records_) {
+        auto handle = std::make_shared<const TEndpointRecord>(record);
+        snapshot->KnownEndpoints.emplace(record.Endpoint, handle);
+        snapshot->Records.emplace_back(std::move(handle));
+    }
+    for (const auto& [nodeId, knownEndpoint] : KnownEndpointsByNodeId_) {
+        const auto& record = knownEndpoint.Record;
+        // Record of the node is not pessimized together with the endpoint, so it is shared only while they are equal
+        auto it = snapshot->KnownEndpoints.find(record.Endpoint);
+        if (it != snapshot->KnownEndpoints.end() && it->second->Priority == record.Priority) {
+            snapshot->KnownEndpointsByNodeId.emplace(nodeId, it->second);
+        } else {
+            snapshot->KnownEndpointsByNodeId.emplace(nodeId, std::make_shared<const TEndpointRecord>(record));
+        }
+    }
+    snapshot->BestK = BestK_;
+
+    Snapshot_ = std::move(snapshot);
+    SnapshotGeneration_.fetch_add(1, std::memory_order_release);
+}
+
+const TEndpointElectorSafe::TSnapshot& TEndpointElectorSafe::GetSnapshot() const {
+    struct TCachedSnapshot {
+        ui64 ElectorId = 0;
+        ui64 Generation = 0;
+        std::shared_ptr<const TSnapshot> Snapshot;
+    };
+    // The common path reads only the generation, which is written once per discovery round,
+    // so lookups from many threads do not contend on the mutex or on a reference counter
+    static thread_local std::array<TCachedSnapshot, SnapshotCacheSize> cache;
+    static thread_local size_t nextEvicted = 0;
+
+    const ui64 generation = SnapshotGeneration_.load(std::memory_order_acquire);
+
+    TCachedSnapshot* cached = nullptr;
+    for (auto& entry : cache) {
+        if (entry.ElectorId == Id_) {
+            if (entry.Generation == generation) {
+                return *entry.Snapshot;
+            }
+            cached = &entry;
+            break;
+        }
+    }
+
+    if (!cached) {
+        cached = &cache[nextEvicted++ % cache.size()];
+        cached->ElectorId = Id_;
+    }
+
+    std::shared_lock guard(Mutex_);
+    cached->Snapshot = Snapshot_;
+    cached->Generation = SnapshotGeneration_.load(std::memory_order_relaxed);
+    return *cached->Snapshot;
+}
+
 // TODO: Suboptimal, but should not be used often
 void TEndpointElectorSafe::PessimizeEndpoint(const std::string& endpoint) {
+    // Transport errors ban the endpoint on every failed call, repeated bans must not take the unique lock
+    {
+        const TSnapshot& snapshot = GetSnapshot();
+        auto it = snapshot.KnownEndpoints.find(endpoint);
+        if (it == snapshot.KnownEndpoints.end() || it->second->Priority == std::numeric_limits<std::int32_t>::max()) {
+            return;
+        }
+    }
+
     std::unique_lock guard(Mutex_);
+    bool changed = false;
     for (auto& r : Records_) {
         if (r.Endpoint == endpoint && r.Priority != std::numeric_limits<std::int32_t>::max()) {
+            changed = true;
             int pessimizationRatio = PessimizationRatio_.load();
             auto newRatio = (pessimizationRatio * Records_.size() + 100) / Records_.size();
             PessimizationRatio_.store(newRatio);
@@ -176,8 +355,12 @@ void TEndpointElectorSafe::PessimizeEndpoint(const std::string& endpoint) {
             }
         }
     }
+    if (!changed) {
+        return;
+    }
     Sort(Records_.begin(), Records_.end());
     BestK_ = GetBestK(Records_);
+    PublishSnapshot();
 }
 
 // % of endpoints which was pessimized
@@ -189,6 +372,19 @@ void TEndpointElectorSafe::SetStatCollector(const NSdkStats::TStatCollector::TEn
     EndpointCountGauge_.Set(endpointStatCollector.EndpointCount);
     PessimizationRatioGauge_.Set(endpointStatCollector.PessimizationRatio);
     EndpointActiveGauge_.Set(endpointStatCollector.EndpointActive);
+
+    std::unique_lock guard(Mutex_);
+    StatCollector_ = endpointStatCollector;
+    // Registry could be changed, so counters of known endpoints are resolved again
+    for (auto& record : Records_) {
+        record.Counters = StatCollector_.GetEndpointCounters(record.Endpoint);
+        KnownEndpoints_[record.Endpoint].Counters = record.Counters;
+        auto nodeIdIt = KnownEndpointsByNodeId_.find(record.NodeId);
+        if (nodeIdIt != KnownEndpointsByNodeId_.end() && nodeIdIt->second.Record.Endpoint == record.Endpoint) {
+            nodeIdIt->second.Record.Counters = record.Counters;
+        }
+    }
+    PublishSnapshot();
 }
 
 bool TEndpointElectorSafe::LinkObjToEndpoint(const TEndpointKey& endpoint, TEndpointObj* obj, const void* tag) {
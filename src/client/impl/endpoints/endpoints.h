@@ -1,20 +1,53 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 #include <string>
 #include <src/client/impl/stats/stats.h>
 
+#include <util/datetime/base.h>
+
 namespace NYdb::inline V3 {
 
+// Load of an endpoint as observed by this client, updated lock-free around every unary request
+class TEndpointLoad {
+public:
+    void OnRequestStarted();
+    void OnRequestFinished(TDuration latency, TInstant now);
+    // Transport errors and overload replies, counted as a slow response whatever their latency
+    void OnRequestFailed(TDuration latency, TInstant now);
+    // Streams are in flight while they are open. Their lifetime is not a response time,
+    // so a stream adds a latency sample only if it is broken, as a failed request
+    void OnStreamFinished(bool failed, TInstant now);
+
+    // Expected cost of one more request: observed latency times the requests already in flight
+    double GetCost(TInstant now) const;
+
+private:
+    void AddSample(TDuration latency, TInstant now, bool failed);
+
+private:
+    std::atomic<std::int64_t> InFlight_ = 0;
+    // Peak EWMA of the request latency in microseconds, 0 until the first response
+    std::atomic<double> LatencyUs_ = 0;
+    std::atomic<std::uint64_t> LastUpdateUs_ = 0;
+};
+
+using TEndpointLoadPtr = std::shared_ptr<TEndpointLoad>;
+
 struct TEndpointRecord {
     std::string Endpoint;
     std::int32_t Priority;
     std::string SslTargetNameOverride;
     std::uint64_t NodeId = 0;
     std::string Location;
+    // Resolved by the elector when the endpoint appears
+    NSdkStats::TEndpointCounters Counters;
+    // Set by the elector when endpoints are chosen by load
+    TEndpointLoadPtr Load;
 
     TEndpointRecord()
         : Endpoint()
@@ -43,6 +76,9 @@ struct TEndpointRecord {
     }
 };
 
+// Record of the endpoint set published by the elector, never changed after publication
+using TEndpointHandle = std::shared_ptr<const TEndpointRecord>;
+
 struct TEndpointKey {
     std::string Endpoint;
     std::uint64_t NodeId = 0;
@@ -83,10 +119,17 @@ public:
     virtual size_t Size() const = 0;
 };
 
+enum class EEndpointSelection {
+    // Uniformly among the endpoints with the best priority
+    Random,
+    // The less loaded of two random endpoints with the best priority
+    PowerOfTwoChoices
+};
+
 class TEndpointObj;
 class TEndpointElectorSafe {
 public:
-    TEndpointElectorSafe() = default;
+    explicit TEndpointElectorSafe(EEndpointSelection selection = EEndpointSelection::Random);
 
     // Sets new endpoints, returns removed
     std::vector<std::string> SetNewState(std::vector<TEndpointRecord>&& records);
@@ -97,6 +140,9 @@ public:
     // Returns preferred (if presents) or best endpoint
     TEndpointRecord GetEndpoint(const TEndpointKey& preferredEndpoint, bool onlyPreferred = false) const;
 
+    // Same as GetEndpoint, but without the mutex and the record copy, returns nullptr if there is no endpoint
+    TEndpointHandle GetEndpointHandle(const TEndpointKey& preferredEndpoint, bool onlyPreferred = false) const;
+
     // Move endpoint to the end
     void PessimizeEndpoint(const std::string& endpoint);
 
@@ -120,13 +166,33 @@ private:
         TTaggedObjRegistry TaggedObjs;
     };
 
+    // Immutable copy of the state used by lookups, replaced as a whole on every change
+    struct TSnapshot {
+        std::vector<TEndpointHandle> Records;
+        std::unordered_map<std::string, TEndpointHandle> KnownEndpoints;
+        std::unordered_map<ui64, TEndpointHandle> KnownEndpointsByNodeId;
+        std::int32_t BestK = -1;
+    };
+
+    // Must be called under the unique lock after every change of the records
+    void PublishSnapshot();
+    // Snapshot cached by the calling thread, valid until its next call
+    const TSnapshot& GetSnapshot() const;
+
 private:
+    // Unique for the process lifetime, identifies the elector in the thread caches
+    const ui64 Id_;
     mutable std::shared_mutex Mutex_;
     std::vector<TEndpointRecord> Records_;
     std::unordered_map<std::string, TEndpointRecord> KnownEndpoints_;
     std::unordered_map<ui64, TKnownEndpoint> KnownEndpointsByNodeId_;
     std::int32_t BestK_ = -1;
+    std::shared_ptr<const TSnapshot> Snapshot_;
+    // Incremented on every publication, lets the threads check their cached snapshot without the mutex
+    std::atomic<ui64> SnapshotGeneration_ = 0;
+    const EEndpointSelection Selection_;
     std::atomic_int PessimizationRatio_ = 0;
+    NSdkStats::TStatCollector::TEndpointElectorStatCollector StatCollector_;
     NSdkStats::TAtomicCounter<::NMonitoring::TIntGauge> EndpointCountGauge_;
     NSdkStats::TAtomicCounter<::NMonitoring::TIntGauge> PessimizationRatioGauge_;
     NSdkStats::TAtomicCounter<::NMonitoring::TIntGauge> EndpointActiveGauge_;
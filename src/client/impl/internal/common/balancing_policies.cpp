@@ -7,6 +7,10 @@ TBalancingPolicy::TImpl TBalancingPolicy::TImpl::UseAllNodes() {
     return {EPolicyType::UseAllNodes, std::nullopt, EPileState::UNSPECIFIED};
 }
 
+TBalancingPolicy::TImpl TBalancingPolicy::TImpl::UseLeastLoadedNodes() {
+    return {EPolicyType::UseLeastLoadedNodes, std::nullopt, EPileState::UNSPECIFIED};
+}
+
 TBalancingPolicy::TImpl TBalancingPolicy::TImpl::UsePreferableLocation(const std::optional<std::string>& location) {
     return {EPolicyType::UsePreferableLocation, location, EPileState::UNSPECIFIED};
 }
@@ -14,11 +14,14 @@ public:
     enum class EPolicyType {
         UseAllNodes,
         UsePreferableLocation,
-        UsePreferablePileState
+        UsePreferablePileState,
+        UseLeastLoadedNodes
     };
 
     static TImpl UseAllNodes();
 
+    static TImpl UseLeastLoadedNodes();
+
     static TImpl UsePreferableLocation(const std::optional<std::string>& location);
 
     static TImpl UsePreferablePileState(EPileState pileState);
@@ -5,6 +5,7 @@ namespace NYdb::inline V3 {
 
 TEndpointPool::TEndpointPool(TListEndpointsResultProvider&& provider, const IInternalClient* client)
     : Provider_(provider)
+    , Elector_(GetEndpointSelection(client->GetBalancingSettings().PolicyType))
     , LastUpdateTime_(TInstant::Zero().MicroSeconds())
     , BalancingPolicy_(client->GetBalancingSettings())
 {}
@@ -52,7 +53,10 @@ std::pair<NThreading::TFuture<TEndpointUpdateResult>, bool> TEndpointPool::Updat
             }
 
             for (const auto& endpoint : result.Result.endpoints()) {
-                std::int32_t loadFactor = static_cast<std::int32_t>(multiplicator * std::min(LoadMax, std::max(LoadMin, endpoint.load_factor())));
+                // Endpoints chosen by load observed on the client ignore the reported load factor
+                std::int32_t loadFactor = BalancingPolicy_.PolicyType == TBalancingPolicy::TImpl::EPolicyType::UseLeastLoadedNodes
+                    ? 0
+                    : static_cast<std::int32_t>(multiplicator * std::min(LoadMax, std::max(LoadMin, endpoint.load_factor())));
                 std::uint64_t nodeId = endpoint.node_id();
                 std::string location = endpoint.location();
                 if (!IsPreferredEndpoint(endpoint, selfLocation, pileStates)) {
@@ -131,6 +135,10 @@ TEndpointRecord TEndpointPool::GetEndpoint(const TEndpointKey& preferredEndpoint
     return Elector_.GetEndpoint(preferredEndpoint, onlyPreferred);
 }
 
+TEndpointHandle TEndpointPool::GetEndpointHandle(const TEndpointKey& preferredEndpoint, bool onlyPreferred) const {
+    return Elector_.GetEndpointHandle(preferredEndpoint, onlyPreferred);
+}
+
 TDuration TEndpointPool::TimeSinceLastUpdate() const {
     auto now = TInstant::Now().MicroSeconds();
     return TDuration::MicroSeconds(now - LastUpdateTime_.load());
@@ -171,6 +179,12 @@ void TEndpointPool::SetStatCollector(NSdkStats::TStatCollector& statCollector) {
     StatCollector_ = &statCollector;
 }
 
+EEndpointSelection TEndpointPool::GetEndpointSelection(TBalancingPolicy::TImpl::EPolicyType policyType) {
+    return policyType == TBalancingPolicy::TImpl::EPolicyType::UseLeastLoadedNodes
+        ? EEndpointSelection::PowerOfTwoChoices
+        : EEndpointSelection::Random;
+}
+
 constexpr std::int32_t TEndpointPool::GetLocalityShift() {
     return LoadMax * Multiplicator;
 }
@@ -180,6 +194,7 @@ bool TEndpointPool::IsPreferredEndpoint(const Ydb::Discovery::EndpointInfo& endp
                                         const std::unordered_map<std::string, Ydb::Bridge::PileState>& pileStates) const {
     switch (BalancingPolicy_.PolicyType) {
         case TBalancingPolicy::TImpl::EPolicyType::UseAllNodes:
+        case TBalancingPolicy::TImpl::EPolicyType::UseLeastLoadedNodes:
             return true;
         case TBalancingPolicy::TImpl::EPolicyType::UsePreferableLocation:
             return endpoint.location() == BalancingPolicy_.Location.value_or(selfLocation);
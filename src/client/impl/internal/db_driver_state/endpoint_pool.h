@@ -33,6 +33,7 @@ public:
     ~TEndpointPool();
     std::pair<NThreading::TFuture<TEndpointUpdateResult>, bool> UpdateAsync();
     TEndpointRecord GetEndpoint(const TEndpointKey& preferredEndpoint, bool onlyPreferred = false) const;
+    TEndpointHandle GetEndpointHandle(const TEndpointKey& preferredEndpoint, bool onlyPreferred = false) const;
     TDuration TimeSinceLastUpdate() const;
     void BanEndpoint(const std::string& endpoint);
     int GetPessimizationRatio();
@@ -50,6 +51,7 @@ private:
                              const std::string& selfLocation,
                              const std::unordered_map<std::string, Ydb::Bridge::PileState>& pileStates) const;
     EPileState GetPileState(const Ydb::Bridge::PileState::State& state) const;
+    static EEndpointSelection GetEndpointSelection(TBalancingPolicy::TImpl::EPolicyType policyType);
 
 private:
     TListEndpointsResultProvider Provider_;
@@ -51,6 +51,7 @@ TDbDriverState::TDbDriverState(
         client->GetExternalMetricRegistry(),
         discoveryEndpoint
     )
+    , CommonCallHeaders(client->MakeCommonCallHeaders(database))
     , Log(Client->GetLog())
     , DiscoveryCompletedPromise(NThreading::NewPromise<void>())
 {
@@ -71,6 +71,7 @@ public:
     std::shared_mutex LastDiscoveryStatusRWLock;
     TPlainStatus LastDiscoveryStatus;
     NSdkStats::TStatCollector StatCollector;
+    const std::shared_ptr<const std::vector<std::pair<std::string, std::string>>> CommonCallHeaders;
     TLog Log;
     NThreading::TPromise<void> DiscoveryCompletedPromise;
 
@@ -524,18 +524,47 @@ TCallMeta TGRpcConnectionsImpl::MakeCallMeta(const TRpcRequestSettings& requestS
         }
     }
 
-    if (!dbState->Database.empty()) {
-        // See TDbDriverStateTracker::GetDriverState to find place where we do quote non ASCII characters
-        meta.Aux.push_back({YDB_DATABASE_HEADER, dbState->Database});
-    }
+    meta.Common = dbState->CommonCallHeaders;
+    meta.Aux.insert(meta.Aux.end(), requestSettings.Header.begin(), requestSettings.Header.end());
+
+    return meta;
+}
 
+std::shared_ptr<const std::vector<std::pair<std::string, std::string>>> TGRpcConnectionsImpl::MakeCommonCallHeaders(
+    const std::string& database) const
+{
     static const std::string clientPid = GetClientPIDHeaderValue();
 
-    meta.Aux.push_back({YDB_SDK_BUILD_INFO_HEADER, BuildInfo_});
-    meta.Aux.push_back({YDB_CLIENT_PID, clientPid});
-    meta.Aux.insert(meta.Aux.end(), requestSettings.Header.begin(), requestSettings.Header.end());
+    auto headers = std::make_shared<std::vector<std::pair<std::string, std::string>>>();
+    if (!database.empty()) {
+        // See TDbDriverStateTracker::GetDriverState to find place where we do quote non ASCII characters
+        headers->emplace_back(YDB_DATABASE_HEADER, database);
+    }
+    headers->emplace_back(YDB_SDK_BUILD_INFO_HEADER, BuildInfo_);
+    headers->emplace_back(YDB_CLIENT_PID, clientPid);
+    return headers;
+}
 
-    return meta;
+std::multimap<std::string, std::string> TGRpcConnectionsImpl::CollectResponseMetadata(const grpc::ClientContext& ctx,
+    bool ydbOnly)
+{
+    static constexpr std::string_view ydbHeaderPrefix = "x-ydb-";
+
+    std::multimap<std::string, std::string> metadata;
+    auto collect = [&metadata, ydbOnly](const std::multimap<grpc::string_ref, grpc::string_ref>& source) {
+        for (const auto& [name, value] : source) {
+            std::string_view nameView(name.data(), name.size());
+            if (!ydbOnly || nameView.starts_with(ydbHeaderPrefix)) {
+                metadata.emplace(
+                    std::piecewise_construct,
+                    std::forward_as_tuple(nameView),
+                    std::forward_as_tuple(value.data(), value.size()));
+            }
+        }
+    };
+    collect(ctx.GetServerInitialMetadata());
+    collect(ctx.GetServerTrailingMetadata());
+    return metadata;
 }
 
 } // namespace NYdb
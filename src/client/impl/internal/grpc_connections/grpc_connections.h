@@ -15,6 +15,7 @@
 
 #include <src/library/issue/yql_issue_message.h>
 
+#include <concepts>
 #include <optional>
 
 namespace NYdb::inline V3 {
@@ -43,6 +44,20 @@ using TDeferredResultCb = std::function<void(google::protobuf::Any*, TPlainStatu
 std::string GetAuthInfo(TDbDriverStatePtr p);
 std::string CreateSDKBuildInfo();
 
+// Server replied, but refused to do the work, so the reply latency says nothing about the endpoint load
+template<typename TResponse>
+bool IsOverloadedResponse(const TResponse& response) {
+    Ydb::StatusIds::StatusCode status;
+    if constexpr (requires { { response.operation().status() } -> std::same_as<Ydb::StatusIds::StatusCode>; }) {
+        status = response.operation().status();
+    } else if constexpr (requires { { response.status() } -> std::same_as<Ydb::StatusIds::StatusCode>; }) {
+        status = response.status();
+    } else {
+        return false;
+    }
+    return status == Ydb::StatusIds::OVERLOADED || status == Ydb::StatusIds::UNAVAILABLE;
+}
+
 class TGRpcConnectionsImpl
     : public IQueueClientContextProvider
     , public IInternalClient
@@ -91,7 +106,7 @@ public:
     static void SetGrpcCompressionAlgorithm(NYdbGrpc::TGRpcClientConfig& config, EGrpcCompressionAlgorithm algorithm);
 
     template<typename TService>
-    std::pair<std::unique_ptr<TServiceConnection<TService>>, TEndpointKey> GetServiceConnection(
+    std::tuple<std::unique_ptr<TServiceConnection<TService>>, TEndpointKey, NSdkStats::TEndpointCounters, TEndpointLoadPtr> GetServiceConnection(
         TDbDriverStatePtr dbState, const TEndpointKey& preferredEndpoint,
         TRpcRequestSettings::TEndpointPolicy endpointPolicy)
     {
@@ -116,22 +131,30 @@ public:
 
         SetGrpcCompressionAlgorithm(clientConfig, GRpcCompressionAlgorithm_);
 
-        if (dbState->DiscoveryMode != EDiscoveryMode::Off) {
-            if (std::is_same<TService,Ydb::Discovery::V1::DiscoveryService>()
-                || dbState->Database.empty()
-                || endpointPolicy == TRpcRequestSettings::TEndpointPolicy::UseDiscoveryEndpoint)
-            {
+        NSdkStats::TEndpointCounters endpointCounters;
+        TEndpointLoadPtr endpointLoad;
+
+        const bool useDiscoveryEndpoint = dbState->DiscoveryMode == EDiscoveryMode::Off
+            || std::is_same<TService,Ydb::Discovery::V1::DiscoveryService>()
+            || dbState->Database.empty()
+            || endpointPolicy == TRpcRequestSettings::TEndpointPolicy::UseDiscoveryEndpoint;
+
+        if (useDiscoveryEndpoint) {
+            if (dbState->DiscoveryMode != EDiscoveryMode::Off) {
                 SetGrpcKeepAlive(clientConfig, GRPC_KEEP_ALIVE_TIMEOUT_FOR_DISCOVERY, GRpcKeepAlivePermitWithoutCalls_);
-            } else {
-                auto endpoint = dbState->EndpointPool.GetEndpoint(preferredEndpoint, endpointPolicy == TRpcRequestSettings::TEndpointPolicy::UsePreferredEndpointStrictly);
-                if (!endpoint) {
-                    return {nullptr, TEndpointKey()};
-                }
-                clientConfig.Locator = endpoint.Endpoint;
-                clientConfig.SslTargetNameOverride = endpoint.SslTargetNameOverride;
-                if (GRpcKeepAliveTimeout_ > TDeadline::Duration::zero()) {
-                    SetGrpcKeepAlive(clientConfig, GRpcKeepAliveTimeout_, GRpcKeepAlivePermitWithoutCalls_);
-                }
+            }
+            endpointCounters = dbState->StatCollector.GetEndpointCountersByHost(clientConfig.Locator);
+        } else {
+            auto endpoint = dbState->EndpointPool.GetEndpointHandle(preferredEndpoint, endpointPolicy == TRpcRequestSettings::TEndpointPolicy::UsePreferredEndpointStrictly);
+            if (!endpoint || !*endpoint) {
+                return {nullptr, TEndpointKey(), NSdkStats::TEndpointCounters(), nullptr};
+            }
+            clientConfig.Locator = endpoint->Endpoint;
+            clientConfig.SslTargetNameOverride = endpoint->SslTargetNameOverride;
+            endpointCounters = endpoint->Counters;
+            endpointLoad = endpoint->Load;
+            if (GRpcKeepAliveTimeout_ > TDeadline::Duration::zero()) {
+                SetGrpcKeepAlive(clientConfig, GRpcKeepAliveTimeout_, GRpcKeepAlivePermitWithoutCalls_);
             }
         }
 
@@ -148,7 +171,7 @@ public:
 #else
         conn = std::move(GRpcClientLow_.CreateGRpcServiceConnection<TService>(clientConfig));
 #endif
-        return {std::move(conn), TEndpointKey(clientConfig.Locator, 0)};
+        return {std::move(conn), TEndpointKey(clientConfig.Locator, 0), endpointCounters, std::move(endpointLoad)};
     }
 
     template<class TService, class TRequest, class TResponse>
@@ -246,7 +269,7 @@ public:
         WithServiceConnection<TService>(
             [this, requestWrapper = std::move(requestWrapper), userResponseCb = std::move(userResponseCb), rpc, 
              requestSettings, context = std::move(context), dbState]
-            (TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint) mutable -> void {
+            (TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint, NSdkStats::TEndpointCounters endpointCounters, TEndpointLoadPtr endpointLoad) mutable -> void {
                 if (!status.Ok()) {
                     userResponseCb(
                         nullptr,
@@ -269,28 +292,28 @@ public:
                 }
 
                 dbState->StatCollector.IncGRpcInFlight();
-                dbState->StatCollector.IncGRpcInFlightByHost(endpoint.GetEndpoint());
+                endpointCounters.IncGRpcInFlight();
+                if (endpointLoad) {
+                    endpointLoad->OnRequestStarted();
+                }
 
                 NYdbGrpc::TAdvancedResponseCallback<TResponse> responseCbLow =
-                    [this, context, userResponseCb = std::move(userResponseCb), endpoint, dbState]
+                    [this, context, userResponseCb = std::move(userResponseCb), endpoint, endpointCounters, dbState,
+                     endpointLoad = std::move(endpointLoad), requestStart = TInstant::Now(),
+                     ydbMetadataOnly = requestSettings.YdbResponseMetadataOnly]
                     (const grpc::ClientContext& ctx, TGrpcStatus&& grpcStatus, TResponse&& response) mutable -> void {
                         dbState->StatCollector.DecGRpcInFlight();
-                        dbState->StatCollector.DecGRpcInFlightByHost(endpoint.GetEndpoint());
-
-                        if (NYdbGrpc::IsGRpcStatusGood(grpcStatus)) {
-                            std::multimap<std::string, std::string> metadata;
-
-                            for (const auto& [name, value] : ctx.GetServerInitialMetadata()) {
-                                metadata.emplace(
-                                    std::string(name.begin(), name.end()),
-                                    std::string(value.begin(), value.end()));
-                            }
-                            for (const auto& [name, value] : ctx.GetServerTrailingMetadata()) {
-                                metadata.emplace(
-                                    std::string(name.begin(), name.end()),
-                                    std::string(value.begin(), value.end()));
+                        endpointCounters.DecGRpcInFlight();
+                        if (endpointLoad) {
+                            const auto now = TInstant::Now();
+                            if (!NYdbGrpc::IsGRpcStatusGood(grpcStatus) || IsOverloadedResponse(response)) {
+                                endpointLoad->OnRequestFailed(now - requestStart, now);
+                            } else {
+                                endpointLoad->OnRequestFinished(now - requestStart, now);
                             }
+                        }
 
+                        if (NYdbGrpc::IsGRpcStatusGood(grpcStatus)) {
                             auto resp = new TResult<TResponse>(
                                 std::move(response),
                                 std::move(grpcStatus),
@@ -298,12 +321,12 @@ public:
                                 this,
                                 std::move(context),
                                 endpoint.GetEndpoint(),
-                                std::move(metadata));
+                                CollectResponseMetadata(ctx, ydbMetadataOnly));
 
                             EnqueueResponse(resp);
                         } else {
                             dbState->StatCollector.IncReqFailDueTransportError();
-                            dbState->StatCollector.IncTransportErrorsByHost(endpoint.GetEndpoint());
+                            endpointCounters.IncTransportErrors();
 
                             auto resp = new TGRpcErrorResponse<TResponse>(
                                 std::move(grpcStatus),
@@ -464,7 +487,7 @@ public:
         }
 
         WithServiceConnection<TService>(
-            [this, request, responseCb = std::move(responseCb), rpc, requestSettings, context = std::move(context), dbState](TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint) mutable {
+            [this, request, responseCb = std::move(responseCb), rpc, requestSettings, context = std::move(context), dbState](TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint, NSdkStats::TEndpointCounters endpointCounters, TEndpointLoadPtr endpointLoad) mutable {
                 if (!status.Ok()) {
                     responseCb(std::move(status), nullptr);
                     return;
@@ -484,17 +507,24 @@ public:
                 }
 
                 dbState->StatCollector.IncGRpcInFlight();
-                dbState->StatCollector.IncGRpcInFlightByHost(endpoint.GetEndpoint());
+                endpointCounters.IncGRpcInFlight();
+                if (endpointLoad) {
+                    endpointLoad->OnRequestStarted();
+                }
 
-                auto lowCallback = [responseCb = std::move(responseCb), dbState, endpoint]
+                auto lowCallback = [responseCb = std::move(responseCb), dbState, endpoint, endpointCounters, endpointLoad = std::move(endpointLoad)]
                     (TGrpcStatus grpcStatus, TProcessor processor) mutable {
                         dbState->StatCollector.DecGRpcInFlight();
-                        dbState->StatCollector.DecGRpcInFlightByHost(endpoint.GetEndpoint());
+                        endpointCounters.DecGRpcInFlight();
 
                         if (grpcStatus.Ok()) {
                             Y_ABORT_UNLESS(processor);
-                            auto finishedCallback = [dbState, endpoint] (TGrpcStatus grpcStatus) {
-                                if (!grpcStatus.Ok() && grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED) {
+                            auto finishedCallback = [dbState, endpoint, endpointLoad] (TGrpcStatus grpcStatus) {
+                                const bool failed = !grpcStatus.Ok() && grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED;
+                                if (endpointLoad) {
+                                    endpointLoad->OnStreamFinished(failed, TInstant::Now());
+                                }
+                                if (failed) {
                                     dbState->EndpointPool.BanEndpoint(endpoint.GetEndpoint());
                                 }
                             };
@@ -503,8 +533,12 @@ public:
                             responseCb(std::move(status), std::move(processor));
                         } else {
                             dbState->StatCollector.IncReqFailDueTransportError();
-                            dbState->StatCollector.IncTransportErrorsByHost(endpoint.GetEndpoint());
-                            if (grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED) {
+                            endpointCounters.IncTransportErrors();
+                            const bool failed = grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED;
+                            if (endpointLoad) {
+                                endpointLoad->OnStreamFinished(failed, TInstant::Now());
+                            }
+                            if (failed) {
                                 dbState->EndpointPool.BanEndpoint(endpoint.GetEndpoint());
                             }
                             TPlainStatus status(std::move(grpcStatus), endpoint.GetEndpoint(), {});
@@ -545,7 +579,7 @@ public:
 
         WithServiceConnection<TService>(
             [this, connectedCallback = std::move(connectedCallback), rpc, requestSettings, context = std::move(context), dbState]
-            (TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint) mutable {
+            (TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint, NSdkStats::TEndpointCounters endpointCounters, TEndpointLoadPtr endpointLoad) mutable {
                 if (!status.Ok()) {
                     connectedCallback(std::move(status), nullptr);
                     return;
@@ -565,17 +599,24 @@ public:
                 }
 
                 dbState->StatCollector.IncGRpcInFlight();
-                dbState->StatCollector.IncGRpcInFlightByHost(endpoint.GetEndpoint());
+                endpointCounters.IncGRpcInFlight();
+                if (endpointLoad) {
+                    endpointLoad->OnRequestStarted();
+                }
 
-                auto lowCallback = [connectedCallback = std::move(connectedCallback), dbState, endpoint]
+                auto lowCallback = [connectedCallback = std::move(connectedCallback), dbState, endpoint, endpointCounters, endpointLoad = std::move(endpointLoad)]
                     (TGrpcStatus grpcStatus, TProcessor processor) {
                         dbState->StatCollector.DecGRpcInFlight();
-                        dbState->StatCollector.DecGRpcInFlightByHost(endpoint.GetEndpoint());
+                        endpointCounters.DecGRpcInFlight();
 
                         if (grpcStatus.Ok()) {
                             Y_ABORT_UNLESS(processor);
-                            auto finishedCallback = [dbState, endpoint] (TGrpcStatus grpcStatus) {
-                                if (!grpcStatus.Ok() && grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED) {
+                            auto finishedCallback = [dbState, endpoint, endpointLoad] (TGrpcStatus grpcStatus) {
+                                const bool failed = !grpcStatus.Ok() && grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED;
+                                if (endpointLoad) {
+                                    endpointLoad->OnStreamFinished(failed, TInstant::Now());
+                                }
+                                if (failed) {
                                     dbState->EndpointPool.BanEndpoint(endpoint.GetEndpoint());
                                 }
                             };
@@ -584,8 +625,12 @@ public:
                             connectedCallback(std::move(status), std::move(processor));
                         } else {
                             dbState->StatCollector.IncReqFailDueTransportError();
-                            dbState->StatCollector.IncTransportErrorsByHost(endpoint.GetEndpoint());
-                            if (grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED) {
+                            endpointCounters.IncTransportErrors();
+                            const bool failed = grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED;
+                            if (endpointLoad) {
+                                endpointLoad->OnStreamFinished(failed, TInstant::Now());
+                            }
+                            if (failed) {
                                 dbState->EndpointPool.BanEndpoint(endpoint.GetEndpoint());
                             }
                             TPlainStatus status(std::move(grpcStatus), endpoint.GetEndpoint(), {});
@@ -623,6 +668,8 @@ public:
 
     void SetDiscoveryMutator(IDiscoveryMutatorApi::TMutatorCb&& cb);
     const TLog& GetLog() const override;
+    std::shared_ptr<const std::vector<std::pair<std::string, std::string>>> MakeCommonCallHeaders(
+        const std::string& database) const override;
 
 private:
     static std::optional<TPlainStatus> ValidateClientTlsCredentials(const TDbDriverStatePtr& dbState) {
@@ -646,7 +693,10 @@ private:
         using TConnection = std::unique_ptr<TServiceConnection<TService>>;
         TConnection serviceConnection;
         TEndpointKey endpoint;
-        std::tie(serviceConnection, endpoint) = GetServiceConnection<TService>(dbState, preferredEndpoint, endpointPolicy);
+        NSdkStats::TEndpointCounters endpointCounters;
+        TEndpointLoadPtr endpointLoad;
+        std::tie(serviceConnection, endpoint, endpointCounters, endpointLoad) =
+            GetServiceConnection<TService>(dbState, preferredEndpoint, endpointPolicy);
         if (!serviceConnection) {
             if (dbState->DiscoveryMode == EDiscoveryMode::Off) {
                 TStringStream errString;
@@ -656,7 +706,9 @@ private:
                 callback(
                     TPlainStatus(EStatus::UNAVAILABLE, errString.Str()),
                     TConnection{nullptr},
-                    TEndpointKey{ });
+                    TEndpointKey{ },
+                    NSdkStats::TEndpointCounters{ },
+                    nullptr);
 
             } else if (dbState->DiscoveryMode == EDiscoveryMode::Sync) {
                 TStringStream errString;
@@ -680,7 +732,9 @@ private:
                 callback(
                     discoveryStatus,
                     TConnection{nullptr},
-                    TEndpointKey{ });
+                    TEndpointKey{ },
+                    NSdkStats::TEndpointCounters{ },
+                    nullptr);
             } else {
                 int64_t newVal;
                 int64_t val;
@@ -691,7 +745,9 @@ private:
                         callback(
                             TPlainStatus(EStatus::CLIENT_LIMITS_REACHED, "Requests queue limit reached"),
                             TConnection{nullptr},
-                            TEndpointKey{ });
+                            TEndpointKey{ },
+                            NSdkStats::TEndpointCounters{ },
+                            nullptr);
                         return;
                     }
                     newVal = val + 1;
@@ -716,7 +772,9 @@ private:
                         callback(
                             TPlainStatus(discoveryStatus.Status, std::move(discoveryStatus.Issues)),
                             TConnection{nullptr},
-                            TEndpointKey{ });
+                            TEndpointKey{ },
+                            NSdkStats::TEndpointCounters{ },
+                            nullptr);
                     }
                 });
             }
@@ -726,13 +784,17 @@ private:
         callback(
             TPlainStatus{ },
             std::move(serviceConnection),
-            std::move(endpoint));
+            std::move(endpoint),
+            endpointCounters,
+            std::move(endpointLoad));
     }
 
     void EnqueueResponse(IObjectInQueue* action);
 
 private:
     TCallMeta MakeCallMeta(const TRpcRequestSettings& requestSettings, const TDbDriverStatePtr& dbState) const;
+    static std::multimap<std::string, std::string> CollectResponseMetadata(const grpc::ClientContext& ctx,
+        bool ydbOnly);
 
     std::mutex ExtensionsLock_;
     ::NMonitoring::TMetricRegistry* MetricRegistryPtr_ = nullptr;
@@ -38,6 +38,9 @@ public:
     virtual ::NMonitoring::TMetricRegistry* GetMetricRegistry() = 0;
     virtual std::shared_ptr<NMetrics::IMetricRegistry> GetExternalMetricRegistry() const = 0;
     virtual const TLog& GetLog() const = 0;
+    // Call headers which are the same for every request to the database
+    virtual std::shared_ptr<const std::vector<std::pair<std::string, std::string>>> MakeCommonCallHeaders(
+        const std::string& database) const = 0;
 };
 
 } // namespace NYdb
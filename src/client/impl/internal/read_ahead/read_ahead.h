@@ -0,0 +1,149 @@
+#pragma once
+
+#include <src/client/impl/internal/internal_header.h>
+
+#include <ydb-cpp-sdk/client/types/request_settings.h>
+
+#include <src/library/grpc/client/grpc_client_low.h>
+
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace NYdb::inline V3 {
+
+//! Keeps reading a server stream into a bounded buffer independently of the consumer,
+//! so the network does not idle while the application processes received parts.
+//! Read has the same contract as IStreamRequestReadProcessor::Read: one active call at a time.
+template <typename TResponse>
+class TStreamReadAhead : public std::enable_shared_from_this<TStreamReadAhead<TResponse>> {
+public:
+    using TStreamProcessorPtr = typename NYdbGrpc::IStreamRequestReadProcessor<TResponse>::TPtr;
+    using TReadCallback = typename NYdbGrpc::IStreamRequestReadProcessor<TResponse>::TReadCallback;
+    using TGRpcStatus = NYdbGrpc::TGrpcStatus;
+
+    TStreamReadAhead(TStreamProcessorPtr streamProcessor, const TReadAheadSettings& settings)
+        : StreamProcessor_(std::move(streamProcessor))
+        , MaxParts_(settings.MaxParts_)
+        , MaxBytes_(settings.MaxBytes_)
+    {}
+
+    void Start() {
+        ReadMore();
+    }
+
+    void Read(TResponse* response, TReadCallback callback) {
+        TGRpcStatus status;
+        {
+            std::unique_lock guard(Mutex_);
+            Y_ABORT_UNLESS(!PendingCallback_, "Multiple Read calls detected");
+
+            if (Buffered_.empty()) {
+                if (!Finished_) {
+                    PendingResponse_ = response;
+                    PendingCallback_ = std::move(callback);
+                    return;
+                }
+                // Every read after the end of the stream gets its final status
+                status = FinalStatus_;
+            } else {
+                auto& part = Buffered_.front();
+                response->Swap(&part.Response);
+                status = std::move(part.Status);
+                BufferedBytes_ -= part.Bytes;
+                Buffered_.pop_front();
+            }
+        }
+
+        ReadMore();
+        callback(std::move(status));
+    }
+
+private:
+    struct TPart {
+        TResponse Response;
+        TGRpcStatus Status;
+        size_t Bytes = 0;
+    };
+
+    void ReadMore() {
+        {
+            std::unique_lock guard(Mutex_);
+            // Empty buffer is always refilled, so a part larger than the byte limit cannot stall the stream
+            const bool full = Buffered_.size() >= MaxParts_ || (!Buffered_.empty() && BufferedBytes_ >= MaxBytes_);
+            if (ReadActive_ || Finished_ || full) {
+                return;
+            }
+            ReadActive_ = true;
+        }
+
+        // Capture self - read callback must not outlive the buffer it writes into
+        StreamProcessor_->Read(&InFlight_, [self = this->shared_from_this()](TGRpcStatus&& status) {
+            self->OnRead(std::move(status));
+        });
+    }
+
+    void OnRead(TGRpcStatus&& status) {
+        TReadCallback callback;
+        {
+            std::unique_lock guard(Mutex_);
+            ReadActive_ = false;
+            if (!status.Ok()) {
+                Finished_ = true;
+                FinalStatus_ = status;
+            }
+
+            if (PendingCallback_) {
+                // Consumer is already waiting, so the buffer is empty
+                PendingResponse_->Swap(&InFlight_);
+                PendingResponse_ = nullptr;
+                callback = std::move(PendingCallback_);
+                PendingCallback_ = nullptr;
+            } else {
+                const size_t bytes = InFlight_.ByteSizeLong();
+                Buffered_.push_back(TPart{std::move(InFlight_), std::move(status), bytes});
+                BufferedBytes_ += bytes;
+            }
+            InFlight_.Clear();
+        }
+
+        ReadMore();
+        if (callback) {
+            callback(std::move(status));
+        }
+    }
+
+private:
+    TStreamProcessorPtr StreamProcessor_;
+    const size_t MaxParts_;
+    const uint64_t MaxBytes_;
+
+    std::mutex Mutex_;
+    std::deque<TPart> Buffered_;
+    uint64_t BufferedBytes_ = 0;
+
+    TResponse InFlight_;
+    bool ReadActive_ = false;
+    bool Finished_ = false;
+    TGRpcStatus FinalStatus_;
+
+    TResponse* PendingResponse_ = nullptr;
+    TReadCallback PendingCallback_;
+};
+
+//! Returns read-ahead buffer for the stream or nullptr if read-ahead is disabled
+template <typename TResponse>
+std::shared_ptr<TStreamReadAhead<TResponse>> MakeStreamReadAhead(
+    typename TStreamReadAhead<TResponse>::TStreamProcessorPtr streamProcessor,
+    const std::optional<TReadAheadSettings>& settings)
+{
+    if (!settings || settings->MaxParts_ == 0 || settings->MaxBytes_ == 0) {
+        return nullptr;
+    }
+
+    auto readAhead = std::make_shared<TStreamReadAhead<TResponse>>(std::move(streamProcessor), *settings);
+    readAhead->Start();
+    return readAhead;
+}
+
+} // namespace NYdb
@@ -20,6 +20,7 @@ struct TRpcRequestSettings {
     bool UseAuth = true;
     NYdb::TDeadline Deadline = NYdb::TDeadline::Max();
     std::string TraceParent;
+    bool YdbResponseMetadataOnly = false;
 
     template <typename TRequestSettings>
     static TRpcRequestSettings Make(const TRequestSettings& settings,
@@ -30,6 +31,7 @@ struct TRpcRequestSettings {
         rpcSettings.RequestType = settings.RequestType_;
         rpcSettings.Header = settings.Header_;
         rpcSettings.TraceParent = settings.TraceParent_;
+        rpcSettings.YdbResponseMetadataOnly = settings.YdbResponseMetadataOnly_;
         rpcSettings.PreferredEndpoint = preferredEndpoint;
         rpcSettings.EndpointPolicy = endpointPolicy;
         rpcSettings.UseAuth = true;
@@ -2,10 +2,17 @@
 
 #include <src/client/impl/internal/internal_header.h>
 
+#include <ydb-cpp-sdk/client/value/value.h>
+
 #include <src/api/protos/ydb_value.pb.h>
 
 namespace NYdb::inline V3 {
 
 bool TypesEqual(const Ydb::Type& t1, const Ydb::Type& t2);
 
+//! Returns the shared immutable instance of the type, equal types interned by different
+//! callers point to the same TType::TImpl
+TType InternType(const Ydb::Type& typeProto);
+TType InternType(Ydb::Type&& typeProto);
+
 } // namespace NYdb
@@ -30,9 +30,10 @@ void TRequestObservation::End(EStatus status, const std::string& endpoint) noexc
         std::string location;
         if (!endpoint.empty()) {
             if (auto state = DbDriverState_.lock()) {
-                const auto record = state->EndpointPool.GetEndpoint(TEndpointKey(endpoint, 0), /*onlyPreferred=*/true);
-                nodeId = record.NodeId;
-                location = record.Location;
+                if (const auto record = state->EndpointPool.GetEndpointHandle(TEndpointKey(endpoint, 0), /*onlyPreferred=*/true)) {
+                    nodeId = record->NodeId;
+                    location = record->Location;
+                }
             }
         }
         Span_->SetPeerEndpoint(endpoint, nodeId, location);
@@ -100,9 +100,13 @@ std::uint32_t TSessionPool::TWaitersQueue::Size() const {
 }
 
 
-TSessionPool::TSessionPool(std::uint32_t maxActiveSessions, std::uint32_t minPoolSize)
+TSessionPool::TSessionPool(std::uint32_t maxActiveSessions, std::uint32_t minPoolSize, std::uint32_t shardsCount)
     : Closed_(false)
+    , ShardsCount_(std::max<std::uint32_t>(shardsCount, 1))
+    , Shards_(new TShard[ShardsCount_])
+    , IdleSessions_(0)
     , WaitersQueue_(maxActiveSessions * 10)
+    , WaitersCount_(0)
     , ActiveSessions_(0)
     , MaxActiveSessions_(maxActiveSessions)
     , MinPoolSize_(minPoolSize)
@@ -126,8 +130,92 @@ void TSessionPool::ReplySessionToUser(
     ctx->ReplySessionToUser(session);
 }
 
+bool TSessionPool::IsSharded() const {
+    return ShardsCount_ > 1;
+}
+
+TSessionPool::TShard& TSessionPool::GetLocalShard() {
+    static std::atomic<std::size_t> nextThreadIndex = 0;
+    static thread_local const std::size_t threadIndex = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return Shards_[threadIndex % ShardsCount_];
+}
+
+std::unique_ptr<TKqpSessionCommon> TSessionPool::TakeIdleSession() {
+    if (IdleSessions_.load(std::memory_order_relaxed) == 0) {
+        return {};
+    }
+
+    const std::size_t home = &GetLocalShard() - Shards_.get();
+    for (std::size_t i = 0; i < ShardsCount_; ++i) {
+        auto& shard = Shards_[(home + i) % ShardsCount_];
+        std::lock_guard guard(shard.Mtx);
+        if (!shard.Sessions.empty()) {
+            auto it = std::prev(shard.Sessions.end());
+            it->second->UpdateServerCloseHandler(nullptr);
+            auto sessionImpl = std::move(it->second);
+            shard.Sessions.erase(it);
+            IdleSessions_.fetch_sub(1);
+            return sessionImpl;
+        }
+    }
+    return {};
+}
+
+bool TSessionPool::PutIdleSession(TKqpSessionCommon* impl) {
+    auto& shard = GetLocalShard();
+    std::lock_guard guard(shard.Mtx);
+    // Drain sets Closed_ before it visits shards, so the session is either drained or rejected here
+    if (Closed_) {
+        return false;
+    }
+    impl->UpdateServerCloseHandler(this);
+    shard.Sessions.emplace(impl->GetTimeToTouchFast(), impl);
+    IdleSessions_.fetch_add(1);
+    return true;
+}
+
+bool TSessionPool::TryAcquireActiveSlot() {
+    std::int64_t active = ActiveSessions_.load();
+    do {
+        if (MaxActiveSessions_ != 0 && active >= MaxActiveSessions_) {
+            return false;
+        }
+    } while (!ActiveSessions_.compare_exchange_weak(active, active + 1));
+    return true;
+}
+
+void TSessionPool::FeedWaiters() {
+    std::vector<std::pair<std::unique_ptr<IGetSessionCtx>, std::unique_ptr<TKqpSessionCommon>>> waitersToReply;
+    {
+        std::lock_guard guard(Mtx_);
+        while (WaitersQueue_.Size() && TryAcquireActiveSlot()) {
+            auto ctx = WaitersQueue_.TryGet();
+            waitersToReply.emplace_back(std::move(ctx), TakeIdleSession());
+        }
+        WaitersCount_ = WaitersQueue_.Size();
+        UpdateStats();
+    }
+
+    for (auto& [ctx, sessionImpl] : waitersToReply) {
+        if (sessionImpl) {
+            ReplySessionToUser(sessionImpl.release(), std::move(ctx));
+        } else {
+            ctx->ReplyNewSession();
+        }
+    }
+}
+
 void TSessionPool::GetSession(std::unique_ptr<IGetSessionCtx> ctx)
 {
+    if (IsSharded() && WaitersCount_ == 0 && TryAcquireActiveSlot()) {
+        if (auto sessionImpl = TakeIdleSession()) {
+            ReplySessionToUser(sessionImpl.release(), std::move(ctx));
+        } else {
+            ctx->ReplyNewSession();
+        }
+        return;
+    }
+
     std::unique_ptr<TKqpSessionCommon> sessionImpl;
     enum class TSessionSource {
         Pool,
@@ -138,27 +226,26 @@ void TSessionPool::GetSession(std::unique_ptr<IGetSessionCtx> ctx)
     {
         std::lock_guard guard(Mtx_);
 
-        if (MaxActiveSessions_ == 0 || ActiveSessions_ < MaxActiveSessions_) {
-            IncrementActiveCounterUnsafe();
+        if (TryAcquireActiveSlot()) {
+            sessionImpl = TakeIdleSession();
         } else if (auto* ctxPtr = WaitersQueue_.TryPush(ctx)) {
             sessionSource = TSessionSource::Waiter;
+            WaitersCount_ = WaitersQueue_.Size();
             ctxPtr->ScheduleOnDeadlineWaiterCleanup();
             ExternalStatCollector_.IncPendingRequests();
         } else {
             sessionSource = TSessionSource::Error;
         }
-        if (!Sessions_.empty()) {
-            auto it = std::prev(Sessions_.end());
-            it->second->UpdateServerCloseHandler(nullptr);
-            sessionImpl = std::move(it->second);
-            Sessions_.erase(it);
-        }
 
         UpdateStats();
     }
 
     if (sessionSource == TSessionSource::Waiter) {
-        // ctxPtr->ScheduleOnDeadlineWaiterCleanup() is called after TryPush
+        // ctxPtr->ScheduleOnDeadlineWaiterCleanup() is called after TryPush.
+        // In the sharded mode a slot can be released without the lock right before the push
+        if (IsSharded()) {
+            FeedWaiters();
+        }
     } else if (sessionSource == TSessionSource::Error) {
         FakeSessionsCounter_.Inc();
         ctx->ReplyError(CLIENT_RESOURCE_EXHAUSTED_ACTIVE_SESSION_LIMIT);
@@ -178,6 +265,7 @@ bool TSessionPool::CheckAndFeedWaiterNewSession(bool active) {
 
         if (auto maybeCtx = WaitersQueue_.TryGet()) {
             getSessionCtx = std::move(maybeCtx);
+            WaitersCount_ = WaitersQueue_.Size();
         } else {
             return false;
         }
@@ -207,6 +295,7 @@ void TSessionPool::ClearOldWaiters() {
 
     std::vector<std::unique_ptr<IGetSessionCtx>> oldWaiters;
     WaitersQueue_.GetOld(TDeadline::Now(), oldWaiters);
+    WaitersCount_ = WaitersQueue_.Size();
 
     for (auto& waiter : oldWaiters) {
         FakeSessionsCounter_.Inc();
@@ -220,6 +309,27 @@ void TSessionPool::ClearOldWaiters() {
 }
 
 bool TSessionPool::ReturnSession(TKqpSessionCommon* impl, bool active) {
+    if (IsSharded() && WaitersCount_ == 0) {
+        if (active) {
+            impl->SetNeedUpdateActiveCounter(false);
+        }
+        if (!PutIdleSession(impl)) {
+            if (active) {
+                impl->SetNeedUpdateActiveCounter(true);
+            }
+            return false;
+        }
+        if (active) {
+            const auto activeBefore = ActiveSessions_.fetch_sub(1);
+            Y_ABORT_UNLESS(activeBefore > 0);
+            // A waiter could be queued after the check above, it must not miss the released slot
+            if (WaitersCount_ != 0) {
+                FeedWaiters();
+            }
+        }
+        return true;
+    }
+
     // Do not call ReplySessionToUser under the session pool lock
     std::unique_ptr<IGetSessionCtx> getSessionCtx;
     {
@@ -229,18 +339,18 @@ bool TSessionPool::ReturnSession(TKqpSessionCommon* impl, bool active) {
 
         if (auto maybeCtx = WaitersQueue_.TryGet()) {
             getSessionCtx = std::move(maybeCtx);
+            WaitersCount_ = WaitersQueue_.Size();
             if (!active)
                 IncrementActiveCounterUnsafe();
         } else {
-            impl->UpdateServerCloseHandler(this);
-            Sessions_.emplace(std::make_pair(
-                impl->GetTimeToTouchFast(),
-                impl));
+            if (active) {
+                impl->SetNeedUpdateActiveCounter(false);
+            }
+            PutIdleSession(impl);
 
             if (active) {
                 Y_ABORT_UNLESS(ActiveSessions_);
                 ActiveSessions_--;
-                impl->SetNeedUpdateActiveCounter(false);
             }
         }
         UpdateStats();
@@ -254,10 +364,15 @@ bool TSessionPool::ReturnSession(TKqpSessionCommon* impl, bool active) {
 }
 
 void TSessionPool::DecrementActiveCounter() {
-    std::lock_guard guard(Mtx_);
-    Y_ABORT_UNLESS(ActiveSessions_);
-    ActiveSessions_--;
-    UpdateStats();
+    {
+        std::lock_guard guard(Mtx_);
+        Y_ABORT_UNLESS(ActiveSessions_);
+        ActiveSessions_--;
+        UpdateStats();
+    }
+    if (IsSharded() && WaitersCount_ != 0) {
+        FeedWaiters();
+    }
 }
 
 void TSessionPool::IncrementActiveCounterUnsafe() {
@@ -270,12 +385,18 @@ void TSessionPool::Drain(std::function<bool(std::unique_ptr<TKqpSessionCommon>&&
     {
         std::lock_guard guard(Mtx_);
         Closed_ = close;
-        for (auto it = Sessions_.begin(); it != Sessions_.end();) {
-            it->second->UpdateServerCloseHandler(nullptr);
-            const bool cont = cb(std::move(it->second));
-            it = Sessions_.erase(it);
-            if (!cont)
-                break;
+        bool cont = true;
+        for (std::uint32_t i = 0; i < ShardsCount_ && cont; ++i) {
+            auto& shard = Shards_[i];
+            std::lock_guard shardGuard(shard.Mtx);
+            for (auto it = shard.Sessions.begin(); it != shard.Sessions.end();) {
+                it->second->UpdateServerCloseHandler(nullptr);
+                cont = cb(std::move(it->second));
+                it = shard.Sessions.erase(it);
+                IdleSessions_.fetch_sub(1);
+                if (!cont)
+                    break;
+            }
         }
         if (close) {
             // Collect all pending waiters to reply with error outside the lock.
@@ -284,6 +405,7 @@ void TSessionPool::Drain(std::function<bool(std::unique_ptr<TKqpSessionCommon>&&
             while (auto waiter = WaitersQueue_.TryGet()) {
                 waitersToReplyError.push_back(std::move(waiter));
             }
+            WaitersCount_ = 0;
         }
         UpdateStats();
     }
@@ -307,34 +429,39 @@ TPeriodicCb TSessionPool::CreatePeriodicTask(std::weak_ptr<ISessionClient> weakC
             // moreover it is unsafe to touch this ptr!
             return false;
         } else {
-            auto sessionCountToProcess = PERIODIC_ACTION_BATCH_SIZE;
             std::vector<std::unique_ptr<TKqpSessionCommon>> sessionsToTouch;
-            sessionsToTouch.reserve(sessionCountToProcess);
+            sessionsToTouch.reserve(PERIODIC_ACTION_BATCH_SIZE);
             std::vector<std::unique_ptr<TKqpSessionCommon>> sessionsToDelete;
-            sessionsToDelete.reserve(sessionCountToProcess);
+            sessionsToDelete.reserve(PERIODIC_ACTION_BATCH_SIZE);
             std::vector<std::unique_ptr<IGetSessionCtx>> waitersToReplyError;
-            waitersToReplyError.reserve(sessionCountToProcess);
+            waitersToReplyError.reserve(PERIODIC_ACTION_BATCH_SIZE);
             const auto now = TDeadline::Now();
             const auto nowUtil = TInstant::Now();
             {
                 std::lock_guard guard(Mtx_);
-                {
-                    auto& sessions = Sessions_;
+                // Every shard gets its own batch, so keep alive doesn't fall behind with many shards
+                for (std::uint32_t i = 0; i < ShardsCount_; ++i) {
+                    auto& shard = Shards_[i];
+                    std::lock_guard shardGuard(shard.Mtx);
+                    auto& sessions = shard.Sessions;
 
+                    auto sessionCountToProcess = PERIODIC_ACTION_BATCH_SIZE;
                     auto it = sessions.begin();
                     while (it != sessions.end() && sessionCountToProcess--) {
                         if (nowUtil < it->second->GetTimeToTouchFast()) {
                             break;
                         }
 
-                        if (deletePredicate(it->second.get(), sessions.size())) {
+                        if (deletePredicate(it->second.get(), IdleSessions_.load())) {
                             it->second->UpdateServerCloseHandler(nullptr);
                             sessionsToDelete.emplace_back(std::move(it->second));
                             sessions.erase(it++);
+                            IdleSessions_.fetch_sub(1);
                         } else if (cmd) {
                             it->second->UpdateServerCloseHandler(nullptr);
                             sessionsToTouch.emplace_back(std::move(it->second));
                             sessions.erase(it++);
+                            IdleSessions_.fetch_sub(1);
                         } else {
                             it++;
                         }
@@ -342,6 +469,7 @@ TPeriodicCb TSessionPool::CreatePeriodicTask(std::weak_ptr<ISessionClient> weakC
                 }
 
                 WaitersQueue_.GetOld(now, waitersToReplyError);
+                WaitersCount_ = WaitersQueue_.Size();
 
                 UpdateStats();
             }
@@ -373,7 +501,6 @@ TPeriodicCb TSessionPool::CreatePeriodicTask(std::weak_ptr<ISessionClient> weakC
 }
 
 std::int64_t TSessionPool::GetActiveSessions() const {
-    std::lock_guard guard(Mtx_);
     return ActiveSessions_;
 }
 
@@ -382,8 +509,7 @@ std::int64_t TSessionPool::GetActiveSessionsLimit() const {
 }
 
 std::int64_t TSessionPool::GetCurrentPoolSize() const {
-    std::lock_guard guard(Mtx_);
-    return Sessions_.size();
+    return IdleSessions_;
 }
 
 void TSessionPool::OnCloseSession(const TKqpSessionCommon* s, std::shared_ptr<ISessionClient> client) {
@@ -392,17 +518,22 @@ void TSessionPool::OnCloseSession(const TKqpSessionCommon* s, std::shared_ptr<IS
         std::lock_guard guard(Mtx_);
         const auto timeToTouch = s->GetTimeToTouchFast();
         const auto id = s->GetId();
-        auto it = Sessions_.find(timeToTouch);
-        // Sessions_ is multimap of sessions sorted by scheduled time to run periodic task
-        // Scan sessions with same scheduled time to find needed one. In most cases only one session here
-        while (it != Sessions_.end() && it->first == timeToTouch) {
-            if (id != it->second->GetId()) {
-                it++;
-                continue;
+        for (std::uint32_t i = 0; i < ShardsCount_ && !session; ++i) {
+            auto& shard = Shards_[i];
+            std::lock_guard shardGuard(shard.Mtx);
+            auto it = shard.Sessions.find(timeToTouch);
+            // Sessions are sorted by scheduled time to run periodic task
+            // Scan sessions with same scheduled time to find needed one. In most cases only one session here
+            while (it != shard.Sessions.end() && it->first == timeToTouch) {
+                if (id != it->second->GetId()) {
+                    it++;
+                    continue;
+                }
+                session = std::move(it->second);
+                shard.Sessions.erase(it);
+                IdleSessions_.fetch_sub(1);
+                break;
             }
-            session = std::move(it->second);
-            Sessions_.erase(it);
-            break;
         }
     }
 
@@ -424,7 +555,7 @@ void TSessionPool::SetStatCollector(NSdkStats::TStatCollector::TSessionPoolStatC
         SessionWaiterCounter_.Set(statCollector.Waiters);
         ExternalStatCollector_ = std::move(statCollector);
         snapshot = ExternalStatCollector_;
-        idleCount = static_cast<std::int64_t>(Sessions_.size());
+        idleCount = IdleSessions_;
         usedCount = ActiveSessions_;
     }
     snapshot.UpdateConnectionCount(idleCount, usedCount);
@@ -438,13 +569,17 @@ void TSessionPool::RecordConnectionCreateTime(double seconds) {
     ExternalStatCollector_.RecordConnectionCreateTime(seconds);
 }
 
+// Must be called under Mtx_. In the sharded mode lock-free paths don't update stats,
+// they are refreshed by the next locked operation or periodic task.
 void TSessionPool::UpdateStats() {
-    ActiveSessionsCounter_.Apply(ActiveSessions_);
-    InPoolSessionsCounter_.Apply(Sessions_.size());
+    const std::int64_t idle = IdleSessions_;
+    const std::int64_t active = ActiveSessions_;
+    ActiveSessionsCounter_.Apply(active);
+    InPoolSessionsCounter_.Apply(idle);
     SessionWaiterCounter_.Apply(WaitersQueue_.Size());
     ExternalStatCollector_.UpdateConnectionCount(
-        /*idle=*/static_cast<std::int64_t>(Sessions_.size()),
-        /*used=*/ActiveSessions_
+        /*idle=*/idle,
+        /*used=*/active
     );
 }
 
@@ -4,6 +4,8 @@
 
 #include <ydb-cpp-sdk/client/types/core_facility/core_facility.h>
 
+#include <atomic>
+
 
 namespace NYdb::inline V3 {
 
@@ -104,7 +106,10 @@ private:
 public:
     using TKeepAliveCmd = std::function<void(TKqpSessionCommon* s)>;
     using TDeletePredicate = std::function<bool(TKqpSessionCommon* s, size_t sessionsCount)>;
-    TSessionPool(std::uint32_t maxActiveSessions, std::uint32_t minPoolSize = 0);
+    // With shardsCount > 1 idle sessions are spread over shards with their own locks,
+    // a thread takes sessions from its home shard first and steals from the others if it is empty.
+    // GetSession and ReturnSession take the pool-wide lock only if there are waiters.
+    TSessionPool(std::uint32_t maxActiveSessions, std::uint32_t minPoolSize = 0, std::uint32_t shardsCount = 1);
 
     // Extracts session from pool or creates new one ising given ctx
     void GetSession(std::unique_ptr<IGetSessionCtx> ctx);
@@ -133,16 +138,34 @@ public:
     void OnCloseSession(const TKqpSessionCommon*, std::shared_ptr<ISessionClient> client) override;
 
 private:
+    struct alignas(64) TShard {
+        std::mutex Mtx;
+        std::multimap<TInstant, std::unique_ptr<TKqpSessionCommon>> Sessions;
+    };
+
+    bool IsSharded() const;
+    TShard& GetLocalShard();
+    std::unique_ptr<TKqpSessionCommon> TakeIdleSession();
+    bool PutIdleSession(TKqpSessionCommon* impl);
+    bool TryAcquireActiveSlot();
+    // Gives free active slots to waiters, used by the sharded mode
+    void FeedWaiters();
+
     void UpdateStats();
     static void ReplySessionToUser(TKqpSessionCommon* session, std::unique_ptr<IGetSessionCtx> ctx);
 
     mutable std::mutex Mtx_;
-    bool Closed_;
+    std::atomic<bool> Closed_;
+
+    const std::uint32_t ShardsCount_;
+    std::unique_ptr<TShard[]> Shards_;
+    std::atomic<std::int64_t> IdleSessions_;
 
-    std::multimap<TInstant, std::unique_ptr<TKqpSessionCommon>> Sessions_;
     TWaitersQueue WaitersQueue_;
+    // Size of WaitersQueue_, readable without the lock
+    std::atomic<std::uint32_t> WaitersCount_;
 
-    std::int64_t ActiveSessions_;
+    std::atomic<std::int64_t> ActiveSessions_;
     const std::uint32_t MaxActiveSessions_;
     const std::uint32_t MinPoolSize_;
     NSdkStats::TSessionCounter ActiveSessionsCounter_;
@@ -165,6 +165,31 @@ private:
     i64 oldValue = 0;
 };
 
+// Per-endpoint counters are resolved once, when the endpoint becomes known,
+// so the request path does not look up the registry by host label
+struct TEndpointCounters {
+    void IncGRpcInFlight() const {
+        if (GRpcInFlight) {
+            GRpcInFlight->Inc();
+        }
+    }
+
+    void DecGRpcInFlight() const {
+        if (GRpcInFlight) {
+            GRpcInFlight->Dec();
+        }
+    }
+
+    void IncTransportErrors() const {
+        if (TransportErrors) {
+            TransportErrors->Inc();
+        }
+    }
+
+    ::NMonitoring::TIntGauge* GRpcInFlight = nullptr;
+    ::NMonitoring::TRate* TransportErrors = nullptr;
+};
+
 struct TStatCollector {
     using TMetricRegistry = ::NMonitoring::TMetricRegistry;
 
@@ -173,15 +198,25 @@ public:
 
         TEndpointElectorStatCollector(::NMonitoring::TIntGauge* endpointCount = nullptr
         , ::NMonitoring::TIntGauge* pessimizationRatio = nullptr
-        , ::NMonitoring::TIntGauge* activeEndpoints = nullptr)
+        , ::NMonitoring::TIntGauge* activeEndpoints = nullptr
+        , TMetricRegistry* registry = nullptr
+        , const std::string& database = {})
         : EndpointCount(endpointCount)
         , PessimizationRatio(pessimizationRatio)
         , EndpointActive(activeEndpoints)
+        , Registry(registry)
+        , Database(database)
         { }
 
+        TEndpointCounters GetEndpointCounters(const std::string& endpoint) const {
+            return ResolveEndpointCounters(Registry, Database, endpoint);
+        }
+
         ::NMonitoring::TIntGauge* EndpointCount;
         ::NMonitoring::TIntGauge* PessimizationRatio;
         ::NMonitoring::TIntGauge* EndpointActive;
+        TMetricRegistry* Registry;
+        std::string Database;
     };
 
     struct TSessionPoolStatCollector {
@@ -597,6 +632,39 @@ public:
             ::NMonitoring::ExponentialHistogram(20, 2, 1)));
         ResultSize_.Set(sensorsRegistry->HistogramRate({ DatabaseLabel_, {"sensor", "Request/ResultSize"} },
             ::NMonitoring::ExponentialHistogram(20, 2, 32)));
+
+        if (!DiscoveryEndpoint_.empty()) {
+            auto counters = ResolveEndpointCounters(sensorsRegistry, Database_, DiscoveryEndpoint_);
+            DiscoveryEndpointGRpcInFlight_.Set(counters.GRpcInFlight);
+            DiscoveryEndpointTransportErrors_.Set(counters.TransportErrors);
+        }
+    }
+
+    static TEndpointCounters ResolveEndpointCounters(TMetricRegistry* registry, const std::string& database,
+        const std::string& endpoint)
+    {
+        if (!registry) {
+            return {};
+        }
+        TEndpointCounters counters;
+        counters.GRpcInFlight = registry->IntGauge({ {"database", database}, {"sensor", "Grpc/InFlightByYdbHost"},
+            {"YdbHost", endpoint} });
+        counters.TransportErrors = registry->Rate({ {"database", database}, {"sensor", "TransportErrorsByYdbHost"},
+            {"YdbHost", endpoint} });
+        return counters;
+    }
+
+    // Per-host counters of the endpoint which is not taken from the endpoint pool:
+    // the discovery endpoint, also used when discovery is off. Its counters are cached,
+    // any other host is looked up in the registry
+    TEndpointCounters GetEndpointCountersByHost(const std::string& endpoint) const {
+        if (endpoint != DiscoveryEndpoint_) {
+            return ResolveEndpointCounters(MetricRegistryPtr_.Get(), Database_, endpoint);
+        }
+        TEndpointCounters counters;
+        counters.GRpcInFlight = DiscoveryEndpointGRpcInFlight_.Get();
+        counters.TransportErrors = DiscoveryEndpointTransportErrors_.Get();
+        return counters;
     }
 
     void IncDiscoveryDuePessimization() {
@@ -654,7 +722,7 @@ public:
             auto endpointCoint = registry->IntGauge({ DatabaseLabel_,      {"sensor", "Endpoints/Total"} });
             auto pessimizationRatio = registry->IntGauge({ DatabaseLabel_, {"sensor", "Endpoints/BadRatio"} });
             auto activeEndpoints = registry->IntGauge({ DatabaseLabel_,    {"sensor", "Endpoints/Good"} });
-            return TEndpointElectorStatCollector(endpointCoint, pessimizationRatio, activeEndpoints);
+            return TEndpointElectorStatCollector(endpointCoint, pessimizationRatio, activeEndpoints, registry, Database_);
         }
 
         return TEndpointElectorStatCollector();
@@ -722,11 +790,6 @@ public:
     void IncSessionsOnHost(const std::string& host);
     void DecSessionsOnHost(const std::string& host);
 
-    void IncTransportErrorsByHost(const std::string& host);
-
-    void IncGRpcInFlightByHost(const std::string& host);
-    void DecGRpcInFlightByHost(const std::string& host);
-
 private:
     const std::string Database_;
     const ::NMonitoring::TLabel DatabaseLabel_;
@@ -743,6 +806,8 @@ private:
     TAtomicCounter<::NMonitoring::TRate> DiscoveryFailDueTransportError_;
     TAtomicCounter<::NMonitoring::TIntGauge> SessionCV_;
     TAtomicCounter<::NMonitoring::TIntGauge> GRpcInFlight_;
+    TAtomicCounter<::NMonitoring::TIntGauge> DiscoveryEndpointGRpcInFlight_;
+    TAtomicCounter<::NMonitoring::TRate> DiscoveryEndpointTransportErrors_;
     TAtomicHistogram<::NMonitoring::THistogram> RequestLatency_;
     TAtomicHistogram<::NMonitoring::THistogram> ResultSize_;
 };
@@ -1,5 +1,9 @@
 #include "impl.h"
 
+#define INCLUDE_YDB_INTERNAL_H
+#include <src/client/impl/internal/value_helpers/helpers.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
 #include <src/api/protos/ydb_scheme.pb.h>
 #include <src/api/protos/ydb_value.pb.h>
 
@@ -10,14 +14,18 @@ TParams::TImpl::TImpl(::google::protobuf::Map<TStringType, Ydb::TypedValue>&& pa
     ParamsMap_.swap(paramsMap);
 }
 
+TParams::TImpl::TImpl(std::shared_ptr<const TParamsStorage> storage)
+    : Storage_(std::move(storage)) {}
+
 bool TParams::TImpl::Empty() const {
-    return ParamsMap_.empty();
+    return GetProtoMap().empty();
 }
 
 std::map<std::string, TValue> TParams::TImpl::GetValues() const {
     std::map<std::string, TValue> valuesMap;
-    for (auto it = ParamsMap_.begin(); it != ParamsMap_.end(); ++it) {
-        auto paramType = TType(it->second.type());
+    const auto& paramsMap = GetProtoMap();
+    for (auto it = paramsMap.begin(); it != paramsMap.end(); ++it) {
+        auto paramType = InternType(it->second.type());
         auto paramValue = TValue(paramType, it->second.value());
 
         valuesMap.emplace(it->first, paramValue);
@@ -27,9 +35,10 @@ std::map<std::string, TValue> TParams::TImpl::GetValues() const {
 }
 
 std::optional<TValue> TParams::TImpl::GetValue(const std::string& name) const {
-    auto it = ParamsMap_.find(name);
-    if (it != ParamsMap_.end()) {
-        auto paramType = TType(it->second.type());
+    const auto& paramsMap = GetProtoMap();
+    auto it = paramsMap.find(name);
+    if (it != paramsMap.end()) {
+        auto paramType = InternType(it->second.type());
         return TValue(paramType, it->second.value());
     }
 
@@ -37,11 +46,16 @@ std::optional<TValue> TParams::TImpl::GetValue(const std::string& name) const {
 }
 
 ::google::protobuf::Map<TStringType, Ydb::TypedValue>* TParams::TImpl::GetProtoMapPtr() {
+    if (Storage_) {
+        // Callers may swap the map out, the template storage has to stay intact for reuse
+        ParamsMap_ = *Storage_->ParamsMap;
+        Storage_.reset();
+    }
     return &ParamsMap_;
 }
 
 const ::google::protobuf::Map<TStringType, Ydb::TypedValue>& TParams::TImpl::GetProtoMap() const {
-    return ParamsMap_;
+    return Storage_ ? *Storage_->ParamsMap : ParamsMap_;
 }
 
 } // namespace NYdb
@@ -2,11 +2,24 @@
 
 #include <ydb-cpp-sdk/client/params/params.h>
 
+#include <google/protobuf/arena.h>
+
+#include <vector>
+
 namespace NYdb::inline V3 {
 
+//! Arena-backed parameters of TParamsTemplate, shared with every TParams built from them
+struct TParamsStorage {
+    google::protobuf::Arena Arena;
+    ::google::protobuf::Map<TStringType, Ydb::TypedValue>* ParamsMap = nullptr;
+    // Entries of ParamsMap by template parameter index
+    std::vector<Ydb::TypedValue*> Params;
+};
+
 class TParams::TImpl {
 public:
     TImpl(::google::protobuf::Map<TStringType, Ydb::TypedValue>&& paramsMap);
+    TImpl(std::shared_ptr<const TParamsStorage> storage);
 
     bool Empty() const;
     std::map<std::string, TValue> GetValues() const;
@@ -16,6 +29,8 @@ public:
 
 private:
     ::google::protobuf::Map<TStringType, Ydb::TypedValue> ParamsMap_;
+    // Set for params built by TParamsTemplate, ParamsMap_ is unused then
+    std::shared_ptr<const TParamsStorage> Storage_;
 };
 
 } // namespace NYdb
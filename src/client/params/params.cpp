@@ -1,5 +1,9 @@
 #include "impl.h"
 
+#define INCLUDE_YDB_INTERNAL_H
+#include <src/client/impl/internal/value_helpers/helpers.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
 #include <ydb-cpp-sdk/client/params/params.h>
 
 #include <src/api/protos/ydb_value.pb.h>
@@ -8,6 +12,9 @@
 
 #include <util/string/builder.h>
 
+#include <atomic>
+#include <unordered_map>
+
 namespace NYdb::inline V3 {
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -15,6 +22,9 @@ namespace NYdb::inline V3 {
 TParams::TParams(::google::protobuf::Map<TStringType, Ydb::TypedValue>&& protoMap)
     : Impl_(new TImpl(std::move(protoMap))) {}
 
+TParams::TParams(std::shared_ptr<TImpl> impl)
+    : Impl_(std::move(impl)) {}
+
 ::google::protobuf::Map<TStringType, Ydb::TypedValue>* TParams::GetProtoMapPtr() {
     return Impl_->GetProtoMapPtr();
 }
@@ -176,4 +186,229 @@ TParams TParamsBuilder::Build() {
     return Impl_->Build();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+class TParamsTemplate::TImpl {
+    enum class EParamState {
+        Unbound,
+        Building,
+        Bound,
+    };
+
+    struct TStorageSlot {
+        std::shared_ptr<TParamsStorage> Storage;
+        // Value builders write straight into Storage and keep their struct member maps between requests
+        std::vector<std::unique_ptr<TParamTemplateValueBuilder>> Builders;
+        // Arena usage after the first request, values replaced on reuse never return their arena memory
+        ui64 InitialSpaceUsed = 0;
+    };
+
+    // Storages still referenced by in-flight requests are kept for reuse up to this count
+    static constexpr size_t MaxPooledStorages = 16;
+    // The storage is rebuilt on a fresh arena once it outgrows the first request this many times
+    static constexpr ui64 MaxArenaGrowth = 4;
+
+public:
+    TImpl(const std::vector<std::pair<std::string, TType>>& typeInfo) {
+        Names_.reserve(typeInfo.size());
+        Types_.reserve(typeInfo.size());
+        for (const auto& [name, type] : typeInfo) {
+            if (!Indexes_.emplace(name, Names_.size()).second) {
+                FatalError(TStringBuilder() << "Duplicate parameter: " << name);
+            }
+            Names_.push_back(name);
+            Types_.push_back(type);
+        }
+        States_.assign(Names_.size(), EParamState::Unbound);
+    }
+
+    size_t ParamsCount() const {
+        return Names_.size();
+    }
+
+    size_t GetParamIndex(const std::string& name) const {
+        auto it = Indexes_.find(name);
+        if (it == Indexes_.end()) {
+            FatalError(TStringBuilder() << "Parameter not found: " << name);
+        }
+        return it->second;
+    }
+
+    TParamTemplateValueBuilder& Param(TParamsTemplate& owner, size_t index) {
+        auto& param = ResetParam(index);
+
+        auto& builder = Current_->Builders[index];
+        if (!builder) {
+            builder.reset(new TParamTemplateValueBuilder(owner, index, *param.mutable_type(), *param.mutable_value()));
+        }
+        builder->Owner_ = &owner;
+
+        States_[index] = EParamState::Building;
+        return *builder;
+    }
+
+    void Param(size_t index, const TValue& value) {
+        auto& param = ResetParam(index);
+
+        if (!TypesEqual(param.type(), value.GetType().GetProto())) {
+            FatalError(TStringBuilder() << "Type mismatch for parameter: " << Names_[index] << ", expected: "
+                << FormatType(Types_[index]) << ", actual: " << FormatType(value.GetType()));
+        }
+        param.mutable_value()->CopyFrom(value.GetProto());
+
+        States_[index] = EParamState::Bound;
+    }
+
+    void OnParamBuilt(size_t index) {
+        States_[index] = EParamState::Bound;
+    }
+
+    TParams Build() {
+        if (!Current_) {
+            StartRequest();
+        }
+
+        for (size_t i = 0; i < States_.size(); ++i) {
+            if (States_[i] == EParamState::Unbound) {
+                FatalError(TStringBuilder() << "Parameter is not bound: " << Names_[i]);
+            }
+            if (States_[i] == EParamState::Building) {
+                FatalError(TStringBuilder() << "Incomplete value for parameter: " << Names_[i]
+                    << ", call Build() on parameter value builder");
+            }
+        }
+
+        if (!Current_->InitialSpaceUsed) {
+            Current_->InitialSpaceUsed = Current_->Storage->Arena.SpaceUsed();
+        }
+
+        auto storage = Current_->Storage;
+        Current_ = nullptr;
+        return TParams(std::make_shared<TParams::TImpl>(std::move(storage)));
+    }
+
+private:
+    Ydb::TypedValue& ResetParam(size_t index) {
+        if (index >= Names_.size()) {
+            FatalError(TStringBuilder() << "Parameter index out of bounds: " << index);
+        }
+
+        if (!Current_) {
+            StartRequest();
+        }
+
+        if (States_[index] == EParamState::Building) {
+            // Abandoned in the middle of a value, the builder state can't be reused
+            Current_->Builders[index].reset();
+        }
+
+        auto& param = *Current_->Storage->Params[index];
+        param.mutable_value()->Clear();
+        return param;
+    }
+
+    void StartRequest() {
+        States_.assign(Names_.size(), EParamState::Unbound);
+
+        for (auto& slot : Pool_) {
+            if (slot->Storage.use_count() == 1) {
+                // Pairs with the release of the last TParams reference, possibly on another thread
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot->Storage->Arena.SpaceUsed() > slot->InitialSpaceUsed * MaxArenaGrowth) {
+                    ResetSlot(*slot);
+                }
+                Current_ = slot.get();
+                return;
+            }
+        }
+
+        auto slot = std::make_unique<TStorageSlot>();
+        ResetSlot(*slot);
+        if (Pool_.size() < MaxPooledStorages) {
+            Pool_.push_back(std::move(slot));
+            Current_ = Pool_.back().get();
+        } else {
+            Overflow_ = std::move(slot);
+            Current_ = Overflow_.get();
+        }
+    }
+
+    void ResetSlot(TStorageSlot& slot) {
+        auto storage = std::make_shared<TParamsStorage>();
+        storage->ParamsMap = google::protobuf::Arena::Create<::google::protobuf::Map<TStringType, Ydb::TypedValue>>(
+            &storage->Arena);
+        for (size_t i = 0; i < Names_.size(); ++i) {
+            (*storage->ParamsMap)[Names_[i]].mutable_type()->CopyFrom(Types_[i].GetProto());
+        }
+        storage->Params.reserve(Names_.size());
+        for (const auto& name : Names_) {
+            storage->Params.push_back(&storage->ParamsMap->at(name));
+        }
+
+        slot.Storage = std::move(storage);
+        slot.Builders.clear();
+        slot.Builders.resize(Names_.size());
+        slot.InitialSpaceUsed = 0;
+    }
+
+    void FatalError(const std::string& msg) const {
+        ThrowFatalError(TStringBuilder() << "TParamsTemplate: " << msg);
+    }
+
+private:
+    std::vector<std::string> Names_;
+    std::vector<TType> Types_;
+    std::unordered_map<std::string, size_t> Indexes_;
+    std::vector<EParamState> States_;
+
+    std::vector<std::unique_ptr<TStorageSlot>> Pool_;
+    std::unique_ptr<TStorageSlot> Overflow_;
+    // Slot of the request being bound, null between Build() and the next Param()
+    TStorageSlot* Current_ = nullptr;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TParamTemplateValueBuilder::TParamTemplateValueBuilder(TParamsTemplate& owner, size_t index,
+    Ydb::Type& typeProto, Ydb::Value& valueProto)
+    : TValueBuilderBase(typeProto, valueProto)
+    , Owner_(&owner)
+    , Index_(index) {}
+
+TParamsTemplate& TParamTemplateValueBuilder::Build() {
+    CheckValue();
+
+    Owner_->Impl_->OnParamBuilt(Index_);
+    return *Owner_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TParamsTemplate::TParamsTemplate(TParamsTemplate&&) = default;
+TParamsTemplate::~TParamsTemplate() = default;
+
+TParamsTemplate::TParamsTemplate(const std::vector<std::pair<std::string, TType>>& typeInfo)
+    : Impl_(new TImpl(typeInfo)) {}
+
+size_t TParamsTemplate::ParamsCount() const {
+    return Impl_->ParamsCount();
+}
+
+size_t TParamsTemplate::GetParamIndex(const std::string& name) const {
+    return Impl_->GetParamIndex(name);
+}
+
+TParamTemplateValueBuilder& TParamsTemplate::Param(size_t index) {
+    return Impl_->Param(*this, index);
+}
+
+TParamsTemplate& TParamsTemplate::Param(size_t index, const TValue& value) {
+    Impl_->Param(index, value);
+    return *this;
+}
+
+TParams TParamsTemplate::Build() {
+    return Impl_->Build();
+}
+
 } // namespace NYdb
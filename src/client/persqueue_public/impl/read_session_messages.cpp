@@ -97,11 +97,11 @@ std::string TReadSessionEvent::TDataReceivedEvent::IMessage::DebugString(bool pr
     return std::move(ret);
 }
 
-TReadSessionEvent::TDataReceivedEvent::IMessage::IMessage(const std::string& data,
+TReadSessionEvent::TDataReceivedEvent::IMessage::IMessage(std::string data,
                                                           TPartitionStream::TPtr partitionStream,
                                                           const std::string& partitionKey,
                                                           const std::string& explicitHash)
-    : Data(data)
+    : Data(std::move(data))
     , PartitionStream(partitionStream)
     , PartitionKey(partitionKey)
     , ExplicitHash(explicitHash)
@@ -152,13 +152,13 @@ void TReadSessionEvent::TDataReceivedEvent::TMessage::DebugString(TStringBuilder
     });
 }
 
-TReadSessionEvent::TDataReceivedEvent::TMessage::TMessage(const std::string& data,
+TReadSessionEvent::TDataReceivedEvent::TMessage::TMessage(std::string data,
                                                           std::exception_ptr decompressionException,
                                                           const TMessageInformation& information,
                                                           TPartitionStream::TPtr partitionStream,
                                                           const std::string& partitionKey,
                                                           const std::string& explicitHash)
-    : IMessage(data, partitionStream, partitionKey, explicitHash)
+    : IMessage(std::move(data), partitionStream, partitionKey, explicitHash)
     , DecompressionException(std::move(decompressionException))
     , Information(information)
 {
@@ -224,12 +224,12 @@ void TReadSessionEvent::TDataReceivedEvent::TCompressedMessage::DebugString(TStr
 }
 
 TReadSessionEvent::TDataReceivedEvent::TCompressedMessage::TCompressedMessage(ECodec codec,
-                                                                              const std::string& data,
+                                                                              std::string data,
                                                                               const std::vector<TMessageInformation>& information,
                                                                               TPartitionStream::TPtr partitionStream,
                                                                               const std::string& partitionKey,
                                                                               const std::string& explicitHash)
-    : IMessage(data, partitionStream, partitionKey, explicitHash)
+    : IMessage(std::move(data), partitionStream, partitionKey, explicitHash)
     , Codec(codec)
     , Information(information)
 {}
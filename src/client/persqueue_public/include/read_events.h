@@ -104,7 +104,7 @@ struct TReadSessionEvent {
             std::string DebugString(bool printData = false) const;
             virtual void DebugString(TStringBuilder& ret, bool printData = false) const = 0;
 
-            IMessage(const std::string& data,
+            IMessage(std::string data,
                      TPartitionStream::TPtr partitionStream,
                      const std::string& partitionKey,
                      const std::string& explicitHash);
@@ -147,7 +147,7 @@ struct TReadSessionEvent {
             //! Metainfo.
             const TWriteSessionMeta::TPtr& GetMeta() const;
 
-            TMessage(const std::string& data,
+            TMessage(std::string data,
                      std::exception_ptr decompressionException,
                      const TMessageInformation& information,
                      TPartitionStream::TPtr partitionStream,
@@ -198,7 +198,7 @@ struct TReadSessionEvent {
 
             virtual ~TCompressedMessage() {}
             TCompressedMessage(ECodec codec,
-                               const std::string& data,
+                               std::string data,
                                const std::vector<TMessageInformation>& information,
                                TPartitionStream::TPtr partitionStream,
                                const std::string& partitionKey,
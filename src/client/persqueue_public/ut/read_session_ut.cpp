@@ -1294,6 +1294,67 @@ Y_UNIT_TEST_SUITE(ReadSessionImplTest) {
         return result;
     }
 
+    // Payloads are moved out of the server response, they must stay intact in the events after commit
+    void ReadAndCommitImpl(Ydb::PersQueue::V1::Codec codec) {
+        TReadSessionImplTestSetup setup;
+        setup.SuccessfulInit();
+        TPartitionStream::TPtr stream = setup.CreatePartitionStream();
+
+        const std::vector<TString> sourceData = {"message1", "", GenerateMessageData(100000), "message4"};
+        TMockReadSessionProcessor::TServerReadInfo response;
+        response.PartitionData(1).Batch("src_id");
+        for (size_t i = 0; i < sourceData.size(); ++i) {
+            response.CompressMessage(i + 1, sourceData[i], codec);
+        }
+        setup.MockProcessor->AddServerResponse(response);
+
+        bool committed = false;
+        EXPECT_CALL(*setup.MockProcessor, OnCommitRequest(_))
+            .WillRepeatedly(Invoke([&](const Ydb::PersQueue::V1::MigrationStreamingReadClientMessage::Commit&) {
+                committed = true;
+            }));
+
+        std::vector<TReadSessionEvent::TEvent> events;
+        for (size_t messagesCount = 0; messagesCount < sourceData.size(); ) {
+            std::optional<TReadSessionEvent::TEvent> event = setup.EventsQueue->GetEvent(true);
+            UNIT_ASSERT(event);
+            UNIT_ASSERT_EVENT_TYPE(*event, TReadSessionEvent::TDataReceivedEvent);
+            messagesCount += std::get<TReadSessionEvent::TDataReceivedEvent>(*event).GetMessagesCount();
+            events.push_back(std::move(*event));
+        }
+
+        auto checkData = [&]() {
+            size_t i = 0;
+            for (auto& event : events) {
+                for (const auto& message : std::get<TReadSessionEvent::TDataReceivedEvent>(event).GetMessages()) {
+                    UNIT_ASSERT_VALUES_EQUAL(message.GetData(), sourceData[i++]);
+                }
+            }
+            UNIT_ASSERT_VALUES_EQUAL(i, sourceData.size());
+        };
+
+        checkData();
+        for (auto& event : events) {
+            std::get<TReadSessionEvent::TDataReceivedEvent>(event).Commit();
+        }
+        UNIT_ASSERT(committed);
+        checkData();
+
+        setup.AssertNoEvents();
+    }
+
+    Y_UNIT_TEST(ReadAndCommitRaw) {
+        ReadAndCommitImpl(Ydb::PersQueue::V1::CODEC_RAW);
+    }
+
+    Y_UNIT_TEST(ReadAndCommitGzip) {
+        ReadAndCommitImpl(Ydb::PersQueue::V1::CODEC_GZIP);
+    }
+
+    Y_UNIT_TEST(ReadAndCommitZstd) {
+        ReadAndCommitImpl(Ydb::PersQueue::V1::CODEC_ZSTD);
+    }
+
     void PacksBatchesImpl(size_t serverBatchesCount, size_t messagesInServerBatchCount, size_t messageSize, size_t batchLimit, size_t batches, size_t messagesInBatch, size_t expectedTasks = 0, size_t reorderedCycleSize = 0, size_t memoryLimit = 0) {
         if (!expectedTasks) {
             expectedTasks = serverBatchesCount;
@@ -71,7 +71,8 @@ public:
         , Settings_(settings)
         , SessionPool_(
             Settings_.SessionPoolSettings_.MaxActiveSessions_,
-            Settings_.SessionPoolSettings_.MinPoolSize_
+            Settings_.SessionPoolSettings_.MinPoolSize_,
+            Settings_.SessionPoolSettings_.ShardsCount_
         )
     {
         SetStatCollector(DbDriverState_->StatCollector.GetClientStatCollector("Query"));
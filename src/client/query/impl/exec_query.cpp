@@ -5,6 +5,7 @@
 #include <ydb-cpp-sdk/client/query/client.h>
 #include <src/client/impl/internal/make_request/make.h>
 #include <src/client/impl/session/kqp_session_common.h>
+#include <src/client/impl/internal/read_ahead/read_ahead.h>
 #include <src/client/impl/session/session_pool.h>
 #include <src/client/common_client/impl/client.h>
 #undef INCLUDE_YDB_INTERNAL_H
@@ -54,8 +55,10 @@ public:
     using TGRpcStatus = NYdbGrpc::TGrpcStatus;
     using TBatchReadResult = std::pair<TResponse, TGRpcStatus>;
 
-    TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint, const std::optional<TSession>& session)
+    TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint, const std::optional<TSession>& session,
+        const std::optional<TReadAheadSettings>& readAhead = {})
         : StreamProcessor_(streamProcessor)
+        , ReadAhead_(MakeStreamReadAhead<TResponse>(streamProcessor, readAhead))
         , Finished_(false)
         , Endpoint_(endpoint)
         , Session_(session)
@@ -107,7 +110,11 @@ public:
             }
         };
 
-        StreamProcessor_->Read(&Response_, readCb);
+        if (ReadAhead_) {
+            ReadAhead_->Read(&Response_, readCb);
+        } else {
+            StreamProcessor_->Read(&Response_, readCb);
+        }
         return promise.GetFuture();
     }
 
@@ -124,6 +131,7 @@ public:
 
 private:
     TStreamProcessorPtr StreamProcessor_;
+    std::shared_ptr<TStreamReadAhead<TResponse>> ReadAhead_;
     TResponse Response_;
     bool Finished_;
     std::string Endpoint_;
@@ -385,6 +393,7 @@ TAsyncExecuteQueryIterator TExecQueryImpl::StreamExecuteQuery(const std::shared_
     TExecuteQueryProcessorPtr processor;
 
     auto sessionCopy = session;
+    auto readAhead = settings.ReadAhead_;
 
     if (auto* txPtr = std::get_if<TTransaction>(&txControl.Tx_); txPtr && txControl.CommitTx_) {
         auto queryCopy = query;
@@ -414,7 +423,7 @@ TAsyncExecuteQueryIterator TExecQueryImpl::StreamExecuteQuery(const std::shared_
 
     co_return TExecuteQueryIterator(
         processor
-            ? std::make_shared<TExecuteQueryIterator::TReaderImpl>(processor, plainStatus.Endpoint, sessionCopy)
+            ? std::make_shared<TExecuteQueryIterator::TReaderImpl>(processor, plainStatus.Endpoint, sessionCopy, readAhead)
             : nullptr,
         std::move(plainStatus)
     );
@@ -0,0 +1,802 @@
+#include <ydb-cpp-sdk/client/result/arrow.h>
+
+#include <ydb-cpp-sdk/client/types/fatal_error_handlers/handlers.h>
+
+#include <util/string/builder.h>
+
+#include <util/generic/mapfindptr.h>
+
+#include <lz4frame.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <optional>
+
+namespace NYdb::inline V3 {
+
+const std::string& TArrowAccessor::GetSchema(const TResultSet& resultSet) {
+    return resultSet.GetArrowSchema();
+}
+
+const std::vector<std::string>& TArrowAccessor::GetBatches(const TResultSet& resultSet) {
+    return resultSet.GetBytesData();
+}
+
+namespace NArrow {
+
+namespace {
+
+// Deeper schemas are rejected instead of exhausting the stack while parsing them
+constexpr size_t MAX_FIELD_DEPTH = 64;
+
+// Compressed buffers claim their uncompressed size, which is validated before the allocation.
+// LZ4 frames can't expand more than 255 times and a zstd block of 128 KB takes at least 4 bytes
+constexpr uint64_t LZ4_MAX_RATIO = 256;
+constexpr uint64_t ZSTD_MAX_RATIO = 32768;
+constexpr uint64_t MAX_DECOMPRESSED_BUFFER_SIZE = 1ull << 30;
+
+[[noreturn]] void FatalError(const std::string& msg) {
+    ThrowFatalError(TStringBuilder() << "Arrow: " << msg);
+    Y_UNREACHABLE();
+}
+
+template <typename T>
+T ReadScalar(std::string_view buffer, size_t pos) {
+    if (pos > buffer.size() || buffer.size() - pos < sizeof(T)) {
+        FatalError(TStringBuilder() << "Corrupted message: read of " << sizeof(T) << " bytes at " << pos << " is out of bounds");
+    }
+
+    // Arrow IPC and flatbuffers are little-endian
+    T value;
+    std::memcpy(&value, buffer.data() + pos, sizeof(T));
+    return value;
+}
+
+// Minimal read-only accessor for flatbuffers tables used in Arrow IPC metadata
+class TFlatTable {
+public:
+    TFlatTable(std::string_view buffer, size_t pos)
+        : Buffer_(buffer)
+        , Pos_(pos)
+    {
+        const auto vtableOffset = ReadScalar<int32_t>(Buffer_, Pos_);
+        VTable_ = static_cast<size_t>(static_cast<int64_t>(Pos_) - vtableOffset);
+        VTableSize_ = ReadScalar<uint16_t>(Buffer_, VTable_);
+    }
+
+    static TFlatTable Root(std::string_view buffer) {
+        return TFlatTable(buffer, ReadScalar<uint32_t>(buffer, 0));
+    }
+
+    bool Has(size_t field) const {
+        return FieldOffset(field) != 0;
+    }
+
+    template <typename T>
+    T GetScalar(size_t field, T defaultValue) const {
+        const auto offset = FieldOffset(field);
+        return offset ? ReadScalar<T>(Buffer_, Pos_ + offset) : defaultValue;
+    }
+
+    std::optional<TFlatTable> GetTable(size_t field) const {
+        const auto pos = Indirect(field);
+        return pos ? std::optional<TFlatTable>(TFlatTable(Buffer_, *pos)) : std::nullopt;
+    }
+
+    std::string_view GetString(size_t field) const {
+        const auto pos = Indirect(field);
+        if (!pos) {
+            return {};
+        }
+
+        const auto size = ReadScalar<uint32_t>(Buffer_, *pos);
+        if (*pos + 4 + size > Buffer_.size()) {
+            FatalError("Corrupted message: string is out of bounds");
+        }
+        return Buffer_.substr(*pos + 4, size);
+    }
+
+    // Returns position of the first element and number of elements
+    std::pair<size_t, size_t> GetVector(size_t field, size_t elementSize) const {
+        const auto pos = Indirect(field);
+        if (!pos) {
+            return {0, 0};
+        }
+
+        const auto size = ReadScalar<uint32_t>(Buffer_, *pos);
+        if (*pos + 4 + static_cast<uint64_t>(size) * elementSize > Buffer_.size()) {
+            FatalError("Corrupted message: vector is out of bounds");
+        }
+        return {*pos + 4, size};
+    }
+
+    TFlatTable GetVectorTable(size_t elementPos) const {
+        return TFlatTable(Buffer_, elementPos + ReadScalar<uint32_t>(Buffer_, elementPos));
+    }
+
+    std::string_view GetBuffer() const {
+        return Buffer_;
+    }
+
+private:
+    uint16_t FieldOffset(size_t field) const {
+        const size_t slot = 4 + 2 * field;
+        return slot < VTableSize_ ? ReadScalar<uint16_t>(Buffer_, VTable_ + slot) : 0;
+    }
+
+    std::optional<size_t> Indirect(size_t field) const {
+        const auto offset = FieldOffset(field);
+        if (!offset) {
+            return std::nullopt;
+        }
+        return Pos_ + offset + ReadScalar<uint32_t>(Buffer_, Pos_ + offset);
+    }
+
+private:
+    std::string_view Buffer_;
+    size_t Pos_;
+    size_t VTable_;
+    uint16_t VTableSize_;
+};
+
+// Slots of Arrow IPC flatbuffers tables (union fields take two slots: type and value)
+namespace NMessage {
+    constexpr size_t HeaderType = 1;
+    constexpr size_t Header = 2;
+    constexpr size_t BodyLength = 3;
+
+    constexpr uint8_t HeaderSchema = 1;
+    constexpr uint8_t HeaderRecordBatch = 3;
+}
+
+namespace NSchema {
+    constexpr size_t Fields = 1;
+}
+
+namespace NField {
+    constexpr size_t Name = 0;
+    constexpr size_t Nullable = 1;
+    constexpr size_t TypeType = 2;
+    constexpr size_t Type = 3;
+    constexpr size_t Dictionary = 4;
+    constexpr size_t Children = 5;
+}
+
+namespace NRecordBatch {
+    constexpr size_t Length = 0;
+    constexpr size_t Nodes = 1;
+    constexpr size_t Buffers = 2;
+    constexpr size_t Compression = 3;
+}
+
+enum class ETypeTag : uint8_t {
+    Null = 1,
+    Int = 2,
+    FloatingPoint = 3,
+    Binary = 4,
+    Utf8 = 5,
+    Bool = 6,
+    Decimal = 7,
+    Date = 8,
+    Time = 9,
+    Timestamp = 10,
+    List = 12,
+    Struct = 13,
+    FixedSizeBinary = 15,
+    Duration = 18,
+    LargeBinary = 19,
+    LargeUtf8 = 20,
+};
+
+enum class ECompressionCodec : uint8_t {
+    Lz4Frame = 0,
+    Zstd = 1,
+};
+
+struct TMessage {
+    TFlatTable Metadata;
+    std::string_view Body;
+};
+
+// Encapsulated message: [0xFFFFFFFF] <int32 metadata size> <flatbuffer Message> <body>.
+// The continuation marker is absent in messages written before Arrow 0.15.
+TMessage ParseMessage(std::string_view data, uint8_t expectedHeader) {
+    size_t pos = 0;
+    auto metadataSize = ReadScalar<uint32_t>(data, pos);
+    pos += 4;
+    if (metadataSize == std::numeric_limits<uint32_t>::max()) {
+        metadataSize = ReadScalar<uint32_t>(data, pos);
+        pos += 4;
+    }
+
+    if (data.size() - pos < metadataSize) {
+        FatalError("Corrupted message: metadata is out of bounds");
+    }
+
+    auto message = TFlatTable::Root(data.substr(pos, metadataSize));
+    if (message.GetScalar<uint8_t>(NMessage::HeaderType, 0) != expectedHeader) {
+        FatalError(TStringBuilder() << "Unexpected message type " << static_cast<int>(message.GetScalar<uint8_t>(NMessage::HeaderType, 0)));
+    }
+
+    auto header = message.GetTable(NMessage::Header);
+    if (!header) {
+        FatalError("Corrupted message: no header");
+    }
+
+    pos += metadataSize;
+    const auto bodyLength = message.GetScalar<int64_t>(NMessage::BodyLength, 0);
+    if (bodyLength < 0 || data.size() - pos < static_cast<uint64_t>(bodyLength)) {
+        FatalError("Corrupted message: body is out of bounds");
+    }
+
+    return {*header, data.substr(pos, bodyLength)};
+}
+
+ETimeUnit ParseTimeUnit(int16_t unit) {
+    if (unit < 0 || unit > static_cast<int16_t>(ETimeUnit::Nanosecond)) {
+        FatalError(TStringBuilder() << "Unknown time unit " << unit);
+    }
+    return static_cast<ETimeUnit>(unit);
+}
+
+TField ParseField(const TFlatTable& table, size_t depth = 0) {
+    TField field;
+    field.Name = table.GetString(NField::Name);
+
+    if (depth >= MAX_FIELD_DEPTH) {
+        FatalError(TStringBuilder() << "Field " << field.Name << " is nested deeper than " << MAX_FIELD_DEPTH << " levels");
+    }
+    field.Nullable = table.GetScalar<uint8_t>(NField::Nullable, 0);
+
+    if (table.Has(NField::Dictionary)) {
+        FatalError(TStringBuilder() << "Dictionary encoded field " << field.Name << " is not supported");
+    }
+
+    const auto typeTag = static_cast<ETypeTag>(table.GetScalar<uint8_t>(NField::TypeType, 0));
+    const auto type = table.GetTable(NField::Type);
+    if (!type) {
+        FatalError(TStringBuilder() << "Field " << field.Name << " has no type");
+    }
+
+    switch (typeTag) {
+        case ETypeTag::Null:
+            field.Type = EType::Null;
+            break;
+        case ETypeTag::Int: {
+            const auto bitWidth = type->GetScalar<int32_t>(0, 0);
+            const bool isSigned = type->GetScalar<uint8_t>(1, 0);
+            switch (bitWidth) {
+                case 8: field.Type = isSigned ? EType::Int8 : EType::Uint8; break;
+                case 16: field.Type = isSigned ? EType::Int16 : EType::Uint16; break;
+                case 32: field.Type = isSigned ? EType::Int32 : EType::Uint32; break;
+                case 64: field.Type = isSigned ? EType::Int64 : EType::Uint64; break;
+                default:
+                    FatalError(TStringBuilder() << "Unsupported int bit width " << bitWidth);
+            }
+            field.ByteWidth = bitWidth / 8;
+            break;
+        }
+        case ETypeTag::FloatingPoint: {
+            switch (type->GetScalar<int16_t>(0, 0)) {
+                case 0: field.Type = EType::HalfFloat; field.ByteWidth = 2; break;
+                case 1: field.Type = EType::Float; field.ByteWidth = 4; break;
+                case 2: field.Type = EType::Double; field.ByteWidth = 8; break;
+                default:
+                    FatalError("Unknown floating point precision");
+            }
+            break;
+        }
+        case ETypeTag::Binary:
+            field.Type = EType::Binary;
+            break;
+        case ETypeTag::Utf8:
+            field.Type = EType::Utf8;
+            break;
+        case ETypeTag::LargeBinary:
+            field.Type = EType::LargeBinary;
+            break;
+        case ETypeTag::LargeUtf8:
+            field.Type = EType::LargeUtf8;
+            break;
+        case ETypeTag::Bool:
+            field.Type = EType::Bool;
+            break;
+        case ETypeTag::Decimal:
+            field.Type = EType::Decimal;
+            field.Precision = type->GetScalar<int32_t>(0, 0);
+            field.Scale = type->GetScalar<int32_t>(1, 0);
+            field.ByteWidth = type->GetScalar<int32_t>(2, 128) / 8;
+            break;
+        case ETypeTag::Date:
+            // DateUnit: DAY = 0, MILLISECOND = 1 (default)
+            if (type->GetScalar<int16_t>(0, 1) == 0) {
+                field.Type = EType::Date32;
+                field.ByteWidth = 4;
+            } else {
+                field.Type = EType::Date64;
+                field.ByteWidth = 8;
+            }
+            break;
+        case ETypeTag::Time:
+            field.Unit = ParseTimeUnit(type->GetScalar<int16_t>(0, 1));
+            field.ByteWidth = type->GetScalar<int32_t>(1, 32) / 8;
+            field.Type = field.ByteWidth == 4 ? EType::Time32 : EType::Time64;
+            break;
+        case ETypeTag::Timestamp:
+            field.Type = EType::Timestamp;
+            field.Unit = ParseTimeUnit(type->GetScalar<int16_t>(0, 0));
+            field.Timezone = type->GetString(1);
+            field.ByteWidth = 8;
+            break;
+        case ETypeTag::Duration:
+            field.Type = EType::Duration;
+            field.Unit = ParseTimeUnit(type->GetScalar<int16_t>(0, 1));
+            field.ByteWidth = 8;
+            break;
+        case ETypeTag::FixedSizeBinary:
+            field.Type = EType::FixedSizeBinary;
+            field.ByteWidth = type->GetScalar<int32_t>(0, 0);
+            break;
+        case ETypeTag::Struct:
+            field.Type = EType::Struct;
+            break;
+        case ETypeTag::List:
+            field.Type = EType::List;
+            break;
+        default:
+            FatalError(TStringBuilder() << "Field " << field.Name << " has unsupported type " << static_cast<int>(typeTag));
+    }
+
+    auto [childrenPos, childrenCount] = table.GetVector(NField::Children, 4);
+    field.Children.reserve(childrenCount);
+    for (size_t i = 0; i < childrenCount; ++i) {
+        field.Children.push_back(ParseField(table.GetVectorTable(childrenPos + 4 * i), depth + 1));
+    }
+
+    if (field.Type == EType::List && field.Children.size() != 1) {
+        FatalError(TStringBuilder() << "List field " << field.Name << " must have exactly one child");
+    }
+
+    return field;
+}
+
+uint64_t MaxDecompressedSize(ECompressionCodec codec, size_t compressedSize) {
+    uint64_t maxRatio = 0;
+    switch (codec) {
+        case ECompressionCodec::Zstd:
+            maxRatio = ZSTD_MAX_RATIO;
+            break;
+        case ECompressionCodec::Lz4Frame:
+            maxRatio = LZ4_MAX_RATIO;
+            break;
+        default:
+            FatalError(TStringBuilder() << "Unknown compression codec " << static_cast<int>(codec));
+    }
+    return std::min<uint64_t>(compressedSize * maxRatio, MAX_DECOMPRESSED_BUFFER_SIZE);
+}
+
+std::string Decompress(ECompressionCodec codec, std::string_view data, uint64_t uncompressedSize) {
+    if (uncompressedSize > MaxDecompressedSize(codec, data.size())) {
+        FatalError(TStringBuilder() << "Corrupted message: uncompressed buffer length " << uncompressedSize
+            << " is too large for " << data.size() << " compressed bytes");
+    }
+
+    std::string result(uncompressedSize, '\0');
+
+    switch (codec) {
+        case ECompressionCodec::Zstd: {
+            const auto size = ZSTD_decompress(result.data(), result.size(), data.data(), data.size());
+            if (ZSTD_isError(size) || size != uncompressedSize) {
+                FatalError("Failed to decompress zstd buffer");
+            }
+            break;
+        }
+        case ECompressionCodec::Lz4Frame: {
+            LZ4F_dctx* ctx = nullptr;
+            if (LZ4F_isError(LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION))) {
+                FatalError("Failed to create lz4 decompression context");
+            }
+
+            size_t dstSize = result.size();
+            size_t srcSize = data.size();
+            const auto code = LZ4F_decompress(ctx, result.data(), &dstSize, data.data(), &srcSize, nullptr);
+            LZ4F_freeDecompressionContext(ctx);
+            if (LZ4F_isError(code) || code != 0 || dstSize != uncompressedSize) {
+                FatalError("Failed to decompress lz4 frame buffer");
+            }
+            break;
+        }
+        default:
+            FatalError(TStringBuilder() << "Unknown compression codec " << static_cast<int>(codec));
+    }
+
+    return result;
+}
+
+struct TBatchReader {
+    TFlatTable Header;
+    std::string_view Body;
+
+    size_t NodesPos = 0;
+    size_t NodesCount = 0;
+    size_t NextNode = 0;
+
+    size_t BuffersPos = 0;
+    size_t BuffersCount = 0;
+    size_t NextBuffer = 0;
+
+    std::optional<ECompressionCodec> Codec = std::nullopt;
+    std::vector<std::string>* Decompressed = nullptr;
+
+    std::pair<size_t, size_t> ReadNode() {
+        if (NextNode == NodesCount) {
+            FatalError("Corrupted message: not enough field nodes");
+        }
+
+        const auto pos = NodesPos + 16 * NextNode++;
+        const auto length = ReadScalar<int64_t>(Header.GetBuffer(), pos);
+        const auto nullCount = ReadScalar<int64_t>(Header.GetBuffer(), pos + 8);
+        if (length < 0 || nullCount < 0 || nullCount > length) {
+            FatalError("Corrupted message: invalid field node");
+        }
+        return {length, nullCount};
+    }
+
+    std::string_view ReadBuffer() {
+        if (NextBuffer == BuffersCount) {
+            FatalError("Corrupted message: not enough buffers");
+        }
+
+        const auto pos = BuffersPos + 16 * NextBuffer++;
+        const auto offset = ReadScalar<int64_t>(Header.GetBuffer(), pos);
+        const auto length = ReadScalar<int64_t>(Header.GetBuffer(), pos + 8);
+        if (offset < 0 || length < 0 || static_cast<uint64_t>(offset) > Body.size() || Body.size() - offset < static_cast<uint64_t>(length)) {
+            FatalError("Corrupted message: buffer is out of bounds");
+        }
+
+        auto buffer = Body.substr(offset, length);
+        if (!Codec || buffer.empty()) {
+            return buffer;
+        }
+
+        // Compressed buffer is prefixed with uncompressed length, -1 means that buffer is stored as is
+        const auto uncompressedSize = ReadScalar<int64_t>(buffer, 0);
+        if (uncompressedSize == -1) {
+            return buffer.substr(8);
+        }
+        if (uncompressedSize < 0) {
+            FatalError("Corrupted message: invalid uncompressed buffer length");
+        }
+
+        Decompressed->push_back(Decompress(*Codec, buffer.substr(8), uncompressedSize));
+        return Decompressed->back();
+    }
+};
+
+} // namespace
+
+TSchema ParseSchema(std::string_view message) {
+    auto header = ParseMessage(message, NMessage::HeaderSchema).Metadata;
+
+    TSchema schema;
+    auto [fieldsPos, fieldsCount] = header.GetVector(NSchema::Fields, 4);
+    schema.Fields.reserve(fieldsCount);
+    for (size_t i = 0; i < fieldsCount; ++i) {
+        schema.Fields.push_back(ParseField(header.GetVectorTable(fieldsPos + 4 * i)));
+    }
+
+    return schema;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const TField& TColumnView::GetField() const {
+    return *Field_;
+}
+
+size_t TColumnView::Size() const {
+    return Size_;
+}
+
+size_t TColumnView::NullCount() const {
+    return NullCount_;
+}
+
+bool TColumnView::IsNull(size_t row) const {
+    CheckRow(row);
+    if (Field_->Type == EType::Null) {
+        return true;
+    }
+    return Validity_ && !(Validity_[row >> 3] & (1 << (row & 7)));
+}
+
+bool TColumnView::GetBool(size_t row) const {
+    if (Field_->Type != EType::Bool) {
+        FatalError(TStringBuilder() << "Column " << Field_->Name << " is not Bool");
+    }
+    CheckRow(row);
+    return Values_[row >> 3] & (1 << (row & 7));
+}
+
+std::string_view TColumnView::GetString(size_t row) const {
+    CheckRow(row);
+    if (Field_->Type == EType::FixedSizeBinary) {
+        return std::string_view(reinterpret_cast<const char*>(Values_) + row * Field_->ByteWidth, Field_->ByteWidth);
+    }
+
+    const auto begin = GetItemOffset(row);
+    const auto end = GetItemOffset(row + 1);
+    if (begin > end || end > ValuesSize_) {
+        FatalError(TStringBuilder() << "Corrupted data: invalid offsets in column " << Field_->Name);
+    }
+    return std::string_view(reinterpret_cast<const char*>(Values_) + begin, end - begin);
+}
+
+const uint8_t* TColumnView::GetValidityBitmap() const {
+    return Validity_;
+}
+
+const uint8_t* TColumnView::GetValues() const {
+    return Values_;
+}
+
+const uint8_t* TColumnView::GetOffsets() const {
+    return Offsets_;
+}
+
+size_t TColumnView::ChildrenCount() const {
+    return Children_.size();
+}
+
+const TColumnView& TColumnView::GetChild(size_t index) const {
+    if (index >= Children_.size()) {
+        FatalError(TStringBuilder() << "Child index out of bounds: " << index);
+    }
+    return Children_[index];
+}
+
+void TColumnView::CheckRow(size_t row) const {
+    if (row >= Size_) {
+        FatalError(TStringBuilder() << "Row index out of bounds: " << row << ", column " << Field_->Name << " has " << Size_ << " row(s)");
+    }
+}
+
+void TColumnView::CheckValueWidth(size_t width) const {
+    if (Field_->ByteWidth != width || Field_->Type == EType::FixedSizeBinary) {
+        FatalError(TStringBuilder() << "Column " << Field_->Name << " has value width " << Field_->ByteWidth
+            << ", but " << width << " is requested");
+    }
+}
+
+void TColumnView::CheckOffset(size_t index, size_t width) const {
+    if (!Offsets_ || (index + 1) * width > OffsetsSize_) {
+        FatalError(TStringBuilder() << "Corrupted data: offset " << index << " is out of bounds in column " << Field_->Name);
+    }
+}
+
+size_t TColumnView::GetItemOffset(size_t index) const {
+    switch (Field_->Type) {
+        case EType::Binary:
+        case EType::Utf8:
+        case EType::List: {
+            int32_t offset;
+            CheckOffset(index, sizeof(offset));
+            std::memcpy(&offset, Offsets_ + index * sizeof(offset), sizeof(offset));
+            return static_cast<uint32_t>(offset);
+        }
+        case EType::LargeBinary:
+        case EType::LargeUtf8: {
+            int64_t offset;
+            CheckOffset(index, sizeof(offset));
+            std::memcpy(&offset, Offsets_ + index * sizeof(offset), sizeof(offset));
+            return static_cast<uint64_t>(offset);
+        }
+        default:
+            FatalError(TStringBuilder() << "Column " << Field_->Name << " is not a varlen column");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TColumnViewBuilder {
+public:
+    static TColumnView Build(const TField& field, TBatchReader& reader) {
+        TColumnView column;
+        column.Field_ = &field;
+
+        std::tie(column.Size_, column.NullCount_) = reader.ReadNode();
+        if (field.Type == EType::Null) {
+            column.NullCount_ = column.Size_;
+            return column;
+        }
+
+        auto validity = reader.ReadBuffer();
+        if (column.NullCount_ != 0) {
+            if (validity.size() * 8 < column.Size_) {
+                FatalError(TStringBuilder() << "Corrupted data: validity bitmap of column " << field.Name << " is too short");
+            }
+            column.Validity_ = reinterpret_cast<const uint8_t*>(validity.data());
+        }
+
+        auto checkSize = [&](std::string_view buffer, uint64_t expected) {
+            if (buffer.size() < expected) {
+                FatalError(TStringBuilder() << "Corrupted data: buffer of column " << field.Name << " is too short");
+            }
+            return reinterpret_cast<const uint8_t*>(buffer.data());
+        };
+
+        switch (field.Type) {
+            case EType::Struct:
+                break;
+            case EType::Bool:
+                column.Values_ = checkSize(reader.ReadBuffer(), (column.Size_ + 7) / 8);
+                break;
+            case EType::Binary:
+            case EType::Utf8:
+            case EType::LargeBinary:
+            case EType::LargeUtf8:
+            case EType::List: {
+                const bool large = field.Type == EType::LargeBinary || field.Type == EType::LargeUtf8;
+                const size_t offsetWidth = large ? 8 : 4;
+                auto offsets = reader.ReadBuffer();
+                column.Offsets_ = checkSize(offsets, column.Size_ ? (column.Size_ + 1) * offsetWidth : 0);
+                column.OffsetsSize_ = offsets.size();
+                if (field.Type != EType::List) {
+                    auto data = reader.ReadBuffer();
+                    column.Values_ = reinterpret_cast<const uint8_t*>(data.data());
+                    column.ValuesSize_ = data.size();
+                }
+                break;
+            }
+            default: {
+                auto data = reader.ReadBuffer();
+                column.Values_ = checkSize(data, static_cast<uint64_t>(column.Size_) * field.ByteWidth);
+                column.ValuesSize_ = data.size();
+                break;
+            }
+        }
+
+        column.Children_.reserve(field.Children.size());
+        for (const auto& child : field.Children) {
+            column.Children_.push_back(Build(child, reader));
+        }
+
+        return column;
+    }
+};
+
+TRecordBatchView::TRecordBatchView(const TSchema& schema, std::string_view message) {
+    auto [header, body] = ParseMessage(message, NMessage::HeaderRecordBatch);
+
+    TBatchReader reader{header, body};
+    std::tie(reader.NodesPos, reader.NodesCount) = header.GetVector(NRecordBatch::Nodes, 16);
+    std::tie(reader.BuffersPos, reader.BuffersCount) = header.GetVector(NRecordBatch::Buffers, 16);
+
+    if (auto compression = header.GetTable(NRecordBatch::Compression)) {
+        reader.Codec = static_cast<ECompressionCodec>(compression->GetScalar<uint8_t>(0, 0));
+        Decompressed_ = std::make_shared<std::vector<std::string>>();
+        // Views point into decompressed strings, so they must never be reallocated
+        Decompressed_->reserve(reader.BuffersCount);
+        reader.Decompressed = Decompressed_.get();
+    }
+
+    RowsCount_ = header.GetScalar<int64_t>(NRecordBatch::Length, 0);
+
+    Columns_.reserve(schema.Fields.size());
+    for (const auto& field : schema.Fields) {
+        Columns_.push_back(TColumnViewBuilder::Build(field, reader));
+    }
+}
+
+size_t TRecordBatchView::RowsCount() const {
+    return RowsCount_;
+}
+
+size_t TRecordBatchView::ColumnsCount() const {
+    return Columns_.size();
+}
+
+const TColumnView& TRecordBatchView::GetColumn(size_t columnIndex) const {
+    if (columnIndex >= Columns_.size()) {
+        FatalError(TStringBuilder() << "Column index out of bounds: " << columnIndex);
+    }
+    return Columns_[columnIndex];
+}
+
+} // namespace NArrow
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TArrowResultSetParser::TImpl {
+public:
+    TImpl(const TResultSet& resultSet)
+        : ResultSet_(resultSet)
+    {
+        const auto& schema = TArrowAccessor::GetSchema(ResultSet_);
+        if (schema.empty()) {
+            FatalError("Result set has no Arrow schema");
+        }
+
+        Schema_ = NArrow::ParseSchema(schema);
+        for (size_t i = 0; i < Schema_.Fields.size(); ++i) {
+            ColumnIndexMap[Schema_.Fields[i].Name] = i;
+        }
+    }
+
+    const NArrow::TSchema& GetSchema() const {
+        return Schema_;
+    }
+
+    ssize_t ColumnIndex(const std::string& columnName) const {
+        auto idx = MapFindPtr(ColumnIndexMap, columnName);
+        return idx ? static_cast<ssize_t>(*idx) : -1;
+    }
+
+    size_t BatchesCount() const {
+        return TArrowAccessor::GetBatches(ResultSet_).size();
+    }
+
+    bool TryNextBatch() {
+        const auto& batches = TArrowAccessor::GetBatches(ResultSet_);
+        if (BatchIndex_ == batches.size()) {
+            return false;
+        }
+
+        Batch_ = NArrow::TRecordBatchView(Schema_, batches[BatchIndex_]);
+        BatchIndex_++;
+        return true;
+    }
+
+    const NArrow::TRecordBatchView& GetBatch() const {
+        if (BatchIndex_ == 0) {
+            FatalError("Batch position is undefined");
+        }
+        return Batch_;
+    }
+
+private:
+    void FatalError(const std::string& msg) const {
+        ThrowFatalError(TStringBuilder() << "TArrowResultSetParser: " << msg);
+    }
+
+private:
+    TResultSet ResultSet_;
+    NArrow::TSchema Schema_;
+
+    std::map<std::string, size_t> ColumnIndexMap;
+
+    size_t BatchIndex_ = 0;
+    NArrow::TRecordBatchView Batch_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TArrowResultSetParser::TArrowResultSetParser(TArrowResultSetParser&&) = default;
+TArrowResultSetParser::~TArrowResultSetParser() = default;
+
+TArrowResultSetParser::TArrowResultSetParser(const TResultSet& resultSet)
+    : Impl_(new TImpl(resultSet)) {}
+
+const NArrow::TSchema& TArrowResultSetParser::GetSchema() const {
+    return Impl_->GetSchema();
+}
+
+ssize_t TArrowResultSetParser::ColumnIndex(const std::string& columnName) const {
+    return Impl_->ColumnIndex(columnName);
+}
+
+size_t TArrowResultSetParser::BatchesCount() const {
+    return Impl_->BatchesCount();
+}
+
+bool TArrowResultSetParser::TryNextBatch() {
+    return Impl_->TryNextBatch();
+}
+
+const NArrow::TRecordBatchView& TArrowResultSetParser::GetBatch() const {
+    return Impl_->GetBatch();
+}
+
+} // namespace NYdb
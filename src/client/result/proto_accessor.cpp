@@ -8,4 +8,8 @@ const Ydb::ResultSet& TProtoAccessor::GetProto(const TResultSet& resultSet) {
     return resultSet.GetProto();
 }
 
+Ydb::ResultSet* TProtoAccessor::GetProtoPtr(TResultSet& resultSet) {
+    return &resultSet.MutableProto();
+}
+
 } // namespace NYdb
@@ -1,4 +1,9 @@
 #include <ydb-cpp-sdk/client/result/result.h>
+#include <ydb-cpp-sdk/client/result/typed_row.h>
+
+#define INCLUDE_YDB_INTERNAL_H
+#include <src/client/impl/internal/value_helpers/helpers.h>
+#undef INCLUDE_YDB_INTERNAL_H
 
 #include <ydb-cpp-sdk/client/types/fatal_error_handlers/handlers.h>
 
@@ -11,6 +16,8 @@
 
 #include <google/protobuf/text_format.h>
 
+#include <algorithm>
+
 namespace NYdb::inline V3 {
 
 std::string TColumn::ToString() const {
@@ -37,19 +44,26 @@ bool operator!=(const TColumn& col1, const TColumn& col2) {
 class TResultSet::TImpl {
 public:
     TImpl(const Ydb::ResultSet& proto)
-        : ProtoResultSet_(proto)
+        : Proto_(std::make_shared<Ydb::ResultSet>(proto))
     {
         Init(true);
     }
 
     TImpl(Ydb::ResultSet&& proto)
-        : ProtoResultSet_(std::move(proto))
+        : Proto_(std::make_shared<Ydb::ResultSet>(std::move(proto)))
     {
         Init(true);
     }
 
+    TImpl(std::shared_ptr<Ydb::ResultSet>&& proto)
+        : Proto_(std::move(proto))
+    {
+        // The proto may be shared with other result sets of the same response, so it is never modified
+        Init(true, false);
+    }
+
     TImpl(const Ydb::ResultSet& proto, const std::string& arrowSchema, const std::vector<std::string>& bytesData)
-        : ProtoResultSet_(proto)
+        : Proto_(std::make_shared<Ydb::ResultSet>(proto))
         , ArrowSchema_(arrowSchema)
         , BytesData_(bytesData)
     {
@@ -57,33 +71,43 @@ public:
     }
 
     TImpl(Ydb::ResultSet&& proto, std::string&& arrowSchema, std::vector<std::string>&& bytesData)
-        : ProtoResultSet_(std::move(proto))
+        : Proto_(std::make_shared<Ydb::ResultSet>(std::move(proto)))
         , ArrowSchema_(std::move(arrowSchema))
         , BytesData_(std::move(bytesData))
     {
         Init(false);
     }
 
-    void Init(bool extractArrowResult) {
-        ColumnsMeta_.reserve(ProtoResultSet_.columns_size());
-        for (auto& meta : ProtoResultSet_.columns()) {
-            ColumnsMeta_.push_back(TColumn(meta.name(), TType(meta.type())));
+    // Everything is initialized in the constructor, so copies sharing the impl only read it
+    void Init(bool extractArrowResult, bool ownsProto = true) {
+        ColumnsMeta_.reserve(Proto_->columns_size());
+        for (auto& meta : Proto_->columns()) {
+            ColumnsMeta_.push_back(TColumn(meta.name(), InternType(meta.type())));
         }
 
-        auto format = static_cast<EFormat>(ProtoResultSet_.format());
+        auto format = static_cast<EFormat>(Proto_->format());
         if (format == EFormat::Arrow && extractArrowResult) {
-            if (ProtoResultSet_.has_arrow_format_meta() && ArrowSchema_.empty()) {
-                ArrowSchema_ = std::move(*ProtoResultSet_.mutable_arrow_format_meta()->mutable_schema());
+            if (Proto_->has_arrow_format_meta() && ArrowSchema_.empty()) {
+                if (ownsProto) {
+                    ArrowSchema_ = std::move(*Proto_->mutable_arrow_format_meta()->mutable_schema());
+                } else {
+                    ArrowSchema_ = Proto_->arrow_format_meta().schema();
+                }
             }
 
-            if (auto* data = ProtoResultSet_.mutable_data(); data && !data->empty()) {
-                BytesData_.push_back(std::move(*data));
+            if (!Proto_->data().empty()) {
+                if (ownsProto) {
+                    BytesData_.push_back(std::move(*Proto_->mutable_data()));
+                } else {
+                    BytesData_.push_back(Proto_->data());
+                }
             }
         }
     }
 
 public:
-    Ydb::ResultSet ProtoResultSet_;
+    // Either owned by this result set only or shared with the response message it was received in
+    std::shared_ptr<Ydb::ResultSet> Proto_;
     std::vector<TColumn> ColumnsMeta_;
 
     std::string ArrowSchema_;
@@ -98,6 +122,9 @@ TResultSet::TResultSet(const Ydb::ResultSet& proto)
 TResultSet::TResultSet(Ydb::ResultSet&& proto)
     : Impl_(new TResultSet::TImpl(std::move(proto))) {}
 
+TResultSet::TResultSet(std::shared_ptr<Ydb::ResultSet> proto)
+    : Impl_(new TResultSet::TImpl(std::move(proto))) {}
+
 TResultSet::TResultSet(const Ydb::ResultSet& proto, const std::string& arrowSchema, const std::vector<std::string>& bytesData)
     : Impl_(new TResultSet::TImpl(proto, arrowSchema, bytesData)) {}
 
@@ -109,11 +136,11 @@ size_t TResultSet::ColumnsCount() const {
 }
 
 size_t TResultSet::RowsCount() const {
-    return Impl_->ProtoResultSet_.rows_size();
+    return Impl_->Proto_->rows_size();
 }
 
 bool TResultSet::Truncated() const {
-    return Impl_->ProtoResultSet_.truncated();
+    return Impl_->Proto_->truncated();
 }
 
 const std::vector<TColumn>& TResultSet::GetColumnsMeta() const {
@@ -121,15 +148,15 @@ const std::vector<TColumn>& TResultSet::GetColumnsMeta() const {
 }
 
 const Ydb::ResultSet& TResultSet::GetProto() const {
-    return Impl_->ProtoResultSet_;
+    return *Impl_->Proto_;
 }
 
 Ydb::ResultSet& TResultSet::MutableProto() {
-    return Impl_->ProtoResultSet_;
+    return *Impl_->Proto_;
 }
 
 TResultSet::EFormat TResultSet::Format() const {
-    return static_cast<EFormat>(Impl_->ProtoResultSet_.format());
+    return static_cast<EFormat>(Impl_->Proto_->format());
 }
 
 const std::string& TResultSet::GetArrowSchema() const {
@@ -230,7 +257,71 @@ public:
         return GetValue(*idx);
     }
 
+    template <typename T, typename TExtractor>
+    TColumnValues<T> GetColumn(size_t columnIndex, std::initializer_list<EPrimitiveType> primitiveTypes,
+        Ydb::Value::ValueCase valueCase, TExtractor&& extractor) const
+    {
+        const bool optional = CheckColumnType(columnIndex, primitiveTypes);
+
+        const auto& rows = ResultSet_.GetProto().rows();
+        const size_t rowsCount = rows.size();
+
+        TColumnValues<T> result;
+        result.Values.resize(rowsCount);
+        result.Nulls.resize(rowsCount);
+
+        for (size_t rowIndex = 0; rowIndex < rowsCount; ++rowIndex) {
+            const auto& row = rows[rowIndex];
+            if (static_cast<size_t>(row.items_size()) != ColumnsCount()) {
+                FatalError(TStringBuilder() << "Corrupted data: row " << rowIndex << " contains " << row.items_size() << " column(s), but metadata contains " << ColumnsCount() << " column(s)");
+            }
+
+            const auto& item = row.items(columnIndex);
+            if (item.value_case() == valueCase) {
+                result.Values[rowIndex] = extractor(item);
+            } else if (optional && item.value_case() == Ydb::Value::kNestedValue
+                && item.nested_value().value_case() == valueCase)
+            {
+                // Optional value may be wrapped, as TValueParser::OpenOptional accepts
+                result.Values[rowIndex] = extractor(item.nested_value());
+            } else if (optional && item.value_case() == Ydb::Value::kNullFlagValue) {
+                result.Nulls[rowIndex] = true;
+            } else {
+                FatalError(TStringBuilder() << "Corrupted data: unexpected value in row " << rowIndex << ", column " << columnIndex);
+            }
+        }
+
+        return result;
+    }
+
 private:
+    // Returns true if column is optional
+    bool CheckColumnType(size_t columnIndex, std::initializer_list<EPrimitiveType> primitiveTypes) const {
+        if (columnIndex >= ColumnParsers.size()) {
+            FatalError(TStringBuilder() << "Column index out of bounds: " << columnIndex);
+        }
+
+        const auto& column = ResultSet_.GetColumnsMeta()[columnIndex];
+        const Ydb::Type* type = &column.Type.GetProto();
+
+        bool optional = false;
+        if (type->type_case() == Ydb::Type::kOptionalType) {
+            optional = true;
+            type = &type->optional_type().item();
+        }
+
+        if (type->type_case() == Ydb::Type::kTypeId) {
+            for (auto primitiveType : primitiveTypes) {
+                if (static_cast<EPrimitiveType>(type->type_id()) == primitiveType) {
+                    return optional;
+                }
+            }
+        }
+
+        FatalError(TStringBuilder() << "Column " << column.Name << " has unexpected type " << column.Type);
+        return false;
+    }
+
     void FatalError(const std::string& msg) const {
         ThrowFatalError(TStringBuilder() << "TResultSetParser: " << msg);
     }
@@ -284,4 +375,101 @@ TValue TResultSetParser::GetValue(const std::string& columnName) const {
     return Impl_->GetValue(columnName);
 }
 
+TColumnValues<bool> TResultSetParser::GetBoolColumn(size_t columnIndex) const {
+    return Impl_->GetColumn<bool>(columnIndex, {EPrimitiveType::Bool}, Ydb::Value::kBoolValue,
+        [](const Ydb::Value& value) { return value.bool_value(); });
+}
+
+TColumnValues<int32_t> TResultSetParser::GetInt32Column(size_t columnIndex) const {
+    return Impl_->GetColumn<int32_t>(columnIndex,
+        {EPrimitiveType::Int8, EPrimitiveType::Int16, EPrimitiveType::Int32, EPrimitiveType::Date32},
+        Ydb::Value::kInt32Value,
+        [](const Ydb::Value& value) { return value.int32_value(); });
+}
+
+TColumnValues<uint32_t> TResultSetParser::GetUint32Column(size_t columnIndex) const {
+    return Impl_->GetColumn<uint32_t>(columnIndex,
+        {EPrimitiveType::Uint8, EPrimitiveType::Uint16, EPrimitiveType::Uint32, EPrimitiveType::Date, EPrimitiveType::Datetime},
+        Ydb::Value::kUint32Value,
+        [](const Ydb::Value& value) { return value.uint32_value(); });
+}
+
+TColumnValues<int64_t> TResultSetParser::GetInt64Column(size_t columnIndex) const {
+    return Impl_->GetColumn<int64_t>(columnIndex,
+        {EPrimitiveType::Int64, EPrimitiveType::Interval, EPrimitiveType::Datetime64, EPrimitiveType::Timestamp64, EPrimitiveType::Interval64},
+        Ydb::Value::kInt64Value,
+        [](const Ydb::Value& value) { return value.int64_value(); });
+}
+
+TColumnValues<uint64_t> TResultSetParser::GetUint64Column(size_t columnIndex) const {
+    return Impl_->GetColumn<uint64_t>(columnIndex, {EPrimitiveType::Uint64, EPrimitiveType::Timestamp},
+        Ydb::Value::kUint64Value,
+        [](const Ydb::Value& value) { return value.uint64_value(); });
+}
+
+TColumnValues<float> TResultSetParser::GetFloatColumn(size_t columnIndex) const {
+    return Impl_->GetColumn<float>(columnIndex, {EPrimitiveType::Float}, Ydb::Value::kFloatValue,
+        [](const Ydb::Value& value) { return value.float_value(); });
+}
+
+TColumnValues<double> TResultSetParser::GetDoubleColumn(size_t columnIndex) const {
+    return Impl_->GetColumn<double>(columnIndex, {EPrimitiveType::Double}, Ydb::Value::kDoubleValue,
+        [](const Ydb::Value& value) { return value.double_value(); });
+}
+
+TColumnValues<std::string_view> TResultSetParser::GetStringColumn(size_t columnIndex) const {
+    return Impl_->GetColumn<std::string_view>(columnIndex, {EPrimitiveType::String, EPrimitiveType::Yson},
+        Ydb::Value::kBytesValue,
+        [](const Ydb::Value& value) { return std::string_view(value.bytes_value()); });
+}
+
+TColumnValues<std::string_view> TResultSetParser::GetUtf8Column(size_t columnIndex) const {
+    return Impl_->GetColumn<std::string_view>(columnIndex,
+        {EPrimitiveType::Utf8, EPrimitiveType::Json, EPrimitiveType::JsonDocument, EPrimitiveType::DyNumber},
+        Ydb::Value::kTextValue,
+        [](const Ydb::Value& value) { return std::string_view(value.text_value()); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TTypedResultSetParserBase::TTypedResultSetParserBase(const TResultSet& resultSet, const TType& rowType)
+    : ResultSet_(resultSet)
+{
+    const auto& columns = ResultSet_.GetColumnsMeta();
+    for (const auto& member : rowType.GetProto().struct_type().members()) {
+        auto column = std::find_if(columns.begin(), columns.end(), [&member](const TColumn& column) {
+            return column.Name == member.name();
+        });
+        if (column == columns.end()) {
+            ThrowFatalError(TStringBuilder() << "TTypedResultSetParser: unknown column: " << member.name());
+        }
+
+        const bool typesEqual = TypesEqual(member.type(), column->Type.GetProto())
+            || (member.type().has_optional_type() && TypesEqual(member.type().optional_type().item(), column->Type.GetProto()));
+        if (!typesEqual) {
+            ThrowFatalError(TStringBuilder() << "TTypedResultSetParser: column " << column->Name
+                << " has type " << column->Type << ", but the row member has type " << TType(member.type()));
+        }
+        ColumnIndexes_.push_back(column - columns.begin());
+    }
+}
+
+const Ydb::Value* TTypedResultSetParserBase::NextRow() {
+    const auto& rows = ResultSet_.GetProto().rows();
+    if (RowIndex_ == static_cast<size_t>(rows.size())) {
+        return nullptr;
+    }
+
+    const auto& row = rows[RowIndex_++];
+    if (static_cast<size_t>(row.items_size()) != ResultSet_.ColumnsCount()) {
+        ThrowFatalError(TStringBuilder() << "TTypedResultSetParser: corrupted data: row " << RowIndex_ - 1 << " contains "
+            << row.items_size() << " column(s), but metadata contains " << ResultSet_.ColumnsCount() << " column(s)");
+    }
+    return &row;
+}
+
+size_t TTypedResultSetParserBase::RowsCount() const {
+    return ResultSet_.RowsCount();
+}
+
 } // namespace NYdb
@@ -0,0 +1,269 @@
+#include <ydb-cpp-sdk/client/table/table.h>
+#include <ydb-cpp-sdk/client/types/fatal_error_handlers/handlers.h>
+
+#include <src/api/protos/ydb_value.pb.h>
+
+#include <google/protobuf/arena.h>
+
+#include <deque>
+#include <mutex>
+#include <set>
+
+namespace NYdb::inline V3 {
+namespace NTable {
+
+using namespace NThreading;
+
+class TBulkUpsertWriter::TImpl : public std::enable_shared_from_this<TImpl> {
+    struct TBatch {
+        uint64_t SeqNo = 0;
+        std::unique_ptr<google::protobuf::Arena> Arena;
+        Ydb::Value* Rows = nullptr;
+        size_t RowsCount = 0;
+        uint64_t Bytes = 0;
+    };
+
+    struct TFlushWaiter {
+        uint64_t SeqNo;
+        TPromise<TStatus> Promise;
+    };
+
+public:
+    TImpl(const TTableClient& client, const std::string& table, const TBulkUpsertWriterSettings& settings)
+        : Client_(client)
+        , Table_(table)
+        , Settings_(settings)
+    {}
+
+    TFuture<void> AddRow(const TValue& row) {
+        std::vector<std::shared_ptr<TBatch>> toSend;
+        TFuture<void> result;
+        {
+            std::lock_guard lock(Lock_);
+            if (Closed_) {
+                ThrowFatalError("Attempt to add a row to a closed TBulkUpsertWriter");
+            }
+            if (!Error_) {
+                if (!ListType_) {
+                    Ydb::Type listType;
+                    *listType.mutable_list_type()->mutable_item() = row.GetType().GetProto();
+                    ListType_ = TType(std::move(listType));
+                }
+                if (!Current_) {
+                    Current_ = NewBatch();
+                }
+
+                *Current_->Rows->add_items() = row.GetProto();
+                ++Current_->RowsCount;
+                Current_->Bytes += row.GetProto().ByteSizeLong();
+
+                if (Current_->RowsCount >= Settings_.MaxBatchRows_ || Current_->Bytes >= Settings_.MaxBatchBytes_) {
+                    Seal();
+                    toSend = PickBatchesToSend();
+                }
+            }
+            result = GetCapacityFuture();
+        }
+        for (auto& batch : toSend) {
+            Send(std::move(batch));
+        }
+        return result;
+    }
+
+    TAsyncStatus Flush() {
+        std::vector<std::shared_ptr<TBatch>> toSend;
+        TAsyncStatus result;
+        {
+            std::lock_guard lock(Lock_);
+            if (Current_ && !Error_) {
+                Seal();
+                toSend = PickBatchesToSend();
+            }
+            if (Outstanding_.empty() || Error_) {
+                result = MakeFuture(GetStatus());
+            } else {
+                auto promise = NewPromise<TStatus>();
+                result = promise.GetFuture();
+                FlushWaiters_.push_back(TFlushWaiter{NextSeqNo_ - 1, std::move(promise)});
+            }
+        }
+        for (auto& batch : toSend) {
+            Send(std::move(batch));
+        }
+        return result;
+    }
+
+    TAsyncStatus Close() {
+        {
+            std::lock_guard lock(Lock_);
+            Closed_ = true;
+        }
+        return Flush();
+    }
+
+private:
+    // Must be called under the lock
+    std::shared_ptr<TBatch> NewBatch() {
+        auto batch = std::make_shared<TBatch>();
+        if (FreeArenas_.empty()) {
+            batch->Arena = std::make_unique<google::protobuf::Arena>();
+        } else {
+            batch->Arena = std::move(FreeArenas_.back());
+            FreeArenas_.pop_back();
+        }
+        batch->Rows = google::protobuf::Arena::CreateMessage<Ydb::Value>(batch->Arena.get());
+        return batch;
+    }
+
+    // Must be called under the lock
+    void Seal() {
+        Current_->SeqNo = NextSeqNo_++;
+        Outstanding_.insert(Current_->SeqNo);
+        Queue_.push_back(std::move(Current_));
+        Current_.reset();
+    }
+
+    // Must be called under the lock
+    std::vector<std::shared_ptr<TBatch>> PickBatchesToSend() {
+        std::vector<std::shared_ptr<TBatch>> result;
+        while (!Queue_.empty() && InFlight_ < std::max<size_t>(Settings_.MaxInFlight_, 1)) {
+            result.push_back(std::move(Queue_.front()));
+            Queue_.pop_front();
+            ++InFlight_;
+        }
+        return result;
+    }
+
+    // Must be called under the lock
+    TFuture<void> GetCapacityFuture() {
+        if (Queue_.empty() || Error_) {
+            return MakeFuture();
+        }
+        if (!CapacityPromise_) {
+            CapacityPromise_ = NewPromise<void>();
+        }
+        return CapacityPromise_->GetFuture();
+    }
+
+    // Must be called under the lock
+    TStatus GetStatus() const {
+        return Error_ ? *Error_ : TStatus(EStatus::SUCCESS, {});
+    }
+
+    void Send(std::shared_ptr<TBatch> batch) {
+        auto settings = Settings_.BulkUpsertSettings_;
+        settings.Arena(batch->Arena.get());
+
+        // Request is copied from the batch on every attempt, so the batch is kept intact for retries
+        TValue rows(ListType_.value(), batch->Rows);
+        auto operation = [table = Table_, rows, settings](TTableClient& client) {
+            TValue value = rows;
+            return client.BulkUpsert(table, std::move(value), settings);
+        };
+
+        auto self = shared_from_this();
+        Client_.RetryOperation<TBulkUpsertResult>(std::move(operation), Settings_.RetrySettings_)
+            .Subscribe([self, batch](const TAsyncStatus& future) mutable {
+                self->OnBatchDone(std::move(batch), future.GetValue());
+            });
+    }
+
+    void OnBatchDone(std::shared_ptr<TBatch> batch, const TStatus& status) {
+        std::vector<std::shared_ptr<TBatch>> toSend;
+        std::vector<std::pair<TPromise<TStatus>, TStatus>> flushed;
+        std::optional<TPromise<void>> capacity;
+        {
+            std::lock_guard lock(Lock_);
+            --InFlight_;
+            Outstanding_.erase(batch->SeqNo);
+
+            if (!status.IsSuccess() && !Error_) {
+                Error_ = status;
+                for (auto& queued : Queue_) {
+                    Outstanding_.erase(queued->SeqNo);
+                }
+                Queue_.clear();
+                Current_.reset();
+            }
+
+            batch->Rows = nullptr;
+            batch->Arena->Reset();
+            if (FreeArenas_.size() < std::max<size_t>(Settings_.MaxInFlight_, 1)) {
+                FreeArenas_.push_back(std::move(batch->Arena));
+            }
+
+            toSend = PickBatchesToSend();
+
+            while (!FlushWaiters_.empty()) {
+                auto& waiter = FlushWaiters_.front();
+                if (!Error_ && !Outstanding_.empty() && *Outstanding_.begin() <= waiter.SeqNo) {
+                    break;
+                }
+                flushed.emplace_back(std::move(waiter.Promise), GetStatus());
+                FlushWaiters_.pop_front();
+            }
+
+            if (CapacityPromise_ && (Queue_.empty() || Error_)) {
+                capacity = std::move(CapacityPromise_);
+                CapacityPromise_.reset();
+            }
+        }
+
+        for (auto& next : toSend) {
+            Send(std::move(next));
+        }
+        for (auto& [promise, flushStatus] : flushed) {
+            promise.SetValue(std::move(flushStatus));
+        }
+        if (capacity) {
+            capacity->SetValue();
+        }
+    }
+
+private:
+    TTableClient Client_;
+    const std::string Table_;
+    const TBulkUpsertWriterSettings Settings_;
+
+    std::mutex Lock_;
+    std::optional<TType> ListType_;
+    std::shared_ptr<TBatch> Current_;
+    // Sealed batches waiting for a free in-flight slot
+    std::deque<std::shared_ptr<TBatch>> Queue_;
+    std::vector<std::unique_ptr<google::protobuf::Arena>> FreeArenas_;
+    size_t InFlight_ = 0;
+
+    uint64_t NextSeqNo_ = 1;
+    // Sealed batches which are not finished yet
+    std::set<uint64_t> Outstanding_;
+    std::deque<TFlushWaiter> FlushWaiters_;
+    std::optional<TPromise<void>> CapacityPromise_;
+    std::optional<TStatus> Error_;
+    bool Closed_ = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TBulkUpsertWriter::TBulkUpsertWriter(const TTableClient& client, const std::string& table,
+    const TBulkUpsertWriterSettings& settings)
+    : Impl_(std::make_shared<TImpl>(client, table, settings))
+{}
+
+TBulkUpsertWriter::~TBulkUpsertWriter() {
+    Impl_->Close();
+}
+
+TFuture<void> TBulkUpsertWriter::AddRow(const TValue& row) {
+    return Impl_->AddRow(row);
+}
+
+TAsyncStatus TBulkUpsertWriter::Flush() {
+    return Impl_->Flush();
+}
+
+TAsyncStatus TBulkUpsertWriter::Close() {
+    return Impl_->Close();
+}
+
+} // namespace NTable
+} // namespace NYdb
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <ydb-cpp-sdk/client/table/table.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace NYdb::inline V3 {
+namespace NTable {
+
+//! Stream of the parts of one key range. In the client it is a ReadTable stream on a session of its own,
+//! opened by the first ReadNext. Failures of the opening are returned as failed parts.
+class IKeyRangeStream {
+public:
+    using TPtr = std::shared_ptr<IKeyRangeStream>;
+
+    virtual ~IKeyRangeStream() = default;
+
+    //! Called again only after the previous part is received
+    virtual TAsyncSimpleStreamPart<TResultSet> ReadNext() = 0;
+};
+
+using TKeyRangeStreamFactory = std::function<IKeyRangeStream::TPtr(const TKeyRange& range)>;
+
+//! Reads the key ranges with at most MaxConcurrentReaders streams at a time, see TParallelTablePartIterator.
+//! Streams are released when their range is finished, all of them after the first failed part
+//! and on destruction of the reader, which cancels the reads in flight.
+class TParallelTablePartIterator::TReaderImpl : public std::enable_shared_from_this<TReaderImpl> {
+    using TPart = TSimpleStreamPart<TResultSet>;
+
+    struct TPartition {
+        TKeyRange Range;
+        IKeyRangeStream::TPtr Stream;
+        std::deque<TPart> Parts;
+        bool Finished = false;
+        bool Paused = false;
+    };
+
+public:
+    TReaderImpl(TKeyRangeStreamFactory factory, const TReadTableParallelSettings& settings,
+        const std::vector<TKeyRange>& ranges);
+
+    void Start();
+
+    TAsyncSimpleStreamPart<TResultSet> ReadNext();
+
+    TReadTableParallelProgress GetProgress() const;
+
+private:
+    void StartPartition(size_t index);
+    void ReadPartition(size_t index);
+    void OnPart(size_t index, TPart&& part);
+
+    // Must be called under the lock
+    std::vector<size_t> PickPartitionsToStart();
+    std::vector<size_t> PickPartitionsToResume();
+    bool CanRead(size_t index) const;
+    void AdvanceHead();
+    std::optional<TPart> PopPart();
+    void Deliver();
+
+    void SetWaiters();
+
+private:
+    const TKeyRangeStreamFactory Factory_;
+    const TReadTableParallelSettings Settings_;
+
+    mutable std::mutex Lock_;
+    std::vector<TPartition> Partitions_;
+    size_t NextToStart_ = 0;
+    size_t ActiveReaders_ = 0;
+    size_t Head_ = 0;
+    // Partition of every buffered part in order of arrival, unordered mode only
+    std::deque<size_t> ReadyOrder_;
+    std::optional<TPart> Error_;
+    TReadTableParallelProgress Progress_;
+
+    std::deque<NThreading::TPromise<TPart>> Waiters_;
+    std::vector<std::pair<NThreading::TPromise<TPart>, TPart>> Ready_;
+};
+
+using TReadRowsFunc = std::function<TAsyncReadRowsResult(TValue&& keys)>;
+
+//! Splits the list of keys into lists of at most maxKeysPerChunk keys
+std::vector<TValue> SplitKeys(TValue&& keys, size_t maxKeysPerChunk);
+
+//! Reads the chunks with at most maxConcurrentRequests requests at a time and concatenates their rows in chunk order.
+//! The first failed request fails the whole read, no more requests are sent then.
+TAsyncReadRowsResult ReadRowsInChunks(TReadRowsFunc readRows, std::vector<TValue>&& chunks, size_t maxConcurrentRequests);
+
+} // namespace NTable
+} // namespace NYdb
@@ -9,8 +9,10 @@ namespace NTable {
 using namespace NThreading;
 
 
-TTablePartIterator::TReaderImpl::TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint)
+TTablePartIterator::TReaderImpl::TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint,
+    const std::optional<TReadAheadSettings>& readAhead)
     : StreamProcessor_(streamProcessor)
+    , ReadAhead_(MakeStreamReadAhead<TResponse>(streamProcessor, readAhead))
     , Finished_(false)
     , Endpoint_(endpoint)
 {}
@@ -47,14 +49,20 @@ TAsyncSimpleStreamPart<TResultSet> TTablePartIterator::TReaderImpl::ReadNext(std
                             snapshot});
         }
     };
-    StreamProcessor_->Read(&Response_, readCb);
+    if (ReadAhead_) {
+        ReadAhead_->Read(&Response_, readCb);
+    } else {
+        StreamProcessor_->Read(&Response_, readCb);
+    }
     return promise.GetFuture();
 }
 
 
 
-TScanQueryPartIterator::TReaderImpl::TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint)
+TScanQueryPartIterator::TReaderImpl::TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint,
+    const std::optional<TReadAheadSettings>& readAhead)
     : StreamProcessor_(streamProcessor)
+    , ReadAhead_(MakeStreamReadAhead<TResponse>(streamProcessor, readAhead))
     , Finished_(false)
     , Endpoint_(endpoint)
 {}
@@ -104,7 +112,11 @@ TAsyncScanQueryPart TScanQueryPartIterator::TReaderImpl::ReadNext(std::shared_pt
             }
         }
     };
-    StreamProcessor_->Read(&Response_, readCb);
+    if (ReadAhead_) {
+        ReadAhead_->Read(&Response_, readCb);
+    } else {
+        StreamProcessor_->Read(&Response_, readCb);
+    }
     return promise.GetFuture();
 }
 
@@ -2,6 +2,10 @@
 
 #include <ydb-cpp-sdk/client/resources/ydb_resources.h>
 
+#define INCLUDE_YDB_INTERNAL_H
+#include <src/client/impl/internal/read_ahead/read_ahead.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
 #include <src/api/grpc/ydb_table_v1.grpc.pb.h>
 #include <ydb-cpp-sdk/client/proto/accessor.h>
 
@@ -27,13 +31,15 @@ public:
     using TGRpcStatus = NYdbGrpc::TGrpcStatus;
     using TBatchReadResult = std::pair<TResponse, TGRpcStatus>;
 
-    TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint);
+    TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint,
+        const std::optional<TReadAheadSettings>& readAhead = {});
     ~TReaderImpl();
     bool IsFinished();
     TAsyncSimpleStreamPart<TResultSet> ReadNext(std::shared_ptr<TSelf> self);
 
 private:
     TStreamProcessorPtr StreamProcessor_;
+    std::shared_ptr<TStreamReadAhead<TResponse>> ReadAhead_;
     TResponse Response_;
     bool Finished_;
     std::string Endpoint_;
@@ -49,13 +55,15 @@ public:
     using TGRpcStatus = NYdbGrpc::TGrpcStatus;
     using TBatchReadResult = std::pair<TResponse, TGRpcStatus>;
 
-    TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint);
+    TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint,
+        const std::optional<TReadAheadSettings>& readAhead = {});
     ~TReaderImpl();
     bool IsFinished() const;
     TAsyncScanQueryPart ReadNext(std::shared_ptr<TSelf> self);
 
 private:
     TStreamProcessorPtr StreamProcessor_;
+    std::shared_ptr<TStreamReadAhead<TResponse>> ReadAhead_;
     TResponse Response_;
     bool Finished_;
     std::string Endpoint_;
@@ -22,7 +22,8 @@ TTableClient::TImpl::TImpl(std::shared_ptr<TGRpcConnectionsImpl>&& connections,
     , Settings_(settings)
     , SessionPool_(
         Settings_.SessionPoolSettings_.MaxActiveSessions_,
-        Settings_.SessionPoolSettings_.MinPoolSize_
+        Settings_.SessionPoolSettings_.MinPoolSize_,
+        Settings_.SessionPoolSettings_.ShardsCount_
     )
 {
     auto clientCollector = DbDriverState_->StatCollector.GetClientStatCollector("Table");
@@ -271,7 +272,8 @@ void TTableClient::TImpl::StartPeriodicHostScanTask() {
             std::unordered_map<ui64, size_t> hostMap;
 
             winner = ScanLocation(strongClient, hostMap,
-            balancingPolicy == TBalancingPolicy::TImpl::EPolicyType::UseAllNodes);
+            balancingPolicy == TBalancingPolicy::TImpl::EPolicyType::UseAllNodes
+                || balancingPolicy == TBalancingPolicy::TImpl::EPolicyType::UseLeastLoadedNodes);
 
             bool forceMigrate = false;
 
@@ -1062,16 +1064,19 @@ TAsyncReadRowsResult TTableClient::TImpl::ReadRows(const std::string& path, TVal
     auto promise = NewPromise<TReadRowsResult>();
 
     auto responseCb = [promise] (Ydb::Table::ReadRowsResponse* response, TPlainStatus status) mutable {
-        Ydb::ResultSet resultSet;
+        auto resultSet = std::make_shared<Ydb::ResultSet>();
         // if there is no response status contains transport errors
         if (response) {
             Ydb::StatusIds::StatusCode msgStatus = response->status();
             NYdb::NIssue::TIssues issues;
             NYdb::NIssue::IssuesFromMessage(response->issues(), issues);
             status = TPlainStatus(static_cast<EStatus>(msgStatus), std::move(issues));
-            resultSet = std::move(*response->mutable_result_set());
+            // Swap exchanges pointers only when both messages are on the same arena (or both on the heap)
+            // and deep-copies otherwise. Replies of TSimpleRequestProcessor are plain members, not arena
+            // allocated, so this is a pointer swap with the heap allocated result set
+            resultSet->Swap(response->mutable_result_set());
         }
-        TReadRowsResult val(TStatus(std::move(status)), std::move(resultSet));
+        TReadRowsResult val(TStatus(std::move(status)), TResultSet(std::move(resultSet)));
         promise.SetValue(std::move(val));
     };
 
@@ -1311,14 +1316,14 @@ TAsyncScanQueryPartIterator TTableClient::TImpl::StreamExecuteScanQuery(const st
 {
     auto promise = NewPromise<TScanQueryPartIterator>();
 
-    auto iteratorCallback = [promise](TFuture<std::pair<TPlainStatus,
+    auto iteratorCallback = [promise, readAhead = settings.ReadAhead_](TFuture<std::pair<TPlainStatus,
         TTableClient::TImpl::TScanQueryProcessorPtr>> future) mutable
     {
         Y_ASSERT(future.HasValue());
         auto pair = future.ExtractValue();
         promise.SetValue(TScanQueryPartIterator(
             pair.second
-                ? std::make_shared<TScanQueryPartIterator::TReaderImpl>(pair.second, pair.first.Endpoint)
+                ? std::make_shared<TScanQueryPartIterator::TReaderImpl>(pair.second, pair.first.Endpoint, readAhead)
                 : nullptr,
             std::move(pair.first))
         );
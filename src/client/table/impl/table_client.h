@@ -267,11 +267,15 @@ private:
 
                 auto queryText = GetQueryText(query);
                 if (any) {
-                    Ydb::Table::ExecuteQueryResult result;
+                    // Result sets alias the unpacked message, so rows are never copied
+                    // after parsing: the message lives as long as any of its result sets
+                    auto resultPtr = std::make_shared<Ydb::Table::ExecuteQueryResult>();
+                    auto& result = *resultPtr;
                     any->UnpackTo(&result);
 
+                    res.reserve(result.result_sets_size());
                     for (size_t i = 0; i < static_cast<size_t>(result.result_sets_size()); i++) {
-                        res.push_back(TResultSet(*result.mutable_result_sets(i)));
+                        res.push_back(TResultSet(std::shared_ptr<Ydb::ResultSet>(resultPtr, result.mutable_result_sets(i))));
                     }
 
                     if (result.has_tx_meta()) {
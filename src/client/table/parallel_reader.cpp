@@ -0,0 +1,515 @@
+#include <src/client/table/impl/parallel_reader.h>
+
+#include <ydb-cpp-sdk/client/proto/accessor.h>
+
+#include <src/api/protos/ydb_value.pb.h>
+
+#include <algorithm>
+
+namespace NYdb::inline V3 {
+namespace NTable {
+
+using namespace NThreading;
+
+namespace {
+
+using TPart = TSimpleStreamPart<TResultSet>;
+
+TPart MakeEosPart() {
+    return TPart(TResultSet(Ydb::ResultSet()), TStatus(EStatus::CLIENT_OUT_OF_RANGE, {}));
+}
+
+TPart MakeErrorPart(const TStatus& status) {
+    return TPart(TResultSet(Ydb::ResultSet()), TStatus(status));
+}
+
+// ReadTable of one key range on a session of its own. Nothing is opened if the reader is gone meanwhile
+class TReadTableRangeStream : public IKeyRangeStream, public std::enable_shared_from_this<TReadTableRangeStream> {
+public:
+    TReadTableRangeStream(const TTableClient& client, const std::string& path, TReadTableSettings&& settings)
+        : Client_(client)
+        , Path_(path)
+        , Settings_(std::move(settings))
+    {}
+
+    TAsyncSimpleStreamPart<TResultSet> ReadNext() override {
+        if (Iterator_) {
+            return Iterator_->ReadNext();
+        }
+
+        auto promise = NewPromise<TPart>();
+        std::weak_ptr<TReadTableRangeStream> weak = shared_from_this();
+        Client_.GetSession().Subscribe([weak, promise](const TAsyncCreateSessionResult& future) mutable {
+            auto self = weak.lock();
+            if (!self) {
+                return;
+            }
+            auto result = future.GetValue();
+            if (!result.IsSuccess()) {
+                promise.SetValue(MakeErrorPart(result));
+                return;
+            }
+            self->Session_ = result.GetSession();
+            self->Session_->ReadTable(self->Path_, self->Settings_).Subscribe([weak, promise](const TAsyncTablePartIterator& future) mutable {
+                auto self = weak.lock();
+                if (!self) {
+                    return;
+                }
+                auto iterator = future.GetValue();
+                if (!iterator.IsSuccess()) {
+                    promise.SetValue(MakeErrorPart(iterator));
+                    return;
+                }
+                self->Iterator_ = iterator;
+                self->Iterator_->ReadNext().Subscribe([promise](TAsyncSimpleStreamPart<TResultSet> future) mutable {
+                    promise.SetValue(future.ExtractValue());
+                });
+            });
+        });
+        return promise.GetFuture();
+    }
+
+private:
+    TTableClient Client_;
+    const std::string Path_;
+    const TReadTableSettings Settings_;
+    std::optional<TSession> Session_;
+    std::optional<TTablePartIterator> Iterator_;
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+TParallelTablePartIterator::TReaderImpl::TReaderImpl(TKeyRangeStreamFactory factory,
+    const TReadTableParallelSettings& settings, const std::vector<TKeyRange>& ranges)
+    : Factory_(std::move(factory))
+    , Settings_(settings)
+{
+    Partitions_.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        Partitions_.push_back(TPartition{range, nullptr, {}, false, false});
+    }
+    Progress_.PartitionsTotal = Partitions_.size();
+}
+
+void TParallelTablePartIterator::TReaderImpl::Start() {
+    std::vector<size_t> toStart;
+    {
+        std::lock_guard lock(Lock_);
+        toStart = PickPartitionsToStart();
+    }
+    for (size_t index : toStart) {
+        StartPartition(index);
+    }
+}
+
+TAsyncSimpleStreamPart<TResultSet> TParallelTablePartIterator::TReaderImpl::ReadNext() {
+    auto promise = NewPromise<TPart>();
+    auto future = promise.GetFuture();
+
+    std::vector<size_t> toResume;
+    {
+        std::lock_guard lock(Lock_);
+        Waiters_.push_back(std::move(promise));
+        Deliver();
+        toResume = PickPartitionsToResume();
+    }
+    SetWaiters();
+    for (size_t index : toResume) {
+        ReadPartition(index);
+    }
+    return future;
+}
+
+TReadTableParallelProgress TParallelTablePartIterator::TReaderImpl::GetProgress() const {
+    std::lock_guard lock(Lock_);
+    return Progress_;
+}
+
+void TParallelTablePartIterator::TReaderImpl::StartPartition(size_t index) {
+    // Ranges are not changed after the construction
+    auto stream = Factory_(Partitions_[index].Range);
+    {
+        std::lock_guard lock(Lock_);
+        if (Error_) {
+            return;
+        }
+        Partitions_[index].Stream = std::move(stream);
+    }
+    ReadPartition(index);
+}
+
+void TParallelTablePartIterator::TReaderImpl::ReadPartition(size_t index) {
+    IKeyRangeStream::TPtr stream;
+    {
+        std::lock_guard lock(Lock_);
+        stream = Partitions_[index].Stream;
+    }
+    if (!stream) {
+        return;
+    }
+
+    std::weak_ptr<TReaderImpl> weak = shared_from_this();
+    stream->ReadNext().Subscribe([weak, index](TAsyncSimpleStreamPart<TResultSet> future) {
+        if (auto self = weak.lock()) {
+            self->OnPart(index, future.ExtractValue());
+        }
+    });
+}
+
+void TParallelTablePartIterator::TReaderImpl::OnPart(size_t index, TPart&& part) {
+    // Streams are released outside of the lock
+    std::vector<IKeyRangeStream::TPtr> garbage;
+    std::vector<size_t> toStart;
+    std::vector<size_t> toResume;
+    bool readMore = false;
+    {
+        std::lock_guard lock(Lock_);
+        if (Error_) {
+            return;
+        }
+
+        auto& partition = Partitions_[index];
+        if (part.EOS()) {
+            partition.Finished = true;
+            ++Progress_.PartitionsFinished;
+            --ActiveReaders_;
+            garbage.push_back(std::move(partition.Stream));
+            toStart = PickPartitionsToStart();
+        } else if (!part.IsSuccess()) {
+            Error_ = std::move(part);
+            for (auto& p : Partitions_) {
+                garbage.push_back(std::move(p.Stream));
+                p.Parts.clear();
+            }
+            ReadyOrder_.clear();
+            Progress_.BufferedBytes = 0;
+        } else {
+            const uint64_t bytes = TProtoAccessor::GetProto(part.GetPart()).ByteSizeLong();
+            Progress_.RowsRead += part.GetPart().RowsCount();
+            Progress_.BytesRead += bytes;
+            Progress_.BufferedBytes += bytes;
+            partition.Parts.push_back(std::move(part));
+            if (!Settings_.KeyOrdered_) {
+                ReadyOrder_.push_back(index);
+            }
+            readMore = CanRead(index);
+            partition.Paused = !readMore;
+        }
+
+        Deliver();
+        toResume = PickPartitionsToResume();
+    }
+    garbage.clear();
+
+    SetWaiters();
+    if (readMore) {
+        ReadPartition(index);
+    }
+    for (size_t i : toResume) {
+        ReadPartition(i);
+    }
+    for (size_t i : toStart) {
+        StartPartition(i);
+    }
+}
+
+std::vector<size_t> TParallelTablePartIterator::TReaderImpl::PickPartitionsToStart() {
+    std::vector<size_t> result;
+    while (!Error_ && NextToStart_ < Partitions_.size() && ActiveReaders_ < std::max<size_t>(Settings_.MaxConcurrentReaders_, 1)) {
+        result.push_back(NextToStart_++);
+        ++ActiveReaders_;
+    }
+    return result;
+}
+
+std::vector<size_t> TParallelTablePartIterator::TReaderImpl::PickPartitionsToResume() {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < NextToStart_; ++i) {
+        auto& partition = Partitions_[i];
+        if (partition.Paused && CanRead(i)) {
+            partition.Paused = false;
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+bool TParallelTablePartIterator::TReaderImpl::CanRead(size_t index) const {
+    if (Progress_.BufferedBytes < Settings_.MaxBufferedBytes_) {
+        return true;
+    }
+    // The head partition is never blocked by the budget in ordered mode,
+    // otherwise parts of the following partitions could fill it up forever
+    return Settings_.KeyOrdered_ && index == Head_ && Partitions_[index].Parts.empty();
+}
+
+void TParallelTablePartIterator::TReaderImpl::AdvanceHead() {
+    while (Head_ < Partitions_.size() && Partitions_[Head_].Finished && Partitions_[Head_].Parts.empty()) {
+        ++Head_;
+    }
+}
+
+std::optional<TParallelTablePartIterator::TReaderImpl::TPart> TParallelTablePartIterator::TReaderImpl::PopPart() {
+    size_t index;
+    if (Settings_.KeyOrdered_) {
+        AdvanceHead();
+        if (Head_ == Partitions_.size() || Partitions_[Head_].Parts.empty()) {
+            return std::nullopt;
+        }
+        index = Head_;
+    } else {
+        if (ReadyOrder_.empty()) {
+            return std::nullopt;
+        }
+        index = ReadyOrder_.front();
+        ReadyOrder_.pop_front();
+    }
+
+    auto& parts = Partitions_[index].Parts;
+    TPart part = std::move(parts.front());
+    parts.pop_front();
+    Progress_.BufferedBytes -= TProtoAccessor::GetProto(part.GetPart()).ByteSizeLong();
+    return part;
+}
+
+void TParallelTablePartIterator::TReaderImpl::Deliver() {
+    if (Settings_.KeyOrdered_) {
+        AdvanceHead();
+    }
+    while (!Waiters_.empty()) {
+        std::optional<TPart> part;
+        if (Error_) {
+            part = *Error_;
+        } else if (part = PopPart(); !part && Progress_.PartitionsFinished == Partitions_.size()) {
+            part = MakeEosPart();
+        }
+        if (!part) {
+            break;
+        }
+        Ready_.emplace_back(std::move(Waiters_.front()), std::move(*part));
+        Waiters_.pop_front();
+    }
+}
+
+void TParallelTablePartIterator::TReaderImpl::SetWaiters() {
+    std::vector<std::pair<TPromise<TPart>, TPart>> ready;
+    {
+        std::lock_guard lock(Lock_);
+        ready.swap(Ready_);
+    }
+    for (auto& [promise, part] : ready) {
+        promise.SetValue(std::move(part));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TParallelTablePartIterator::TParallelTablePartIterator(
+    std::shared_ptr<TReaderImpl> impl,
+    TStatus&& status)
+    : TStatus(std::move(status))
+    , ReaderImpl_(impl)
+{}
+
+TAsyncSimpleStreamPart<TResultSet> TParallelTablePartIterator::ReadNext() {
+    if (!ReaderImpl_) {
+        RaiseError("Attempt to perform read on an unsuccessful result " + GetIssues().ToString());
+    }
+    return ReaderImpl_->ReadNext();
+}
+
+TReadTableParallelProgress TParallelTablePartIterator::GetProgress() const {
+    return ReaderImpl_ ? ReaderImpl_->GetProgress() : TReadTableParallelProgress();
+}
+
+TAsyncParallelTablePartIterator TTableClient::ReadTableParallel(const std::string& path,
+    const TReadTableParallelSettings& settings)
+{
+    if (settings.ReadTableSettings_.From_ || settings.ReadTableSettings_.To_) {
+        NYdb::NIssue::TIssues issues;
+        issues.AddIssue(NYdb::NIssue::TIssue("From and To are not supported by parallel ReadTable"));
+        return MakeFuture(TParallelTablePartIterator(nullptr, TStatus(EStatus::BAD_REQUEST, std::move(issues))));
+    }
+
+    auto promise = NewPromise<TParallelTablePartIterator>();
+    auto client = *this;
+    GetSession().Subscribe([promise, client, path, settings](const TAsyncCreateSessionResult& future) mutable {
+        auto sessionResult = future.GetValue();
+        if (!sessionResult.IsSuccess()) {
+            promise.SetValue(TParallelTablePartIterator(nullptr, std::move(sessionResult)));
+            return;
+        }
+
+        auto session = sessionResult.GetSession();
+        session.DescribeTable(path, TDescribeTableSettings().WithKeyShardBoundary(true))
+            .Subscribe([promise, client, path, settings, session](const TAsyncDescribeTableResult& future) mutable {
+                auto describeResult = future.GetValue();
+                if (!describeResult.IsSuccess()) {
+                    promise.SetValue(TParallelTablePartIterator(nullptr, std::move(describeResult)));
+                    return;
+                }
+
+                auto ranges = describeResult.GetTableDescription().GetKeyRanges();
+                if (ranges.empty()) {
+                    ranges.emplace_back(std::nullopt, std::nullopt);
+                }
+
+                auto factory = [client, path, readSettings = settings.ReadTableSettings_](const TKeyRange& range) {
+                    auto rangeSettings = readSettings;
+                    rangeSettings.From_ = range.From();
+                    rangeSettings.To_ = range.To();
+                    return std::make_shared<TReadTableRangeStream>(client, path, std::move(rangeSettings));
+                };
+                auto impl = std::make_shared<TParallelTablePartIterator::TReaderImpl>(std::move(factory), settings, ranges);
+                impl->Start();
+                promise.SetValue(TParallelTablePartIterator(impl, TStatus(EStatus::SUCCESS, {})));
+            });
+    });
+    return promise.GetFuture();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+class TReadRowsParallelState : public std::enable_shared_from_this<TReadRowsParallelState> {
+public:
+    TReadRowsParallelState(TReadRowsFunc readRows, std::vector<TValue>&& chunks, size_t maxConcurrentRequests)
+        : ReadRows_(std::move(readRows))
+        , MaxConcurrentRequests_(std::max<size_t>(maxConcurrentRequests, 1))
+        , Chunks_(std::move(chunks))
+        , Results_(Chunks_.size())
+        , Promise_(NewPromise<TReadRowsResult>())
+    {}
+
+    TAsyncReadRowsResult Start() {
+        if (Chunks_.empty()) {
+            return MakeFuture(TReadRowsResult(TStatus(EStatus::SUCCESS, {}), TResultSet(Ydb::ResultSet())));
+        }
+        const size_t concurrency = std::min(MaxConcurrentRequests_, Chunks_.size());
+        {
+            std::lock_guard lock(Lock_);
+            NextChunk_ = concurrency;
+        }
+        for (size_t i = 0; i < concurrency; ++i) {
+            Send(i);
+        }
+        return Promise_.GetFuture();
+    }
+
+private:
+    void Send(size_t index) {
+        auto self = shared_from_this();
+        ReadRows_(std::move(Chunks_[index])).Subscribe([self, index](TAsyncReadRowsResult future) {
+            self->OnResult(index, future.ExtractValue());
+        });
+    }
+
+    void OnResult(size_t index, TReadRowsResult&& result) {
+        std::optional<size_t> next;
+        bool failed = false;
+        bool done = false;
+        {
+            std::lock_guard lock(Lock_);
+            if (Failed_) {
+                return;
+            }
+            if (!result.IsSuccess()) {
+                Failed_ = failed = true;
+            } else {
+                Results_[index] = result.GetResultSet();
+                ++Completed_;
+                if (NextChunk_ < Chunks_.size()) {
+                    next = NextChunk_++;
+                }
+                done = Completed_ == Chunks_.size();
+            }
+        }
+
+        if (failed) {
+            Promise_.SetValue(std::move(result));
+        } else if (done) {
+            Promise_.SetValue(Merge());
+        } else if (next) {
+            Send(*next);
+        }
+    }
+
+    // Results of the chunks are owned here, so their rows are moved instead of copied
+    TReadRowsResult Merge() {
+        size_t rowsCount = 0;
+        for (const auto& resultSet : Results_) {
+            rowsCount += resultSet->RowsCount();
+        }
+
+        Ydb::ResultSet merged;
+        merged.Swap(TProtoAccessor::GetProtoPtr(*Results_.front()));
+        auto* rows = merged.mutable_rows();
+        rows->Reserve(rowsCount);
+        for (size_t i = 1; i < Results_.size(); ++i) {
+            for (auto& row : *TProtoAccessor::GetProtoPtr(*Results_[i])->mutable_rows()) {
+                *rows->Add() = std::move(row);
+            }
+        }
+        Results_.clear();
+
+        return TReadRowsResult(TStatus(EStatus::SUCCESS, {}), TResultSet(std::move(merged)));
+    }
+
+private:
+    const TReadRowsFunc ReadRows_;
+    const size_t MaxConcurrentRequests_;
+
+    std::vector<TValue> Chunks_;
+    std::vector<std::optional<TResultSet>> Results_;
+    TPromise<TReadRowsResult> Promise_;
+
+    std::mutex Lock_;
+    size_t NextChunk_ = 0;
+    size_t Completed_ = 0;
+    bool Failed_ = false;
+};
+
+} // namespace
+
+std::vector<TValue> SplitKeys(TValue&& keys, size_t maxKeysPerChunk) {
+    const size_t chunkSize = std::max<size_t>(maxKeysPerChunk, 1);
+    auto& items = *keys.GetProto().mutable_items();
+
+    std::vector<TValue> chunks;
+    chunks.reserve((items.size() + chunkSize - 1) / chunkSize);
+    for (int begin = 0; begin < items.size(); begin += chunkSize) {
+        const int end = std::min<int>(begin + chunkSize, items.size());
+        Ydb::Value chunk;
+        chunk.mutable_items()->Reserve(end - begin);
+        for (int i = begin; i < end; ++i) {
+            *chunk.add_items() = std::move(items[i]);
+        }
+        chunks.emplace_back(keys.GetType(), std::move(chunk));
+    }
+    return chunks;
+}
+
+TAsyncReadRowsResult ReadRowsInChunks(TReadRowsFunc readRows, std::vector<TValue>&& chunks, size_t maxConcurrentRequests) {
+    auto state = std::make_shared<TReadRowsParallelState>(std::move(readRows), std::move(chunks), maxConcurrentRequests);
+    return state->Start();
+}
+
+TAsyncReadRowsResult TTableClient::ReadRowsParallel(const std::string& table, TValue&& keys,
+    const std::vector<std::string>& columns, const TReadRowsParallelSettings& settings)
+{
+    const size_t chunkSize = std::max<size_t>(settings.MaxKeysPerRequest_, 1);
+    if (static_cast<size_t>(keys.GetProto().items_size()) <= chunkSize) {
+        return ReadRows(table, std::move(keys), columns, settings.ReadRowsSettings_);
+    }
+
+    auto readRows = [client = *this, table, columns, readRowsSettings = settings.ReadRowsSettings_](TValue&& chunk) mutable {
+        return client.ReadRows(table, std::move(chunk), columns, readRowsSettings);
+    };
+    return ReadRowsInChunks(std::move(readRows), SplitKeys(std::move(keys), chunkSize), settings.MaxConcurrentRequests_);
+}
+
+} // namespace NTable
+} // namespace NYdb
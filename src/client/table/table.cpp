@@ -2050,12 +2050,12 @@ TAsyncTablePartIterator TSession::ReadTable(const std::string& path,
     const TReadTableSettings& settings)
 {
     auto promise = NThreading::NewPromise<TTablePartIterator>();
-    auto readTableIteratorBuilder = [promise](NThreading::TFuture<std::pair<TPlainStatus, TTableClient::TImpl::TReadTableStreamProcessorPtr>> future) mutable {
+    auto readTableIteratorBuilder = [promise, readAhead = settings.ReadAhead_](NThreading::TFuture<std::pair<TPlainStatus, TTableClient::TImpl::TReadTableStreamProcessorPtr>> future) mutable {
         Y_ASSERT(future.HasValue());
         auto pair = future.ExtractValue();
             promise.SetValue(TTablePartIterator(
                 pair.second ? std::make_shared<TTablePartIterator::TReaderImpl>(
-                pair.second, pair.first.Endpoint) : nullptr, std::move(pair.first))
+                pair.second, pair.first.Endpoint, readAhead) : nullptr, std::move(pair.first))
             );
     };
     Client_->ReadTable(*this, path, settings).Subscribe(readTableIteratorBuilder);
@@ -2,9 +2,21 @@
 
 #include <library/cpp/streams/zstd/zstd.h>
 
+#include <util/generic/size_literals.h>
 #include <util/stream/buffer.h>
 #include <util/stream/zlib.h>
 
+#include <lz4frame.h>
+#include <zlib.h>
+#include <zdict.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+
 namespace NYdb::inline V3::NTopic {
 
 namespace {
@@ -27,34 +39,503 @@ public:
     }
 };
 
+// Size hint comes from the wire (as does the content size of a zstd frame), so it is not trusted
+// for huge preallocations: besides the absolute limit it is capped by the ratio deflate can not exceed.
+// Output of better compressed data grows as it is produced
+constexpr size_t MAX_PRESIZED_OUTPUT = 64_MB;
+constexpr size_t MAX_PRESIZED_RATIO = 1032;
+
+size_t GetInitialOutputSize(size_t inputSize, size_t uncompressedSizeHint) {
+    if (uncompressedSizeHint) {
+        return std::min({uncompressedSizeHint, inputSize * MAX_PRESIZED_RATIO, MAX_PRESIZED_OUTPUT});
+    }
+    return std::min(std::max<size_t>(inputSize * 4, 256), MAX_PRESIZED_OUTPUT);
+}
+
+void GrowOutput(std::string& result) {
+    result.resize(std::max<size_t>(result.size() * 2, 256));
+}
+
+// Compression levels of the SDK follow gzip and zstd (default 4), but LZ4 levels from 3 select
+// the slow high compression mode. It is used only for explicitly high levels, lower ones map to the fast mode
+constexpr int LZ4_HIGH_COMPRESSION_QUALITY = 9;
+constexpr int LZ4_MAX_COMPRESSION_LEVEL = 12;
+
+int GetLz4CompressionLevel(int quality) {
+    if (quality < 0) {
+        // Fast mode with acceleration
+        return quality;
+    }
+    if (quality < LZ4_HIGH_COMPRESSION_QUALITY) {
+        return 0;
+    }
+    return std::min(quality, LZ4_MAX_COMPRESSION_LEVEL);
+}
+
+class TInflateContext {
+public:
+    TInflateContext() {
+        // 15 window bits + 32 enables gzip and zlib header autodetection
+        if (inflateInit2(&Stream_, 15 + 32) != Z_OK) {
+            throw yexception() << "can not initialize zlib decompression";
+        }
+    }
+
+    ~TInflateContext() {
+        inflateEnd(&Stream_);
+    }
+
+    z_stream* Reset() {
+        inflateReset(&Stream_);
+        return &Stream_;
+    }
+
+private:
+    z_stream Stream_ = {};
+};
+
+class TZstdDecompressionContext {
+public:
+    TZstdDecompressionContext()
+        : Ctx_(ZSTD_createDCtx())
+    {
+        if (!Ctx_) {
+            throw yexception() << "can not create zstd decompression context";
+        }
+    }
+
+    ~TZstdDecompressionContext() {
+        ZSTD_freeDCtx(Ctx_);
+    }
+
+    ZSTD_DCtx* Reset() {
+        ZSTD_DCtx_reset(Ctx_, ZSTD_reset_session_only);
+        return Ctx_;
+    }
+
+private:
+    ZSTD_DCtx* Ctx_;
+};
+
+void DecompressZstd(ZSTD_DCtx* ctx, const std::string& data, size_t uncompressedSizeHint, std::string& result) {
+    if (!uncompressedSizeHint) {
+        const auto frameSize = ZSTD_getFrameContentSize(data.data(), data.size());
+        if (frameSize != ZSTD_CONTENTSIZE_UNKNOWN && frameSize != ZSTD_CONTENTSIZE_ERROR) {
+            uncompressedSizeHint = frameSize;
+        }
+    }
+
+    result.resize(GetInitialOutputSize(data.size(), uncompressedSizeHint));
+    ZSTD_inBuffer input = {data.data(), data.size(), 0};
+    ZSTD_outBuffer output = {result.data(), result.size(), 0};
+
+    while (true) {
+        if (output.pos == result.size()) {
+            GrowOutput(result);
+        }
+        output.dst = result.data();
+        output.size = result.size();
+
+        const size_t ret = ZSTD_decompressStream(ctx, &output, &input);
+        if (ZSTD_isError(ret)) {
+            throw yexception() << "zstd decompression failed: " << ZSTD_getErrorName(ret);
+        }
+        if (input.pos == input.size) {
+            if (ret == 0) {
+                break;
+            }
+            if (output.pos != output.size) {
+                throw yexception() << "zstd decompression failed: truncated input";
+            }
+        }
+    }
+
+    result.resize(output.pos);
+}
+
+class TZstdCompressionContext {
+public:
+    TZstdCompressionContext()
+        : Ctx_(ZSTD_createCCtx())
+    {
+        if (!Ctx_) {
+            throw yexception() << "can not create zstd compression context";
+        }
+    }
+
+    ~TZstdCompressionContext() {
+        ZSTD_freeCCtx(Ctx_);
+    }
+
+    ZSTD_CCtx* Get() {
+        return Ctx_;
+    }
+
+private:
+    ZSTD_CCtx* Ctx_;
+};
+
+class TLz4DecompressionContext {
+public:
+    TLz4DecompressionContext() {
+        const auto ret = LZ4F_createDecompressionContext(&Ctx_, LZ4F_VERSION);
+        if (LZ4F_isError(ret)) {
+            throw yexception() << "can not create lz4 decompression context: " << LZ4F_getErrorName(ret);
+        }
+    }
+
+    ~TLz4DecompressionContext() {
+        LZ4F_freeDecompressionContext(Ctx_);
+    }
+
+    LZ4F_dctx* Reset() {
+        LZ4F_resetDecompressionContext(Ctx_);
+        return Ctx_;
+    }
+
+private:
+    LZ4F_dctx* Ctx_ = nullptr;
+};
+
+// Collects the whole message and compresses it with one call on Finish.
+// Topic messages are compressed one by one, and for small messages one-shot compression is cheaper
+// than streaming, needs no per-coder state and stores the content size in the frame header
+class TOneShotCompressor final : public IOutputStream {
+public:
+    using TCompressFunc = std::function<void(const TBuffer& input, TBuffer& dst)>;
+
+    TOneShotCompressor(TBuffer& dst, TCompressFunc compress)
+        : Dst_(dst)
+        , Compress_(std::move(compress))
+    {
+    }
+
+    ~TOneShotCompressor() override {
+        try {
+            Finish();
+        } catch (...) {
+        }
+    }
+
+private:
+    void DoWrite(const void* buf, size_t len) override {
+        Input_.Append(static_cast<const char*>(buf), len);
+    }
+
+    void DoFinish() override {
+        // Finish should be idempotent
+        if (Compress_) {
+            auto compress = std::move(Compress_);
+            Compress_ = nullptr;
+            compress(Input_, Dst_);
+        }
+    }
+
+private:
+    TBuffer& Dst_;
+    TCompressFunc Compress_;
+    TBuffer Input_;
+};
+
 }
 
 std::string TGzipCodec::Decompress(const std::string& data) const {
-    TMemoryInput input(data.data(), data.size());
-    TString result;
-    TStringOutput resultOutput(result);
-    TZLibDecompress inputStreamStorage(&input);
-    TransferData(&inputStreamStorage, &resultOutput);
+    std::string result;
+    DecompressInto(data, 0, result);
     return result;
 }
 
+void TGzipCodec::DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const {
+    if (data.empty()) {
+        result.clear();
+        return;
+    }
+
+    thread_local TInflateContext context;
+    z_stream* stream = context.Reset();
+
+    result.resize(GetInitialOutputSize(data.size(), uncompressedSizeHint));
+    stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream->avail_in = data.size();
+
+    size_t produced = 0;
+    while (true) {
+        if (produced == result.size()) {
+            GrowOutput(result);
+        }
+        const size_t available = std::min<size_t>(result.size() - produced, std::numeric_limits<uInt>::max());
+        stream->next_out = reinterpret_cast<Bytef*>(result.data() + produced);
+        stream->avail_out = available;
+
+        const int ret = inflate(stream, Z_NO_FLUSH);
+        produced += available - stream->avail_out;
+
+        if (ret == Z_STREAM_END) {
+            if (stream->avail_in == 0) {
+                break;
+            }
+            // Concatenated gzip members
+            inflateReset(stream);
+            continue;
+        }
+        if (ret != Z_OK && ret != Z_BUF_ERROR) {
+            throw yexception() << "gzip decompression failed: " << (stream->msg ? stream->msg : "unknown error");
+        }
+        if (stream->avail_in == 0 && stream->avail_out != 0) {
+            throw yexception() << "gzip decompression failed: truncated input";
+        }
+    }
+
+    result.resize(produced);
+}
+
 std::unique_ptr<IOutputStream> TGzipCodec::CreateCoder(TBuffer& result, int quality) const {
     return std::make_unique<TZLibToStringCompressor>(result, ZLib::GZip, quality >= 0 ? quality : 6);
 }
 
 std::string TZstdCodec::Decompress(const std::string& data) const {
-    TMemoryInput input(data.data(), data.size());
-    TString result;
-    TStringOutput resultOutput(result);
-    TZstdDecompress inputStreamStorage(&input);
-    TransferData(&inputStreamStorage, &resultOutput);
+    std::string result;
+    DecompressInto(data, 0, result);
     return result;
 }
 
+void TZstdCodec::DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const {
+    if (data.empty()) {
+        result.clear();
+        return;
+    }
+
+    thread_local TZstdDecompressionContext context;
+    DecompressZstd(context.Reset(), data, uncompressedSizeHint, result);
+}
+
 std::unique_ptr<IOutputStream> TZstdCodec::CreateCoder(TBuffer& result, int quality) const {
     return std::make_unique<TZstdToStringCompressor>(result, quality);
 }
 
+std::string TLz4Codec::Decompress(const std::string& data) const {
+    std::string result;
+    DecompressInto(data, 0, result);
+    return result;
+}
+
+void TLz4Codec::DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const {
+    if (data.empty()) {
+        result.clear();
+        return;
+    }
+
+    thread_local TLz4DecompressionContext context;
+    LZ4F_dctx* ctx = context.Reset();
+
+    size_t consumed = 0;
+    if (!uncompressedSizeHint) {
+        // Frame header is consumed here and decompression continues after it
+        LZ4F_frameInfo_t frameInfo = {};
+        consumed = data.size();
+        const size_t ret = LZ4F_getFrameInfo(ctx, &frameInfo, data.data(), &consumed);
+        if (LZ4F_isError(ret)) {
+            throw yexception() << "lz4 decompression failed: " << LZ4F_getErrorName(ret);
+        }
+        uncompressedSizeHint = frameInfo.contentSize;
+    }
+
+    result.resize(GetInitialOutputSize(data.size(), uncompressedSizeHint));
+
+    size_t produced = 0;
+    while (true) {
+        if (produced == result.size()) {
+            GrowOutput(result);
+        }
+        size_t dstSize = result.size() - produced;
+        size_t srcSize = data.size() - consumed;
+
+        const size_t ret = LZ4F_decompress(ctx, result.data() + produced, &dstSize, data.data() + consumed, &srcSize, nullptr);
+        if (LZ4F_isError(ret)) {
+            throw yexception() << "lz4 decompression failed: " << LZ4F_getErrorName(ret);
+        }
+        produced += dstSize;
+        consumed += srcSize;
+
+        if (consumed == data.size()) {
+            if (ret == 0) {
+                break;
+            }
+            if (produced != result.size()) {
+                throw yexception() << "lz4 decompression failed: truncated input";
+            }
+        }
+        // Zero with some input left is the end of a frame, the next concatenated frame follows
+    }
+
+    result.resize(produced);
+}
+
+std::unique_ptr<IOutputStream> TLz4Codec::CreateCoder(TBuffer& result, int quality) const {
+    return std::make_unique<TOneShotCompressor>(result, [quality](const TBuffer& input, TBuffer& dst) {
+        LZ4F_preferences_t preferences = {};
+        preferences.frameInfo.contentSize = input.Size();
+        preferences.compressionLevel = GetLz4CompressionLevel(quality);
+
+        const size_t offset = dst.Size();
+        dst.Advance(LZ4F_compressFrameBound(input.Size(), &preferences));
+        const size_t ret = LZ4F_compressFrame(dst.Data() + offset, dst.Size() - offset, input.Data(), input.Size(), &preferences);
+        if (LZ4F_isError(ret)) {
+            throw yexception() << "lz4 compression failed: " << LZ4F_getErrorName(ret);
+        }
+        dst.Resize(offset + ret);
+    });
+}
+
+class TZstdDictCodec::TImpl {
+public:
+    TImpl(const std::string& dictionary, const std::vector<std::string>& previousDictionaries)
+        : Dictionary_(dictionary)
+        , DictionaryId_(ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size()))
+    {
+        if (!DictionaryId_) {
+            throw yexception() << "zstd dictionary has no id, only dictionaries in zstd format are supported";
+        }
+        AddDecompressionDictionary(dictionary);
+        for (const auto& previous : previousDictionaries) {
+            AddDecompressionDictionary(previous);
+        }
+    }
+
+    ~TImpl() {
+        for (auto& [_, ddict] : DDicts_) {
+            ZSTD_freeDDict(ddict);
+        }
+        for (auto& [_, cdict] : CDicts_) {
+            ZSTD_freeCDict(cdict);
+        }
+    }
+
+    uint32_t GetDictionaryId() const {
+        return DictionaryId_;
+    }
+
+    void DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const {
+        thread_local TZstdDecompressionContext context;
+        ZSTD_DCtx* ctx = context.Reset();
+
+        // Frames written without a dictionary carry zero id
+        const uint32_t dictionaryId = ZSTD_getDictID_fromFrame(data.data(), data.size());
+        const ZSTD_DDict* ddict = nullptr;
+        if (dictionaryId) {
+            auto it = DDicts_.find(dictionaryId);
+            if (it == DDicts_.end()) {
+                throw yexception() << "zstd decompression failed: unknown dictionary id " << dictionaryId;
+            }
+            ddict = it->second;
+        }
+        ZSTD_DCtx_refDDict(ctx, ddict);
+
+        DecompressZstd(ctx, data, uncompressedSizeHint, result);
+    }
+
+    void Compress(const TBuffer& input, TBuffer& dst, int quality) const {
+        thread_local TZstdCompressionContext context;
+
+        const size_t offset = dst.Size();
+        dst.Advance(ZSTD_compressBound(input.Size()));
+        const size_t ret = ZSTD_compress_usingCDict(context.Get(), dst.Data() + offset, dst.Size() - offset,
+            input.Data(), input.Size(), GetCDict(quality));
+        if (ZSTD_isError(ret)) {
+            throw yexception() << "zstd compression failed: " << ZSTD_getErrorName(ret);
+        }
+        dst.Resize(offset + ret);
+    }
+
+private:
+    void AddDecompressionDictionary(const std::string& dictionary) {
+        const uint32_t id = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+        if (!id) {
+            throw yexception() << "zstd dictionary has no id, only dictionaries in zstd format are supported";
+        }
+        if (DDicts_.contains(id)) {
+            return;
+        }
+        ZSTD_DDict* ddict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+        if (!ddict) {
+            throw yexception() << "can not load zstd dictionary " << id;
+        }
+        DDicts_.emplace(id, ddict);
+    }
+
+    // Digested dictionaries depend on the compression level, so they are made on the first use of each level
+    const ZSTD_CDict* GetCDict(int quality) const {
+        std::lock_guard lock(CDictsLock_);
+        auto it = CDicts_.find(quality);
+        if (it == CDicts_.end()) {
+            ZSTD_CDict* cdict = ZSTD_createCDict(Dictionary_.data(), Dictionary_.size(), quality);
+            if (!cdict) {
+                throw yexception() << "can not load zstd dictionary " << DictionaryId_;
+            }
+            it = CDicts_.emplace(quality, cdict).first;
+        }
+        return it->second;
+    }
+
+private:
+    const std::string Dictionary_;
+    const uint32_t DictionaryId_;
+    std::map<uint32_t, ZSTD_DDict*> DDicts_;
+
+    mutable std::mutex CDictsLock_;
+    mutable std::map<int, ZSTD_CDict*> CDicts_;
+};
+
+TZstdDictCodec::TZstdDictCodec(const std::string& dictionary, const std::vector<std::string>& previousDictionaries)
+    : Impl_(std::make_unique<TImpl>(dictionary, previousDictionaries))
+{
+}
+
+TZstdDictCodec::~TZstdDictCodec() = default;
+
+std::string TZstdDictCodec::TrainDictionary(const std::vector<std::string>& samples, size_t maxDictionarySize) {
+    std::string buffer;
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        buffer += sample;
+        sizes.push_back(sample.size());
+    }
+
+    std::string dictionary(maxDictionarySize, '\0');
+    const size_t ret = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), buffer.data(), sizes.data(), sizes.size());
+    if (ZDICT_isError(ret)) {
+        throw yexception() << "zstd dictionary training failed: " << ZDICT_getErrorName(ret);
+    }
+    dictionary.resize(ret);
+    return dictionary;
+}
+
+uint32_t TZstdDictCodec::GetDictionaryId() const {
+    return Impl_->GetDictionaryId();
+}
+
+std::string TZstdDictCodec::Decompress(const std::string& data) const {
+    std::string result;
+    DecompressInto(data, 0, result);
+    return result;
+}
+
+void TZstdDictCodec::DecompressInto(const std::string& data, size_t uncompressedSizeHint, std::string& result) const {
+    if (data.empty()) {
+        result.clear();
+        return;
+    }
+
+    Impl_->DecompressInto(data, uncompressedSizeHint, result);
+}
+
+std::unique_ptr<IOutputStream> TZstdDictCodec::CreateCoder(TBuffer& result, int quality) const {
+    return std::make_unique<TOneShotCompressor>(result, [impl = Impl_.get(), quality](const TBuffer& input, TBuffer& dst) {
+        impl->Compress(input, dst, quality);
+    });
+}
+
 std::string TUnsupportedCodec::Decompress(const std::string&) const {
     throw yexception() << "use of unsupported codec";
 }
@@ -0,0 +1,165 @@
+#include "work_stealing_executor.h"
+
+#include <algorithm>
+
+namespace NYdb::inline V3::NTopic {
+
+namespace {
+
+struct TCurrentWorker {
+    const TWorkStealingExecutor* Owner = nullptr;
+    size_t Index = 0;
+};
+
+thread_local TCurrentWorker CurrentWorker;
+
+}
+
+TWorkStealingExecutor::TWorkStealingExecutor(size_t threadCount)
+    : ThreadCount(std::max<size_t>(threadCount, 1))
+    , Queues(std::make_unique<TWorkerQueue[]>(ThreadCount))
+{
+}
+
+TWorkStealingExecutor::~TWorkStealingExecutor() {
+    {
+        std::lock_guard guard(SleepLock);
+        Stopping.store(true);
+    }
+    SleepCondVar.notify_all();
+    for (auto& worker : Workers) {
+        worker.join();
+    }
+}
+
+void TWorkStealingExecutor::DoStart() {
+    Workers.reserve(ThreadCount);
+    for (size_t i = 0; i < ThreadCount; ++i) {
+        Workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+}
+
+void TWorkStealingExecutor::PostImpl(std::vector<TFunction>&& fs) {
+    for (auto& f : fs) {
+        PostImpl(std::move(f));
+    }
+}
+
+void TWorkStealingExecutor::PostImpl(TFunction&& f) {
+    const size_t index = CurrentWorker.Owner == this
+        ? CurrentWorker.Index
+        : NextQueue.fetch_add(1, std::memory_order_relaxed) % ThreadCount;
+    PendingTasks.fetch_add(1);
+    {
+        auto& queue = Queues[index];
+        std::lock_guard guard(queue.Lock);
+        queue.Tasks.push_back(TTask{std::move(f), TClock::now()});
+    }
+
+    // Pairs with the increment of SleepingWorkers before the pending tasks check in WorkerLoop
+    if (SleepingWorkers.load() > 0) {
+        std::lock_guard guard(SleepLock);
+        SleepCondVar.notify_one();
+    }
+}
+
+void TWorkStealingExecutor::WorkerLoop(size_t index) {
+    CurrentWorker = {this, index};
+
+    while (true) {
+        TTask task;
+        if (PopOwn(index, task)) {
+            Execute(std::move(task), false);
+            continue;
+        }
+        if (Steal(index, task)) {
+            Execute(std::move(task), true);
+            continue;
+        }
+
+        std::unique_lock lock(SleepLock);
+        SleepingWorkers.fetch_add(1);
+        SleepCondVar.wait(lock, [this] {
+            return Stopping.load() || PendingTasks.load() > 0;
+        });
+        SleepingWorkers.fetch_sub(1);
+        // Tasks posted before the destruction are still executed
+        if (Stopping.load() && PendingTasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool TWorkStealingExecutor::PopOwn(size_t index, TTask& task) {
+    auto& queue = Queues[index];
+    std::lock_guard guard(queue.Lock);
+    if (queue.Tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.Tasks.front());
+    queue.Tasks.pop_front();
+    PendingTasks.fetch_sub(1);
+    return true;
+}
+
+bool TWorkStealingExecutor::Steal(size_t index, TTask& task) {
+    // Owner takes the oldest tasks, so a thief takes the newest ones to keep out of its way
+    for (size_t i = 1; i < ThreadCount; ++i) {
+        auto& queue = Queues[(index + i) % ThreadCount];
+        std::lock_guard guard(queue.Lock);
+        if (!queue.Tasks.empty()) {
+            task = std::move(queue.Tasks.back());
+            queue.Tasks.pop_back();
+            PendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TWorkStealingExecutor::Execute(TTask&& task, bool stolen) {
+    const uint64_t waitUs = std::chrono::duration_cast<std::chrono::microseconds>(TClock::now() - task.PostedAt).count();
+    TotalWaitTimeUs.fetch_add(waitUs, std::memory_order_relaxed);
+    uint64_t maxWaitUs = MaxWaitTimeUs.load(std::memory_order_relaxed);
+    while (waitUs > maxWaitUs && !MaxWaitTimeUs.compare_exchange_weak(maxWaitUs, waitUs, std::memory_order_relaxed)) {
+    }
+    if (stolen) {
+        TasksStolen.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    task.Function();
+    TasksExecuted.fetch_add(1, std::memory_order_relaxed);
+}
+
+TCompressionExecutorStats TWorkStealingExecutor::GetStats() const {
+    TCompressionExecutorStats stats;
+    stats.QueueDepth = std::max<i64>(PendingTasks.load(std::memory_order_relaxed), 0);
+    stats.TasksExecuted = TasksExecuted.load(std::memory_order_relaxed);
+    stats.TasksStolen = TasksStolen.load(std::memory_order_relaxed);
+    stats.TotalWaitTime = TDuration::MicroSeconds(TotalWaitTimeUs.load(std::memory_order_relaxed));
+    stats.MaxWaitTime = TDuration::MicroSeconds(MaxWaitTimeUs.load(std::memory_order_relaxed));
+    return stats;
+}
+
+namespace {
+
+std::shared_ptr<TWorkStealingExecutor> GetSharedCompressionExecutorImpl() {
+    static std::shared_ptr<TWorkStealingExecutor> executor = [] {
+        auto result = std::make_shared<TWorkStealingExecutor>(std::thread::hardware_concurrency());
+        result->Start();
+        return result;
+    }();
+    return executor;
+}
+
+}
+
+IExecutor::TPtr GetSharedCompressionExecutor() {
+    return GetSharedCompressionExecutorImpl();
+}
+
+TCompressionExecutorStats GetSharedCompressionExecutorStats() {
+    return GetSharedCompressionExecutorImpl()->GetStats();
+}
+
+} // namespace NYdb::NTopic
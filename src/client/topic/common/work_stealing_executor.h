@@ -0,0 +1,74 @@
+#pragma once
+
+#include "executor_impl.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NYdb::inline V3::NTopic {
+
+//! Executor with a queue per worker thread. Tasks posted from outside are spread over the queues round-robin,
+//! tasks posted from a worker go to its own queue. Idle workers steal tasks from the other queues,
+//! so there is no single queue all the posting threads contend on.
+class TWorkStealingExecutor : public IAsyncExecutor {
+private:
+    using TClock = std::chrono::steady_clock;
+
+    struct TTask {
+        TFunction Function;
+        TClock::time_point PostedAt;
+    };
+
+    struct alignas(64) TWorkerQueue {
+        std::mutex Lock;
+        std::deque<TTask> Tasks;
+    };
+
+public:
+    explicit TWorkStealingExecutor(size_t threadCount);
+    //! Waits for the tasks that are already posted
+    ~TWorkStealingExecutor();
+
+    //! Shared by all the sessions, so it is stopped only on destruction
+    void Stop() override {
+    }
+
+    TCompressionExecutorStats GetStats() const;
+
+private:
+    void DoStart() override;
+
+    void PostImpl(std::vector<TFunction>&& fs) override;
+    void PostImpl(TFunction&& f) override;
+
+    void WorkerLoop(size_t index);
+    bool PopOwn(size_t index, TTask& task);
+    bool Steal(size_t index, TTask& task);
+    void Execute(TTask&& task, bool stolen);
+
+private:
+    const size_t ThreadCount;
+    std::unique_ptr<TWorkerQueue[]> Queues;
+    std::vector<std::thread> Workers;
+    std::atomic<size_t> NextQueue = 0;
+
+    std::mutex SleepLock;
+    std::condition_variable SleepCondVar;
+    std::atomic<size_t> SleepingWorkers = 0;
+    std::atomic<bool> Stopping = false;
+
+    // Counted before a task is queued, so it may be ahead of the queues for a moment
+    std::atomic<i64> PendingTasks = 0;
+    std::atomic<uint64_t> TasksExecuted = 0;
+    std::atomic<uint64_t> TasksStolen = 0;
+    std::atomic<uint64_t> TotalWaitTimeUs = 0;
+    std::atomic<uint64_t> MaxWaitTimeUs = 0;
+};
+
+} // namespace NYdb::NTopic
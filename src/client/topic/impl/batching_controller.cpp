@@ -0,0 +1,99 @@
+#include "batching_controller.h"
+
+#include <util/generic/size_literals.h>
+
+#include <algorithm>
+
+namespace NYdb::inline V3::NTopic {
+
+namespace {
+
+// The flush interval is recalculated after this number of acknowledged requests,
+// or after the window duration if requests are rare
+constexpr size_t WINDOW_REQUESTS = 64;
+constexpr TDuration MIN_WINDOW_DURATION = TDuration::MilliSeconds(100);
+
+constexpr std::uint64_t MIN_FLUSH_SIZE_BYTES = 1024;
+constexpr std::uint64_t DEFAULT_MAX_FLUSH_SIZE_BYTES = 64_MB;
+
+}
+
+TBatchingController::TBatchingController(TDuration latencyTarget, TDuration maxFlushInterval, std::uint64_t maxFlushSizeBytes)
+    : LatencyTarget(latencyTarget)
+    , MinFlushInterval(Min(TDuration::MilliSeconds(1), latencyTarget))
+    , MaxFlushInterval(maxFlushInterval ? Min(maxFlushInterval, latencyTarget) : latencyTarget)
+    , MaxFlushSizeBytes(maxFlushSizeBytes ? maxFlushSizeBytes : DEFAULT_MAX_FLUSH_SIZE_BYTES)
+    , FlushInterval(Max(MinFlushInterval, MaxFlushInterval / 4))
+    , FlushSizeBytes(MaxFlushSizeBytes)
+{
+    Latencies.reserve(WINDOW_REQUESTS);
+}
+
+void TBatchingController::OnReady(std::uint64_t size, TInstant now) {
+    if (PendingBytes == 0) {
+        PendingSince = now;
+    }
+    PendingBytes += size;
+}
+
+bool TBatchingController::ShouldSend(bool hasInflight, TInstant now) const {
+    return !hasInflight
+        || PendingBytes >= FlushSizeBytes
+        || now - PendingSince >= FlushInterval;
+}
+
+void TBatchingController::OnSent(std::uint64_t size, std::uint64_t lastId, TInstant now) {
+    SentRequests.push_back({lastId, size, PendingSince});
+    PendingBytes -= Min(size, PendingBytes);
+    // Blocks which are still pending became ready not later than now
+    PendingSince = PendingBytes ? now : TInstant::Zero();
+}
+
+bool TBatchingController::OnAck(std::uint64_t id, TInstant now) {
+    if (SentRequests.empty() || SentRequests.front().LastId > id) {
+        return false;
+    }
+
+    if (WindowStartedAt == TInstant::Zero()) {
+        WindowStartedAt = SentRequests.front().ReadySince;
+    }
+    while (!SentRequests.empty() && SentRequests.front().LastId <= id) {
+        const auto& request = SentRequests.front();
+        Latencies.push_back(now - request.ReadySince);
+        AckedBytes += request.Size;
+        SentRequests.pop_front();
+    }
+
+    if (Latencies.size() >= WINDOW_REQUESTS || now - WindowStartedAt >= Max(LatencyTarget, MIN_WINDOW_DURATION)) {
+        RecalculateImpl(now);
+        return true;
+    }
+    return false;
+}
+
+void TBatchingController::OnRetry() {
+    SentRequests.clear();
+}
+
+void TBatchingController::RecalculateImpl(TInstant now) {
+    const size_t p99Index = (Latencies.size() * 99 + 99) / 100 - 1;
+    std::nth_element(Latencies.begin(), Latencies.begin() + p99Index, Latencies.end());
+    LatencyP99 = Latencies[p99Index];
+
+    if (LatencyP99 > LatencyTarget) {
+        FlushInterval = Max(FlushInterval / 2, MinFlushInterval);
+    } else {
+        FlushInterval = Min(FlushInterval + LatencyTarget / 16, MaxFlushInterval);
+    }
+
+    // Expected size of a batch collected for the flush interval at the current write rate
+    const TDuration windowDuration = Max(now - WindowStartedAt, TDuration::MicroSeconds(1));
+    const double bytesPerInterval = static_cast<double>(AckedBytes) * FlushInterval.MicroSeconds() / windowDuration.MicroSeconds();
+    FlushSizeBytes = std::clamp<std::uint64_t>(static_cast<std::uint64_t>(bytesPerInterval), MIN_FLUSH_SIZE_BYTES, MaxFlushSizeBytes);
+
+    Latencies.clear();
+    AckedBytes = 0;
+    WindowStartedAt = now;
+}
+
+} // namespace NYdb::inline V3::NTopic
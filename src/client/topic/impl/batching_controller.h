@@ -0,0 +1,83 @@
+#pragma once
+
+#include <util/datetime/base.h>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace NYdb::inline V3::NTopic {
+
+// Decides when the write session sends ready messages to the server.
+// Like Nagle's algorithm, messages go to the wire at once if nothing is in flight, otherwise they wait
+// for the flush interval or until the expected batch size is reached. The interval is increased additively
+// while p99 of the write latency (from the moment messages are ready to the ack) stays below the target
+// and is halved otherwise; the expected batch size follows the observed write rate.
+// Not thread-safe, the write session calls it under its lock.
+class TBatchingController {
+public:
+    // maxFlushInterval and maxFlushSizeBytes bound the batches, zero values mean no bound
+    TBatchingController(TDuration latencyTarget, TDuration maxFlushInterval, std::uint64_t maxFlushSizeBytes);
+
+    // A block of the given size is ready to be sent
+    void OnReady(std::uint64_t size, TInstant now);
+
+    // Whether ready blocks should be sent now
+    bool ShouldSend(bool hasInflight, TInstant now) const;
+
+    // A write request is sent, lastId is the id of its last message
+    void OnSent(std::uint64_t size, std::uint64_t lastId, TInstant now);
+
+    // Message with the given id is acknowledged. Returns true if the flush interval was recalculated
+    bool OnAck(std::uint64_t id, TInstant now);
+
+    // Sent requests are going to be resent after reconnect, their latency is not measured
+    void OnRetry();
+
+    TDuration GetFlushInterval() const {
+        return FlushInterval;
+    }
+
+    std::uint64_t GetFlushSizeBytes() const {
+        return FlushSizeBytes;
+    }
+
+    TDuration GetLatencyP99() const {
+        return LatencyP99;
+    }
+
+    // Zero if there are no ready blocks
+    TInstant GetPendingSince() const {
+        return PendingSince;
+    }
+
+private:
+    void RecalculateImpl(TInstant now);
+
+private:
+    struct TSentRequest {
+        std::uint64_t LastId = 0;
+        std::uint64_t Size = 0;
+        TInstant ReadySince;
+    };
+
+    const TDuration LatencyTarget;
+    const TDuration MinFlushInterval;
+    const TDuration MaxFlushInterval;
+    const std::uint64_t MaxFlushSizeBytes;
+
+    TDuration FlushInterval;
+    std::uint64_t FlushSizeBytes;
+    TDuration LatencyP99;
+
+    std::uint64_t PendingBytes = 0;
+    TInstant PendingSince;
+    std::deque<TSentRequest> SentRequests;
+
+    // Latencies and acknowledged bytes of the current window
+    std::vector<TDuration> Latencies;
+    std::uint64_t AckedBytes = 0;
+    TInstant WindowStartedAt;
+};
+
+} // namespace NYdb::inline V3::NTopic
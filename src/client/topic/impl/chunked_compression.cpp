@@ -0,0 +1,88 @@
+#include "chunked_compression.h"
+
+#include <util/generic/yexception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace NYdb::inline V3::NTopic {
+
+bool IsChunkedCompressionSupported(ECodec codec) {
+    switch (codec) {
+        case ECodec::GZIP:
+        case ECodec::ZSTD:
+            return true;
+        case ECodec::LZ4:
+            // Id of the custom range, so the codec provided under it may be not the built-in one
+            try {
+                return dynamic_cast<const TLz4Codec*>(TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<uint32_t>(codec)));
+            } catch (const yexception&) {
+                return false;
+            }
+        default:
+            return false;
+    }
+}
+
+std::vector<std::vector<std::string_view>> SplitIntoChunks(const std::vector<std::string>& data, size_t chunkSize) {
+    std::vector<std::vector<std::string_view>> chunks(1);
+    size_t chunkFilled = 0;
+    for (std::string_view rest : data) {
+        while (!rest.empty()) {
+            if (chunkFilled == chunkSize) {
+                chunks.emplace_back();
+                chunkFilled = 0;
+            }
+            const size_t size = std::min(rest.size(), chunkSize - chunkFilled);
+            chunks.back().push_back(rest.substr(0, size));
+            chunkFilled += size;
+            rest.remove_prefix(size);
+        }
+    }
+    return chunks;
+}
+
+void CompressInChunks(IExecutor& executor, const std::vector<std::string>& data, ECodec codec, i32 level,
+    size_t chunkSize, std::function<void(TBuffer&& compressed)> onCompressed)
+{
+    struct TChunkedBlock {
+        std::vector<std::vector<std::string_view>> Inputs;
+        std::vector<TBuffer> Outputs;
+        std::atomic<size_t> ChunksLeft = 0;
+        std::function<void(TBuffer&&)> OnCompressed;
+    };
+
+    auto chunked = std::make_shared<TChunkedBlock>();
+    chunked->Inputs = SplitIntoChunks(data, chunkSize);
+    chunked->Outputs.resize(chunked->Inputs.size());
+    chunked->ChunksLeft = chunked->Inputs.size();
+    chunked->OnCompressed = std::move(onCompressed);
+
+    const auto* codecImpl = TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<ui32>(codec));
+    for (size_t i = 0; i < chunked->Inputs.size(); ++i) {
+        executor.Post([chunked, codecImpl, level, i] {
+            auto coder = codecImpl->CreateCoder(chunked->Outputs[i], level);
+            for (const auto& part : chunked->Inputs[i]) {
+                coder->Write(part.data(), part.size());
+            }
+            coder->Finish();
+            if (chunked->ChunksLeft.fetch_sub(1) != 1) {
+                return;
+            }
+
+            size_t compressedSize = 0;
+            for (const auto& output : chunked->Outputs) {
+                compressedSize += output.Size();
+            }
+            TBuffer compressed;
+            compressed.Reserve(compressedSize);
+            for (const auto& output : chunked->Outputs) {
+                compressed.Append(output.Data(), output.Size());
+            }
+            chunked->OnCompressed(std::move(compressed));
+        });
+    }
+}
+
+} // namespace NYdb::inline V3::NTopic
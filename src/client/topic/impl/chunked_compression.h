@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ydb-cpp-sdk/client/topic/codecs.h>
+#include <ydb-cpp-sdk/client/topic/executor.h>
+
+#include <util/generic/buffer.h>
+#include <util/generic/size_literals.h>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace NYdb::inline V3::NTopic {
+
+// Large blocks are compressed by chunks of this size in parallel, if the compression executor allows it
+constexpr size_t COMPRESSION_CHUNK_SIZE = 1_MB;
+
+// Decoders of these codecs read concatenated frames (gzip members) as one stream
+bool IsChunkedCompressionSupported(ECodec codec);
+
+std::vector<std::vector<std::string_view>> SplitIntoChunks(const std::vector<std::string>& data, size_t chunkSize);
+
+// Compresses every chunk into a frame of its own on the executor. Chunks complete in any order on different
+// workers, the last one concatenates the frames in the order of the data and passes them to onCompressed.
+// The data has to stay alive until onCompressed is called
+void CompressInChunks(IExecutor& executor, const std::vector<std::string>& data, ECodec codec, i32 level,
+    size_t chunkSize, std::function<void(TBuffer&& compressed)> onCompressed);
+
+} // namespace NYdb::inline V3::NTopic
@@ -0,0 +1,74 @@
+#include "commit_coalescer.h"
+
+#include <algorithm>
+
+namespace NYdb::inline V3::NTopic {
+
+size_t TCommitCoalescer::Add(std::int64_t partitionSessionId, std::uint64_t startOffset, std::uint64_t endOffset) {
+    auto [it, inserted] = Index.try_emplace(partitionSessionId, Partitions.size());
+    if (inserted) {
+        Partitions.emplace_back().PartitionSessionId = partitionSessionId;
+    }
+
+    auto& partition = Partitions[it->second];
+    if (!partition.Ranges.empty()) {
+        auto& last = partition.Ranges.back();
+        if (last.second == startOffset) {
+            last.second = endOffset;
+            return RangesCount;
+        }
+        if (startOffset < last.first) {
+            partition.Sorted = false;
+        }
+    }
+
+    partition.Ranges.emplace_back(startOffset, endOffset);
+    return ++RangesCount;
+}
+
+void TCommitCoalescer::Flush(Ydb::Topic::StreamReadMessage::CommitOffsetRequest& request) {
+    for (size_t i = 0; i < Partitions.size();) {
+        auto& partition = Partitions[i];
+        if (partition.Ranges.empty()) {
+            // Nothing was committed since the previous flush, the session is likely gone
+            Index.erase(partition.PartitionSessionId);
+            if (i + 1 != Partitions.size()) {
+                partition = std::move(Partitions.back());
+                Index[partition.PartitionSessionId] = i;
+            }
+            Partitions.pop_back();
+            continue;
+        }
+
+        if (!partition.Sorted) {
+            std::sort(partition.Ranges.begin(), partition.Ranges.end());
+        }
+
+        auto* commit = request.add_commit_offsets();
+        commit->set_partition_session_id(partition.PartitionSessionId);
+        for (size_t j = 0; j < partition.Ranges.size();) {
+            const auto start = partition.Ranges[j].first;
+            auto end = partition.Ranges[j].second;
+            for (++j; j < partition.Ranges.size() && partition.Ranges[j].first == end; ++j) {
+                end = partition.Ranges[j].second;
+            }
+
+            auto* range = commit->add_offsets();
+            range->set_start(start);
+            range->set_end(end);
+        }
+
+        partition.Ranges.clear();
+        partition.Sorted = true;
+        ++i;
+    }
+    RangesCount = 0;
+}
+
+void TCommitCoalescer::Clear() {
+    Partitions.clear();
+    Index.clear();
+    RangesCount = 0;
+}
+
+} // namespace NYdb::inline V3::NTopic
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <src/api/protos/ydb_topic.pb.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace NYdb::inline V3::NTopic {
+
+// Accumulates commit ranges of partition sessions between flushes and merges adjacent ones,
+// so that per-message commits of all partitions go to the server in one CommitOffsetRequest.
+// Buffers are kept between flushes, so a steady stream of commits does not allocate.
+class TCommitCoalescer {
+public:
+    // Returns the number of pending ranges after the addition
+    size_t Add(std::int64_t partitionSessionId, std::uint64_t startOffset, std::uint64_t endOffset);
+
+    // Moves pending ranges into the request
+    void Flush(Ydb::Topic::StreamReadMessage::CommitOffsetRequest& request);
+
+    // Drops pending ranges, e.g. when partition sessions are lost with the connection
+    void Clear();
+
+    bool Empty() const {
+        return RangesCount == 0;
+    }
+
+    size_t GetRangesCount() const {
+        return RangesCount;
+    }
+
+private:
+    struct TPartitionCommits {
+        std::int64_t PartitionSessionId = 0;
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> Ranges;
+        bool Sorted = true;
+    };
+
+    // Flat list of partition sessions committed since the previous flush, Index maps ids to positions
+    std::vector<TPartitionCommits> Partitions;
+    std::unordered_map<std::int64_t, size_t> Index;
+    size_t RangesCount = 0;
+};
+
+} // namespace NYdb::inline V3::NTopic
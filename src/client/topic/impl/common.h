@@ -7,8 +7,10 @@
 
 #include <src/client/common_client/impl/client.h>
 
+#include <atomic>
 #include <queue>
 #include <condition_variable>
+#include <utility>
 
 namespace NYdb::inline V3::NTopic {
 
@@ -355,13 +357,22 @@ protected:
     };
 
 
+    // Event pushed without the lock, see PushLockFree
+    struct TPushedEvent {
+        TEventInfo Info;
+        TPushedEvent* Next = nullptr;
+    };
+
 public:
     TBaseSessionEventsQueue(const TSettings& settings)
         : Settings(settings)
-        , Waiter(NThreading::NewPromise<void>(), this)
     {}
 
-    virtual ~TBaseSessionEventsQueue() = default;
+    virtual ~TBaseSessionEventsQueue() {
+        for (TPushedEvent* event = Pushed.load(); event;) {
+            delete std::exchange(event, event->Next);
+        }
+    }
 
 
     void Signal() override {
@@ -370,7 +381,7 @@ public:
 
 protected:
     virtual bool HasEventsImpl() const {  // Assumes that we're under lock.
-        return !Events.empty() || CloseEvent;
+        return !Events.empty() || CloseEvent || Pushed.load() != nullptr;
     }
 
     TWaiter PopWaiterImpl() { // Assumes that we're under lock.
@@ -380,7 +391,11 @@ protected:
     }
 
     void WaitEventsImpl() { // Assumes that we're under lock. Posteffect: HasEventsImpl() is true.
-        while (!HasEventsImpl()) {
+        while (true) {
+            WaiterArmed = true;
+            if (HasEventsImpl()) {
+                break;
+            }
             std::unique_lock<std::mutex> lk(Mutex, std::adopt_lock);
             CondVar.wait(lk);
             lk.release();
@@ -389,11 +404,36 @@ protected:
 
     void RenewWaiterImpl() {
         if (Events.empty() && WaiterWillBeSignaled) {
-            Waiter = TWaiter(NThreading::NewPromise<void>(), this);
+            // The promise is created by the next WaitEvent call, consumers that do not wait on futures never allocate it
+            Waiter = TWaiter();
             WaiterWillBeSignaled = false;
         }
     }
 
+    // Multi-producer push that does not take the lock. Returns true if a consumer may be waiting for events:
+    // then the caller has to signal it with PopWaiterImpl under the lock and notify all CondVar waiters.
+    bool PushLockFree(TEventInfo&& eventInfo) {
+        auto* event = new TPushedEvent{std::move(eventInfo)};
+        event->Next = Pushed.load(std::memory_order_relaxed);
+        while (!Pushed.compare_exchange_weak(event->Next, event)) {
+        }
+        // Pairs with arming in WaitEvent and WaitEventsImpl: either the consumer sees the pushed event,
+        // or the producer sees the armed waiter
+        return WaiterArmed.load() && WaiterArmed.exchange(false);
+    }
+
+    void DrainPushedImpl() { // Assumes that we're under lock.
+        TPushedEvent* reversed = Pushed.exchange(nullptr);
+        TPushedEvent* ordered = nullptr;
+        while (reversed) {
+            ordered = std::exchange(reversed, std::exchange(reversed->Next, ordered));
+        }
+        while (ordered) {
+            Events.emplace(std::move(ordered->Info));
+            delete std::exchange(ordered, ordered->Next);
+        }
+    }
+
     virtual void SelfCheck() {
     }
 
@@ -403,6 +443,7 @@ public:
         NThreading::TFuture<void> res;
         {
             std::lock_guard<std::mutex> guard (Mutex);
+            WaiterArmed = true;
             if (HasEventsImpl()) {
                 return NThreading::MakeFuture(); // Signalled
             } else {
@@ -411,7 +452,9 @@ public:
                     needSelfCheck = true;
                 }
 
-                Y_ABORT_UNLESS(Waiter.Valid());
+                if (!Waiter.Valid()) {
+                    Waiter = TWaiter(NThreading::NewPromise<void>(), this);
+                }
                 res = Waiter.GetFuture();
             }
         }
@@ -434,6 +477,10 @@ protected:
     std::mutex Mutex;
     std::optional<TClosedEvent> CloseEvent;
     std::atomic<bool> Closed = false;
+    // Stack of events pushed by PushLockFree, newest first
+    std::atomic<TPushedEvent*> Pushed = nullptr;
+    // Set by consumers before they check for events and wait
+    std::atomic<bool> WaiterArmed = false;
 
 private:
     TInstant LastSelfCheckAt = TInstant::Now();
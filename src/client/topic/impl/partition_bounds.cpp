@@ -0,0 +1,73 @@
+#include "partition_bounds.h"
+
+#include <util/system/byteorder.h>
+#include <util/system/yassert.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace NYdb::inline V3::NTopic {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// THashedKey
+
+bool THashedKey::Fits(const std::string_view key) {
+    return key.size() <= MAX_SIZE;
+}
+
+THashedKey THashedKey::FromString(const std::string_view key) {
+    Y_ABORT_UNLESS(Fits(key), "Key of %zu bytes does not fit into THashedKey", key.size());
+
+    char bytes[MAX_SIZE] = {};
+    memcpy(bytes, key.data(), key.size());
+
+    THashedKey result;
+    memcpy(&result.Hi, bytes, 8);
+    memcpy(&result.Lo, bytes + 8, 8);
+    result.Hi = InetToHost(result.Hi);
+    result.Lo = InetToHost(result.Lo);
+    result.Size = key.size();
+    return result;
+}
+
+THashedKey THashedKey::FromUint64(std::uint64_t value) {
+    // Same as FromString(DefaultPartitioningKeyHasher(key)) for value being the hash of the key
+    return THashedKey{.Hi = value, .Lo = 0, .Size = 8};
+}
+
+std::string THashedKey::ToString() const {
+    char bytes[MAX_SIZE];
+    const std::uint64_t hiBe = HostToInet(Hi);
+    const std::uint64_t loBe = HostToInet(Lo);
+    memcpy(bytes, &hiBe, 8);
+    memcpy(bytes + 8, &loBe, 8);
+    return std::string(bytes, Size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// TPartitionBounds
+
+void TPartitionBounds::Rebuild(const std::map<std::string, std::uint32_t>& partitionsIndex) {
+    Bounds.clear();
+    PartitionIds.clear();
+    for (const auto& [bound, _] : partitionsIndex) {
+        if (!THashedKey::Fits(bound)) {
+            return;
+        }
+    }
+
+    Bounds.reserve(partitionsIndex.size());
+    PartitionIds.reserve(partitionsIndex.size());
+    for (const auto& [bound, partitionId] : partitionsIndex) {
+        Bounds.push_back(THashedKey::FromString(bound));
+        PartitionIds.push_back(partitionId);
+    }
+}
+
+std::uint32_t TPartitionBounds::Find(const THashedKey& hashedKey) const {
+    auto upperBound = std::upper_bound(Bounds.begin(), Bounds.end(), hashedKey);
+    Y_ABORT_IF(upperBound == Bounds.begin(), "Lower bound is the first element");
+    return PartitionIds[std::prev(upperBound) - Bounds.begin()];
+}
+
+} // namespace NYdb::inline V3::NTopic
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace NYdb::inline V3::NTopic {
+
+// Hashed partitioning key or partition bound packed into two big-endian words.
+// Comparison of packed values matches the lexicographic comparison of the original strings.
+struct THashedKey {
+    static constexpr size_t MAX_SIZE = 16;
+
+    static bool Fits(const std::string_view key);
+    static THashedKey FromString(const std::string_view key);
+    static THashedKey FromUint64(std::uint64_t value);
+
+    std::string ToString() const;
+
+    auto operator<=>(const THashedKey& other) const = default;
+
+    std::uint64_t Hi = 0;
+    std::uint64_t Lo = 0;
+    std::uint8_t Size = 0;
+};
+
+// Flat copy of the producer's partition bound -> partition id index searched by the bound partition chooser.
+// Empty if some of the bounds do not fit into THashedKey, the index itself has to be searched then.
+class TPartitionBounds {
+public:
+    void Rebuild(const std::map<std::string, std::uint32_t>& partitionsIndex);
+
+    // The partition with the greatest bound not exceeding the key
+    std::uint32_t Find(const THashedKey& hashedKey) const;
+
+    bool Empty() const {
+        return Bounds.empty();
+    }
+
+private:
+    std::vector<THashedKey> Bounds;
+    std::vector<std::uint32_t> PartitionIds;
+};
+
+} // namespace NYdb::inline V3::NTopic
@@ -51,9 +51,9 @@ bool TProducer::TPartitionInfo::IsSplitted() const {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // TProducer::TMessageInfo
 
-TProducer::TMessageInfo::TMessageInfo(const std::string& key, const std::string& choosePartitionKey, TWriteMessage&& message, std::uint32_t partition)
-    : Key(key)
-    , Data(message.Data)
+TProducer::TMessageInfo::TMessageInfo(std::string&& key, std::string&& choosePartitionKey, TWriteMessage&& message, std::uint32_t partition)
+    : Key(std::move(key))
+    , Data(message.ReleaseData())
     , Codec(message.Codec)
     , OriginalSize(message.OriginalSize)
     , SeqNo(message.SeqNo_)
@@ -61,12 +61,9 @@ TProducer::TMessageInfo::TMessageInfo(const std::string& key, const std::string&
     , Tx(message.Tx_)
     , Partition(partition)
 {
-    for (const auto& [key, value] : message.MessageMeta_) {
-        MessageMeta.Fields.emplace_back(key, value);
-    }
-
+    MessageMeta.Fields = std::move(message.MessageMeta_);
     if (!choosePartitionKey.empty()) {
-        MessageMeta.Fields.emplace_back(PARTITION_KEY_META_KEY, choosePartitionKey);
+        MessageMeta.Fields.emplace_back(PARTITION_KEY_META_KEY, std::move(choosePartitionKey));
     }
 }
 
@@ -343,6 +340,7 @@ void TProducer::TSplittedPartitionWorker::HandleDescribeResult() {
             .ToBound(childPartitionInfo.ToBound)
             .Locked(true);
     }
+    Producer->RebuildPartitionBounds();
 
     splittedPartitionIt->second.Children(children);
 }
@@ -1294,12 +1292,12 @@ bool TProducer::TMessagesWorker::IsMemoryUsageOK() const {
 }
 
 void TProducer::TMessagesWorker::AddMessage(
-    const std::string& key,
-    const std::string& choosePartitionKey,
+    std::string&& key,
+    std::string&& choosePartitionKey,
     TWriteMessage&& message,
     std::uint32_t partition) {
     MemoryUsage += message.Data.size();
-    PushInFlightMessage(partition, TMessageInfo(key, choosePartitionKey, std::move(message), partition));
+    PushInFlightMessage(partition, TMessageInfo(std::move(key), std::move(choosePartitionKey), std::move(message), partition));
 }
 
 std::optional<TContinuationToken> TProducer::TMessagesWorker::GetContinuationToken(std::uint32_t partition) {
@@ -1657,6 +1655,9 @@ TProducer::TProducer(
     switch (partitionChooserStrategy) {
         case TProducerSettings::EPartitionChooserStrategy::Bound:
             PartitioningKeyHasher = settings.PartitioningKeyHasher_;
+            if (auto hasher = PartitioningKeyHasher.target<std::string(*)(const std::string_view)>()) {
+                DefaultPartitioningKeyHasher = *hasher == &TProducerSettings::DefaultPartitioningKeyHasher;
+            }
             PartitionChooser = std::make_unique<TBoundPartitionChooser>(this);
             for (size_t i = 0; i < partitions.size(); ++i) {
                 const auto& partition = partitions[i];
@@ -1670,6 +1671,7 @@ TProducer::TProducer(
 
                 PartitionsIndex[partition.GetFromBound().value_or("")] = partition.GetPartitionId();
             }
+            RebuildPartitionBounds();
             break;
         case TProducerSettings::EPartitionChooserStrategy::KafkaHash:
             if (autoPartitioningEnabled) {
@@ -1726,6 +1728,10 @@ std::unordered_map<std::uint32_t, TProducer::TPartitionInfo> TProducer::GetParti
     return Partitions;
 }
 
+void TProducer::RebuildPartitionBounds() {
+    PartitionBounds.Rebuild(PartitionsIndex);
+}
+
 std::map<std::string, std::uint32_t> TProducer::GetPartitionsIndex() const {
     std::lock_guard lock(GlobalLock);
     return PartitionsIndex;
@@ -2132,17 +2138,13 @@ TWriteResult TProducer::WriteInternal(TContinuationToken&&, TWriteMessage&& mess
             chosenPartition = message.GetPartition().value();
         } else if (!message.GetKey().has_value()) {
             key = Settings.ProducerIdPrefix_;
-            const auto partitionChoice = PartitionChooser->ChoosePartition(Settings.ProducerIdPrefix_);
-            chosenPartition = partitionChoice.first;
-            choosePartitionKey = partitionChoice.second;
+            std::tie(chosenPartition, choosePartitionKey) = PartitionChooser->ChoosePartition(key);
         } else {
-            const auto partitionChoice = PartitionChooser->ChoosePartition(*message.GetKey());
-            chosenPartition = partitionChoice.first;
-            choosePartitionKey = partitionChoice.second;
             key = *message.GetKey();
+            std::tie(chosenPartition, choosePartitionKey) = PartitionChooser->ChoosePartition(key);
         }
 
-        MessagesWorker->AddMessage(key, choosePartitionKey, std::move(message), chosenPartition);
+        MessagesWorker->AddMessage(std::move(key), std::move(choosePartitionKey), std::move(message), chosenPartition);
         eventsPromise = EventsWorker->HandleNewMessage();
         RunUserEventLoop();
     }
@@ -2245,7 +2247,15 @@ TProducer::TBoundPartitionChooser::TBoundPartitionChooser(TProducer* producer)
 {}
 
 std::pair<std::uint32_t, std::string> TProducer::TBoundPartitionChooser::ChoosePartition(const std::string_view key) {
+    if (Producer->DefaultPartitioningKeyHasher && !Producer->PartitionBounds.Empty()) {
+        const auto hashedKey = THashedKey::FromUint64(MurmurHash<std::uint64_t>(key.data(), key.size(), std::uint64_t{0}));
+        return { Producer->PartitionBounds.Find(hashedKey), hashedKey.ToString() };
+    }
+
     auto hashedKey = Producer->PartitioningKeyHasher(key);
+    if (!Producer->PartitionBounds.Empty() && THashedKey::Fits(hashedKey)) {
+        return { Producer->PartitionBounds.Find(THashedKey::FromString(hashedKey)), std::move(hashedKey) };
+    }
 
     auto lowerBound = Producer->PartitionsIndex.lower_bound(hashedKey);
     if (lowerBound != Producer->PartitionsIndex.end() && lowerBound->first == hashedKey) {
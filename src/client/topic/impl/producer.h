@@ -1,6 +1,7 @@
 #pragma once
 
 #include <src/client/topic/common/callback_context.h>
+#include <src/client/topic/impl/partition_bounds.h>
 #include <src/client/topic/impl/write_session_impl.h>
 #include <src/client/topic/impl/topic_impl.h>
 #include <ydb-cpp-sdk/client/topic/producer.h>
@@ -42,7 +43,7 @@ private:
     };
 
     struct TMessageInfo {
-        TMessageInfo(const std::string& key, const std::string& choosePartitionKey, TWriteMessage&& message, std::uint32_t partition);
+        TMessageInfo(std::string&& key, std::string&& choosePartitionKey, TWriteMessage&& message, std::uint32_t partition);
 
         std::string Key;
         std::string Data;
@@ -155,7 +156,7 @@ private:
         
         void DoWork();
 
-        void AddMessage(const std::string& key, const std::string& choosePartitionKey, TWriteMessage&& message, std::uint32_t partition);
+        void AddMessage(std::string&& key, std::string&& choosePartitionKey, TWriteMessage&& message, std::uint32_t partition);
         void ScheduleResendMessages(std::uint32_t partition, std::uint64_t afterSeqNo);
         void RebuildPendingMessagesIndex(std::uint32_t partition);
         void HandleAck();
@@ -388,6 +389,8 @@ private:
 
     void NextEpoch();
 
+    void RebuildPartitionBounds();
+
     TWriteResult WriteInternal(TContinuationToken&&, TWriteMessage&& message);
 
     bool IsFederation(const std::string& endpoint);
@@ -440,6 +443,8 @@ private:
 
     std::unordered_map<std::uint32_t, TPartitionInfo> Partitions;
     std::map<std::string, std::uint32_t> PartitionsIndex;
+    // Flat copy of PartitionsIndex searched by the bound partition chooser
+    TPartitionBounds PartitionBounds;
 
     TProducerSettings Settings;
     ESeqNoStrategy SeqNoStrategy = ESeqNoStrategy::NotInitialized;
@@ -457,6 +462,8 @@ private:
     std::unique_ptr<IPartitionChooser> PartitionChooser;
 
     std::function<std::string(const std::string_view key)> PartitioningKeyHasher;
+    // The default hasher is inlined by the bound partition chooser
+    bool DefaultPartitioningKeyHasher = false;
 
     std::shared_ptr<TEventsWorker> EventsWorker;
     std::shared_ptr<TSessionsWorker> SessionsWorker;
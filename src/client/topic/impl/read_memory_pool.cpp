@@ -0,0 +1,141 @@
+#include "read_memory_pool.h"
+
+#include <algorithm>
+
+namespace NYdb::inline V3::NTopic {
+
+namespace {
+
+// Shared by all pools, so that a session destroyed by its wakeup callback never joins the executor thread
+IExecutor::TPtr GetWakeupExecutor() {
+    static IExecutor::TPtr executor = [] {
+        auto result = CreateThreadPoolExecutor(1);
+        result->Start();
+        return result;
+    }();
+    return executor;
+}
+
+}
+
+IReadSessionMemoryPool::TPtr CreateReadSessionMemoryPool(size_t maxMemoryUsageBytes) {
+    return std::make_shared<TReadSessionMemoryPool>(maxMemoryUsageBytes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TReadSessionMemoryPool::TReservation
+
+TReadSessionMemoryPool::TReservation::TReservation(std::shared_ptr<TReadSessionMemoryPool> pool, std::function<void()> onMemoryReleased)
+    : Pool(std::move(pool))
+    , OnMemoryReleased(std::move(onMemoryReleased))
+{
+    Pool->Add(this);
+}
+
+TReadSessionMemoryPool::TReservation::~TReservation() {
+    Pool->Remove(this);
+}
+
+void TReadSessionMemoryPool::TReservation::Update(i64 usage) {
+    const i64 delta = usage - Usage.exchange(usage);
+    if (delta == 0) {
+        return;
+    }
+    Pool->MemoryUsage += delta;
+    if (delta < 0) {
+        Pool->WakeWaiters();
+    }
+}
+
+i64 TReadSessionMemoryPool::TReservation::GetLimit() const {
+    const i64 fairShare = Pool->MaxMemoryUsageBytes / std::max<i64>(Pool->SessionsCount.load(), 1);
+    const i64 unused = Pool->MaxMemoryUsageBytes - Pool->MemoryUsage.load();
+    return std::max<i64>({fairShare, Usage.load() + unused, 1});
+}
+
+void TReadSessionMemoryPool::TReservation::WaitForMemory(i64 localLimit) {
+    const i64 limit = GetLimit();
+    if (limit >= localLimit) {
+        return;
+    }
+
+    {
+        std::lock_guard guard(Pool->Lock);
+        if (!Waiting) {
+            Waiting = true;
+            ++Pool->WaitersCount;
+        }
+    }
+    // Memory could be released before the session started waiting
+    if (std::min(localLimit, GetLimit()) > limit) {
+        Pool->WakeWaiters();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TReadSessionMemoryPool
+
+TReadSessionMemoryPool::TReadSessionMemoryPool(size_t maxMemoryUsageBytes)
+    : MaxMemoryUsageBytes(std::max<i64>(static_cast<i64>(maxMemoryUsageBytes), 1))
+    , WakeupExecutor(GetWakeupExecutor())
+{}
+
+std::unique_ptr<TReadSessionMemoryPool::TReservation> TReadSessionMemoryPool::Register(std::function<void()> onMemoryReleased) {
+    return std::make_unique<TReservation>(shared_from_this(), std::move(onMemoryReleased));
+}
+
+size_t TReadSessionMemoryPool::GetMemoryUsage() const {
+    return std::max<i64>(MemoryUsage.load(), 0);
+}
+
+size_t TReadSessionMemoryPool::GetSessionsCount() const {
+    return SessionsCount.load();
+}
+
+void TReadSessionMemoryPool::Add(TReservation* reservation) {
+    std::lock_guard guard(Lock);
+    Reservations.push_back(reservation);
+    ++SessionsCount;
+}
+
+void TReadSessionMemoryPool::Remove(TReservation* reservation) {
+    {
+        std::lock_guard guard(Lock);
+        Reservations.erase(std::find(Reservations.begin(), Reservations.end(), reservation));
+        if (reservation->Waiting) {
+            --WaitersCount;
+        }
+        --SessionsCount;
+        MemoryUsage -= reservation->Usage.load();
+    }
+    // Fair shares of the other sessions grew
+    WakeWaiters();
+}
+
+void TReadSessionMemoryPool::WakeWaiters() {
+    if (WaitersCount.load() == 0) {
+        return;
+    }
+
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard guard(Lock);
+        for (auto* reservation : Reservations) {
+            if (reservation->Waiting) {
+                reservation->Waiting = false;
+                --WaitersCount;
+                callbacks.push_back(reservation->OnMemoryReleased);
+            }
+        }
+    }
+
+    if (!callbacks.empty()) {
+        WakeupExecutor->Post([callbacks = std::move(callbacks)] {
+            for (const auto& callback : callbacks) {
+                callback();
+            }
+        });
+    }
+}
+
+} // namespace NYdb::inline V3::NTopic
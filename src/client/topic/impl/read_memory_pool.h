@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ydb-cpp-sdk/client/topic/read_session.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace NYdb::inline V3::NTopic {
+
+class TReadSessionMemoryPool : public IReadSessionMemoryPool,
+                               public std::enable_shared_from_this<TReadSessionMemoryPool> {
+public:
+    //! Share of the pool held by one read session
+    class TReservation {
+        friend class TReadSessionMemoryPool;
+
+    public:
+        TReservation(std::shared_ptr<TReadSessionMemoryPool> pool, std::function<void()> onMemoryReleased);
+        ~TReservation();
+
+        //! Sets the number of bytes held by the session
+        void Update(i64 usage);
+
+        //! Max number of bytes the session may hold now:
+        //! its fair share of the budget or its current usage plus the unused part of the budget, whichever is greater
+        i64 GetLimit() const;
+
+        //! The session hit its memory limit: if the pool is what limits it (GetLimit() is below localLimit,
+        //! the own limit of the session), schedules onMemoryReleased as soon as other sessions release memory.
+        //! A session limited by its own limit does not wait, it continues when its data is consumed
+        void WaitForMemory(i64 localLimit);
+
+    private:
+        const std::shared_ptr<TReadSessionMemoryPool> Pool;
+        const std::function<void()> OnMemoryReleased;
+        std::atomic<i64> Usage = 0;
+        // Guarded by the pool lock
+        bool Waiting = false;
+    };
+
+    explicit TReadSessionMemoryPool(size_t maxMemoryUsageBytes);
+
+    std::unique_ptr<TReservation> Register(std::function<void()> onMemoryReleased);
+
+    size_t GetMemoryUsage() const override;
+    size_t GetSessionsCount() const override;
+
+private:
+    void Add(TReservation* reservation);
+    void Remove(TReservation* reservation);
+    void WakeWaiters();
+
+private:
+    const i64 MaxMemoryUsageBytes;
+    std::atomic<i64> MemoryUsage = 0;
+    std::atomic<i64> SessionsCount = 0;
+    std::atomic<size_t> WaitersCount = 0;
+    // Sessions call the pool under their own locks, so wakeups never run inline
+    const IExecutor::TPtr WakeupExecutor;
+
+    std::mutex Lock;
+    std::vector<TReservation*> Reservations;
+};
+
+} // namespace NYdb::inline V3::NTopic
@@ -79,8 +79,8 @@ void TPrintable<TPartitionSession>::DebugString(TStringBuilder& res, bool) const
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // NTopic::TReadSessionEvent::TDataReceivedEvent::TMessageBase
 
-TMessageBase::TMessageBase(const std::string& data, TMessageInformation info)
-    : Data(data)
+TMessageBase::TMessageBase(std::string data, TMessageInformation info)
+    : Data(std::move(data))
     , Information(std::move(info))
 {}
 
@@ -163,11 +163,11 @@ void TPrintable<TMessageBase>::DebugString(TStringBuilder& ret, bool printData)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // NTopic::TReadSessionEvent::TDataReceivedEvent::TMessage
 
-TMessage::TMessage(const std::string& data,
+TMessage::TMessage(std::string data,
                    std::exception_ptr decompressionException,
                    TMessageInformation information,
                    TPartitionSession::TPtr partitionSession)
-    : TMessageBase(data, std::move(information))
+    : TMessageBase(std::move(data), std::move(information))
     , TPartitionSessionAccessor(std::move(partitionSession))
     , DecompressionException(std::move(decompressionException)) {
 }
@@ -208,10 +208,10 @@ void TPrintable<TMessage>::DebugString(TStringBuilder& ret, bool printData) cons
 // NTopic::TReadSessionEvent::TDataReceivedEvent::TCompressedMessage
 
 TCompressedMessage::TCompressedMessage(ECodec codec,
-                                       const std::string& data,
+                                       std::string data,
                                        TMessageInformation information,
                                        TPartitionSession::TPtr partitionSession)
-    : TMessageBase(data, std::move(information))
+    : TMessageBase(std::move(data), std::move(information))
     , TPartitionSessionAccessor(std::move(partitionSession))
     , Codec(codec) {
 }
@@ -4,9 +4,11 @@
 #error "Do not include this file directly. Use read_session_impl.ipp instead."
 #endif
 
+#include "commit_coalescer.h"
 #include "common.h"
 #include "counters_logger.h"
 #include "offsets_collector.h"
+#include "read_memory_pool.h"
 #include "transaction.h"
 #include "direct_reader.h"
 
@@ -1322,6 +1324,8 @@ private:
     // Read/Write.
     void ReadFromProcessorImpl(TDeferredActions<UseMigrationProtocol>& deferred); // Assumes that we're under lock.
     void WriteToProcessorImpl(TClientMessage<UseMigrationProtocol>&& req); // Assumes that we're under lock.
+    void FlushCommitsImpl(); // Assumes that we're under lock.
+    void ScheduleCommitsFlush();
     void OnReadDone(NYdbGrpc::TGrpcStatus&& grpcStatus, size_t connectionGeneration);
 
     // Direct Read
@@ -1340,16 +1344,25 @@ private:
 
     void StartDecompressionTasksImpl(TDeferredActions<UseMigrationProtocol>& deferred); // Assumes that we're under lock.
 
+    // Settings.MaxMemoryUsageBytes_ or less if the memory pool of the session is short of memory
+    i64 GetMemoryLimit() const {
+        const i64 limit = static_cast<i64>(Settings.MaxMemoryUsageBytes_);
+        return MemoryReservation ? Min(limit, MemoryReservation->GetLimit()) : limit;
+    }
+
     i64 GetCompressedDataSizeLimit() const {
-        const double overallLimit = static_cast<double>(Settings.MaxMemoryUsageBytes_);
-        // CompressedDataSize + CompressedDataSize * AverageCompressionRatio <= Settings.MaxMemoryUsageBytes_
+        const double overallLimit = static_cast<double>(GetMemoryLimit());
+        // CompressedDataSize + CompressedDataSize * AverageCompressionRatio <= GetMemoryLimit()
         return Max<i64>(1l, static_cast<i64>(overallLimit / (1.0 + AverageCompressionRatio)));
     }
 
     i64 GetDecompressedDataSizeLimit() const {
-        return Max<i64>(1l, static_cast<i64>(Settings.MaxMemoryUsageBytes_) - GetCompressedDataSizeLimit());
+        return Max<i64>(1l, GetMemoryLimit() - GetCompressedDataSizeLimit());
     }
 
+    void SyncMemoryPoolImpl(); // Assumes that we're under lock.
+    void OnMemoryPoolReleased();
+
     bool GetRangesMode() const;
 
     void CallCloseCallbackImpl();
@@ -1500,6 +1513,9 @@ private:
     std::unordered_map<ui64, TIntrusivePtr<TPartitionStreamImpl<UseMigrationProtocol>>> PartitionStreams; // assignId -> Partition stream.
     std::optional<TDirectReadSessionManager> DirectReadSessionManager; // Only for ydb_topic
     TPartitionCookieMapping CookieMapping;  // Only for ydb_persqueue
+    TCommitCoalescer CommitCoalescer; // Only for ydb_topic
+    std::unique_ptr<TReadSessionMemoryPool::TReservation> MemoryReservation; // Only for ydb_topic
+    bool CommitsFlushScheduled = false;
     std::deque<TDecompressionQueueItem> DecompressionQueue;
     bool DataReadingSuspended = false;
 
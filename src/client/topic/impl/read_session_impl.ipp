@@ -273,6 +273,16 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::Start() {
     Y_ABORT_UNLESS(this->SelfContext);
     Settings.DecompressionExecutor_->Start();
     Settings.EventHandlers_.HandlersExecutor_->Start();
+    if constexpr (!UseMigrationProtocol) {
+        if (auto pool = std::dynamic_pointer_cast<TReadSessionMemoryPool>(Settings.MemoryPool_)) {
+            std::lock_guard guard(Lock);
+            MemoryReservation = pool->Register([cbContext = this->SelfContext]() {
+                if (auto borrowedSelf = cbContext->LockShared()) {
+                    borrowedSelf->OnMemoryPoolReleased();
+                }
+            });
+        }
+    }
     if (!Reconnect(TPlainStatus())) {
         AbortSession(EStatus::ABORTED, "Driver is stopping");
     }
@@ -589,13 +599,16 @@ template<bool UseMigrationProtocol>
 void TSingleClusterReadSessionImpl<UseMigrationProtocol>::ContinueReadingDataImpl() {
     Y_ABORT_UNLESS(Lock.IsLocked());
 
+    SyncMemoryPoolImpl();
+    const bool hasMemory = CompressedDataSize < GetCompressedDataSizeLimit()
+        && CompressedDataSize + DecompressedDataSize < GetMemoryLimit();
+
     if (!Closing
         && !Aborting
         && !WaitingReadResponse
         && !DataReadingSuspended
         && Processor
-        && CompressedDataSize < GetCompressedDataSizeLimit()
-        && static_cast<size_t>(CompressedDataSize + DecompressedDataSize) < Settings.MaxMemoryUsageBytes_)
+        && hasMemory)
     {
         TClientMessage<UseMigrationProtocol> req;
         if constexpr (UseMigrationProtocol) {
@@ -608,9 +621,14 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::ContinueReadingDataImp
             if (ReadSizeBudget <= 0 || ReadSizeServerDelta + ReadSizeBudget <= 0) {
                 return;
             }
-            req.mutable_read_request()->set_bytes_size(ReadSizeBudget);
-            ReadSizeServerDelta += ReadSizeBudget;
-            UpdateReadSizeBudgetCounter(ReadSizeBudget = 0);
+            // With a memory pool the server is asked only for the data the pool can hold now,
+            // the rest of the budget is kept for the next requests
+            const i64 readSize = MemoryReservation
+                ? Min(ReadSizeBudget, GetCompressedDataSizeLimit() - CompressedDataSize)
+                : ReadSizeBudget;
+            req.mutable_read_request()->set_bytes_size(readSize);
+            ReadSizeServerDelta += readSize;
+            UpdateReadSizeBudgetCounter(ReadSizeBudget -= readSize);
         }
 
         WriteToProcessorImpl(std::move(req));
@@ -618,7 +636,31 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::ContinueReadingDataImp
                  GetLogPrefix() << "After sending read request: ReadSizeBudget = " << ReadSizeBudget
                                 << ", ReadSizeServerDelta = " << ReadSizeServerDelta);
         WaitingReadResponse = true;
+    } else if (MemoryReservation && !hasMemory && !Closing && !Aborting) {
+        // Continue when other sessions of the pool release memory
+        MemoryReservation->WaitForMemory(static_cast<i64>(Settings.MaxMemoryUsageBytes_));
+    }
+}
+
+template<bool UseMigrationProtocol>
+void TSingleClusterReadSessionImpl<UseMigrationProtocol>::SyncMemoryPoolImpl() {
+    Y_ABORT_UNLESS(Lock.IsLocked());
+
+    if (MemoryReservation) {
+        MemoryReservation->Update(CompressedDataSize + DecompressedDataSize);
+    }
+}
+
+template<bool UseMigrationProtocol>
+void TSingleClusterReadSessionImpl<UseMigrationProtocol>::OnMemoryPoolReleased() {
+    TDeferredActions<UseMigrationProtocol> deferred;
+    std::lock_guard guard(Lock);
+    if (Aborting) {
+        return;
     }
+
+    ContinueReadingDataImpl();
+    StartDecompressionTasksImpl(deferred);
 }
 
 template<bool UseMigrationProtocol>
@@ -740,6 +782,9 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::ConfirmPartitionStream
             NTopic::TReadSessionEvent::TPartitionSessionClosedEvent
     >;
 
+    // Pending commits of the partition session must reach the server before its stop confirmation
+    FlushCommitsImpl();
+
     CookieMapping.RemoveMapping(GetPartitionStreamId(partitionStream));
     PartitionStreams.erase(partitionStream->GetAssignId());
 
@@ -783,6 +828,27 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::Commit(const TPartitio
         GetLogPrefix() << "Commit offsets [" << startOffset << ", " << endOffset
             << "). Partition stream id: " << GetPartitionStreamId(partitionStream)
     );
+    if constexpr (!UseMigrationProtocol) {
+        if (Settings.CommitBatchWindow_ && ScheduleCallbackFunc) {
+            {
+                std::lock_guard guard(Lock);
+                if (Aborting || Closing || !IsActualPartitionStreamImpl(partitionStream)) { // Got previous incarnation.
+                    return;
+                }
+                if (CommitCoalescer.Add(partitionStream->GetAssignId(), startOffset, endOffset) >= Settings.MaxCommitBatchRanges_) {
+                    FlushCommitsImpl();
+                    return;
+                }
+                if (CommitsFlushScheduled) {
+                    return;
+                }
+                CommitsFlushScheduled = true;
+            }
+            ScheduleCommitsFlush();
+            return;
+        }
+    }
+
     std::lock_guard guard(Lock);
     if (Aborting || Closing || !IsActualPartitionStreamImpl(partitionStream)) { // Got previous incarnation.
         return;
@@ -885,6 +951,37 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::WriteToProcessorImpl(
     }
 }
 
+template<bool UseMigrationProtocol>
+void TSingleClusterReadSessionImpl<UseMigrationProtocol>::FlushCommitsImpl() {
+    Y_ABORT_UNLESS(Lock.IsLocked());
+
+    if constexpr (!UseMigrationProtocol) {
+        if (CommitCoalescer.Empty()) {
+            return;
+        }
+
+        LOG_LAZY(Log, TLOG_DEBUG, GetLogPrefix() << "Flush " << CommitCoalescer.GetRangesCount() << " pending commit ranges");
+        TClientMessage<UseMigrationProtocol> req;
+        CommitCoalescer.Flush(*req.mutable_commit_offset_request());
+        WriteToProcessorImpl(std::move(req));
+    }
+}
+
+template<bool UseMigrationProtocol>
+void TSingleClusterReadSessionImpl<UseMigrationProtocol>::ScheduleCommitsFlush() {
+    Y_ABORT_UNLESS(this->SelfContext);
+
+    ScheduleCallbackFunc(Settings.CommitBatchWindow_, [cbContext = this->SelfContext](bool) {
+        if (auto borrowedSelf = cbContext->LockShared()) {
+            std::lock_guard guard(borrowedSelf->Lock);
+            borrowedSelf->CommitsFlushScheduled = false;
+            if (!borrowedSelf->Aborting) {
+                borrowedSelf->FlushCommitsImpl();
+            }
+        }
+    }, nullptr);
+}
+
 template<bool UseMigrationProtocol>
 bool TSingleClusterReadSessionImpl<UseMigrationProtocol>::HasCommitsInflightImpl() const {
     Y_ABORT_UNLESS(Lock.IsLocked());
@@ -1759,13 +1856,15 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::StartDecompressionTask
         return;
     }
     UpdateMemoryUsageStatisticsImpl();
+    SyncMemoryPoolImpl();
     const i64 limit = GetDecompressedDataSizeLimit();
+    const i64 memoryLimit = GetMemoryLimit();
     Y_ABORT_UNLESS(limit > 0);
     while (
         !DecompressionQueue.empty()
         && (DecompressEverything
             || (DecompressedDataSize < limit
-                && (static_cast<size_t>(CompressedDataSize + DecompressedDataSize) < Settings.MaxMemoryUsageBytes_
+                && (CompressedDataSize + DecompressedDataSize < memoryLimit
                     || DecompressedDataSize == 0 /* Allow decompression of at least one message even if memory is full. */)))
     ) {
         TDecompressionQueueItem& current = DecompressionQueue.front();
@@ -1780,6 +1879,11 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::StartDecompressionTask
             break;
         }
     }
+
+    if (MemoryReservation && !DecompressionQueue.empty() && !Aborting) {
+        // Continue when other sessions of the pool release memory
+        MemoryReservation->WaitForMemory(static_cast<i64>(Settings.MaxMemoryUsageBytes_));
+    }
 }
 
 template<bool UseMigrationProtocol>
@@ -1803,6 +1907,7 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::DestroyAllPartitionStr
     }
     PartitionStreams.clear();
     CookieMapping.ClearMapping();
+    CommitCoalescer.Clear();
 }
 
 template<bool UseMigrationProtocol>
@@ -1960,6 +2065,7 @@ void TSingleClusterReadSessionImpl<UseMigrationProtocol>::Close(std::function<vo
         if (!Processor) {
             CallCloseCallbackImpl();
         } else {
+            FlushCommitsImpl();
             if (!HasCommitsInflightImpl()) {
                 Processor->Cancel();
                 CallCloseCallbackImpl();
@@ -3054,6 +3160,7 @@ void TDataDecompressionEvent<UseMigrationProtocol>::TakeData(TIntrusivePtr<TPart
         }
     }();
     auto& messageData = *batch.mutable_message_data(Message);
+    const size_t messageDataSize = messageData.data().size();
 
     minOffset = Min(minOffset, static_cast<i64>(messageData.offset()));
     maxOffset = Max(maxOffset, static_cast<i64>(messageData.offset()));
@@ -3071,7 +3178,7 @@ void TDataDecompressionEvent<UseMigrationProtocol>::TakeData(TIntrusivePtr<TPart
                                         messageData.uncompressed_size());
 
         if (Parent->GetDoDecompress()) {
-            messages.emplace_back(messageData.data(),
+            messages.emplace_back(std::move(*messageData.mutable_data()),
                                   Parent->GetDecompressionError(Batch, Message),
                                   messageInfo,
                                   partitionStream,
@@ -3079,7 +3186,7 @@ void TDataDecompressionEvent<UseMigrationProtocol>::TakeData(TIntrusivePtr<TPart
                                   messageData.explicit_hash());
         } else {
             compressedMessages.emplace_back(static_cast<NPersQueue::ECodec>(messageData.codec()),
-                                            messageData.data(),
+                                            std::move(*messageData.mutable_data()),
                                             std::vector<TMessageInformation>{messageInfo},
                                             partitionStream,
                                             messageData.partition_key(),
@@ -3100,23 +3207,23 @@ void TDataDecompressionEvent<UseMigrationProtocol>::TakeData(TIntrusivePtr<TPart
         );
 
         if (Parent->GetDoDecompress()) {
-            messages.emplace_back(messageData.data(),
+            messages.emplace_back(std::move(*messageData.mutable_data()),
                                   Parent->GetDecompressionError(Batch, Message),
                                   messageInfo,
                                   partitionStream);
         } else {
             compressedMessages.emplace_back(static_cast<ECodec>(batch.codec()),
-                                            messageData.data(),
+                                            std::move(*messageData.mutable_data()),
                                             messageInfo,
                                             partitionStream);
         }
     }
 
-    maxByteSize -= Min(maxByteSize, messageData.data().size());
+    maxByteSize -= Min(maxByteSize, messageDataSize);
 
-    dataSize += messageData.data().size();
+    dataSize += messageDataSize;
 
-    // Clear data to free internal session's memory.
+    // Payload is moved into the event without copying, clear what is left of it in the response.
     messageData.clear_data();
 
     LOG_LAZY(partitionStream->GetLog(), TLOG_DEBUG, TStringBuilder()
@@ -3216,7 +3323,8 @@ void TDataDecompressionInfo<UseMigrationProtocol>::TDecompressionTask::operator(
                         && data.codec() != Ydb::PersQueue::V1::CODEC_UNSPECIFIED
                     ) {
                         const ICodec* codecImpl = TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<ui32>(data.codec()));
-                        std::string decompressed = codecImpl->Decompress(data.data());
+                        std::string decompressed;
+                        codecImpl->DecompressInto(data.data(), std::max<i64>(data.uncompressed_size(), 0), decompressed);
                         data.set_data(TStringType{std::move(decompressed)});
                         data.set_codec(Ydb::PersQueue::V1::CODEC_RAW);
                     }
@@ -3226,7 +3334,8 @@ void TDataDecompressionInfo<UseMigrationProtocol>::TDecompressionTask::operator(
                         && static_cast<Ydb::Topic::Codec>(batch.codec()) != Ydb::Topic::CODEC_UNSPECIFIED
                     ) {
                         const ICodec* codecImpl = TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<ui32>(batch.codec()));
-                        std::string decompressed = codecImpl->Decompress(data.data());
+                        std::string decompressed;
+                        codecImpl->DecompressInto(data.data(), std::max<i64>(data.uncompressed_size(), 0), decompressed);
                         data.set_data(TStringType{std::move(decompressed)});
                     }
                 }
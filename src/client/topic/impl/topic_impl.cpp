@@ -8,7 +8,7 @@ namespace NYdb::inline V3::NTopic {
 
 std::shared_ptr<IReadSession> TTopicClient::TImpl::CreateReadSession(const TReadSessionSettings& settings) {
     std::optional<TReadSessionSettings> maybeSettings;
-    if (!settings.DecompressionExecutor_ || !settings.EventHandlers_.HandlersExecutor_) {
+    if (!settings.DecompressionExecutor_ || !settings.EventHandlers_.HandlersExecutor_ || (!settings.MemoryPool_ && Settings.DefaultReadSessionMemoryPool_)) {
         maybeSettings = settings;
         std::lock_guard guard(Lock);
         if (!settings.DecompressionExecutor_) {
@@ -17,6 +17,9 @@ std::shared_ptr<IReadSession> TTopicClient::TImpl::CreateReadSession(const TRead
         if (!settings.EventHandlers_.HandlersExecutor_) {
             maybeSettings->EventHandlers_.HandlersExecutor(Settings.DefaultHandlersExecutor_);
         }
+        if (!settings.MemoryPool_) {
+            maybeSettings->MemoryPool(Settings.DefaultReadSessionMemoryPool_);
+        }
     }
     auto session = std::make_shared<TReadSession>(maybeSettings.value_or(settings), shared_from_this(), Connections_, DbDriverState_);
     session->Start();
@@ -1,7 +1,9 @@
 #include "write_session_impl.h"
+#include "chunked_compression.h"
 
 #include <src/client/topic/common/log_lazy.h>
 #include <src/client/topic/common/trace_lazy.h>
+#include <src/client/topic/common/work_stealing_executor.h>
 
 #include <library/cpp/string_utils/url/url.h>
 
@@ -98,6 +100,13 @@ TWriteSessionImpl::TWriteSessionImpl(
     } else {
         Counters = MakeIntrusive<TWriterCounters>(new ::NMonitoring::TDynamicCounters());
     }
+    if (Settings.BatchFlushLatencyTarget_) {
+        BatchingController.emplace(*Settings.BatchFlushLatencyTarget_,
+                                   Settings.BatchFlushInterval_.value_or(TDuration::Zero()),
+                                   Settings.BatchFlushSizeBytes_.value_or(0));
+        WakeupInterval = std::clamp(*Settings.BatchFlushLatencyTarget_ / 5, TDuration::MilliSeconds(1), TDuration::MilliSeconds(100));
+        UpdateBatchingCountersImpl();
+    }
 }
 
 void TWriteSessionImpl::Start(const TDuration& delay) {
@@ -380,7 +389,8 @@ std::optional<TEndpointKey> TWriteSessionImpl::GetPreferredEndpointImpl(ui32 par
 
     TEndpointKey preferredEndpoint{"", partitionNodeId};
 
-    bool nodeIsKnown = (bool)DbDriverState->EndpointPool.GetEndpoint(preferredEndpoint, true);
+    auto endpoint = DbDriverState->EndpointPool.GetEndpointHandle(preferredEndpoint, true);
+    bool nodeIsKnown = endpoint && *endpoint;
     if (nodeIsKnown)
     {
         LOG_LAZY(DbDriverState->Log, TLOG_DEBUG, LogPrefixImpl() << "GetPreferredEndpoint: partitionId " << partitionId << ", partitionNodeId " << partitionNodeId << " exists in the endpoint pool.");
@@ -433,6 +443,7 @@ void TWriteSessionImpl::InitWriter() { // No Lock, very initial start - no race
             ThrowFatalError("ProducerId != MessageGroupId scenario is currently not supported");
     }
     CompressionExecutor = Settings.CompressionExecutor_;
+    ParallelCompression = dynamic_cast<TWorkStealingExecutor*>(CompressionExecutor.get()) != nullptr;
 
     Settings.CompressionExecutor_->Start();
     Settings.EventHandlers_.HandlersExecutor_->Start();
@@ -652,7 +663,7 @@ void TWriteSessionImpl::WriteInternal(TContinuationToken&&, TWriteMessage&& mess
         }
 
         CurrentBatch.Add(
-                seqNo, createdAtValue, message.Data, message.Codec, message.OriginalSize,
+                seqNo, createdAtValue, message.ReleaseData(), message.Codec, message.OriginalSize,
                 message.MessageMeta_,
                 MakeTransactionId(message.GetTxPtr())
         );
@@ -1159,6 +1170,10 @@ TWriteSessionImpl::TProcessSrvMessageResult TWriteSessionImpl::ProcessServerMess
                     result.Events.emplace_back(TWriteSessionEvent::TReadyToAcceptEvent{IssueContinuationToken()});
                 }
             }
+            if (BatchingController) {
+                // Messages collected while the acknowledged requests were in flight
+                SendImpl();
+            }
             //EventsQueue->PushEvent(std::move(acksEvent));
             result.Events.emplace_back(std::move(acksEvent));
             break;
@@ -1183,13 +1198,13 @@ bool TWriteSessionImpl::CleanupOnAcknowledgedImpl(uint64_t id) {
     uint64_t size = 0;
     uint64_t compressedSize = 0;
     if(!SentPackedMessage.empty() && SentPackedMessage.front().Offset == id) {
-        auto memoryUsage = OnMemoryUsageChangedImpl(-static_cast<i64>(SentPackedMessage.front().Data.size()));
+        auto memoryUsage = OnMemoryUsageChangedImpl(-static_cast<i64>(SentPackedMessage.front().GetDataSize()));
         result = memoryUsage.NowOk && !memoryUsage.WasOk;
         const auto& front = SentPackedMessage.front();
         if (front.Compressed) {
             compressedSize = front.Data.size();
         } else {
-            size = front.Data.size();
+            size = front.GetDataSize();
         }
 
         (*Counters->MessagesWritten) += front.MessageCount;
@@ -1216,6 +1231,10 @@ bool TWriteSessionImpl::CleanupOnAcknowledgedImpl(uint64_t id) {
     (*Counters->BytesInflightTotal) = MemoryUsage;
     SentOriginalMessages.pop();
 
+    if (BatchingController && BatchingController->OnAck(id, TInstant::Now())) {
+        UpdateBatchingCountersImpl();
+    }
+
     WrittenInTx.erase(id);
 
     return result;
@@ -1255,7 +1274,8 @@ TMemoryUsageChange TWriteSessionImpl::OnMemoryUsageChangedImpl(i64 diff) {
     return {wasOk, nowOk};
 }
 
-TBuffer CompressBuffer(std::shared_ptr<TTopicClient::TImpl> client, std::vector<std::string_view>& data, ECodec codec, i32 level) {
+template <typename TData>
+TBuffer CompressBuffer(std::shared_ptr<TTopicClient::TImpl> client, const std::vector<TData>& data, ECodec codec, i32 level) {
     TBuffer result;
     Y_UNUSED(client);
     std::unique_ptr<IOutputStream> coder = TCodecMap::GetTheCodecMap().GetOrThrow((ui32)codec)->CreateCoder(result, level);
@@ -1277,6 +1297,13 @@ void TWriteSessionImpl::CompressImpl(TBlock&& block_) {
 
     std::shared_ptr<TBlock> blockPtr(std::make_shared<TBlock>());
     blockPtr->Move(block_);
+    if (ParallelCompression && blockPtr->OriginalMemoryUsage >= 2 * COMPRESSION_CHUNK_SIZE
+        && IsChunkedCompressionSupported(Settings.Codec_))
+    {
+        CompressInChunksImpl(std::move(blockPtr));
+        return;
+    }
+
     auto lambda = [cbContext = SelfContext,
                    codec = Settings.Codec_,
                    level = Settings.CompressionLevel_,
@@ -1286,10 +1313,11 @@ void TWriteSessionImpl::CompressImpl(TBlock&& block_) {
         Y_ABORT_UNLESS(!blockPtr->Compressed);
 
         auto compressedData = CompressBuffer(
-            std::move(client), blockPtr->OriginalDataRefs, codec, level
+            std::move(client), blockPtr->OriginalData, codec, level
         );
         Y_ABORT_UNLESS(!compressedData.Empty());
         blockPtr->Data = std::move(compressedData);
+        blockPtr->OriginalData.clear();
         blockPtr->Compressed = true;
         blockPtr->CodecID = static_cast<ui32>(codec);
         if (auto self = cbContext->LockShared()) {
@@ -1300,6 +1328,27 @@ void TWriteSessionImpl::CompressImpl(TBlock&& block_) {
     CompressionExecutor->Post(lambda);
 }
 
+// The chunk compressed last assembles the block and only it takes the session lock,
+// the block is then ordered by Offset in PackedMessagesToSend
+void TWriteSessionImpl::CompressInChunksImpl(std::shared_ptr<TBlock> blockPtr) {
+    Y_ABORT_UNLESS(Lock.IsLocked());
+
+    const auto& data = blockPtr->OriginalData;
+    CompressInChunks(*CompressionExecutor, data, Settings.Codec_, Settings.CompressionLevel_, COMPRESSION_CHUNK_SIZE,
+        [cbContext = SelfContext, codec = Settings.Codec_, blockPtr = std::move(blockPtr)](TBuffer&& compressed) {
+            auto& block = *blockPtr;
+            Y_ABORT_UNLESS(!block.Compressed);
+            Y_ABORT_UNLESS(!compressed.Empty());
+            block.Data = std::move(compressed);
+            block.OriginalData.clear();
+            block.Compressed = true;
+            block.CodecID = static_cast<ui32>(codec);
+            if (auto self = cbContext->LockShared()) {
+                self->OnCompressed(std::move(block), false);
+            }
+        });
+}
+
 void TWriteSessionImpl::OnCompressed(TBlock&& block, bool isSyncCompression) {
     TMemoryUsageChange memoryUsage;
     if (!isSyncCompression) {
@@ -1322,6 +1371,9 @@ TMemoryUsageChange TWriteSessionImpl::OnCompressedImpl(TBlock&& block) {
     (*Counters->BytesInflightUncompressed) -= block.OriginalSize;
     (*Counters->BytesInflightCompressed) += block.Data.size();
 
+    if (BatchingController) {
+        BatchingController->OnReady(block.GetDataSize(), TInstant::Now());
+    }
     PackedMessagesToSend.emplace(std::move(block));
 
     if (!SendImplScheduled.exchange(true)) {
@@ -1344,7 +1396,13 @@ void TWriteSessionImpl::ResetForRetryImpl() {
     SessionEstablished = false;
     const size_t totalPackedMessages = PackedMessagesToSend.size() + SentPackedMessage.size();
     const size_t totalOriginalMessages = OriginalMessagesToSend.size() + SentOriginalMessages.size();
+    if (BatchingController) {
+        BatchingController->OnRetry();
+    }
     while (!SentPackedMessage.empty()) {
+        if (BatchingController) {
+            BatchingController->OnReady(SentPackedMessage.front().GetDataSize(), TInstant::Now());
+        }
         PackedMessagesToSend.emplace(std::move(SentPackedMessage.front()));
         SentPackedMessage.pop();
     }
@@ -1370,7 +1428,6 @@ void TWriteSessionImpl::FlushWriteIfRequiredImpl() {
     Y_ABORT_UNLESS(Lock.IsLocked());
 
     if (!CurrentBatch.Empty() && !CurrentBatch.FlushRequested) {
-        MessagesAcquired += static_cast<uint64_t>(CurrentBatch.Acquire());
         if (TInstant::Now() - CurrentBatch.StartedAt >= Settings.BatchFlushInterval_.value_or(TDuration::Zero())
             || CurrentBatch.CurrentSize >= Settings.BatchFlushSizeBytes_.value_or(0)
             || CurrentBatch.CurrentSize >= MaxBlockSize
@@ -1395,9 +1452,6 @@ size_t TWriteSessionImpl::WriteBatchImpl() {
     Y_ABORT_UNLESS(CurrentBatch.Messages.size() <= MaxBlockMessageCount);
 
     const bool skipCompression = Settings.Codec_ == ECodec::RAW || CurrentBatch.HasCodec();
-    if (!skipCompression && Settings.CompressionExecutor_->IsAsync()) {
-        MessagesAcquired += static_cast<uint64_t>(CurrentBatch.Acquire());
-    }
 
     size_t size = 0;
     for (size_t i = 0; i != CurrentBatch.Messages.size();) {
@@ -1417,31 +1471,33 @@ size_t TWriteSessionImpl::WriteBatchImpl() {
             }
 
             block.MessageCount += 1;
-            const auto& datum = currMessage.DataRef;
-            block.OriginalSize += datum.size();
-            block.OriginalMemoryUsage = CurrentBatch.Data.size();
-            block.OriginalDataRefs.emplace_back(datum);
+            const size_t dataSize = currMessage.Data.size();
+            block.OriginalSize += dataSize;
+            block.OriginalMemoryUsage += dataSize;
+            block.OriginalData.emplace_back(std::move(currMessage.Data));
             if (CurrentBatch.Messages[i].Codec.has_value()) {
                 Y_ABORT_UNLESS(CurrentBatch.Messages.size() == 1);
                 block.CodecID = static_cast<ui32>(*currMessage.Codec);
                 block.OriginalSize = currMessage.OriginalSize;
                 block.Compressed = false;
             }
-            size += datum.size();
+            size += dataSize;
             UpdateTimedCountersImpl();
-            (*Counters->BytesInflightUncompressed) += datum.size();
+            (*Counters->BytesInflightUncompressed) += dataSize;
             (*Counters->MessagesInflight)++;
             if (!currMessage.MessageMeta.empty()) {
-                OriginalMessagesToSend.emplace(id, createTs, datum.size(),
+                OriginalMessagesToSend.emplace(id, createTs, dataSize,
                                                std::move(currMessage.MessageMeta),
                                                std::move(currMessage.Tx));
             } else {
-                OriginalMessagesToSend.emplace(id, createTs, datum.size(),
+                OriginalMessagesToSend.emplace(id, createTs, dataSize,
                                                std::move(currMessage.Tx));
             }
         }
-        block.Data = std::move(CurrentBatch.Data);
         if (skipCompression) {
+            if (BatchingController) {
+                BatchingController->OnReady(block.GetDataSize(), TInstant::Now());
+            }
             PackedMessagesToSend.emplace(std::move(block));
         } else {
             CompressImpl(std::move(block));
@@ -1513,9 +1569,25 @@ bool TWriteSessionImpl::TxIsChanged(const Ydb::Topic::StreamWriteMessage_WriteRe
     return GetTransactionId(*writeRequest) != GetTransactionId(OriginalMessagesToSend.front().Tx);
 }
 
+bool TWriteSessionImpl::ShouldSendImpl() const {
+    Y_ABORT_UNLESS(Lock.IsLocked());
+
+    return !BatchingController || BatchingController->ShouldSend(!SentPackedMessage.empty(), TInstant::Now());
+}
+
+void TWriteSessionImpl::UpdateBatchingCountersImpl() {
+    *Counters->BatchFlushIntervalUs = BatchingController->GetFlushInterval().MicroSeconds();
+    *Counters->BatchFlushSizeBytes = BatchingController->GetFlushSizeBytes();
+    *Counters->BatchWriteLatencyP99Us = BatchingController->GetLatencyP99().MicroSeconds();
+}
+
 void TWriteSessionImpl::SendImpl() {
     Y_ABORT_UNLESS(Lock.IsLocked());
 
+    if (!IsReadyToSendNextImpl() || !ShouldSendImpl()) {
+        return;
+    }
+
     // External cycle splits ready blocks into multiple gRPC messages. Current gRPC message size hard limit is 64MiB.
     while (IsReadyToSendNextImpl()) {
         TClientMessage clientMessage;
@@ -1524,6 +1596,7 @@ void TWriteSessionImpl::SendImpl() {
         ui32 prevCodec = 0;
 
         ui64 currentSize = 0;
+        ui64 blocksSize = 0;
 
         // Send blocks while we can without messages reordering.
         while (IsReadyToSendNextImpl() && currentSize < GetMaxGrpcMessageSize()) {
@@ -1564,12 +1637,14 @@ void TWriteSessionImpl::SendImpl() {
                 if (block.Compressed) {
                     msgData->set_data(block.Data.data(), block.Data.size());
                 } else {
-                    for (auto& buffer: block.OriginalDataRefs) {
-                        msgData->set_data(buffer.data(), buffer.size());
+                    // The only copy of an uncompressed body, the block keeps it for resending after reconnect
+                    for (auto& data: block.OriginalData) {
+                        msgData->set_data(data);
                     }
                 }
             }
 
+            blocksSize += block.GetDataSize();
             TBlock moveBlock;
             moveBlock.Move(block);
             SentPackedMessage.emplace(std::move(moveBlock));
@@ -1584,6 +1659,10 @@ void TWriteSessionImpl::SendImpl() {
                 << OriginalMessagesToSend.size() << " left), first sequence number is "
                 << writeRequest->messages(0).seq_no()
         );
+        (*Counters->WriteRequests)++;
+        if (BatchingController) {
+            BatchingController->OnSent(blocksSize, SentOriginalMessages.back().Id, TInstant::Now());
+        }
         Processor->Write(std::move(clientMessage));
     }
 }
@@ -1637,6 +1716,10 @@ void TWriteSessionImpl::HandleWakeUpImpl() {
     Y_ABORT_UNLESS(Lock.IsLocked());
 
     FlushWriteIfRequiredImpl();
+    if (BatchingController) {
+        // Requests collected for the flush interval
+        SendImpl();
+    }
     if (Aborting.load()) {
         return;
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "batching_controller.h"
 #include "transaction.h"
 
 #include <src/client/topic/common/callback_context.h>
@@ -19,17 +20,22 @@ public:
     : TParent(settings)
     {}
 
+    // Producers do not take the lock unless the consumer waits for events
     void PushEvent(TEventInfo eventInfo) {
         if (Closed || ApplyHandler(eventInfo)) {
             return;
         }
 
+        if (!PushLockFree(std::move(eventInfo))) {
+            return;
+        }
+
         TWaiter waiter;
         {
             std::lock_guard guard(Mutex);
-            Events.emplace(std::move(eventInfo));
             waiter = PopWaiterImpl();
         }
+        CondVar.notify_all();
         waiter.Signal(); // Does nothing if waiter is empty.
     }
 
@@ -40,6 +46,7 @@ public:
             if (block) {
                 WaitEventsImpl();
             }
+            DrainPushedImpl();
             if (HasEventsImpl()) {
                 eventInfo = GetEventImpl();
             } else {
@@ -57,6 +64,7 @@ public:
             if (block) {
                 WaitEventsImpl();
             }
+            DrainPushedImpl();
             eventInfos.reserve(Min(Events.size() + CloseEvent.has_value(), maxEventsCount ? *maxEventsCount : std::numeric_limits<size_t>::max()));
             while (!Events.empty()) {
                 eventInfos.emplace_back(GetEventImpl());
@@ -160,18 +168,18 @@ private:
     struct TMessage {
         uint64_t Id;
         TInstant CreatedAt;
-        std::string_view DataRef;
+        std::string Data; //!< Owned message body, moved from the user message when it owns the body
         std::optional<ECodec> Codec;
         ui32 OriginalSize; // only for coded messages
         std::vector<std::pair<std::string, std::string>> MessageMeta;
         std::optional<TTransactionId> Tx;
 
-        TMessage(uint64_t id, const TInstant& createdAt, std::string_view data, std::optional<ECodec> codec = {},
+        TMessage(uint64_t id, const TInstant& createdAt, std::string&& data, std::optional<ECodec> codec = {},
                  ui32 originalSize = 0, const std::vector<std::pair<std::string, std::string>>& messageMeta = {},
                  std::optional<TTransactionId>&& tx = {})
             : Id(id)
             , CreatedAt(createdAt)
-            , DataRef(data)
+            , Data(std::move(data))
             , Codec(codec)
             , OriginalSize(originalSize)
             , MessageMeta(messageMeta)
@@ -180,37 +188,24 @@ private:
     };
 
     struct TMessageBatch {
-        TBuffer Data;
         std::vector<TMessage> Messages;
         uint64_t CurrentSize = 0;
         TInstant StartedAt = TInstant::Zero();
-        bool Acquired = false;
         bool FlushRequested = false;
 
-        void Add(uint64_t id, const TInstant& createdAt, std::string_view data, std::optional<ECodec> codec, ui32 originalSize,
+        void Add(uint64_t id, const TInstant& createdAt, std::string&& data, std::optional<ECodec> codec, ui32 originalSize,
                  const std::vector<std::pair<std::string, std::string>>& messageMeta,
                  std::optional<TTransactionId>&& tx) {
             if (StartedAt == TInstant::Zero())
                 StartedAt = TInstant::Now();
             CurrentSize += codec ? originalSize : data.size();
-            Messages.emplace_back(id, createdAt, data, codec, originalSize, messageMeta, std::move(tx));
-            Acquired = false;
+            Messages.emplace_back(id, createdAt, std::move(data), codec, originalSize, messageMeta, std::move(tx));
         }
 
         bool HasCodec() const {
             return Messages.empty() ? false : Messages.front().Codec.has_value();
         }
 
-        bool Acquire() {
-            if (Acquired || Messages.empty())
-                return false;
-            auto currSize = Data.size();
-            Data.Append(Messages.back().DataRef.data(), Messages.back().DataRef.size());
-            Messages.back().DataRef = std::string_view(Data.data() + currSize, Data.size() - currSize);
-            Acquired = true;
-            return true;
-        }
-
         bool Empty() const noexcept {
             return CurrentSize == 0 && Messages.empty();
         }
@@ -218,8 +213,6 @@ private:
         void Reset() {
             StartedAt = TInstant::Zero();
             Messages.clear();
-            Data.Clear();
-            Acquired = false;
             CurrentSize = 0;
             FlushRequested = false;
         }
@@ -232,8 +225,9 @@ private:
         size_t OriginalSize = 0;
         size_t OriginalMemoryUsage = 0;
         ui32 CodecID = static_cast<ui32>(ECodec::RAW);
-        mutable std::vector<std::string_view> OriginalDataRefs;
-        mutable TBuffer Data;
+        //! Bodies of the messages, sent as is if the block is not compressed. Released after compression
+        mutable std::vector<std::string> OriginalData;
+        mutable TBuffer Data; //!< Compressed bodies
         bool Compressed = false;
         mutable bool Valid = true;
 
@@ -249,12 +243,17 @@ private:
             OriginalSize = rhs.OriginalSize;
             OriginalMemoryUsage = rhs.OriginalMemoryUsage;
             CodecID = rhs.CodecID;
-            OriginalDataRefs.swap(rhs.OriginalDataRefs);
+            OriginalData.swap(rhs.OriginalData);
             Data.Swap(rhs.Data);
             Compressed = rhs.Compressed;
 
             rhs.Data.Clear();
-            rhs.OriginalDataRefs.clear();
+            rhs.OriginalData.clear();
+        }
+
+        //! Size of the data which goes to the wire
+        size_t GetDataSize() const {
+            return Compressed ? Data.size() : OriginalMemoryUsage;
         }
     };
 
@@ -392,8 +391,9 @@ private:
     void OnWriteDone(NYdbGrpc::TGrpcStatus&& status, size_t connectionGeneration);
     TProcessSrvMessageResult ProcessServerMessageImpl();
     TMemoryUsageChange OnMemoryUsageChangedImpl(i64 diff);
-    TBuffer CompressBufferImpl(std::vector<std::string_view>& data, ECodec codec, i32 level);
+    TBuffer CompressBufferImpl(const std::vector<std::string>& data, ECodec codec, i32 level);
     void CompressImpl(TBlock&& block);
+    void CompressInChunksImpl(std::shared_ptr<TBlock> block);
     void OnCompressed(TBlock&& block, bool isSyncCompression=false);
     TMemoryUsageChange OnCompressedImpl(TBlock&& block);
 
@@ -405,6 +405,9 @@ private:
     uint64_t GetSeqNoImpl(uint64_t id);
     uint64_t GetIdImpl(uint64_t seqNo);
     void SendImpl();
+    //! Whether ready blocks should be sent now or collected into a bigger write request
+    bool ShouldSendImpl() const;
+    void UpdateBatchingCountersImpl();
     void AbortImpl();
     void CloseImpl(EStatus statusCode, NYdb::NIssue::TIssues&& issues);
     void CloseImpl(EStatus statusCode, const std::string& message);
@@ -456,6 +459,7 @@ private:
 
     std::string SessionId;
     IExecutor::TPtr CompressionExecutor;
+    bool ParallelCompression = false; //!< Large blocks are split into chunks compressed in parallel
     size_t MemoryUsage = 0; //!< Estimated amount of memory used
     bool FirstTokenSent = false;
 
@@ -487,11 +491,12 @@ private:
     TInstant LastCountersLogTs;
     TWriterCounters::TPtr Counters;
     TDuration WakeupInterval;
+    //! Set if Settings.BatchFlushLatencyTarget is set
+    std::optional<TBatchingController> BatchingController;
 
     // Set by the write session, if Settings.DirectWriteToPartition is true and Settings.PartitionId is unset. Otherwise ignored.
     std::optional<uint64_t> DirectWriteToPartitionId;
 protected:
-    uint64_t MessagesAcquired = 0;
 
     std::unordered_map<TTransactionId, TTransactionInfoPtr, THash<TTransactionId>> Txs;
     std::unordered_map<ui64, TTransactionId> WrittenInTx; // SeqNo -> TxId
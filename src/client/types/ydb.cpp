@@ -26,6 +26,10 @@ TBalancingPolicy TBalancingPolicy::UseAllNodes() {
     return TBalancingPolicy(std::make_unique<TImpl>(TImpl::UseAllNodes()));
 }
 
+TBalancingPolicy TBalancingPolicy::UseLeastLoadedNodes() {
+    return TBalancingPolicy(std::make_unique<TImpl>(TImpl::UseLeastLoadedNodes()));
+}
+
 TBalancingPolicy TBalancingPolicy::UsePreferablePileState(EPileState pileState) {
     return TBalancingPolicy(std::make_unique<TImpl>(TImpl::UsePreferablePileState(pileState)));
 }
@@ -18,6 +18,12 @@
 #include <util/generic/mapfindptr.h>
 #include <util/generic/bitmap.h>
 #include <util/string/builder.h>
+#include <util/digest/numeric.h>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <unordered_map>
 
 namespace NYdb::inline V3 {
 
@@ -69,10 +75,6 @@ static TTypeParser::ETypeKind GetKind(const Ydb::Type& type) {
     return ETypeKind::Void;
 }
 
-bool TypesEqual(const TType& t1, const TType& t2) {
-    return TypesEqual(t1.GetProto(), t2.GetProto());
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 
 class TType::TImpl {
@@ -84,6 +86,8 @@ public:
         : ProtoType_(std::move(typeProto)) {}
 
     Ydb::Type ProtoType_;
+    // Owned by the interning table, shared between unrelated values and never modified
+    bool Interned_ = false;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +98,9 @@ TType::TType(const Ydb::Type& typeProto)
 TType::TType(Ydb::Type&& typeProto)
     : Impl_(new TImpl(std::move(typeProto))) {}
 
+TType::TType(std::shared_ptr<TImpl> impl)
+    : Impl_(std::move(impl)) {}
+
 std::string TType::ToString() const {
     return FormatType(*this);
 }
@@ -108,9 +115,183 @@ const Ydb::Type& TType::GetProto() const {
 
 Ydb::Type& TType::GetProto()
 {
+    if (Impl_->Interned_) {
+        Impl_ = std::make_shared<TImpl>(Impl_->ProtoType_);
+    }
     return Impl_->ProtoType_;
 }
 
+bool TypesEqual(const TType& t1, const TType& t2) {
+    if (t1.Impl_ == t2.Impl_) {
+        return true;
+    }
+    if (t1.Impl_->Interned_ && t2.Impl_->Interned_) {
+        // The table never holds two equal live instances
+        return false;
+    }
+    return TypesEqual(t1.GetProto(), t2.GetProto());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool HasUnknownFields(const google::protobuf::Message& message) {
+    return !message.GetReflection()->GetUnknownFields(message).empty();
+}
+
+// Hash of everything TypesEqual compares. Returns false for types TypesEqual can't tell apart
+// exactly (pg types carry extra fields, unknown fields and type cases), those are never interned.
+static bool HashType(const Ydb::Type& type, size_t& hash) {
+    if (HasUnknownFields(type)) {
+        return false;
+    }
+
+    hash = CombineHashes<size_t>(hash, type.type_case());
+
+    auto hashMembers = [&hash](const auto& members) {
+        hash = CombineHashes<size_t>(hash, members.size());
+        for (const auto& member : members) {
+            if (HasUnknownFields(member)) {
+                return false;
+            }
+            hash = CombineHashes(hash, std::hash<std::string_view>()(member.name()));
+            if (!HashType(member.type(), hash)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto hashElements = [&hash](const auto& elements) {
+        hash = CombineHashes<size_t>(hash, elements.size());
+        for (const auto& element : elements) {
+            if (!HashType(element, hash)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    switch (type.type_case()) {
+        case Ydb::Type::kTypeId:
+            hash = CombineHashes<size_t>(hash, type.type_id());
+            return true;
+        case Ydb::Type::kDecimalType:
+            if (HasUnknownFields(type.decimal_type())) {
+                return false;
+            }
+            hash = CombineHashes<size_t>(hash, type.decimal_type().precision());
+            hash = CombineHashes<size_t>(hash, type.decimal_type().scale());
+            return true;
+        case Ydb::Type::kOptionalType:
+            return !HasUnknownFields(type.optional_type()) && HashType(type.optional_type().item(), hash);
+        case Ydb::Type::kTaggedType:
+            if (HasUnknownFields(type.tagged_type())) {
+                return false;
+            }
+            hash = CombineHashes(hash, std::hash<std::string_view>()(type.tagged_type().tag()));
+            return HashType(type.tagged_type().type(), hash);
+        case Ydb::Type::kListType:
+            return !HasUnknownFields(type.list_type()) && HashType(type.list_type().item(), hash);
+        case Ydb::Type::kTupleType:
+            return !HasUnknownFields(type.tuple_type()) && hashElements(type.tuple_type().elements());
+        case Ydb::Type::kStructType:
+            return !HasUnknownFields(type.struct_type()) && hashMembers(type.struct_type().members());
+        case Ydb::Type::kDictType:
+            return !HasUnknownFields(type.dict_type())
+                && HashType(type.dict_type().key(), hash)
+                && HashType(type.dict_type().payload(), hash);
+        case Ydb::Type::kVariantType: {
+            const auto& variant = type.variant_type();
+            if (HasUnknownFields(variant)) {
+                return false;
+            }
+            hash = CombineHashes<size_t>(hash, variant.type_case());
+            switch (variant.type_case()) {
+                case Ydb::VariantType::kTupleItems:
+                    return !HasUnknownFields(variant.tuple_items()) && hashElements(variant.tuple_items().elements());
+                case Ydb::VariantType::kStructItems:
+                    return !HasUnknownFields(variant.struct_items()) && hashMembers(variant.struct_items().members());
+                default:
+                    return false;
+            }
+        }
+        case Ydb::Type::kVoidType:
+        case Ydb::Type::kNullType:
+        case Ydb::Type::kEmptyListType:
+        case Ydb::Type::kEmptyDictType:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//! Process-wide table of immutable types. Holds weak references only, so a type lives as long
+//! as some value or column uses it; expired entries are dropped on lookup and by periodic sweeps.
+class TTypeInterner {
+public:
+    static TTypeInterner& Instance() {
+        // Never destroyed, types may still be interned from static destructors
+        static TTypeInterner* instance = new TTypeInterner();
+        return *instance;
+    }
+
+    template <typename TProto>
+    TType Intern(TProto&& typeProto) {
+        size_t hash = 0;
+        if (!HashType(typeProto, hash)) {
+            return TType(std::forward<TProto>(typeProto));
+        }
+
+        auto& shard = Shards_[hash % ShardsCount];
+        std::lock_guard lock(shard.Lock);
+
+        auto range = shard.Types.equal_range(hash);
+        for (auto it = range.first; it != range.second;) {
+            if (auto impl = it->second.lock()) {
+                if (TypesEqual(impl->ProtoType_, typeProto)) {
+                    return TType(std::move(impl));
+                }
+                ++it;
+            } else {
+                it = shard.Types.erase(it);
+            }
+        }
+
+        auto impl = std::make_shared<TType::TImpl>(std::forward<TProto>(typeProto));
+        impl->Interned_ = true;
+        shard.Types.emplace(hash, impl);
+
+        if (shard.Types.size() >= shard.SweepThreshold) {
+            std::erase_if(shard.Types, [](const auto& entry) {
+                return entry.second.expired();
+            });
+            shard.SweepThreshold = std::max(MinSweepThreshold, shard.Types.size() * 2);
+        }
+
+        return TType(std::move(impl));
+    }
+
+private:
+    static constexpr size_t ShardsCount = 16;
+    static constexpr size_t MinSweepThreshold = 64;
+
+    struct TShard {
+        std::mutex Lock;
+        std::unordered_multimap<size_t, std::weak_ptr<TType::TImpl>> Types;
+        size_t SweepThreshold = MinSweepThreshold;
+    };
+
+    std::array<TShard, ShardsCount> Shards_;
+};
+
+TType InternType(const Ydb::Type& typeProto) {
+    return TTypeInterner::Instance().Intern(typeProto);
+}
+
+TType InternType(Ydb::Type&& typeProto) {
+    return TTypeInterner::Instance().Intern(std::move(typeProto));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 class TTypeParser::TImpl {
@@ -123,7 +304,7 @@ public:
 
     void Reset() {
         Path_.clear();
-        Path_.emplace_back(TProtoPosition{&Type_.GetProto(), -1});
+        Path_.emplace_back(TProtoPosition{&std::as_const(Type_).GetProto(), -1});
     }
 
     ETypeKind GetKind(ui32 offset = 0) const {
@@ -607,7 +788,7 @@ public:
 
         Ydb::Type type;
         type.Swap(&ProtoType_);
-        return TType(std::move(type));
+        return InternType(std::move(type));
     }
 
     void Primitive(const EPrimitiveType& primitiveType) {
@@ -3465,6 +3646,7 @@ TDerived& TValueBuilderBase<TDerived>::EndTagged() {
 
 template class TValueBuilderBase<TValueBuilder>;
 template class TValueBuilderBase<TParamValueBuilder>;
+template class TValueBuilderBase<TParamTemplateValueBuilder>;
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -5,7 +5,6 @@
 #include <library/cpp/containers/stack_vector/stack_vec.h>
 
 #include <util/system/thread.h>
-#include <util/random/random.h>
 
 #if !defined(_WIN32) && !defined(_WIN64)
 #include <sys/types.h>
@@ -123,6 +122,11 @@ grpc_socket_mutator_vtable TGRpcSocketMutator::VTable =
 #endif
 
 void TGRpcRequestProcessorCommon::ApplyMeta(const TCallMeta& meta) {
+    if (meta.Common) {
+        for (const auto& rec : *meta.Common) {
+            Context.AddMetadata(NYdb::TStringType{rec.first}, NYdb::TStringType{rec.second});
+        }
+    }
     for (const auto& rec : meta.Aux) {
         Context.AddMetadata(NYdb::TStringType{rec.first}, NYdb::TStringType{rec.second});
     }
@@ -216,8 +220,22 @@ void TChannelPool::EraseFromQueueByTime(const TInstant& lastUseTime, const std::
     LastUsedQueue_.erase(pos);
 }
 
-static void PullEvents(grpc::CompletionQueue* cq) {
+namespace {
+
+// Completion queue served by the current thread, lets requests started from
+// a network thread (e.g. from a callback) stay on the same queue and thread
+struct TCurrentQueue {
+    const void* Owner = nullptr;
+    size_t Index = 0;
+};
+
+thread_local TCurrentQueue CurrentQueue;
+
+} // namespace
+
+static void PullEvents(grpc::CompletionQueue* cq, const void* owner, size_t index) {
     TThread::SetCurrentThreadName("grpc_client");
+    CurrentQueue = TCurrentQueue{owner, index};
     while (true) {
         void* tag;
         bool ok;
@@ -291,6 +309,7 @@ public:
             child->Parent = std::move(self);
             child->Owner = Owner;
             child->CQ = CQ;
+            child->Shard = Shard;
 
             // Propagate cancellation to a child context
             if (Cancelled.load(std::memory_order_relaxed)) {
@@ -430,6 +449,7 @@ private:
     TContextPtr Parent;
     TGRpcClientLow* Owner = nullptr;
     grpc::CompletionQueue* CQ = nullptr;
+    size_t Shard = 0;
 
     // Some children are stored inline, others are in a set
     std::array<TContextImpl*, 2> InlineChildren{ { nullptr, nullptr } };
@@ -450,20 +470,24 @@ TGRpcClientLow::TGRpcClientLow(size_t numWorkerThread, bool useCompletionQueuePe
 
 void TGRpcClientLow::Init(size_t numWorkerThread) {
     SetCqState(WORKING);
+    // With a queue per thread shard i holds contexts of queue i
+    ContextShardsCount_ = std::max<size_t>(numWorkerThread, 1);
+    ContextShards_.reset(new TContextShard[ContextShardsCount_]);
+
     if (UseCompletionQueuePerThread_) {
         for (size_t i = 0; i < numWorkerThread; i++) {
             CQS_.push_back(std::make_unique<grpc::CompletionQueue>());
             auto* cq = CQS_.back().get();
-            WorkerThreads_.emplace_back(SystemThreadFactory()->Run([cq]() {
-                PullEvents(cq);
+            WorkerThreads_.emplace_back(SystemThreadFactory()->Run([this, cq, i]() {
+                PullEvents(cq, this, i);
             }).Release());
         }
     } else {
         CQS_.push_back(std::make_unique<grpc::CompletionQueue>());
         auto* cq = CQS_.back().get();
         for (size_t i = 0; i < numWorkerThread; i++) {
-            WorkerThreads_.emplace_back(SystemThreadFactory()->Run([cq]() {
-                PullEvents(cq);
+            WorkerThreads_.emplace_back(SystemThreadFactory()->Run([this, cq, i]() {
+                PullEvents(cq, this, i);
             }).Release());
         }
     }
@@ -473,13 +497,15 @@ void TGRpcClientLow::AddWorkerThreadForTest() {
     if (UseCompletionQueuePerThread_) {
         CQS_.push_back(std::make_unique<grpc::CompletionQueue>());
         auto* cq = CQS_.back().get();
-        WorkerThreads_.emplace_back(SystemThreadFactory()->Run([cq]() {
-            PullEvents(cq);
+        const size_t index = CQS_.size() - 1;
+        WorkerThreads_.emplace_back(SystemThreadFactory()->Run([this, cq, index]() {
+            PullEvents(cq, this, index);
         }).Release());
     } else {
         auto* cq = CQS_.back().get();
-        WorkerThreads_.emplace_back(SystemThreadFactory()->Run([cq]() {
-            PullEvents(cq);
+        const size_t index = WorkerThreads_.size();
+        WorkerThreads_.emplace_back(SystemThreadFactory()->Run([this, cq, index]() {
+            PullEvents(cq, this, index);
         }).Release());
     }
 }
@@ -525,17 +551,22 @@ void TGRpcClientLow::StopInternal(bool silent) {
 
         SetCqState(silent ? STOP_SILENT : STOP_EXPLICIT);
 
-        if (!silent && !Contexts_.empty()) {
-            cancelQueue.reserve(Contexts_.size());
-            for (auto* ptr : Contexts_) {
-                // N.B. some contexts may be stuck in destructors
-                if (auto context = TContextImpl::LockChildPtr(ptr)) {
-                    cancelQueue.emplace_back(std::move(context));
+        // Passing every shard lock guarantees that contexts created before the state change are visible here
+        // and that contexts are not created after it
+        for (size_t i = 0; i < ContextShardsCount_; ++i) {
+            auto& shard = ContextShards_[i];
+            std::unique_lock<std::mutex> shardGuard(shard.Mutex);
+            if (!silent) {
+                for (auto* ptr : shard.Contexts) {
+                    // N.B. some contexts may be stuck in destructors
+                    if (auto context = TContextImpl::LockChildPtr(ptr)) {
+                        cancelQueue.emplace_back(std::move(context));
+                    }
                 }
             }
         }
 
-        shutdown = Contexts_.empty();
+        shutdown = ContextsCount_.load() == 0;
     }
 
     for (auto& context : cancelQueue) {
@@ -544,6 +575,13 @@ void TGRpcClientLow::StopInternal(bool silent) {
     }
 
     if (shutdown) {
+        ShutdownQueuesOnce();
+    }
+}
+
+void TGRpcClientLow::ShutdownQueuesOnce() {
+    // Both Stop and the last finished context may decide to shutdown queues
+    if (!QueuesShutdown_.exchange(true)) {
         for (auto& cq : CQS_) {
             cq->Shutdown();
         }
@@ -561,13 +599,25 @@ void TGRpcClientLow::WaitInternal() {
 void TGRpcClientLow::WaitIdle() {
     std::unique_lock<std::mutex> guard(Mtx_);
 
-    while (!Contexts_.empty()) {
+    while (ContextsCount_.load() != 0) {
         ContextsEmpty_.wait(guard);
     }
 }
 
+size_t TGRpcClientLow::PickContextShard() const {
+    if (CurrentQueue.Owner == this) {
+        return CurrentQueue.Index % ContextShardsCount_;
+    }
+    // Other threads stick to one shard, so their requests and callbacks use the same queue
+    static std::atomic<size_t> nextShard = 0;
+    thread_local size_t homeShard = nextShard.fetch_add(1, std::memory_order_relaxed);
+    return homeShard % ContextShardsCount_;
+}
+
 std::shared_ptr<IQueueClientContext> TGRpcClientLow::CreateContext() {
-    std::unique_lock<std::mutex> guard(Mtx_);
+    const size_t shardIndex = PickContextShard();
+    auto& shard = ContextShards_[shardIndex];
+    std::unique_lock<std::mutex> guard(shard.Mutex);
 
     auto allowCreateContext = [&]() {
         switch (GetCqState()) {
@@ -587,10 +637,12 @@ std::shared_ptr<IQueueClientContext> TGRpcClientLow::CreateContext() {
     }
 
     auto context = std::make_shared<TContextImpl>();
-    Contexts_.insert(context.get());
+    shard.Contexts.insert(context.get());
+    ContextsCount_.fetch_add(1);
     context->Owner = this;
+    context->Shard = shardIndex;
     if (UseCompletionQueuePerThread_) {
-        context->CQ = CQS_[RandomNumber(CQS_.size())].get();
+        context->CQ = CQS_[shardIndex % CQS_.size()].get();
     } else {
         context->CQ = CQS_[0].get();
     }
@@ -598,28 +650,24 @@ std::shared_ptr<IQueueClientContext> TGRpcClientLow::CreateContext() {
 }
 
 void TGRpcClientLow::ForgetContext(TContextImpl* context) {
-    bool shutdown = false;
-
     {
-        std::unique_lock<std::mutex> guard(Mtx_);
+        auto& shard = ContextShards_[context->Shard];
+        std::unique_lock<std::mutex> guard(shard.Mutex);
 
-        if (!Contexts_.erase(context)) {
+        if (!shard.Contexts.erase(context)) {
             Y_ABORT("Unexpected ForgetContext(%p)", context);
         }
+    }
 
-        if (Contexts_.empty()) {
-            if (IsStopping()) {
-                shutdown = true;
-            }
-
+    if (ContextsCount_.fetch_sub(1) == 1) {
+        {
+            std::unique_lock<std::mutex> guard(Mtx_);
             ContextsEmpty_.notify_all();
         }
-    }
 
-    if (shutdown) {
-        // This was the last context, shutdown CQ
-        for (auto& cq : CQS_) {
-            cq->Shutdown();
+        if (IsStopping()) {
+            // This was the last context, shutdown CQ
+            ShutdownQueuesOnce();
         }
     }
 }
@@ -197,8 +197,12 @@ using TAdvancedResponseCallback = std::function<void (const grpc::ClientContext&
 
 // Call associated metadata
 struct TCallMeta {
+    using TMetaHeaders = std::vector<std::pair<std::string, std::string>>;
+
     std::shared_ptr<grpc::CallCredentials> CallCredentials;
-    std::vector<std::pair<std::string, std::string>> Aux;
+    // Immutable headers shared between calls, applied before Aux
+    std::shared_ptr<const TMetaHeaders> Common;
+    TMetaHeaders Aux;
     std::variant<std::monostate, NYdb::TDeadline, NYdb::TDeadline::Duration> Timeout; // timeout as duration from now or time point in future
 };
 
@@ -1400,15 +1404,31 @@ private:
 
     void ForgetContext(TContextImpl* context);
 
+    // Returns shard for a context created by the current thread
+    size_t PickContextShard() const;
+    void ShutdownQueuesOnce();
+
 private:
+    // Live contexts are split between shards, so starting and finishing requests
+    // from different threads do not contend on a single mutex
+    struct alignas(64) TContextShard {
+        std::mutex Mutex;
+        std::unordered_set<TContextImpl*> Contexts;
+    };
+
     bool UseCompletionQueuePerThread_;
     std::vector<CompletionQueueRef> CQS_;
     std::vector<IThreadRef> WorkerThreads_;
     std::atomic<int> CqState_ = -1;
 
+    size_t ContextShardsCount_ = 0;
+    std::unique_ptr<TContextShard[]> ContextShards_;
+    std::atomic<size_t> ContextsCount_ = 0;
+    std::atomic<bool> QueuesShutdown_ = false;
+
+    // Serializes Stop calls and waiting for idle
     std::mutex Mtx_;
     std::condition_variable ContextsEmpty_;
-    std::unordered_set<TContextImpl*> Contexts_;
 
     std::mutex JoinMutex_;
 };
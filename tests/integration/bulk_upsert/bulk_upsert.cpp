@@ -87,6 +87,19 @@ TStatus WriteLogBatch(TTableClient& tableClient, const std::string& table, const
     return status;
 }
 
+TValue MakeLogRow(const TLogMessage& message) {
+    return TValueBuilder()
+        .BeginStruct()
+        .AddMember("Id").Uint64(message.Pk.Id)
+        .AddMember("App").Utf8(message.Pk.App)
+        .AddMember("Host").Utf8(message.Pk.Host)
+        .AddMember("Timestamp").Timestamp(message.Pk.Timestamp)
+        .AddMember("HttpCode").Uint32(message.HttpCode)
+        .AddMember("Message").Utf8(message.Message)
+        .EndStruct()
+        .Build();
+}
+
 static TStatus SelectTransaction(TSession session, const std::string& path,
     std::optional<TResultSet>& resultSet) {
     std::filesystem::path filesystemPath(path);
@@ -35,5 +35,6 @@ TStatus CreateTable(TTableClient& client, const std::string& table);
 TStatistic GetLogBatch(uint64_t logOffset, std::vector<TLogMessage>& logBatch, uint32_t lastNumber);
 TStatus WriteLogBatch(TTableClient& tableClient, const std::string& table, const std::vector<TLogMessage>& logBatch,
                    const TRetryOperationSettings& retrySettings);
+TValue MakeLogRow(const TLogMessage& message);
 TStatistic Select(TTableClient& client, const std::string& path);
 void DropTable(TTableClient& client, const std::string& path);
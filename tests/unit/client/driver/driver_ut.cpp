@@ -67,6 +67,24 @@ namespace {
             op->mutable_result()->PackFrom(result);
             return grpc::Status::OK;
         }
+
+        grpc::Status BulkUpsert(
+                grpc::ServerContext* context,
+                const Ydb::Table::BulkUpsertRequest* request,
+                Ydb::Table::BulkUpsertResponse* response) override
+        {
+            Y_UNUSED(request);
+
+            context->AddInitialMetadata("x-ydb-server-hints", "initial-hint");
+            context->AddInitialMetadata("x-proxy-id", "proxy-1");
+            context->AddTrailingMetadata("x-ydb-consumed-units", "1");
+            context->AddTrailingMetadata("x-trace-id", "trace-1");
+
+            auto* op = response->mutable_operation();
+            op->set_ready(true);
+            op->set_status(Ydb::StatusIds::SUCCESS);
+            return grpc::Status::OK;
+        }
     };
 
     template<class TService>
@@ -77,6 +95,38 @@ namespace {
         return builder.BuildAndStart();
     }
 
+    std::multimap<std::string, std::string> BulkUpsertResponseMetadata(const TBulkUpsertSettings& settings) {
+        TPortManager pm;
+
+        TMockTableService tableService;
+        ui16 tablePort = pm.GetPort();
+        auto tableServer = StartGrpcServer(
+                TStringBuilder() << "127.0.0.1:" << tablePort,
+                tableService);
+
+        auto driver = TDriver(
+            TDriverConfig()
+                .SetEndpoint(TStringBuilder() << "localhost:" << tablePort)
+                .SetDiscoveryMode(EDiscoveryMode::Off)
+                .SetDatabase("/Root/My/DB"));
+        auto client = NTable::TTableClient(driver);
+        auto rows = TValueBuilder()
+            .BeginList()
+                .AddListItem()
+                    .BeginStruct()
+                        .AddMember("key").Uint64(1)
+                    .EndStruct()
+            .EndList()
+            .Build();
+        auto resultFuture = client.BulkUpsert("/Root/My/DB/table", std::move(rows), settings);
+
+        UNIT_ASSERT(resultFuture.Wait(TDuration::Seconds(10)));
+        auto result = resultFuture.ExtractValueSync();
+        UNIT_ASSERT_C(result.IsSuccess(), result.GetIssues().ToString());
+        driver.Stop(true);
+        return result.GetResponseMetadata();
+    }
+
 } // namespace
 
 Y_UNIT_TEST_SUITE(CppGrpcClientSimpleTest) {
@@ -253,6 +303,31 @@ Y_UNIT_TEST_SUITE(CppGrpcClientSimpleTest) {
         UNIT_ASSERT_VALUES_EQUAL(session.GetId(), "my-session-id");
     }
 
+    Y_UNIT_TEST(ResponseMetadataAll) {
+        const auto metadata = BulkUpsertResponseMetadata(TBulkUpsertSettings());
+
+        const std::multimap<std::string, std::string> expected = {
+            {"x-ydb-server-hints", "initial-hint"},
+            {"x-proxy-id", "proxy-1"},
+            {"x-ydb-consumed-units", "1"},
+            {"x-trace-id", "trace-1"},
+        };
+        for (const auto& [name, value] : expected) {
+            UNIT_ASSERT_C(metadata.contains(name), name);
+            UNIT_ASSERT_VALUES_EQUAL(metadata.find(name)->second, value);
+        }
+    }
+
+    Y_UNIT_TEST(ResponseMetadataYdbOnly) {
+        const auto metadata = BulkUpsertResponseMetadata(TBulkUpsertSettings().YdbResponseMetadataOnly(true));
+
+        const std::multimap<std::string, std::string> expected = {
+            {"x-ydb-server-hints", "initial-hint"},
+            {"x-ydb-consumed-units", "1"},
+        };
+        UNIT_ASSERT_EQUAL(metadata, expected);
+    }
+
     Y_UNIT_TEST(WithoutDiscoveryClientLevel) {
         TPortManager pm;
 
@@ -164,6 +164,170 @@ Y_UNIT_TEST_SUITE(EndpointElector) {
         UNIT_ASSERT_VALUES_EQUAL(elector.GetEndpoint(TEndpointKey()).Endpoint, "One");
     }
 
+    Y_UNIT_TEST(EndpointHandle) {
+        TEndpointElectorSafe elector;
+        UNIT_ASSERT(!elector.GetEndpointHandle(TEndpointKey()));
+
+        elector.SetNewState(std::vector<TEndpointRecord>{{"One", 1, "", 10}, {"Two", 2, "", 20}});
+        auto one = elector.GetEndpointHandle(TEndpointKey());
+        UNIT_ASSERT(one);
+        UNIT_ASSERT_VALUES_EQUAL(one->Endpoint, "One");
+        UNIT_ASSERT_EQUAL(elector.GetEndpointHandle(TEndpointKey("One", 0), true), one);
+        UNIT_ASSERT_VALUES_EQUAL(elector.GetEndpointHandle(TEndpointKey(20))->Endpoint, "Two");
+        UNIT_ASSERT(!elector.GetEndpointHandle(TEndpointKey("Three", 0), true));
+
+        // Changes are seen by the next lookup, taken handles keep the old record
+        elector.PessimizeEndpoint("One");
+        UNIT_ASSERT_VALUES_EQUAL(elector.GetEndpointHandle(TEndpointKey())->Endpoint, "Two");
+        UNIT_ASSERT_VALUES_EQUAL(one->Priority, 1);
+        // Nothing changes, so nothing is published again
+        auto two = elector.GetEndpointHandle(TEndpointKey("Two", 0), true);
+        elector.PessimizeEndpoint("One");
+        elector.PessimizeEndpoint("Unknown");
+        UNIT_ASSERT_EQUAL(elector.GetEndpointHandle(TEndpointKey("Two", 0), true), two);
+        UNIT_ASSERT_VALUES_EQUAL(elector.GetPessimizationRatio(), 50);
+        elector.SetNewState(std::vector<TEndpointRecord>{{"Three", 1}});
+        UNIT_ASSERT(!elector.GetEndpointHandle(TEndpointKey("One", 0), true));
+        UNIT_ASSERT_VALUES_EQUAL(one->Endpoint, "One");
+
+        // More electors than a thread keeps cached snapshots for
+        std::vector<std::unique_ptr<TEndpointElectorSafe>> electors;
+        for (int i = 0; i < 10; ++i) {
+            electors.emplace_back(std::make_unique<TEndpointElectorSafe>());
+            electors.back()->SetNewState(std::vector<TEndpointRecord>{{std::to_string(i), 1}});
+        }
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 10; ++i) {
+                UNIT_ASSERT_VALUES_EQUAL(electors[i]->GetEndpointHandle(TEndpointKey())->Endpoint, std::to_string(i));
+            }
+        }
+    }
+
+    Y_UNIT_TEST(EndpointCounters) {
+        NMonitoring::TMetricRegistry registry;
+        TEndpointElectorSafe elector;
+        elector.SetNewState(std::vector<TEndpointRecord>{{"One", 1, "", 1}});
+        UNIT_ASSERT(!elector.GetEndpoint(TEndpointKey("One", 0), true).Counters.GRpcInFlight);
+
+        elector.SetStatCollector(NSdkStats::TStatCollector::TEndpointElectorStatCollector(
+            nullptr, nullptr, nullptr, &registry, "db"));
+        auto one = elector.GetEndpoint(TEndpointKey("One", 0), true).Counters;
+        UNIT_ASSERT(one.GRpcInFlight);
+        UNIT_ASSERT(one.TransportErrors);
+        UNIT_ASSERT_EQUAL(elector.GetEndpoint(TEndpointKey("", 1), true).Counters.GRpcInFlight, one.GRpcInFlight);
+
+        elector.SetNewState(std::vector<TEndpointRecord>{{"One", 1, "", 1}, {"Two", 1, "", 2}});
+        auto two = elector.GetEndpoint(TEndpointKey("Two", 0), true).Counters;
+        UNIT_ASSERT(two.GRpcInFlight);
+        UNIT_ASSERT(two.GRpcInFlight != one.GRpcInFlight);
+        UNIT_ASSERT_EQUAL(elector.GetEndpoint(TEndpointKey("One", 0), true).Counters.GRpcInFlight, one.GRpcInFlight);
+
+        one.IncGRpcInFlight();
+        one.IncGRpcInFlight();
+        one.DecGRpcInFlight();
+        two.IncTransportErrors();
+        UNIT_ASSERT_VALUES_EQUAL(registry.IntGauge({{"database", "db"}, {"sensor", "Grpc/InFlightByYdbHost"},
+            {"YdbHost", "One"}})->Get(), 1);
+        UNIT_ASSERT_VALUES_EQUAL(registry.Rate({{"database", "db"}, {"sensor", "TransportErrorsByYdbHost"},
+            {"YdbHost", "Two"}})->Get(), 1);
+    }
+
+    Y_UNIT_TEST(EndpointLoad) {
+        const TInstant now = TInstant::Seconds(1000);
+        TEndpointLoad load;
+        UNIT_ASSERT_VALUES_EQUAL(load.GetCost(now), 0);
+
+        // Single probe while the latency is unknown
+        load.OnRequestStarted();
+        UNIT_ASSERT(load.GetCost(now) > 1e9);
+        load.OnRequestFinished(TDuration::MilliSeconds(1), now);
+        UNIT_ASSERT_DOUBLES_EQUAL(load.GetCost(now), 1000, 1e-6);
+
+        // Slowdowns are taken at once, requests in flight multiply the cost
+        load.OnRequestStarted();
+        load.OnRequestFinished(TDuration::MilliSeconds(100), now);
+        UNIT_ASSERT_DOUBLES_EQUAL(load.GetCost(now), 100000, 1e-6);
+        load.OnRequestStarted();
+        UNIT_ASSERT_DOUBLES_EQUAL(load.GetCost(now + TDuration::Minutes(1)), 200000, 1e-6);
+
+        // Recovery is smoothed, the latency of an idle endpoint decays
+        load.OnRequestFinished(TDuration::MilliSeconds(1), now + TDuration::Seconds(1));
+        const double recovering = load.GetCost(now + TDuration::Seconds(1));
+        UNIT_ASSERT(recovering > 50000 && recovering < 100000);
+        UNIT_ASSERT(load.GetCost(now + TDuration::Minutes(1)) < 1000);
+    }
+
+    Y_UNIT_TEST(EndpointLoadFailures) {
+        const TInstant now = TInstant::Seconds(1000);
+        TEndpointLoad healthy;
+        TEndpointLoad failing;
+        healthy.OnRequestStarted();
+        healthy.OnRequestFinished(TDuration::MilliSeconds(10), now);
+        failing.OnRequestStarted();
+        failing.OnRequestFinished(TDuration::MilliSeconds(10), now);
+
+        // A quick rejection makes the endpoint look slow, not fast
+        failing.OnRequestStarted();
+        failing.OnRequestFailed(TDuration::MicroSeconds(100), now);
+        UNIT_ASSERT_DOUBLES_EQUAL(failing.GetCost(now), 1'000'000, 1e-6);
+        UNIT_ASSERT(failing.GetCost(now) > healthy.GetCost(now));
+
+        // Failures of a slow endpoint scale its latency up
+        failing.OnRequestStarted();
+        failing.OnRequestFailed(TDuration::MilliSeconds(1), now);
+        UNIT_ASSERT_DOUBLES_EQUAL(failing.GetCost(now), 4'000'000, 1e-6);
+
+        // Failures are forgotten like any other slowdown
+        UNIT_ASSERT(failing.GetCost(now + TDuration::Minutes(2)) < healthy.GetCost(now));
+    }
+
+    Y_UNIT_TEST(EndpointLoadStreams) {
+        const TInstant now = TInstant::Seconds(1000);
+        TEndpointLoad load;
+        load.OnRequestStarted();
+        load.OnRequestFinished(TDuration::MilliSeconds(1), now);
+
+        // An open stream is in flight, closing it doesn't change the latency
+        load.OnRequestStarted();
+        UNIT_ASSERT_DOUBLES_EQUAL(load.GetCost(now), 2000, 1e-6);
+        load.OnStreamFinished(false, now + TDuration::Hours(1));
+        UNIT_ASSERT_DOUBLES_EQUAL(load.GetCost(now), 1000, 1e-6);
+
+        // A broken stream counts as a failed request
+        load.OnRequestStarted();
+        load.OnStreamFinished(true, now);
+        UNIT_ASSERT_DOUBLES_EQUAL(load.GetCost(now), 1'000'000, 1e-6);
+    }
+
+    Y_UNIT_TEST(PowerOfTwoChoices) {
+        TEndpointElectorSafe elector(EEndpointSelection::PowerOfTwoChoices);
+        elector.SetNewState(std::vector<TEndpointRecord>{{"Slow", 1}, {"Fast", 1}, {"Foreign", 2}});
+
+        auto slow = elector.GetEndpoint(TEndpointKey("Slow", 0), true).Load;
+        auto fast = elector.GetEndpoint(TEndpointKey("Fast", 0), true).Load;
+        UNIT_ASSERT(slow && fast);
+        UNIT_ASSERT(elector.GetEndpoint(TEndpointKey("Foreign", 0), true).Load);
+
+        const TInstant now = TInstant::Now();
+        slow->OnRequestStarted();
+        slow->OnRequestFinished(TDuration::Seconds(1), now);
+        fast->OnRequestStarted();
+        fast->OnRequestFinished(TDuration::MilliSeconds(1), now);
+
+        // Both best priority endpoints are always compared
+        for (int i = 0; i < 100; ++i) {
+            UNIT_ASSERT_VALUES_EQUAL(elector.GetEndpoint(TEndpointKey()).Endpoint, "Fast");
+        }
+
+        // Load survives rediscovery of the same endpoint
+        elector.SetNewState(std::vector<TEndpointRecord>{{"Slow", 1}, {"Fast", 1}});
+        UNIT_ASSERT_EQUAL(elector.GetEndpoint(TEndpointKey("Slow", 0), true).Load, slow);
+
+        TEndpointElectorSafe randomElector;
+        randomElector.SetNewState(std::vector<TEndpointRecord>{{"One", 1}});
+        UNIT_ASSERT(!randomElector.GetEndpoint(TEndpointKey()).Load);
+    }
+
     Y_UNIT_TEST(EndpointAssociationTwoThreadsNoRace) {
         TEndpointElectorSafe elector;
 
@@ -358,6 +358,46 @@ TEST(DiscoveryEndpointParserTest, RejectsBadInput) {
     EXPECT_EQ(port, 0);
 }
 
+// ---------------------------------------------------------------------------
+// Per-host gRPC counters of endpoints outside the endpoint pool
+// ---------------------------------------------------------------------------
+
+TEST(EndpointCountersByHostTest, CountsPerHost) {
+    ::NMonitoring::TMetricRegistry registry;
+    TStatCollector collector("/Root/db", &registry, {}, "discovery:2135");
+    auto inFlight = [&](const std::string& host) {
+        return registry.IntGauge({{"database", "/Root/db"}, {"sensor", "Grpc/InFlightByYdbHost"}, {"YdbHost", host}});
+    };
+    auto transportErrors = [&](const std::string& host) {
+        return registry.Rate({{"database", "/Root/db"}, {"sensor", "TransportErrorsByYdbHost"}, {"YdbHost", host}});
+    };
+
+    auto discovery = collector.GetEndpointCountersByHost("discovery:2135");
+    EXPECT_EQ(discovery.GRpcInFlight, inFlight("discovery:2135"));
+    EXPECT_EQ(discovery.TransportErrors, transportErrors("discovery:2135"));
+
+    auto other = collector.GetEndpointCountersByHost("other:2135");
+    EXPECT_EQ(other.GRpcInFlight, inFlight("other:2135"));
+
+    discovery.IncGRpcInFlight();
+    other.IncGRpcInFlight();
+    other.IncGRpcInFlight();
+    other.IncTransportErrors();
+    EXPECT_EQ(inFlight("discovery:2135")->Get(), 1);
+    EXPECT_EQ(inFlight("other:2135")->Get(), 2);
+    EXPECT_EQ(transportErrors("discovery:2135")->Get(), 0u);
+    EXPECT_EQ(transportErrors("other:2135")->Get(), 1u);
+}
+
+TEST(EndpointCountersByHostTest, NullRegistryIsSafe) {
+    TStatCollector collector("/Root/db", nullptr, {}, "discovery:2135");
+    auto counters = collector.GetEndpointCountersByHost("discovery:2135");
+    EXPECT_EQ(counters.GRpcInFlight, nullptr);
+    counters.IncGRpcInFlight();
+    counters.IncTransportErrors();
+    EXPECT_EQ(collector.GetEndpointCountersByHost("other:2135").GRpcInFlight, nullptr);
+}
+
 // ---------------------------------------------------------------------------
 // PoolName resolution (M9)
 // ---------------------------------------------------------------------------
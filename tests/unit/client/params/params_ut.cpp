@@ -239,3 +239,64 @@ TEST(ParamsBuilder, TypeMismatchFromValue) {
             .Build();
     }, TExpectedErrorException);
 }
+
+TEST(ParamsTemplate, Build) {
+    TParamsTemplate paramsTemplate({
+        {"$id", TTypeBuilder().Primitive(EPrimitiveType::Uint64).Build()},
+        {"$tags", TTypeBuilder().BeginList().Primitive(EPrimitiveType::Utf8).EndList().Build()}});
+
+    ASSERT_EQ(paramsTemplate.ParamsCount(), 2u);
+    const size_t id = paramsTemplate.GetParamIndex("$id");
+    const size_t tags = paramsTemplate.GetParamIndex("$tags");
+
+    auto buildParams = [&](uint64_t idValue, const std::string& tag) {
+        return paramsTemplate
+            .Param(id).Uint64(idValue).Build()
+            .Param(tags)
+                .BeginList()
+                .AddListItem().Utf8(tag)
+                .EndList()
+                .Build()
+            .Build();
+    };
+
+    auto params1 = buildParams(1, "first");
+
+    // Previous params are still alive, the next request gets separate storage
+    auto params2 = buildParams(2, "second");
+    ASSERT_EQ(params1.GetValue("$id")->GetProto().uint64_value(), 1u);
+    ASSERT_EQ(params2.GetValue("$id")->GetProto().uint64_value(), 2u);
+    ASSERT_EQ(FormatType(params2.GetValue("$tags")->GetType()), "List<Utf8>");
+    CheckProtoValue(params2.GetValue("$tags")->GetProto(),
+        "items {\n"
+        "  text_value: \"second\"\n"
+        "}\n");
+
+    // Storage is reused once all params built from it are destroyed
+    params1 = TParamsBuilder().Build();
+    auto params3 = buildParams(3, "third");
+    ASSERT_EQ(params3.GetValue("$id")->GetProto().uint64_value(), 3u);
+    CheckProtoValue(params3.GetValue("$tags")->GetProto(),
+        "items {\n"
+        "  text_value: \"third\"\n"
+        "}\n");
+    ASSERT_EQ(params2.GetValue("$id")->GetProto().uint64_value(), 2u);
+}
+
+TEST(ParamsTemplate, Errors) {
+    TParamsTemplate paramsTemplate({
+        {"$id", TTypeBuilder().Primitive(EPrimitiveType::Uint64).Build()},
+        {"$name", TTypeBuilder().Primitive(EPrimitiveType::Utf8).Build()}});
+
+    ASSERT_THROW(paramsTemplate.GetParamIndex("$unknown"), TExpectedErrorException);
+    ASSERT_THROW(paramsTemplate.Param(2), TExpectedErrorException);
+    ASSERT_THROW(paramsTemplate.Param(0).Int32(1), TExpectedErrorException);
+    ASSERT_THROW(paramsTemplate.Param(1, TValueBuilder().String("abc").Build()), TExpectedErrorException);
+
+    paramsTemplate.Param(0).Uint64(1).Build();
+    ASSERT_THROW(paramsTemplate.Build(), TExpectedErrorException);
+
+    paramsTemplate.Param(1, TValueBuilder().Utf8("abc").Build());
+    auto params = paramsTemplate.Build();
+    ASSERT_EQ(params.GetValue("$name")->GetProto().text_value(), "abc");
+}
@@ -0,0 +1,155 @@
+#define INCLUDE_YDB_INTERNAL_H
+#include <src/client/impl/internal/read_ahead/read_ahead.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
+#include <src/api/protos/ydb_table.pb.h>
+
+#include <gtest/gtest.h>
+
+using namespace NYdb;
+
+namespace {
+    using TResponse = Ydb::Table::ReadTableResponse;
+
+    /**
+     * Stream with manually completed reads.
+     */
+    class TFakeStreamProcessor : public NYdbGrpc::IStreamRequestReadProcessor<TResponse> {
+    public:
+        void Cancel() override {
+        }
+
+        void ReadInitialMetadata(std::unordered_multimap<std::string, std::string>*, TReadCallback) override {
+        }
+
+        void Read(TResponse* response, TReadCallback callback) override {
+            ASSERT_FALSE(Callback_) << "Multiple Read calls detected";
+            Response_ = response;
+            Callback_ = std::move(callback);
+            ++ReadsCount;
+        }
+
+        void Finish(TReadCallback) override {
+        }
+
+        void AddFinishedCallback(TReadCallback) override {
+        }
+
+        bool HasActiveRead() const {
+            return static_cast<bool>(Callback_);
+        }
+
+        void Complete(const std::string& issue) {
+            Response_->add_issues()->set_message(TStringType{issue});
+            std::exchange(Callback_, nullptr)(NYdbGrpc::TGrpcStatus());
+        }
+
+        void CompleteWithEof() {
+            std::exchange(Callback_, nullptr)(NYdbGrpc::TGrpcStatus(grpc::StatusCode::OUT_OF_RANGE, "Read EOF"));
+        }
+
+        size_t ReadsCount = 0;
+
+    private:
+        TResponse* Response_ = nullptr;
+        TReadCallback Callback_;
+    };
+
+    std::optional<NYdbGrpc::TGrpcStatus> Read(TStreamReadAhead<TResponse>& readAhead, TResponse& response) {
+        std::optional<NYdbGrpc::TGrpcStatus> result;
+        readAhead.Read(&response, [&result](NYdbGrpc::TGrpcStatus&& status) {
+            result = std::move(status);
+        });
+        return result;
+    }
+}
+
+TEST(ReadAheadTest, Disabled) {
+    TIntrusivePtr<TFakeStreamProcessor> stream = MakeIntrusive<TFakeStreamProcessor>();
+    EXPECT_EQ(MakeStreamReadAhead<TResponse>(stream, std::nullopt), nullptr);
+    EXPECT_EQ(MakeStreamReadAhead<TResponse>(stream, TReadAheadSettings().MaxParts(0)), nullptr);
+    EXPECT_EQ(MakeStreamReadAhead<TResponse>(stream, TReadAheadSettings().MaxBytes(0)), nullptr);
+    EXPECT_EQ(stream->ReadsCount, 0u);
+}
+
+TEST(ReadAheadTest, BufferedParts) {
+    TIntrusivePtr<TFakeStreamProcessor> stream = MakeIntrusive<TFakeStreamProcessor>();
+    auto readAhead = MakeStreamReadAhead<TResponse>(stream, TReadAheadSettings().MaxParts(2));
+
+    // Stream is read before the consumer asks for data, up to the window size
+    ASSERT_TRUE(stream->HasActiveRead());
+    stream->Complete("part1");
+    ASSERT_TRUE(stream->HasActiveRead());
+    stream->Complete("part2");
+    EXPECT_FALSE(stream->HasActiveRead());
+
+    TResponse response;
+    auto status = Read(*readAhead, response);
+    ASSERT_TRUE(status && status->Ok());
+    EXPECT_EQ(response.issues(0).message(), "part1");
+
+    // Consumed part frees space in the window
+    ASSERT_TRUE(stream->HasActiveRead());
+
+    status = Read(*readAhead, response);
+    ASSERT_TRUE(status && status->Ok());
+    EXPECT_EQ(response.issues(0).message(), "part2");
+
+    // Consumer waits for the part in flight
+    std::optional<NYdbGrpc::TGrpcStatus> pendingStatus;
+    readAhead->Read(&response, [&pendingStatus](NYdbGrpc::TGrpcStatus&& status) {
+        pendingStatus = std::move(status);
+    });
+    EXPECT_FALSE(pendingStatus);
+    stream->CompleteWithEof();
+    ASSERT_TRUE(pendingStatus);
+    EXPECT_EQ(pendingStatus->GRpcStatusCode, grpc::StatusCode::OUT_OF_RANGE);
+
+    // Final status is repeated after the end of the stream
+    status = Read(*readAhead, response);
+    ASSERT_TRUE(status);
+    EXPECT_EQ(status->GRpcStatusCode, grpc::StatusCode::OUT_OF_RANGE);
+    EXPECT_EQ(stream->ReadsCount, 3u);
+}
+
+TEST(ReadAheadTest, BytesLimit) {
+    TIntrusivePtr<TFakeStreamProcessor> stream = MakeIntrusive<TFakeStreamProcessor>();
+    auto readAhead = MakeStreamReadAhead<TResponse>(stream, TReadAheadSettings().MaxParts(100).MaxBytes(1));
+
+    stream->Complete("part1");
+    EXPECT_FALSE(stream->HasActiveRead());
+
+    TResponse response;
+    auto status = Read(*readAhead, response);
+    ASSERT_TRUE(status && status->Ok());
+    EXPECT_TRUE(stream->HasActiveRead());
+}
+
+TEST(ReadAheadTest, BytesLimitSmallerThanPart) {
+    TIntrusivePtr<TFakeStreamProcessor> stream = MakeIntrusive<TFakeStreamProcessor>();
+    auto readAhead = MakeStreamReadAhead<TResponse>(stream, TReadAheadSettings().MaxParts(100).MaxBytes(1));
+
+    // Every part exceeds the limit, still one of them is always read ahead
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(stream->HasActiveRead());
+        stream->Complete("part" + std::to_string(i));
+        EXPECT_FALSE(stream->HasActiveRead());
+
+        TResponse response;
+        auto status = Read(*readAhead, response);
+        ASSERT_TRUE(status && status->Ok());
+        EXPECT_EQ(response.issues(0).message(), "part" + std::to_string(i));
+    }
+
+    // Consumer waiting on the empty buffer gets the next part
+    TResponse response;
+    std::optional<NYdbGrpc::TGrpcStatus> pendingStatus;
+    readAhead->Read(&response, [&pendingStatus](NYdbGrpc::TGrpcStatus&& status) {
+        pendingStatus = std::move(status);
+    });
+    ASSERT_TRUE(stream->HasActiveRead());
+    stream->Complete("part3");
+    ASSERT_TRUE(pendingStatus && pendingStatus->Ok());
+    EXPECT_EQ(response.issues(0).message(), "part3");
+    EXPECT_EQ(stream->ReadsCount, 5u);
+}
@@ -0,0 +1,384 @@
+#include <ydb-cpp-sdk/client/result/arrow.h>
+#include <ydb-cpp-sdk/client/types/exceptions/exceptions.h>
+
+#include <src/api/protos/ydb_value.pb.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <cstring>
+#include <limits>
+
+using namespace NYdb;
+
+namespace {
+
+// Serialized with pyarrow: record_batch([int64 [1, -2, 3], utf8 ["a", null, "ccc"]], names=["id", "name"])
+const std::string ArrowSchema(
+    "\xff\xff\xff\xff\xa8\x00\x00\x00\x10\x00\x00\x00\x00\x00\x0a\x00\x0c\x00\x06\x00\x05\x00\x08\x00"
+    "\x0a\x00\x00\x00\x00\x01\x04\x00\x0c\x00\x00\x00\x08\x00\x08\x00\x00\x00\x04\x00\x08\x00\x00\x00"
+    "\x04\x00\x00\x00\x02\x00\x00\x00\x44\x00\x00\x00\x04\x00\x00\x00\xd4\xff\xff\xff\x00\x00\x01\x05"
+    "\x10\x00\x00\x00\x1c\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x6e\x61\x6d\x65"
+    "\x00\x00\x00\x00\x04\x00\x04\x00\x04\x00\x00\x00\x10\x00\x14\x00\x08\x00\x06\x00\x07\x00\x0c\x00"
+    "\x00\x00\x10\x00\x10\x00\x00\x00\x00\x00\x01\x02\x10\x00\x00\x00\x1c\x00\x00\x00\x04\x00\x00\x00"
+    "\x00\x00\x00\x00\x02\x00\x00\x00\x69\x64\x00\x00\x08\x00\x0c\x00\x08\x00\x07\x00\x08\x00\x00\x00"
+    "\x00\x00\x00\x01\x40\x00\x00\x00", 176);
+
+const std::string ArrowBatch(
+    "\xff\xff\xff\xff\xc8\x00\x00\x00\x14\x00\x00\x00\x00\x00\x00\x00\x0c\x00\x16\x00\x06\x00\x05\x00"
+    "\x08\x00\x0c\x00\x0c\x00\x00\x00\x00\x03\x04\x00\x18\x00\x00\x00\x38\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x0a\x00\x18\x00\x0c\x00\x04\x00\x08\x00\x0a\x00\x00\x00\x6c\x00\x00\x00\x10\x00\x00\x00"
+    "\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x05\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x18\x00\x00\x00\x00\x00\x00\x00"
+    "\x18\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x20\x00\x00\x00\x00\x00\x00\x00"
+    "\x10\x00\x00\x00\x00\x00\x00\x00\x30\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x03\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00"
+    "\xfe\xff\xff\xff\xff\xff\xff\xff\x03\x00\x00\x00\x00\x00\x00\x00\x05\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x01\x00\x00\x00\x01\x00\x00\x00\x04\x00\x00\x00\x61\x63\x63\x63\x00\x00\x00\x00", 264);
+
+// Serialized with pyarrow: record_batch([
+//     bool [true, null, false, true],
+//     list<int32> [[1, 2], [], null, [3]],
+//     struct<x: int32, y: utf8> [{1, "a"}, {2, "bb"}, {3, null}, {4, "dddd"}]
+// ], names=["flag", "tags", "point"])
+const std::string NestedSchema(
+    "\xff\xff\xff\xff\x60\x01\x00\x00\x10\x00\x00\x00\x00\x00\x0a\x00\x0c\x00\x06\x00\x05\x00\x08\x00"
+    "\x0a\x00\x00\x00\x00\x01\x04\x00\x0c\x00\x00\x00\x08\x00\x08\x00\x00\x00\x04\x00\x08\x00\x00\x00"
+    "\x04\x00\x00\x00\x03\x00\x00\x00\x00\x01\x00\x00\x88\x00\x00\x00\x04\x00\x00\x00\x1c\xff\xff\xff"
+    "\x00\x00\x01\x0d\x18\x00\x00\x00\x20\x00\x00\x00\x04\x00\x00\x00\x02\x00\x00\x00\x3c\x00\x00\x00"
+    "\x14\x00\x00\x00\x05\x00\x00\x00\x70\x6f\x69\x6e\x74\x00\x00\x00\x14\xff\xff\xff\x4c\xff\xff\xff"
+    "\x00\x00\x01\x05\x10\x00\x00\x00\x14\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00"
+    "\x79\x00\x00\x00\x38\xff\xff\xff\x70\xff\xff\xff\x00\x00\x01\x02\x10\x00\x00\x00\x14\x00\x00\x00"
+    "\x04\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x78\x00\x00\x00\xa4\xff\xff\xff\x00\x00\x00\x01"
+    "\x20\x00\x00\x00\x9c\xff\xff\xff\x00\x00\x01\x0c\x14\x00\x00\x00\x1c\x00\x00\x00\x04\x00\x00\x00"
+    "\x01\x00\x00\x00\x14\x00\x00\x00\x04\x00\x00\x00\x74\x61\x67\x73\x00\x00\x00\x00\x90\xff\xff\xff"
+    "\xc8\xff\xff\xff\x00\x00\x01\x02\x10\x00\x00\x00\x20\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x00\x00\x00\x69\x74\x65\x6d\x00\x00\x00\x00\x08\x00\x0c\x00\x08\x00\x07\x00\x08\x00\x00\x00"
+    "\x00\x00\x00\x01\x20\x00\x00\x00\x10\x00\x14\x00\x08\x00\x06\x00\x07\x00\x0c\x00\x00\x00\x10\x00"
+    "\x10\x00\x00\x00\x00\x00\x01\x06\x10\x00\x00\x00\x1c\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x00\x00\x00\x66\x6c\x61\x67\x00\x00\x00\x00\x04\x00\x04\x00\x04\x00\x00\x00\x00\x00\x00\x00", 360);
+
+const std::string NestedBatch(
+    "\xff\xff\xff\xff\x78\x01\x00\x00\x14\x00\x00\x00\x00\x00\x00\x00\x0c\x00\x16\x00\x06\x00\x05\x00"
+    "\x08\x00\x0c\x00\x0c\x00\x00\x00\x00\x03\x04\x00\x18\x00\x00\x00\x78\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x0a\x00\x18\x00\x0c\x00\x04\x00\x08\x00\x0a\x00\x00\x00\xdc\x00\x00\x00\x10\x00\x00\x00"
+    "\x04\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x0c\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00\x00\x00\x00\x00\x00\x08\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00"
+    "\x10\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x18\x00\x00\x00\x00\x00\x00\x00"
+    "\x14\x00\x00\x00\x00\x00\x00\x00\x30\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x30\x00\x00\x00\x00\x00\x00\x00\x0c\x00\x00\x00\x00\x00\x00\x00\x40\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x40\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x40\x00\x00\x00\x00\x00\x00\x00\x10\x00\x00\x00\x00\x00\x00\x00\x50\x00\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00\x00\x00\x00\x00\x00\x58\x00\x00\x00\x00\x00\x00\x00\x14\x00\x00\x00\x00\x00\x00\x00"
+    "\x70\x00\x00\x00\x00\x00\x00\x00\x07\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x06\x00\x00\x00"
+    "\x04\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00\x00\x00\x00\x00\x00\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00"
+    "\x0d\x00\x00\x00\x00\x00\x00\x00\x09\x00\x00\x00\x00\x00\x00\x00\x0b\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x02\x00\x00\x00\x02\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00\x00"
+    "\x03\x00\x00\x00\x04\x00\x00\x00\x0b\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00"
+    "\x03\x00\x00\x00\x03\x00\x00\x00\x07\x00\x00\x00\x00\x00\x00\x00\x61\x62\x62\x64\x64\x64\x64\x00", 504);
+
+// The same batch written with IpcWriteOptions(compression="lz4")
+const std::string NestedBatchLz4(
+    "\xff\xff\xff\xff\x88\x01\x00\x00\x14\x00\x00\x00\x00\x00\x00\x00\x0c\x00\x18\x00\x06\x00\x05\x00"
+    "\x08\x00\x0c\x00\x0c\x00\x00\x00\x00\x03\x04\x00\x1c\x00\x00\x00\x28\x01\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x0c\x00\x1c\x00\x10\x00\x04\x00\x08\x00\x0c\x00\x0c\x00\x00\x00\xe8\x00\x00\x00"
+    "\x1c\x00\x00\x00\x14\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x04\x00"
+    "\x04\x00\x00\x00\x0c\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x18\x00\x00\x00\x00\x00\x00\x00"
+    "\x18\x00\x00\x00\x00\x00\x00\x00\x18\x00\x00\x00\x00\x00\x00\x00\x30\x00\x00\x00\x00\x00\x00\x00"
+    "\x18\x00\x00\x00\x00\x00\x00\x00\x48\x00\x00\x00\x00\x00\x00\x00\x25\x00\x00\x00\x00\x00\x00\x00"
+    "\x70\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x70\x00\x00\x00\x00\x00\x00\x00"
+    "\x23\x00\x00\x00\x00\x00\x00\x00\x98\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x98\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x98\x00\x00\x00\x00\x00\x00\x00"
+    "\x27\x00\x00\x00\x00\x00\x00\x00\xc0\x00\x00\x00\x00\x00\x00\x00\x18\x00\x00\x00\x00\x00\x00\x00"
+    "\xd8\x00\x00\x00\x00\x00\x00\x00\x2b\x00\x00\x00\x00\x00\x00\x00\x08\x01\x00\x00\x00\x00\x00\x00"
+    "\x1e\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x06\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00"
+    "\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x22\x4d\x18\x60\x40\x82\x01\x00\x00\x80\x0d\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x22\x4d\x18\x60\x40\x82\x01\x00\x00\x80\x09\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x22\x4d\x18\x60\x40\x82\x01\x00\x00\x80\x0b\x00\x00\x00\x00\x14\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x22\x4d\x18\x60\x40\x82\x0e\x00\x00\x00\x56\x00\x00\x00\x00\x02\x04\x00\x50\x00\x03\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x0c\x00\x00\x00\x00\x00\x00\x00\x04\x22\x4d\x18\x60\x40\x82\x0c"
+    "\x00\x00\x80\x01\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x10\x00\x00\x00\x00\x00\x00\x00\x04\x22\x4d\x18\x60\x40\x82\x10\x00\x00\x80\x01\x00\x00\x00\x02"
+    "\x00\x00\x00\x03\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x22\x4d\x18\x60\x40\x82\x01\x00\x00\x80\x0b\x00\x00\x00\x00\x14\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x22\x4d\x18\x60\x40\x82\x14\x00\x00\x80\x00\x00\x00\x00\x01\x00\x00\x00\x03\x00\x00\x00\x03"
+    "\x00\x00\x00\x07\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x07\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x22\x4d\x18\x60\x40\x82\x07\x00\x00\x80\x61\x62\x62\x64\x64\x64\x64\x00\x00\x00\x00\x00\x00", 696);
+
+// The same batch written with IpcWriteOptions(compression="zstd")
+const std::string NestedBatchZstd(
+    "\xff\xff\xff\xff\x90\x01\x00\x00\x14\x00\x00\x00\x00\x00\x00\x00\x0c\x00\x18\x00\x06\x00\x05\x00"
+    "\x08\x00\x0c\x00\x0c\x00\x00\x00\x00\x03\x04\x00\x1c\x00\x00\x00\x08\x01\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x0c\x00\x1e\x00\x10\x00\x04\x00\x08\x00\x0c\x00\x0c\x00\x00\x00\xf0\x00\x00\x00"
+    "\x24\x00\x00\x00\x18\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x06\x00"
+    "\x08\x00\x07\x00\x06\x00\x00\x00\x00\x00\x00\x01\x0c\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x12\x00\x00\x00\x00\x00\x00\x00\x18\x00\x00\x00\x00\x00\x00\x00\x12\x00\x00\x00\x00\x00\x00\x00"
+    "\x30\x00\x00\x00\x00\x00\x00\x00\x12\x00\x00\x00\x00\x00\x00\x00\x48\x00\x00\x00\x00\x00\x00\x00"
+    "\x20\x00\x00\x00\x00\x00\x00\x00\x68\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x68\x00\x00\x00\x00\x00\x00\x00\x1d\x00\x00\x00\x00\x00\x00\x00\x88\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x88\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x88\x00\x00\x00\x00\x00\x00\x00\x21\x00\x00\x00\x00\x00\x00\x00\xb0\x00\x00\x00\x00\x00\x00\x00"
+    "\x12\x00\x00\x00\x00\x00\x00\x00\xc8\x00\x00\x00\x00\x00\x00\x00\x25\x00\x00\x00\x00\x00\x00\x00"
+    "\xf0\x00\x00\x00\x00\x00\x00\x00\x18\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x06\x00\x00\x00"
+    "\x04\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00\x00\x00\x00\x00\x00\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x04\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00\x00\x00\x00\x00\x00\x28\xb5\x2f\xfd\x20\x01\x09\x00\x00\x0d\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00\x00\x00\x00\x00\x00\x28\xb5\x2f\xfd\x20\x01\x09\x00\x00\x09\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00\x00\x00\x00\x00\x00\x28\xb5\x2f\xfd\x20\x01\x09\x00\x00\x0b\x00\x00\x00\x00\x00\x00"
+    "\x14\x00\x00\x00\x00\x00\x00\x00\x28\xb5\x2f\xfd\x20\x14\x7d\x00\x00\x48\x00\x00\x00\x00\x02\x03"
+    "\x00\x00\x00\x01\x00\x1b\x4e\x0b\x0c\x00\x00\x00\x00\x00\x00\x00\x28\xb5\x2f\xfd\x20\x0c\x61\x00"
+    "\x00\x01\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00\x00\x00\x00\x10\x00\x00\x00\x00\x00\x00\x00"
+    "\x28\xb5\x2f\xfd\x20\x10\x81\x00\x00\x01\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00\x04\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x28\xb5\x2f\xfd\x20\x01\x09\x00"
+    "\x00\x0b\x00\x00\x00\x00\x00\x00\x14\x00\x00\x00\x00\x00\x00\x00\x28\xb5\x2f\xfd\x20\x14\xa1\x00"
+    "\x00\x00\x00\x00\x00\x01\x00\x00\x00\x03\x00\x00\x00\x03\x00\x00\x00\x07\x00\x00\x00\x00\x00\x00"
+    "\x07\x00\x00\x00\x00\x00\x00\x00\x28\xb5\x2f\xfd\x20\x07\x39\x00\x00\x61\x62\x62\x64\x64\x64\x64", 672);
+
+// Schema message of a Null field nested into `depth` lists. Tables of a kind share their vtable,
+// which is enough for the parser and keeps the message small at any depth
+std::string MakeNestedListSchema(size_t depth) {
+    std::string buffer;
+    auto append = [&](auto value) {
+        const size_t pos = buffer.size();
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        return pos;
+    };
+    // Offsets to tables and vectors are relative to the place they are stored at
+    auto link = [&](size_t from, size_t to) {
+        const uint32_t offset = to - from;
+        std::memcpy(buffer.data() + from, &offset, sizeof(offset));
+    };
+    auto table = [&](size_t vtable) {
+        return append(static_cast<int32_t>(buffer.size() - vtable));
+    };
+
+    const size_t root = append(uint32_t(0));
+
+    // Vtables: vtable size, table size and offsets of the fields
+    const size_t messageVTable = append(uint16_t(10));
+    for (uint16_t offset : {12, 0, 4, 8}) {
+        append(offset);
+    }
+    const size_t schemaVTable = append(uint16_t(8));
+    for (uint16_t offset : {8, 0, 4}) {
+        append(offset);
+    }
+    const size_t fieldVTable = append(uint16_t(16));
+    for (uint16_t offset : {16, 0, 0, 4, 8, 0, 12}) {
+        append(offset);
+    }
+    const size_t typeVTable = append(uint16_t(4));
+    append(uint16_t(4));
+
+    link(root, table(messageVTable));
+    append(uint32_t(1)); // Schema header
+    const size_t header = append(uint32_t(0));
+
+    link(header, table(schemaVTable));
+    const size_t fields = append(uint32_t(0));
+    link(fields, append(uint32_t(1)));
+    size_t child = append(uint32_t(0));
+
+    std::vector<size_t> types;
+    for (size_t i = 0; i <= depth; ++i) {
+        link(child, table(fieldVTable));
+        append(uint32_t(i < depth ? 12 : 1)); // List or Null
+        types.push_back(append(uint32_t(0)));
+        const size_t children = append(uint32_t(0));
+        link(children, append(uint32_t(i < depth ? 1 : 0)));
+        if (i < depth) {
+            child = append(uint32_t(0));
+        }
+    }
+
+    // Neither List nor Null types have parameters
+    const size_t type = table(typeVTable);
+    for (size_t pos : types) {
+        link(pos, type);
+    }
+
+    const uint32_t prefix[] = {std::numeric_limits<uint32_t>::max(), static_cast<uint32_t>(buffer.size())};
+    return std::string(reinterpret_cast<const char*>(prefix), sizeof(prefix)) + buffer;
+}
+
+// Replaces the uncompressed length of the first buffer in the body of a compressed batch
+std::string WithUncompressedLength(std::string batch, int64_t length) {
+    uint32_t metadataSize;
+    std::memcpy(&metadataSize, batch.data() + 4, sizeof(metadataSize));
+    std::memcpy(batch.data() + 8 + metadataSize, &length, sizeof(length));
+    return batch;
+}
+
+int32_t GetListOffset(const NArrow::TColumnView& column, size_t index) {
+    int32_t offset;
+    std::memcpy(&offset, column.GetOffsets() + index * sizeof(offset), sizeof(offset));
+    return offset;
+}
+
+void CheckNestedBatch(const std::string& message) {
+    const auto schema = NArrow::ParseSchema(NestedSchema);
+    NArrow::TRecordBatchView batch(schema, message);
+    UNIT_ASSERT_VALUES_EQUAL(batch.RowsCount(), 4);
+    UNIT_ASSERT_VALUES_EQUAL(batch.ColumnsCount(), 3);
+
+    const auto& flag = batch.GetColumn(0);
+    UNIT_ASSERT_EQUAL(flag.GetField().Type, NArrow::EType::Bool);
+    UNIT_ASSERT_VALUES_EQUAL(flag.NullCount(), 1);
+    UNIT_ASSERT(flag.GetBool(0));
+    UNIT_ASSERT(flag.IsNull(1));
+    UNIT_ASSERT(!flag.GetBool(2));
+    UNIT_ASSERT(flag.GetBool(3));
+    UNIT_ASSERT(!flag.IsNull(3));
+
+    const auto& tags = batch.GetColumn(1);
+    UNIT_ASSERT_EQUAL(tags.GetField().Type, NArrow::EType::List);
+    UNIT_ASSERT_VALUES_EQUAL(tags.ChildrenCount(), 1);
+    UNIT_ASSERT(tags.IsNull(2));
+    const std::vector<int32_t> expectedOffsets = {0, 2, 2, 2, 3};
+    for (size_t i = 0; i < expectedOffsets.size(); ++i) {
+        UNIT_ASSERT_VALUES_EQUAL(GetListOffset(tags, i), expectedOffsets[i]);
+    }
+    const auto& tagItems = tags.GetChild(0);
+    UNIT_ASSERT_VALUES_EQUAL(tagItems.Size(), 3);
+    UNIT_ASSERT_VALUES_EQUAL(tagItems.GetValue<int32_t>(0), 1);
+    UNIT_ASSERT_VALUES_EQUAL(tagItems.GetValue<int32_t>(1), 2);
+    UNIT_ASSERT_VALUES_EQUAL(tagItems.GetValue<int32_t>(2), 3);
+
+    const auto& point = batch.GetColumn(2);
+    UNIT_ASSERT_EQUAL(point.GetField().Type, NArrow::EType::Struct);
+    UNIT_ASSERT_VALUES_EQUAL(point.ChildrenCount(), 2);
+    UNIT_ASSERT_VALUES_EQUAL(point.NullCount(), 0);
+    const auto& x = point.GetChild(0);
+    const auto& y = point.GetChild(1);
+    UNIT_ASSERT_VALUES_EQUAL(x.GetField().Name, "x");
+    UNIT_ASSERT_VALUES_EQUAL(y.GetField().Name, "y");
+    for (int32_t i = 0; i < 4; ++i) {
+        UNIT_ASSERT_VALUES_EQUAL(x.GetValue<int32_t>(i), i + 1);
+    }
+    UNIT_ASSERT_VALUES_EQUAL(y.GetString(0), "a");
+    UNIT_ASSERT_VALUES_EQUAL(y.GetString(1), "bb");
+    UNIT_ASSERT(y.IsNull(2));
+    UNIT_ASSERT_VALUES_EQUAL(y.GetString(3), "dddd");
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(CppGrpcClientArrowResultSetTest) {
+    Y_UNIT_TEST(Schema) {
+        auto schema = NArrow::ParseSchema(ArrowSchema);
+        UNIT_ASSERT_EQUAL(schema.Fields.size(), 2);
+        UNIT_ASSERT_EQUAL(schema.Fields[0].Name, "id");
+        UNIT_ASSERT_EQUAL(schema.Fields[0].Type, NArrow::EType::Int64);
+        UNIT_ASSERT_EQUAL(schema.Fields[0].ByteWidth, 8);
+        UNIT_ASSERT_EQUAL(schema.Fields[1].Name, "name");
+        UNIT_ASSERT_EQUAL(schema.Fields[1].Type, NArrow::EType::Utf8);
+        UNIT_ASSERT(schema.Fields[1].Nullable);
+    }
+
+    Y_UNIT_TEST(RecordBatch) {
+        TResultSet rs(Ydb::ResultSet(), std::string(ArrowSchema), std::vector<std::string>{ArrowBatch});
+        TArrowResultSetParser parser(rs);
+        UNIT_ASSERT_EQUAL(parser.BatchesCount(), 1);
+        UNIT_ASSERT_EQUAL(parser.ColumnIndex("name"), 1);
+        UNIT_ASSERT_EQUAL(parser.ColumnIndex("otherName"), -1);
+
+        UNIT_ASSERT(parser.TryNextBatch());
+        const auto& batch = parser.GetBatch();
+        UNIT_ASSERT_EQUAL(batch.RowsCount(), 3);
+        UNIT_ASSERT_EQUAL(batch.ColumnsCount(), 2);
+
+        const auto& id = batch.GetColumn(0);
+        UNIT_ASSERT_EQUAL(id.NullCount(), 0);
+        UNIT_ASSERT_EQUAL(id.GetValue<int64_t>(0), 1);
+        UNIT_ASSERT_EQUAL(id.GetValue<int64_t>(1), -2);
+        UNIT_ASSERT_EQUAL(id.GetValue<int64_t>(2), 3);
+        UNIT_ASSERT_EXCEPTION_CONTAINS(id.GetValue<int32_t>(0), TContractViolation, "Column id has value width 8, but 4 is requested");
+
+        const auto& name = batch.GetColumn(1);
+        UNIT_ASSERT_EQUAL(name.NullCount(), 1);
+        UNIT_ASSERT_EQUAL(name.GetString(0), "a");
+        UNIT_ASSERT(name.IsNull(1));
+        UNIT_ASSERT_EQUAL(name.GetString(2), "ccc");
+
+        UNIT_ASSERT(!parser.TryNextBatch());
+    }
+
+    Y_UNIT_TEST(CorruptedBatch) {
+        TResultSet rs(Ydb::ResultSet(), std::string(ArrowSchema), std::vector<std::string>{ArrowBatch.substr(0, 64)});
+        TArrowResultSetParser parser(rs);
+        UNIT_ASSERT_EXCEPTION_CONTAINS(parser.TryNextBatch(), TContractViolation, "Corrupted message");
+    }
+
+    Y_UNIT_TEST(RowOutOfBounds) {
+        const auto schema = NArrow::ParseSchema(ArrowSchema);
+        NArrow::TRecordBatchView batch(schema, ArrowBatch);
+
+        UNIT_ASSERT_EXCEPTION_CONTAINS(batch.GetColumn(0).GetValue<int64_t>(3), TContractViolation, "Row index out of bounds: 3");
+        UNIT_ASSERT_EXCEPTION_CONTAINS(batch.GetColumn(1).GetString(3), TContractViolation, "Row index out of bounds: 3");
+        UNIT_ASSERT_EXCEPTION_CONTAINS(batch.GetColumn(1).IsNull(100), TContractViolation, "Row index out of bounds: 100");
+
+        const auto nestedSchema = NArrow::ParseSchema(NestedSchema);
+        NArrow::TRecordBatchView nested(nestedSchema, NestedBatch);
+        UNIT_ASSERT_EXCEPTION_CONTAINS(nested.GetColumn(0).GetBool(4), TContractViolation, "Row index out of bounds: 4");
+    }
+
+    Y_UNIT_TEST(NestedColumns) {
+        auto schema = NArrow::ParseSchema(NestedSchema);
+        UNIT_ASSERT_VALUES_EQUAL(schema.Fields.size(), 3);
+        UNIT_ASSERT_EQUAL(schema.Fields[0].Type, NArrow::EType::Bool);
+        UNIT_ASSERT_EQUAL(schema.Fields[1].Type, NArrow::EType::List);
+        UNIT_ASSERT_VALUES_EQUAL(schema.Fields[1].Children.size(), 1);
+        UNIT_ASSERT_EQUAL(schema.Fields[1].Children[0].Type, NArrow::EType::Int32);
+        UNIT_ASSERT_EQUAL(schema.Fields[2].Type, NArrow::EType::Struct);
+        UNIT_ASSERT_VALUES_EQUAL(schema.Fields[2].Children.size(), 2);
+        UNIT_ASSERT_EQUAL(schema.Fields[2].Children[1].Type, NArrow::EType::Utf8);
+
+        CheckNestedBatch(NestedBatch);
+    }
+
+    Y_UNIT_TEST(Lz4FrameBody) {
+        CheckNestedBatch(NestedBatchLz4);
+    }
+
+    Y_UNIT_TEST(ZstdBody) {
+        CheckNestedBatch(NestedBatchZstd);
+    }
+
+    Y_UNIT_TEST(OversizedUncompressedLength) {
+        const auto schema = NArrow::ParseSchema(NestedSchema);
+        for (const auto& batch : {NestedBatchLz4, NestedBatchZstd}) {
+            // Beyond any limit
+            UNIT_ASSERT_EXCEPTION_CONTAINS(NArrow::TRecordBatchView(schema, WithUncompressedLength(batch, 1ll << 40)),
+                TContractViolation, "is too large");
+            // Beyond the ratio any codec can reach for a few compressed bytes
+            UNIT_ASSERT_EXCEPTION_CONTAINS(NArrow::TRecordBatchView(schema, WithUncompressedLength(batch, 64ll << 20)),
+                TContractViolation, "is too large");
+            // Within the limits, but not what the buffer decompresses to
+            UNIT_ASSERT_EXCEPTION_CONTAINS(NArrow::TRecordBatchView(schema, WithUncompressedLength(batch, 2)),
+                TContractViolation, "Failed to decompress");
+        }
+    }
+
+    Y_UNIT_TEST(DeeplyNestedSchema) {
+        auto schema = NArrow::ParseSchema(MakeNestedListSchema(63));
+        const NArrow::TField* field = &schema.Fields.at(0);
+        for (size_t i = 0; i < 63; ++i) {
+            UNIT_ASSERT_EQUAL(field->Type, NArrow::EType::List);
+            field = &field->Children.at(0);
+        }
+        UNIT_ASSERT_EQUAL(field->Type, NArrow::EType::Null);
+
+        UNIT_ASSERT_EXCEPTION_CONTAINS(NArrow::ParseSchema(MakeNestedListSchema(64)), TContractViolation, "nested deeper than 64 levels");
+        UNIT_ASSERT_EXCEPTION_CONTAINS(NArrow::ParseSchema(MakeNestedListSchema(100000)), TContractViolation, "nested deeper than 64 levels");
+    }
+}
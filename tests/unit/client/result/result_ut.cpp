@@ -1,4 +1,7 @@
+#include <ydb-cpp-sdk/client/proto/accessor.h>
+#include <ydb-cpp-sdk/client/result/arrow.h>
 #include <ydb-cpp-sdk/client/result/result.h>
+#include <ydb-cpp-sdk/client/result/typed_row.h>
 #include <ydb-cpp-sdk/client/types/exceptions/exceptions.h>
 #include <ydb-cpp-sdk/type_switcher.h>
 
@@ -11,6 +14,24 @@
 
 using namespace NYdb;
 
+namespace {
+    struct TTestRow {
+        uint64_t Id = 0;
+        std::string Name;
+        std::optional<double> Score;
+        TInstant Day;
+    };
+}
+
+template <>
+struct NYdb::TRowTraits<TTestRow> {
+    static constexpr auto Members = std::make_tuple(
+        NYdb::RowMember("id", &TTestRow::Id),
+        NYdb::RowMember<NYdb::EPrimitiveType::Utf8>("name", &TTestRow::Name),
+        NYdb::RowMember("score", &TTestRow::Score),
+        NYdb::RowMember<NYdb::EPrimitiveType::Date>("day", &TTestRow::Day));
+};
+
 Y_UNIT_TEST_SUITE(CppGrpcClientResultSetTest) {
     Y_UNIT_TEST(ListResultSet) {
         const std::string resultSetString =
@@ -234,4 +255,226 @@ Y_UNIT_TEST_SUITE(CppGrpcClientResultSetTest) {
         
         UNIT_ASSERT_EXCEPTION_CONTAINS(rsParser.TryNextRow(), TContractViolation, "Corrupted data: row 0 contains 1 column(s), but metadata contains 2 column(s)");
     }
+
+    Y_UNIT_TEST(SharedProtoResultSet) {
+        const std::string resultSetString =
+            "columns {\n"
+            "  name: \"colName\"\n"
+            "  type {\n"
+            "    type_id: UINT64\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    uint64_value: 7\n"
+            "  }\n"
+            "}\n";
+        auto rsProto = std::make_shared<Ydb::ResultSet>();
+        google::protobuf::TextFormat::ParseFromString(TStringType{resultSetString}, rsProto.get());
+        const Ydb::ResultSet* rawProto = rsProto.get();
+
+        NYdb::TResultSet rs(std::move(rsProto));
+        UNIT_ASSERT_EQUAL(rs.RowsCount(), 1);
+
+        NYdb::TResultSetParser rsParser(rs);
+        UNIT_ASSERT(rsParser.TryNextRow());
+        UNIT_ASSERT_EQUAL(rsParser.ColumnParser(0).GetUint64(), 7);
+        UNIT_ASSERT(!rsParser.TryNextRow());
+
+        // The payload is referenced, not copied
+        NYdb::TResultSet copy = rs;
+        UNIT_ASSERT_EQUAL(&NYdb::TProtoAccessor::GetProto(copy), rawProto);
+    }
+
+    Y_UNIT_TEST(SharedArrowProtoIsNotModified) {
+        auto rsProto = std::make_shared<Ydb::ResultSet>();
+        rsProto->set_format(Ydb::ResultSet::FORMAT_ARROW);
+        rsProto->mutable_arrow_format_meta()->set_schema("schema");
+        rsProto->set_data("batch");
+
+        // Both result sets alias the same message, neither of them may steal the payload from the other
+        NYdb::TResultSet first(rsProto);
+        NYdb::TResultSet second(rsProto);
+
+        for (const auto* rs : {&first, &second}) {
+            UNIT_ASSERT_VALUES_EQUAL(NYdb::TArrowAccessor::GetSchema(*rs), "schema");
+            UNIT_ASSERT_VALUES_EQUAL(NYdb::TArrowAccessor::GetBatches(*rs).size(), 1);
+            UNIT_ASSERT_VALUES_EQUAL(NYdb::TArrowAccessor::GetBatches(*rs)[0], "batch");
+        }
+        UNIT_ASSERT_VALUES_EQUAL(rsProto->arrow_format_meta().schema(), "schema");
+        UNIT_ASSERT_VALUES_EQUAL(rsProto->data(), "batch");
+    }
+
+    Y_UNIT_TEST(ColumnarResultSet) {
+        const std::string resultSetString =
+            "columns {\n"
+            "  name: \"id\"\n"
+            "  type {\n"
+            "    type_id: INT64\n"
+            "  }\n"
+            "}\n"
+            "columns {\n"
+            "  name: \"name\"\n"
+            "  type {\n"
+            "    optional_type {\n"
+            "      item {\n"
+            "        type_id: UTF8\n"
+            "      }\n"
+            "    }\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    int64_value: -1\n"
+            "  }\n"
+            "  items {\n"
+            "    text_value: \"abc\"\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    int64_value: 2\n"
+            "  }\n"
+            "  items {\n"
+            "    null_flag_value: NULL_VALUE\n"
+            "  }\n"
+            "}\n";
+        Ydb::ResultSet rsProto;
+        google::protobuf::TextFormat::ParseFromString(TStringType{resultSetString}, &rsProto);
+
+        NYdb::TResultSet rs(std::move(rsProto));
+        NYdb::TResultSetParser rsParser(rs);
+
+        auto ids = rsParser.GetInt64Column(0);
+        UNIT_ASSERT_EQUAL(ids.Values, std::vector<int64_t>({-1, 2}));
+        UNIT_ASSERT_EQUAL(ids.Nulls, std::vector<bool>({false, false}));
+
+        auto names = rsParser.GetUtf8Column(1);
+        UNIT_ASSERT_EQUAL(names.Values[0], "abc");
+        UNIT_ASSERT_EQUAL(names.Nulls, std::vector<bool>({false, true}));
+
+        UNIT_ASSERT_EXCEPTION_CONTAINS(rsParser.GetUint64Column(0), TContractViolation, "Column id has unexpected type");
+        UNIT_ASSERT_EXCEPTION_CONTAINS(rsParser.GetInt64Column(2), TContractViolation, "Column index out of bounds: 2");
+    }
+
+    Y_UNIT_TEST(ColumnarNestedOptionalResultSet) {
+        const std::string resultSetString =
+            "columns {\n"
+            "  name: \"value\"\n"
+            "  type {\n"
+            "    optional_type {\n"
+            "      item {\n"
+            "        type_id: UINT64\n"
+            "      }\n"
+            "    }\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    nested_value {\n"
+            "      uint64_value: 7\n"
+            "    }\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    uint64_value: 8\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    null_flag_value: NULL_VALUE\n"
+            "  }\n"
+            "}\n";
+        Ydb::ResultSet rsProto;
+        google::protobuf::TextFormat::ParseFromString(TStringType{resultSetString}, &rsProto);
+
+        NYdb::TResultSet rs(std::move(rsProto));
+        NYdb::TResultSetParser rsParser(rs);
+
+        auto values = rsParser.GetUint64Column(0);
+        UNIT_ASSERT_EQUAL(values.Values[0], 7);
+        UNIT_ASSERT_EQUAL(values.Values[1], 8);
+        UNIT_ASSERT_EQUAL(values.Nulls, std::vector<bool>({false, false, true}));
+
+        // Same values as the row parser gives
+        UNIT_ASSERT(rsParser.TryNextRow());
+        UNIT_ASSERT_EQUAL(rsParser.ColumnParser(0).GetOptionalUint64(), 7);
+    }
+
+    Y_UNIT_TEST(TypedRowsResultSet) {
+        const std::vector<TTestRow> rows = {
+            {1, "first", 0.5, TInstant::Days(100)},
+            {2, "second", std::nullopt, TInstant::Days(200)},
+        };
+
+        TTypedRowsBuilder<TTestRow> builder;
+        for (const auto& row : rows) {
+            builder.AddRow(row);
+        }
+        TValue typedValue = builder.Build();
+        UNIT_ASSERT_VALUES_EQUAL(builder.RowsCount(), 0);
+
+        // Same value as the dynamic builder makes
+        TValueBuilder valueBuilder;
+        valueBuilder.BeginList();
+        for (const auto& row : rows) {
+            valueBuilder.AddListItem()
+                .BeginStruct()
+                .AddMember("id").Uint64(row.Id)
+                .AddMember("name").Utf8(row.Name)
+                .AddMember("score").OptionalDouble(row.Score)
+                .AddMember("day").Date(row.Day)
+                .EndStruct();
+        }
+        valueBuilder.EndList();
+        TValue value = valueBuilder.Build();
+        UNIT_ASSERT_VALUES_EQUAL(FormatType(typedValue.GetType()), FormatType(value.GetType()));
+        UNIT_ASSERT_VALUES_EQUAL(typedValue.GetProto().SerializeAsString(), value.GetProto().SerializeAsString());
+
+        // Columns go in another order than the members
+        Ydb::ResultSet rsProto;
+        const auto& members = GetRowType<TTestRow>().GetProto().struct_type().members();
+        for (int i = members.size() - 1; i >= 0; --i) {
+            auto* column = rsProto.add_columns();
+            column->set_name(members[i].name());
+            *column->mutable_type() = members[i].type();
+        }
+        for (const auto& item : typedValue.GetProto().items()) {
+            auto* row = rsProto.add_rows();
+            for (int i = item.items_size() - 1; i >= 0; --i) {
+                *row->add_items() = item.items(i);
+            }
+        }
+
+        NYdb::TResultSet rs(std::move(rsProto));
+        TTypedResultSetParser<TTestRow> parser(rs);
+        UNIT_ASSERT_VALUES_EQUAL(parser.RowsCount(), 2);
+
+        TTestRow row;
+        for (const auto& expected : rows) {
+            UNIT_ASSERT(parser.TryNextRow(row));
+            UNIT_ASSERT_VALUES_EQUAL(row.Id, expected.Id);
+            UNIT_ASSERT_VALUES_EQUAL(row.Name, expected.Name);
+            UNIT_ASSERT_EQUAL(row.Score, expected.Score);
+            UNIT_ASSERT_EQUAL(row.Day, expected.Day);
+        }
+        UNIT_ASSERT(!parser.TryNextRow(row));
+    }
+
+    Y_UNIT_TEST(TypedRowsWrongColumns) {
+        const std::string resultSetString =
+            "columns {\n"
+            "  name: \"id\"\n"
+            "  type {\n"
+            "    type_id: INT64\n"
+            "  }\n"
+            "}\n";
+        Ydb::ResultSet rsProto;
+        google::protobuf::TextFormat::ParseFromString(TStringType{resultSetString}, &rsProto);
+        NYdb::TResultSet rs(std::move(rsProto));
+
+        UNIT_ASSERT_EXCEPTION_CONTAINS(TTypedResultSetParser<TTestRow>{rs}, TContractViolation,
+            "column id has type Int64, but the row member has type Uint64");
+    }
 }
@@ -0,0 +1,260 @@
+#include <src/client/impl/session/session_pool.h>
+
+#include <library/cpp/testing/gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace NYdb;
+using namespace NYdb::NSessionPool;
+
+namespace {
+    struct TReply {
+        enum EKind {
+            Session,
+            NewSession,
+            Error
+        };
+
+        EKind Kind;
+        TKqpSessionCommon* SessionImpl = nullptr;
+        EStatus Status = EStatus::SUCCESS;
+    };
+
+    class TGetSessionCtx : public IGetSessionCtx {
+    public:
+        std::future<TReply> GetFuture() {
+            return Promise_.get_future();
+        }
+
+        void ReplySessionToUser(TKqpSessionCommon* session) override {
+            Promise_.set_value(TReply{TReply::Session, session});
+        }
+
+        void ReplyError(TStatus status) override {
+            Promise_.set_value(TReply{TReply::Error, nullptr, status.GetStatus()});
+        }
+
+        void ReplyNewSession() override {
+            Promise_.set_value(TReply{TReply::NewSession});
+        }
+
+        void ScheduleOnDeadlineWaiterCleanup() override {
+        }
+
+        TDeadline GetDeadline() const override {
+            return TDeadline::AfterDuration(std::chrono::minutes(1));
+        }
+
+    private:
+        std::promise<TReply> Promise_;
+    };
+
+    bool IsReady(const std::future<TReply>& reply) {
+        return reply.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    /**
+     * Drives the pool the way the table and query clients do,
+     * the parameter is the number of shards of the pool.
+     */
+    class TSessionPoolTest : public testing::TestWithParam<std::uint32_t> {
+    protected:
+        void MakePool(std::uint32_t maxActiveSessions) {
+            Pool = std::make_unique<TSessionPool>(maxActiveSessions, 0, GetParam());
+        }
+
+        std::future<TReply> RequestSession() {
+            auto ctx = std::make_unique<TGetSessionCtx>();
+            auto reply = ctx->GetFuture();
+            Pool->GetSession(std::move(ctx));
+            return reply;
+        }
+
+        // Waits for the reply and creates a session if the pool asks for it
+        TKqpSessionCommon* AcquireSession(std::future<TReply> reply) {
+            auto value = reply.get();
+            switch (value.Kind) {
+            case TReply::Session:
+                return value.SessionImpl;
+            case TReply::NewSession: {
+                auto* sessionImpl = new TKqpSessionCommon("session-" + std::to_string(CreatedSessions++), "localhost:2135", true);
+                sessionImpl->MarkActive();
+                sessionImpl->SetNeedUpdateActiveCounter(true);
+                return sessionImpl;
+            }
+            case TReply::Error:
+                ADD_FAILURE() << "Unexpected error " << static_cast<int>(value.Status);
+                return nullptr;
+            }
+            return nullptr;
+        }
+
+        // Deletes the session if the pool doesn't take it back
+        void ReleaseSession(TKqpSessionCommon* sessionImpl) {
+            const bool needUpdateCounter = sessionImpl->NeedUpdateActiveCounter();
+            sessionImpl->MarkIdle();
+            if (!Pool->ReturnSession(sessionImpl, needUpdateCounter)) {
+                sessionImpl->SetNeedUpdateActiveCounter(needUpdateCounter);
+                DeleteSession(sessionImpl);
+            }
+        }
+
+        void DeleteSession(TKqpSessionCommon* sessionImpl) {
+            if (Pool->CheckAndFeedWaiterNewSession(sessionImpl->NeedUpdateActiveCounter())) {
+                sessionImpl->SetNeedUpdateActiveCounter(false);
+            }
+            if (sessionImpl->NeedUpdateActiveCounter()) {
+                Pool->DecrementActiveCounter();
+            }
+            delete sessionImpl;
+        }
+
+        std::unique_ptr<TSessionPool> Pool;
+        std::atomic<std::int64_t> CreatedSessions = 0;
+    };
+} // namespace <anonymous>
+
+TEST_P(TSessionPoolTest, WaiterGetsReturnedSession) {
+    MakePool(1);
+    auto* sessionImpl = AcquireSession(RequestSession());
+    ASSERT_NE(sessionImpl, nullptr);
+
+    auto waiter = RequestSession();
+    EXPECT_FALSE(IsReady(waiter));
+
+    ReleaseSession(sessionImpl);
+    ASSERT_TRUE(IsReady(waiter));
+    EXPECT_EQ(AcquireSession(std::move(waiter)), sessionImpl);
+    EXPECT_EQ(Pool->GetActiveSessions(), 1);
+    EXPECT_EQ(Pool->GetCurrentPoolSize(), 0);
+
+    ReleaseSession(sessionImpl);
+    EXPECT_EQ(Pool->GetActiveSessions(), 0);
+    EXPECT_EQ(Pool->GetCurrentPoolSize(), 1);
+    EXPECT_EQ(CreatedSessions.load(), 1);
+}
+
+TEST_P(TSessionPoolTest, WaiterGetsSlotOfDeletedSession) {
+    MakePool(1);
+    auto* sessionImpl = AcquireSession(RequestSession());
+    ASSERT_NE(sessionImpl, nullptr);
+
+    auto waiter = RequestSession();
+    EXPECT_FALSE(IsReady(waiter));
+
+    sessionImpl->MarkBroken();
+    DeleteSession(sessionImpl);
+    ASSERT_TRUE(IsReady(waiter));
+    EXPECT_EQ(waiter.get().Kind, TReply::NewSession);
+    EXPECT_EQ(Pool->GetActiveSessions(), 1);
+}
+
+TEST_P(TSessionPoolTest, TakesSessionsReturnedByAnotherThread) {
+    // All sessions are returned to the home shard of this thread,
+    // threads with another home shard have to steal them
+    const std::int64_t sessionsCount = 4;
+    MakePool(sessionsCount);
+
+    std::vector<TKqpSessionCommon*> sessions;
+    for (std::int64_t i = 0; i < sessionsCount; ++i) {
+        sessions.push_back(AcquireSession(RequestSession()));
+        ASSERT_NE(sessions.back(), nullptr);
+    }
+    for (auto* sessionImpl : sessions) {
+        ReleaseSession(sessionImpl);
+    }
+    ASSERT_EQ(Pool->GetCurrentPoolSize(), sessionsCount);
+
+    std::vector<TReply::EKind> replies;
+    for (std::int64_t i = 0; i < sessionsCount; ++i) {
+        std::thread([&] {
+            auto reply = RequestSession();
+            replies.push_back(reply.get().Kind);
+        }).join();
+    }
+
+    EXPECT_EQ(replies, std::vector<TReply::EKind>(sessionsCount, TReply::Session));
+    EXPECT_EQ(Pool->GetCurrentPoolSize(), 0);
+    EXPECT_EQ(Pool->GetActiveSessions(), sessionsCount);
+    EXPECT_EQ(CreatedSessions.load(), sessionsCount);
+}
+
+TEST_P(TSessionPoolTest, ActiveSessionsLimitUnderConcurrency) {
+    const std::int64_t maxActiveSessions = 3;
+    const std::uint32_t threadsCount = 8;
+    const std::uint32_t iterations = 2000;
+    MakePool(maxActiveSessions);
+
+    std::atomic<std::int64_t> inUse = 0;
+    std::atomic<std::int64_t> maxInUse = 0;
+    std::vector<std::thread> threads;
+    for (std::uint32_t i = 0; i < threadsCount; ++i) {
+        threads.emplace_back([&] {
+            for (std::uint32_t j = 0; j < iterations; ++j) {
+                auto* sessionImpl = AcquireSession(RequestSession());
+                if (!sessionImpl) {
+                    return;
+                }
+
+                const auto current = ++inUse;
+                auto prev = maxInUse.load();
+                while (prev < current && !maxInUse.compare_exchange_weak(prev, current)) {
+                }
+                EXPECT_LE(Pool->GetActiveSessions(), maxActiveSessions);
+                --inUse;
+
+                ReleaseSession(sessionImpl);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_LE(maxInUse.load(), maxActiveSessions);
+    EXPECT_EQ(Pool->GetActiveSessions(), 0);
+    EXPECT_EQ(Pool->GetCurrentPoolSize(), CreatedSessions.load());
+}
+
+TEST_P(TSessionPoolTest, CloseRejectsWaiters) {
+    MakePool(1);
+    auto* activeSession = AcquireSession(RequestSession());
+    ASSERT_NE(activeSession, nullptr);
+
+    // A session which is not counted as active, it stays in the pool
+    auto* idleSession = new TKqpSessionCommon("idle", "localhost:2135", true);
+    idleSession->MarkIdle();
+    ASSERT_TRUE(Pool->ReturnSession(idleSession, false));
+    ASSERT_EQ(Pool->GetCurrentPoolSize(), 1);
+
+    auto waiter = RequestSession();
+    EXPECT_FALSE(IsReady(waiter));
+
+    std::vector<std::unique_ptr<TKqpSessionCommon>> drained;
+    Pool->Drain([&](std::unique_ptr<TKqpSessionCommon>&& sessionImpl) {
+        drained.push_back(std::move(sessionImpl));
+        return true;
+    }, true);
+
+    ASSERT_EQ(drained.size(), 1u);
+    EXPECT_EQ(drained[0].get(), idleSession);
+    EXPECT_EQ(Pool->GetCurrentPoolSize(), 0);
+
+    ASSERT_TRUE(IsReady(waiter));
+    auto reply = waiter.get();
+    EXPECT_EQ(reply.Kind, TReply::Error);
+    EXPECT_EQ(reply.Status, EStatus::CLIENT_RESOURCE_EXHAUSTED);
+
+    // The closed pool doesn't take sessions back
+    ReleaseSession(activeSession);
+    EXPECT_EQ(Pool->GetCurrentPoolSize(), 0);
+    EXPECT_EQ(Pool->GetActiveSessions(), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Shards,
+    TSessionPoolTest,
+    ::testing::Values(1, 4)
+);
@@ -0,0 +1,209 @@
+#include <ydb-cpp-sdk/client/driver/driver.h>
+#include <ydb-cpp-sdk/client/proto/accessor.h>
+#include <ydb-cpp-sdk/client/table/table.h>
+#include <ydb-cpp-sdk/client/types/exceptions/exceptions.h>
+
+#include <library/cpp/testing/common/network.h>
+
+#include <util/string/builder.h>
+
+#include <src/api/grpc/ydb_table_v1.grpc.pb.h>
+
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace NYdb;
+using namespace NYdb::NTable;
+
+namespace {
+    /**
+     * The mock for BulkUpsert of the table service, it records the keys of every request
+     * and answers with the queued statuses first, successfully after them.
+     */
+    class TMockBulkUpsertService : public Ydb::Table::V1::TableService::Service {
+    public:
+        grpc::Status BulkUpsert(
+            grpc::ServerContext* /* context */,
+            const Ydb::Table::BulkUpsertRequest* request,
+            Ydb::Table::BulkUpsertResponse* response
+        ) override {
+            std::vector<std::uint64_t> keys;
+            for (const auto& row : request->rows().value().items()) {
+                keys.push_back(row.items(0).uint64_value());
+            }
+
+            auto status = Ydb::StatusIds::SUCCESS;
+            {
+                std::lock_guard lock(Lock);
+                Requests.push_back(std::move(keys));
+                if (!Statuses.empty()) {
+                    status = Statuses.front();
+                    Statuses.pop_front();
+                }
+            }
+
+            auto op = response->mutable_operation();
+            op->set_ready(true);
+            op->set_status(status);
+            return grpc::Status::OK;
+        }
+
+        std::vector<std::vector<std::uint64_t>> GetRequests() {
+            std::lock_guard lock(Lock);
+            return Requests;
+        }
+
+        void QueueStatus(Ydb::StatusIds::StatusCode status) {
+            std::lock_guard lock(Lock);
+            Statuses.push_back(status);
+        }
+
+    private:
+        std::mutex Lock;
+        std::vector<std::vector<std::uint64_t>> Requests;
+        std::deque<Ydb::StatusIds::StatusCode> Statuses;
+    };
+
+    class TBulkUpsertWriterTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            NTesting::InitPortManagerFromEnv();
+            const auto portHolder = NTesting::GetFreePort();
+            const ui16 port = static_cast<ui16>(portHolder);
+
+            Server = grpc::ServerBuilder()
+                .AddListeningPort(TStringBuilder() << "127.0.0.1:" << port, grpc::InsecureServerCredentials())
+                .RegisterService(&Service)
+                .BuildAndStart();
+
+            Driver = std::make_unique<TDriver>(
+                TDriverConfig()
+                    .SetEndpoint(TStringBuilder() << "localhost:" << port)
+                    .SetDiscoveryMode(EDiscoveryMode::Off)
+                    .SetDatabase("/Root/My/DB")
+            );
+            Client = std::make_unique<TTableClient>(*Driver);
+        }
+
+        void TearDown() override {
+            Client.reset();
+            Driver->Stop(true);
+            Server->Shutdown();
+        }
+
+        TBulkUpsertWriterSettings MakeSettings() {
+            // One request at a time keeps the order of the requests, retries don't wait for long
+            TBulkUpsertWriterSettings settings;
+            settings.MaxInFlight(1);
+            settings.RetrySettings_
+                .FastBackoffSettings(TBackoffSettings().SlotDuration(TDuration::MilliSeconds(1)))
+                .SlowBackoffSettings(TBackoffSettings().SlotDuration(TDuration::MilliSeconds(1)));
+            return settings;
+        }
+
+        static TValue MakeRow(std::uint64_t key) {
+            return TValueBuilder()
+                .BeginStruct()
+                    .AddMember("key").Uint64(key)
+                    .AddMember("value").String(std::string(100, 'x'))
+                .EndStruct()
+                .Build();
+        }
+
+        static void AddRows(TBulkUpsertWriter& writer, std::uint64_t from, std::uint64_t to) {
+            for (std::uint64_t key = from; key < to; ++key) {
+                ASSERT_TRUE(writer.AddRow(MakeRow(key)).Wait(TDuration::Seconds(10)));
+            }
+        }
+
+        static TStatus Wait(TAsyncStatus future) {
+            EXPECT_TRUE(future.Wait(TDuration::Seconds(10)));
+            return future.ExtractValueSync();
+        }
+
+        TMockBulkUpsertService Service;
+        std::unique_ptr<grpc::Server> Server;
+        std::unique_ptr<TDriver> Driver;
+        std::unique_ptr<TTableClient> Client;
+    };
+
+    using TKeys = std::vector<std::vector<std::uint64_t>>;
+} // namespace <anonymous>
+
+TEST_F(TBulkUpsertWriterTest, SendsBatchesByRows) {
+    TBulkUpsertWriter writer(*Client, "/Root/My/DB/table", MakeSettings().MaxBatchRows(4));
+    AddRows(writer, 0, 10);
+    ASSERT_TRUE(Wait(writer.Flush()).IsSuccess());
+
+    EXPECT_EQ(Service.GetRequests(), (TKeys{{0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9}}));
+}
+
+TEST_F(TBulkUpsertWriterTest, SendsBatchesByBytes) {
+    // Every batch reaches the limit with its third row
+    const auto rowBytes = TProtoAccessor::GetProto(MakeRow(0)).ByteSizeLong();
+    TBulkUpsertWriter writer(*Client, "/Root/My/DB/table", MakeSettings().MaxBatchBytes(rowBytes * 3));
+    AddRows(writer, 0, 7);
+
+    // Full batches are sent without a flush
+    ASSERT_TRUE(Wait(writer.Flush()).IsSuccess());
+    EXPECT_EQ(Service.GetRequests(), (TKeys{{0, 1, 2}, {3, 4, 5}, {6}}));
+}
+
+TEST_F(TBulkUpsertWriterTest, RetriesRetryableStatus) {
+    Service.QueueStatus(Ydb::StatusIds::UNAVAILABLE);
+    Service.QueueStatus(Ydb::StatusIds::OVERLOADED);
+
+    TBulkUpsertWriter writer(*Client, "/Root/My/DB/table", MakeSettings().MaxBatchRows(2));
+    AddRows(writer, 0, 4);
+    ASSERT_TRUE(Wait(writer.Flush()).IsSuccess());
+
+    // The same rows are sent by every attempt
+    EXPECT_EQ(Service.GetRequests(), (TKeys{{0, 1}, {0, 1}, {0, 1}, {2, 3}}));
+}
+
+TEST_F(TBulkUpsertWriterTest, ReturnsNonRetryableStatus) {
+    Service.QueueStatus(Ydb::StatusIds::SCHEME_ERROR);
+
+    TBulkUpsertWriter writer(*Client, "/Root/My/DB/table", MakeSettings().MaxBatchRows(2));
+    AddRows(writer, 0, 2);
+    EXPECT_EQ(Wait(writer.Flush()).GetStatus(), EStatus::SCHEME_ERROR);
+
+    // Rows are dropped after the failure, every flush returns it
+    AddRows(writer, 2, 4);
+    EXPECT_EQ(Wait(writer.Flush()).GetStatus(), EStatus::SCHEME_ERROR);
+    EXPECT_EQ(Service.GetRequests(), (TKeys{{0, 1}}));
+}
+
+TEST_F(TBulkUpsertWriterTest, CloseSendsLastBatch) {
+    TBulkUpsertWriter writer(*Client, "/Root/My/DB/table", MakeSettings().MaxBatchRows(100));
+    AddRows(writer, 0, 3);
+    EXPECT_TRUE(Service.GetRequests().empty());
+
+    ASSERT_TRUE(Wait(writer.Close()).IsSuccess());
+    EXPECT_EQ(Service.GetRequests(), (TKeys{{0, 1, 2}}));
+
+    EXPECT_THROW(writer.AddRow(MakeRow(3)), TContractViolation);
+    ASSERT_TRUE(Wait(writer.Close()).IsSuccess());
+    EXPECT_EQ(Service.GetRequests().size(), 1u);
+}
+
+TEST_F(TBulkUpsertWriterTest, DestructorSendsLastBatch) {
+    {
+        TBulkUpsertWriter writer(*Client, "/Root/My/DB/table", MakeSettings().MaxBatchRows(100));
+        AddRows(writer, 0, 3);
+    }
+
+    // The destructor doesn't wait for the request
+    for (int i = 0; i < 1000 && Service.GetRequests().empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(Service.GetRequests(), (TKeys{{0, 1, 2}}));
+}
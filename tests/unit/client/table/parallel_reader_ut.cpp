@@ -0,0 +1,396 @@
+#include <src/client/table/impl/parallel_reader.h>
+
+#include <ydb-cpp-sdk/client/proto/accessor.h>
+
+#include <src/api/protos/ydb_value.pb.h>
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace NYdb;
+using namespace NYdb::NTable;
+
+namespace {
+    using TPart = TSimpleStreamPart<TResultSet>;
+
+    TResultSet MakeResultSet(const std::vector<std::uint64_t>& keys) {
+        Ydb::ResultSet resultSet;
+        auto* column = resultSet.add_columns();
+        column->set_name("key");
+        column->mutable_type()->set_type_id(Ydb::Type::UINT64);
+        for (auto key : keys) {
+            resultSet.add_rows()->add_items()->set_uint64_value(key);
+        }
+        return TResultSet(std::move(resultSet));
+    }
+
+    std::vector<std::uint64_t> GetKeys(const TResultSet& resultSet) {
+        std::vector<std::uint64_t> keys;
+        for (const auto& row : TProtoAccessor::GetProto(resultSet).rows()) {
+            keys.push_back(row.items(0).uint64_value());
+        }
+        return keys;
+    }
+
+    TPart MakePart(const std::vector<std::uint64_t>& keys) {
+        return TPart(MakeResultSet(keys), TStatus(EStatus::SUCCESS, {}));
+    }
+
+    TPart MakeEosPart() {
+        return TPart(MakeResultSet({}), TStatus(EStatus::CLIENT_OUT_OF_RANGE, {}));
+    }
+
+    TPart MakeErrorPart(EStatus status) {
+        return TPart(MakeResultSet({}), TStatus(status, {}));
+    }
+
+    TValue MakeKey(std::uint64_t key) {
+        return TValueBuilder().Uint64(key).Build();
+    }
+
+    // Reads of a stream are answered by the test, the state outlives the stream released by the reader
+    struct TStreamState {
+        TKeyRange Range;
+        std::deque<NThreading::TPromise<TPart>> Reads;
+
+        void Reply(TPart&& part) {
+            ASSERT_FALSE(Reads.empty());
+            auto promise = std::move(Reads.front());
+            Reads.pop_front();
+            promise.SetValue(std::move(part));
+        }
+    };
+
+    class TFakeStream : public IKeyRangeStream {
+    public:
+        explicit TFakeStream(std::shared_ptr<TStreamState> state)
+            : State(std::move(state))
+        {}
+
+        TAsyncSimpleStreamPart<TResultSet> ReadNext() override {
+            EXPECT_TRUE(State->Reads.empty()) << "read of a stream with a read in flight";
+            return State->Reads.emplace_back(NThreading::NewPromise<TPart>()).GetFuture();
+        }
+
+    private:
+        std::shared_ptr<TStreamState> State;
+    };
+
+    class TFakeStreams {
+    public:
+        TKeyRangeStreamFactory GetFactory() {
+            return [this](const TKeyRange& range) {
+                auto state = std::make_shared<TStreamState>(TStreamState{range, {}});
+                auto stream = std::make_shared<TFakeStream>(state);
+                States.push_back(state);
+                Streams.push_back(stream);
+                return stream;
+            };
+        }
+
+        // In order of the opening
+        std::vector<std::shared_ptr<TStreamState>> States;
+        std::vector<std::weak_ptr<IKeyRangeStream>> Streams;
+    };
+
+    std::vector<TKeyRange> MakeRanges(size_t count) {
+        // Partitions split by keys 10, 20, ...
+        std::vector<TKeyRange> ranges;
+        for (size_t i = 0; i < count; ++i) {
+            std::optional<TKeyBound> from;
+            std::optional<TKeyBound> to;
+            if (i > 0) {
+                from = TKeyBound::Inclusive(MakeKey(i * 10));
+            }
+            if (i + 1 < count) {
+                to = TKeyBound::Exclusive(MakeKey((i + 1) * 10));
+            }
+            ranges.emplace_back(from, to);
+        }
+        return ranges;
+    }
+
+    std::shared_ptr<TParallelTablePartIterator::TReaderImpl> StartReader(TFakeStreams& streams,
+        const TReadTableParallelSettings& settings, size_t rangesCount)
+    {
+        auto reader = std::make_shared<TParallelTablePartIterator::TReaderImpl>(streams.GetFactory(), settings, MakeRanges(rangesCount));
+        reader->Start();
+        return reader;
+    }
+
+    std::vector<std::uint64_t> ReadReady(TParallelTablePartIterator::TReaderImpl& reader) {
+        auto future = reader.ReadNext();
+        EXPECT_TRUE(future.HasValue());
+        const auto& part = future.GetValue();
+        EXPECT_TRUE(part.IsSuccess()) << static_cast<int>(part.GetStatus());
+        return GetKeys(part.GetPart());
+    }
+
+    TValue MakeKeysList(std::uint64_t count) {
+        TValueBuilder builder;
+        builder.BeginList();
+        for (std::uint64_t key = 0; key < count; ++key) {
+            builder.AddListItem().BeginStruct().AddMember("key").Uint64(key).EndStruct();
+        }
+        builder.EndList();
+        return builder.Build();
+    }
+}
+
+TEST(ParallelReadTable, OpensRangesWithinConcurrencyLimit) {
+    TFakeStreams streams;
+    auto reader = StartReader(streams, TReadTableParallelSettings().MaxConcurrentReaders(2), 4);
+
+    ASSERT_EQ(streams.States.size(), 2u);
+    EXPECT_FALSE(streams.States[0]->Range.From());
+    EXPECT_EQ(streams.States[0]->Range.To()->GetValue().GetProto().uint64_value(), 10u);
+    EXPECT_FALSE(streams.States[0]->Range.To()->IsInclusive());
+    EXPECT_EQ(streams.States[1]->Range.From()->GetValue().GetProto().uint64_value(), 10u);
+    EXPECT_TRUE(streams.States[1]->Range.From()->IsInclusive());
+
+    // The next range is opened when one of the active ones is finished
+    streams.States[1]->Reply(MakeEosPart());
+    ASSERT_EQ(streams.States.size(), 3u);
+    EXPECT_EQ(streams.States[2]->Range.From()->GetValue().GetProto().uint64_value(), 20u);
+    EXPECT_TRUE(streams.Streams[1].expired());
+
+    streams.States[0]->Reply(MakeEosPart());
+    ASSERT_EQ(streams.States.size(), 4u);
+    EXPECT_FALSE(streams.States[3]->Range.To());
+
+    const auto progress = reader->GetProgress();
+    EXPECT_EQ(progress.PartitionsTotal, 4u);
+    EXPECT_EQ(progress.PartitionsFinished, 2u);
+}
+
+TEST(ParallelReadTable, KeyOrderedMergesPartitions) {
+    TFakeStreams streams;
+    auto reader = StartReader(streams, TReadTableParallelSettings().MaxConcurrentReaders(3).KeyOrdered(true), 3);
+    ASSERT_EQ(streams.States.size(), 3u);
+
+    // Parts arrive from the last partitions first
+    streams.States[2]->Reply(MakePart({20, 21}));
+    streams.States[1]->Reply(MakePart({10}));
+    auto pending = reader->ReadNext();
+    EXPECT_FALSE(pending.HasValue());
+
+    streams.States[0]->Reply(MakePart({0, 1}));
+    ASSERT_TRUE(pending.HasValue());
+    EXPECT_EQ(GetKeys(pending.GetValue().GetPart()), (std::vector<std::uint64_t>{0, 1}));
+
+    streams.States[2]->Reply(MakeEosPart());
+    streams.States[1]->Reply(MakePart({11}));
+    streams.States[1]->Reply(MakeEosPart());
+    streams.States[0]->Reply(MakePart({2}));
+    streams.States[0]->Reply(MakeEosPart());
+
+    EXPECT_EQ(ReadReady(*reader), (std::vector<std::uint64_t>{2}));
+    EXPECT_EQ(ReadReady(*reader), (std::vector<std::uint64_t>{10}));
+    EXPECT_EQ(ReadReady(*reader), (std::vector<std::uint64_t>{11}));
+    EXPECT_EQ(ReadReady(*reader), (std::vector<std::uint64_t>{20, 21}));
+
+    auto eos = reader->ReadNext();
+    ASSERT_TRUE(eos.HasValue());
+    EXPECT_TRUE(eos.GetValue().EOS());
+
+    const auto progress = reader->GetProgress();
+    EXPECT_EQ(progress.RowsRead, 7u);
+    EXPECT_EQ(progress.BufferedBytes, 0u);
+}
+
+TEST(ParallelReadTable, UnorderedReturnsPartsAsTheyArrive) {
+    TFakeStreams streams;
+    auto reader = StartReader(streams, TReadTableParallelSettings().MaxConcurrentReaders(2), 2);
+
+    streams.States[1]->Reply(MakePart({10}));
+    streams.States[0]->Reply(MakePart({0}));
+    streams.States[1]->Reply(MakePart({11}));
+    streams.States[1]->Reply(MakeEosPart());
+    streams.States[0]->Reply(MakeEosPart());
+
+    EXPECT_EQ(ReadReady(*reader), (std::vector<std::uint64_t>{10}));
+    EXPECT_EQ(ReadReady(*reader), (std::vector<std::uint64_t>{0}));
+    EXPECT_EQ(ReadReady(*reader), (std::vector<std::uint64_t>{11}));
+    EXPECT_TRUE(reader->ReadNext().GetValue().EOS());
+}
+
+TEST(ParallelReadTable, EmptyTable) {
+    TFakeStreams streams;
+    auto reader = StartReader(streams, TReadTableParallelSettings(), 1);
+    streams.States[0]->Reply(MakeEosPart());
+    EXPECT_TRUE(reader->ReadNext().GetValue().EOS());
+}
+
+TEST(ParallelReadTable, PausesReadersOverBufferBudget) {
+    TFakeStreams streams;
+    auto reader = StartReader(streams, TReadTableParallelSettings().MaxBufferedBytes(1), 1);
+
+    streams.States[0]->Reply(MakePart({0}));
+    EXPECT_TRUE(streams.States[0]->Reads.empty());
+
+    EXPECT_EQ(ReadReady(*reader), (std::vector<std::uint64_t>{0}));
+    EXPECT_EQ(streams.States[0]->Reads.size(), 1u);
+}
+
+TEST(ParallelReadTable, ErrorOfOnePartitionStopsAll) {
+    TFakeStreams streams;
+    auto reader = StartReader(streams, TReadTableParallelSettings().MaxConcurrentReaders(2).KeyOrdered(true), 4);
+
+    streams.States[0]->Reply(MakePart({0}));
+    streams.States[1]->Reply(MakeErrorPart(EStatus::OVERLOADED));
+
+    // Buffered parts are dropped, every read returns the error
+    for (int i = 0; i < 2; ++i) {
+        auto part = reader->ReadNext();
+        ASSERT_TRUE(part.HasValue());
+        EXPECT_EQ(part.GetValue().GetStatus(), EStatus::OVERLOADED);
+    }
+
+    // Streams are released, the rest of the ranges are never opened
+    EXPECT_TRUE(streams.Streams[0].expired());
+    EXPECT_TRUE(streams.Streams[1].expired());
+    EXPECT_EQ(streams.States.size(), 2u);
+
+    // Late parts are ignored
+    streams.States[0]->Reply(MakeEosPart());
+    EXPECT_EQ(streams.States.size(), 2u);
+    EXPECT_EQ(reader->ReadNext().GetValue().GetStatus(), EStatus::OVERLOADED);
+    EXPECT_EQ(reader->GetProgress().BufferedBytes, 0u);
+}
+
+TEST(ParallelReadTable, DestructionCancelsReads) {
+    TFakeStreams streams;
+    auto reader = StartReader(streams, TReadTableParallelSettings().MaxConcurrentReaders(2), 3);
+    auto pending = reader->ReadNext();
+    reader.reset();
+
+    EXPECT_TRUE(streams.Streams[0].expired());
+    EXPECT_TRUE(streams.Streams[1].expired());
+
+    // Parts of the reads in flight go nowhere and open nothing
+    streams.States[0]->Reply(MakePart({0}));
+    streams.States[1]->Reply(MakeEosPart());
+    EXPECT_EQ(streams.States.size(), 2u);
+    EXPECT_FALSE(pending.HasValue());
+}
+
+TEST(ParallelReadRows, SplitKeys) {
+    auto keys = MakeKeysList(10);
+    const auto type = keys.GetType();
+    const auto chunks = SplitKeys(std::move(keys), 3);
+
+    ASSERT_EQ(chunks.size(), 4u);
+    std::uint64_t next = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        EXPECT_EQ(chunks[i].GetType().GetProto().DebugString(), type.GetProto().DebugString());
+        EXPECT_EQ(chunks[i].GetProto().items_size(), i + 1 < chunks.size() ? 3 : 1);
+        for (const auto& item : chunks[i].GetProto().items()) {
+            EXPECT_EQ(item.items(0).uint64_value(), next++);
+        }
+    }
+    EXPECT_EQ(next, 10u);
+
+    EXPECT_EQ(SplitKeys(MakeKeysList(3), 3).size(), 1u);
+    EXPECT_EQ(SplitKeys(MakeKeysList(0), 3).size(), 0u);
+}
+
+TEST(ParallelReadRows, MergesChunksInOrder) {
+    std::vector<std::pair<std::vector<std::uint64_t>, NThreading::TPromise<TReadRowsResult>>> requests;
+    auto readRows = [&](TValue&& keys) {
+        std::vector<std::uint64_t> values;
+        for (const auto& item : keys.GetProto().items()) {
+            values.push_back(item.items(0).uint64_value());
+        }
+        auto promise = NThreading::NewPromise<TReadRowsResult>();
+        requests.emplace_back(std::move(values), promise);
+        return promise.GetFuture();
+    };
+    auto reply = [&](size_t request) {
+        auto [keys, promise] = requests[request];
+        promise.SetValue(TReadRowsResult(TStatus(EStatus::SUCCESS, {}), MakeResultSet(keys)));
+    };
+
+    auto result = ReadRowsInChunks(readRows, SplitKeys(MakeKeysList(10), 3), 2);
+    ASSERT_EQ(requests.size(), 2u);
+
+    // Chunks complete out of order, the next one is sent when a request is completed
+    reply(1);
+    ASSERT_EQ(requests.size(), 3u);
+    reply(2);
+    ASSERT_EQ(requests.size(), 4u);
+    reply(3);
+    EXPECT_FALSE(result.HasValue());
+    reply(0);
+
+    ASSERT_TRUE(result.HasValue());
+    auto value = result.ExtractValue();
+    ASSERT_TRUE(value.IsSuccess());
+    EXPECT_EQ(GetKeys(value.GetResultSet()), (std::vector<std::uint64_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(ParallelReadRows, MergeMovesRows) {
+    // Long enough to live in a buffer of its own
+    const std::string payload(1024, 'x');
+    std::map<std::uint64_t, const char*> payloads;
+    auto readRows = [&](TValue&& keys) {
+        Ydb::ResultSet resultSet;
+        resultSet.add_columns()->set_name("key");
+        resultSet.add_columns()->set_name("value");
+        for (const auto& key : keys.GetProto().items()) {
+            auto* row = resultSet.add_rows();
+            row->add_items()->set_uint64_value(key.items(0).uint64_value());
+            row->add_items()->set_bytes_value(payload);
+            payloads[key.items(0).uint64_value()] = row->items(1).bytes_value().data();
+        }
+        return NThreading::MakeFuture(TReadRowsResult(TStatus(EStatus::SUCCESS, {}), TResultSet(std::move(resultSet))));
+    };
+
+    auto result = ReadRowsInChunks(readRows, SplitKeys(MakeKeysList(10), 3), 2);
+    ASSERT_TRUE(result.HasValue());
+    auto value = result.ExtractValue();
+    ASSERT_TRUE(value.IsSuccess());
+
+    const auto resultSet = value.GetResultSet();
+    const auto& proto = TProtoAccessor::GetProto(resultSet);
+    ASSERT_EQ(proto.columns_size(), 2);
+    ASSERT_EQ(proto.rows_size(), 10);
+    for (std::uint64_t key = 0; key < 10; ++key) {
+        const auto& row = proto.rows(key);
+        EXPECT_EQ(row.items(0).uint64_value(), key);
+        // The payload is the very buffer the chunk was received in
+        EXPECT_EQ(row.items(1).bytes_value().data(), payloads.at(key));
+    }
+}
+
+TEST(ParallelReadRows, NoChunks) {
+    auto result = ReadRowsInChunks([](TValue&&) -> TAsyncReadRowsResult {
+        ADD_FAILURE() << "unexpected request";
+        return {};
+    }, {}, 2);
+    ASSERT_TRUE(result.HasValue());
+    auto value = result.ExtractValue();
+    EXPECT_TRUE(value.IsSuccess());
+    EXPECT_EQ(value.GetResultSet().RowsCount(), 0u);
+}
+
+TEST(ParallelReadRows, ErrorOfOneChunkFailsRead) {
+    std::vector<NThreading::TPromise<TReadRowsResult>> requests;
+    auto readRows = [&](TValue&&) {
+        return requests.emplace_back(NThreading::NewPromise<TReadRowsResult>()).GetFuture();
+    };
+
+    auto result = ReadRowsInChunks(readRows, SplitKeys(MakeKeysList(10), 3), 2);
+    ASSERT_EQ(requests.size(), 2u);
+
+    requests[1].SetValue(TReadRowsResult(TStatus(EStatus::UNAVAILABLE, {}), MakeResultSet({})));
+    ASSERT_TRUE(result.HasValue());
+    EXPECT_EQ(result.GetValue().GetStatus(), EStatus::UNAVAILABLE);
+
+    // No more chunks are sent, results of the requests in flight are ignored
+    requests[0].SetValue(TReadRowsResult(TStatus(EStatus::SUCCESS, {}), MakeResultSet({0, 1, 2})));
+    EXPECT_EQ(requests.size(), 2u);
+}
@@ -0,0 +1,99 @@
+#include <src/client/topic/impl/batching_controller.h>
+
+#include <util/generic/size_literals.h>
+
+#include <gtest/gtest.h>
+
+using namespace NYdb::NTopic;
+
+namespace {
+    // Sends one request with a message of the given size and acknowledges it after the latency
+    bool WriteRequest(TBatchingController& controller, std::uint64_t id, std::uint64_t size, TInstant& now, TDuration latency) {
+        controller.OnReady(size, now);
+        controller.OnSent(size, id, now);
+        now += latency;
+        return controller.OnAck(id, now);
+    }
+}
+
+TEST(BatchingController, SendsAtOnceWithoutInflight) {
+    TBatchingController controller(TDuration::MilliSeconds(100), TDuration::Zero(), 0);
+    const TInstant now = TInstant::Seconds(1000);
+
+    controller.OnReady(100, now);
+    EXPECT_TRUE(controller.ShouldSend(false, now));
+    EXPECT_FALSE(controller.ShouldSend(true, now));
+}
+
+TEST(BatchingController, CollectsForFlushInterval) {
+    TBatchingController controller(TDuration::MilliSeconds(100), TDuration::Zero(), 0);
+    const TInstant now = TInstant::Seconds(1000);
+    const TDuration interval = controller.GetFlushInterval();
+    EXPECT_GT(interval, TDuration::Zero());
+    EXPECT_LE(interval, TDuration::MilliSeconds(100));
+
+    controller.OnReady(100, now);
+    controller.OnReady(100, now + interval / 2);
+    EXPECT_FALSE(controller.ShouldSend(true, now + interval / 2));
+    EXPECT_TRUE(controller.ShouldSend(true, now + interval));
+
+    controller.OnSent(200, 2, now + interval);
+    EXPECT_EQ(controller.GetPendingSince(), TInstant::Zero());
+}
+
+TEST(BatchingController, FlushIntervalIsBoundedBySettings) {
+    TBatchingController controller(TDuration::MilliSeconds(100), TDuration::MilliSeconds(10), 0);
+    TInstant now = TInstant::Seconds(1000);
+
+    for (std::uint64_t id = 1; id <= 1000; ++id) {
+        WriteRequest(controller, id, 100, now, TDuration::MilliSeconds(1));
+    }
+    EXPECT_EQ(controller.GetFlushInterval(), TDuration::MilliSeconds(10));
+}
+
+TEST(BatchingController, AdjustsFlushIntervalToLatency) {
+    TBatchingController controller(TDuration::MilliSeconds(100), TDuration::Zero(), 0);
+    TInstant now = TInstant::Seconds(1000);
+
+    // Latency is far below the target: the interval grows up to the target
+    for (std::uint64_t id = 1; id <= 64 * 64; ++id) {
+        WriteRequest(controller, id, 100, now, TDuration::MilliSeconds(10));
+    }
+    EXPECT_EQ(controller.GetFlushInterval(), TDuration::MilliSeconds(100));
+    EXPECT_EQ(controller.GetLatencyP99(), TDuration::MilliSeconds(10));
+
+    // Latency is above the target: the interval is halved on every window
+    std::uint64_t id = 64 * 64;
+    bool recalculated = false;
+    while (!recalculated) {
+        recalculated = WriteRequest(controller, ++id, 100, now, TDuration::MilliSeconds(200));
+    }
+    EXPECT_EQ(controller.GetFlushInterval(), TDuration::MilliSeconds(50));
+    EXPECT_EQ(controller.GetLatencyP99(), TDuration::MilliSeconds(200));
+}
+
+TEST(BatchingController, FlushSizeFollowsWriteRate) {
+    TBatchingController controller(TDuration::MilliSeconds(100), TDuration::Zero(), 0);
+    TInstant now = TInstant::Seconds(1000);
+
+    // 1 MB per 10 ms
+    for (std::uint64_t id = 1; id <= 64 * 64; ++id) {
+        WriteRequest(controller, id, 1_MB, now, TDuration::MilliSeconds(10));
+    }
+    EXPECT_EQ(controller.GetFlushInterval(), TDuration::MilliSeconds(100));
+    EXPECT_EQ(controller.GetFlushSizeBytes(), 10_MB);
+
+    controller.OnReady(10_MB, now);
+    EXPECT_TRUE(controller.ShouldSend(true, now));
+}
+
+TEST(BatchingController, IgnoresRequestsSentBeforeRetry) {
+    TBatchingController controller(TDuration::MilliSeconds(100), TDuration::Zero(), 0);
+    const TInstant now = TInstant::Seconds(1000);
+
+    controller.OnReady(100, now);
+    controller.OnSent(100, 1, now);
+    controller.OnRetry();
+    EXPECT_FALSE(controller.OnAck(1, now + TDuration::Seconds(10)));
+    EXPECT_EQ(controller.GetLatencyP99(), TDuration::Zero());
+}
@@ -0,0 +1,117 @@
+#include <src/client/topic/impl/chunked_compression.h>
+#include <src/client/topic/common/executor_impl.h>
+#include <src/client/topic/common/work_stealing_executor.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+using namespace NYdb;
+using namespace NYdb::NTopic;
+
+namespace {
+    std::string MakeEvent(size_t i) {
+        return "{\"ts\":" + std::to_string(1700000000000ull + i * 37)
+            + ",\"level\":\"info\",\"service\":\"billing\",\"request_id\":\"" + std::to_string(i * 7919)
+            + "\",\"message\":\"request processed\"}";
+    }
+
+    // Messages of about 3 MB in total, one of them is larger than a chunk
+    std::vector<std::string> MakeBlock() {
+        std::vector<std::string> messages;
+        size_t event = 0;
+        for (size_t size : {100_KB, 700_KB, 1500_KB, 10_KB, 800_KB}) {
+            auto& message = messages.emplace_back();
+            while (message.size() < size) {
+                message += MakeEvent(event++);
+            }
+        }
+        return messages;
+    }
+
+    std::string Concatenate(const std::vector<std::string>& messages) {
+        std::string result;
+        for (const auto& message : messages) {
+            result += message;
+        }
+        return result;
+    }
+
+    std::string Compress(IExecutor& executor, const std::vector<std::string>& data, ECodec codec) {
+        std::promise<TBuffer> promise;
+        auto future = promise.get_future();
+        CompressInChunks(executor, data, codec, 4, COMPRESSION_CHUNK_SIZE, [&promise](TBuffer&& compressed) {
+            promise.set_value(std::move(compressed));
+        });
+        EXPECT_EQ(future.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+        const auto compressed = future.get();
+        return std::string(compressed.Data(), compressed.Size());
+    }
+}
+
+TEST(ChunkedCompression, SplitIntoChunks) {
+    const std::vector<std::string> data = {"abc", "", "defgh", "ij", "klmnopq"};
+    const auto chunks = SplitIntoChunks(data, 4);
+
+    std::string joined;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        size_t chunkSize = 0;
+        for (auto part : chunks[i]) {
+            EXPECT_FALSE(part.empty());
+            chunkSize += part.size();
+            joined += part;
+        }
+        if (i + 1 < chunks.size()) {
+            EXPECT_EQ(chunkSize, 4u);
+        } else {
+            EXPECT_LE(chunkSize, 4u);
+        }
+    }
+    EXPECT_EQ(chunks.size(), 5u);
+    EXPECT_EQ(joined, Concatenate(data));
+}
+
+TEST(ChunkedCompression, SupportedCodecs) {
+    EXPECT_TRUE(IsChunkedCompressionSupported(ECodec::GZIP));
+    EXPECT_TRUE(IsChunkedCompressionSupported(ECodec::ZSTD));
+    EXPECT_FALSE(IsChunkedCompressionSupported(ECodec::RAW));
+}
+
+TEST(ChunkedCompression, RoundTrip) {
+    const auto block = MakeBlock();
+    const auto original = Concatenate(block);
+    ASSERT_GE(original.size(), 2 * COMPRESSION_CHUNK_SIZE);
+    ASSERT_GE(SplitIntoChunks(block, COMPRESSION_CHUNK_SIZE).size(), 3u);
+
+    auto executor = std::make_shared<TWorkStealingExecutor>(4);
+    executor->Start();
+    TSyncExecutor syncExecutor;
+
+    for (auto codec : {ECodec::GZIP, ECodec::ZSTD}) {
+        const auto* decoder = TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<ui32>(codec));
+
+        // Frames of the chunks are concatenated in the order of the data, whatever order they are compressed in
+        const auto compressed = Compress(*executor, block, codec);
+        EXPECT_LT(compressed.size(), original.size());
+        EXPECT_EQ(decoder->Decompress(compressed), original);
+
+        std::string result;
+        decoder->DecompressInto(compressed, original.size(), result);
+        EXPECT_EQ(result, original);
+
+        EXPECT_EQ(Compress(syncExecutor, block, codec), compressed);
+    }
+}
+
+TEST(ChunkedCompression, SmallBlockIsOneFrame) {
+    const std::vector<std::string> block = {MakeEvent(0), MakeEvent(1)};
+    TSyncExecutor executor;
+
+    for (auto codec : {ECodec::GZIP, ECodec::ZSTD}) {
+        const auto* decoder = TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<ui32>(codec));
+        EXPECT_EQ(decoder->Decompress(Compress(executor, block, codec)), Concatenate(block));
+    }
+}
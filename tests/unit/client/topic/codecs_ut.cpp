@@ -0,0 +1,245 @@
+#include <ydb-cpp-sdk/client/topic/codecs.h>
+
+#include <util/generic/size_literals.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace NYdb::NTopic;
+
+namespace {
+    std::string MakeEvent(size_t i) {
+        return "{\"ts\":" + std::to_string(1700000000000ull + i * 37)
+            + ",\"level\":\"info\",\"service\":\"billing\",\"request_id\":\"" + std::to_string(i * 7919)
+            + "\",\"message\":\"request processed\"}";
+    }
+
+    std::string Compress(const ICodec& codec, const std::string& data, int quality = 4) {
+        TBuffer buffer;
+        auto coder = codec.CreateCoder(buffer, quality);
+        coder->Write(data.data(), data.size());
+        coder->Finish();
+        return std::string(buffer.Data(), buffer.Size());
+    }
+
+    std::string MakeData() {
+        std::string data;
+        for (size_t i = 0; i < 1000; ++i) {
+            data += MakeEvent(i);
+        }
+        return data;
+    }
+
+    std::string Decompress(const ICodec& codec, const std::string& data) {
+        std::string result;
+        codec.DecompressInto(data, 0, result);
+        return result;
+    }
+
+    // Every prefix of the trailing bytes, where the checksum and frame end are, and a sparse set of the others
+    void ExpectTruncatedThrow(const ICodec& codec, const std::string& prefix, const std::string& compressed) {
+        const size_t step = std::max<size_t>(compressed.size() / 100, 1);
+        for (size_t size = 1; size < compressed.size(); size += size + 16 < compressed.size() ? step : 1) {
+            EXPECT_THROW(Decompress(codec, prefix + compressed.substr(0, size)), yexception) << "truncated to " << size;
+        }
+    }
+
+    std::vector<std::string> MakeSamples(size_t count, size_t offset = 0) {
+        std::vector<std::string> samples;
+        for (size_t i = 0; i < count; ++i) {
+            samples.push_back(MakeEvent(offset + i));
+        }
+        return samples;
+    }
+}
+
+TEST(TopicCodecs, Lz4RoundTrip) {
+    const TLz4Codec lz4;
+    const ICodec* codec = &lz4;
+
+    std::string data;
+    for (size_t i = 0; i < 1000; ++i) {
+        data += MakeEvent(i);
+    }
+
+    for (int quality : {-1, 0, 9}) {
+        const auto compressed = Compress(*codec, data, quality);
+        EXPECT_LT(compressed.size(), data.size());
+        EXPECT_EQ(codec->Decompress(compressed), data);
+
+        std::string result = "previous content";
+        codec->DecompressInto(compressed, data.size(), result);
+        EXPECT_EQ(result, data);
+
+        // Hint smaller than the real size makes output grow
+        codec->DecompressInto(compressed, 10, result);
+        EXPECT_EQ(result, data);
+
+        // Concatenated frames
+        EXPECT_EQ(codec->Decompress(compressed + compressed), data + data);
+    }
+
+    EXPECT_EQ(codec->Decompress(Compress(*codec, "")), "");
+}
+
+TEST(TopicCodecs, Lz4NotRegisteredByDefault) {
+    // Id of the custom range, users may have their own codec there
+    EXPECT_THROW(TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<uint32_t>(ECodec::LZ4)), yexception);
+}
+
+TEST(TopicCodecs, Lz4CompressionLevels) {
+    const TLz4Codec codec;
+
+    std::string data;
+    for (size_t i = 0; i < 1000; ++i) {
+        data += MakeEvent(i);
+    }
+
+    // Default and other ordinary levels use the fast mode
+    const auto fast = Compress(codec, data, 0);
+    for (int quality : {1, 4, 8}) {
+        EXPECT_EQ(Compress(codec, data, quality), fast);
+    }
+
+    // Negative levels trade ratio for speed, high levels switch to the high compression mode
+    EXPECT_GE(Compress(codec, data, -10).size(), fast.size());
+    const auto high = Compress(codec, data, 9);
+    EXPECT_LT(high.size(), fast.size());
+    EXPECT_EQ(Compress(codec, data, 100), Compress(codec, data, 12));
+    EXPECT_EQ(codec.Decompress(high), data);
+}
+
+TEST(TopicCodecs, Lz4TruncatedInput) {
+    const TLz4Codec lz4;
+    const ICodec* codec = &lz4;
+
+    std::string data;
+    for (size_t i = 0; i < 1000; ++i) {
+        data += MakeEvent(i);
+    }
+    const auto compressed = Compress(*codec, data);
+    EXPECT_THROW(codec->Decompress(compressed.substr(0, compressed.size() / 2)), yexception);
+}
+
+TEST(TopicCodecs, DecompressIntoWithWrongHint) {
+    const TGzipCodec gzip;
+    const TZstdCodec zstd;
+    const auto data = MakeData();
+
+    for (const ICodec* codec : {static_cast<const ICodec*>(&gzip), static_cast<const ICodec*>(&zstd)}) {
+        const auto compressed = Compress(*codec, data);
+        for (size_t hint : {size_t{0}, size_t{1}, data.size() - 1, data.size(), data.size() + 1, data.size() * 10, 1_GB}) {
+            std::string result = "previous content";
+            codec->DecompressInto(compressed, hint, result);
+            EXPECT_EQ(result, data) << "hint " << hint;
+        }
+    }
+}
+
+TEST(TopicCodecs, DecompressIntoCapsHintedCapacity) {
+    const TGzipCodec gzip;
+    const TZstdCodec zstd;
+    const auto data = MakeData();
+
+    for (const ICodec* codec : {static_cast<const ICodec*>(&gzip), static_cast<const ICodec*>(&zstd)}) {
+        // The hint comes from the wire, a few kilobytes of input must not reserve gigabytes or the absolute cap
+        std::string result;
+        codec->DecompressInto(Compress(*codec, data), 1_GB, result);
+        EXPECT_EQ(result, data);
+        EXPECT_LT(result.capacity(), 16_MB);
+    }
+}
+
+TEST(TopicCodecs, GzipConcatenatedMembers) {
+    const TGzipCodec codec;
+    const auto data = MakeData();
+    const auto compressed = Compress(codec, data);
+
+    EXPECT_EQ(Decompress(codec, compressed + compressed), data + data);
+    EXPECT_EQ(Decompress(codec, Compress(codec, "first") + Compress(codec, "") + Compress(codec, "second")), "firstsecond");
+}
+
+TEST(TopicCodecs, ZstdConcatenatedFrames) {
+    const TZstdCodec codec;
+    const auto data = MakeData();
+    const auto compressed = Compress(codec, data);
+
+    EXPECT_EQ(Decompress(codec, compressed + compressed), data + data);
+}
+
+TEST(TopicCodecs, GzipBrokenInput) {
+    const TGzipCodec codec;
+    const auto compressed = Compress(codec, MakeData());
+
+    ExpectTruncatedThrow(codec, "", compressed);
+    ExpectTruncatedThrow(codec, compressed, compressed);
+    EXPECT_THROW(Decompress(codec, compressed + "garbage"), yexception);
+    EXPECT_THROW(Decompress(codec, "not compressed"), yexception);
+
+    // Deflate stream, CRC and size after the 10 byte header are all verified
+    for (size_t i = 10; i < compressed.size(); ++i) {
+        auto corrupted = compressed;
+        corrupted[i] ^= 0x5a;
+        EXPECT_THROW(Decompress(codec, corrupted), yexception) << "corrupted byte " << i;
+    }
+}
+
+TEST(TopicCodecs, ZstdBrokenInput) {
+    const TZstdCodec codec;
+    const auto compressed = Compress(codec, MakeData());
+
+    ExpectTruncatedThrow(codec, "", compressed);
+    ExpectTruncatedThrow(codec, compressed, compressed);
+    EXPECT_THROW(Decompress(codec, compressed + "garbage"), yexception);
+    EXPECT_THROW(Decompress(codec, "not compressed"), yexception);
+
+    // Frames are written without checksum, so only the structure is verified
+    auto corrupted = compressed;
+    corrupted[0] ^= 0x01;
+    EXPECT_THROW(Decompress(codec, corrupted), yexception);
+}
+
+TEST(TopicCodecs, ZstdDictRoundTrip) {
+    const auto dictionary = TZstdDictCodec::TrainDictionary(MakeSamples(2000));
+    TZstdDictCodec codec(dictionary);
+    EXPECT_NE(codec.GetDictionaryId(), 0u);
+
+    const auto* plainCodec = TCodecMap::GetTheCodecMap().GetOrThrow(static_cast<uint32_t>(ECodec::ZSTD));
+    for (const auto& message : MakeSamples(100, 100000)) {
+        const auto compressed = Compress(codec, message);
+        EXPECT_LT(compressed.size(), Compress(*plainCodec, message).size());
+        EXPECT_EQ(codec.Decompress(compressed), message);
+
+        std::string result;
+        codec.DecompressInto(compressed, message.size(), result);
+        EXPECT_EQ(result, message);
+    }
+
+    // Messages compressed without a dictionary are read as well
+    const auto message = MakeEvent(42);
+    EXPECT_EQ(codec.Decompress(Compress(*plainCodec, message)), message);
+}
+
+TEST(TopicCodecs, ZstdDictRetraining) {
+    const auto oldDictionary = TZstdDictCodec::TrainDictionary(MakeSamples(2000));
+    const auto newDictionary = TZstdDictCodec::TrainDictionary(MakeSamples(2000, 50000));
+
+    TZstdDictCodec oldCodec(oldDictionary);
+    TZstdDictCodec newCodec(newDictionary, {oldDictionary});
+    ASSERT_NE(oldCodec.GetDictionaryId(), newCodec.GetDictionaryId());
+
+    const auto message = MakeEvent(100000);
+    EXPECT_EQ(newCodec.Decompress(Compress(oldCodec, message)), message);
+    EXPECT_EQ(newCodec.Decompress(Compress(newCodec, message)), message);
+
+    // The old codec does not know the new dictionary
+    EXPECT_THROW(oldCodec.Decompress(Compress(newCodec, message)), yexception);
+}
+
+TEST(TopicCodecs, ZstdDictTrainingErrors) {
+    EXPECT_THROW(TZstdDictCodec::TrainDictionary({"a", "b"}), yexception);
+    EXPECT_THROW(TZstdDictCodec("not a dictionary"), yexception);
+}
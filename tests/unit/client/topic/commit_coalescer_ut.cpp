@@ -0,0 +1,91 @@
+#include <src/client/topic/impl/commit_coalescer.h>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace NYdb::NTopic;
+
+namespace {
+    using TRanges = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+
+    std::map<std::int64_t, TRanges> Flush(TCommitCoalescer& coalescer) {
+        Ydb::Topic::StreamReadMessage::CommitOffsetRequest request;
+        coalescer.Flush(request);
+
+        std::map<std::int64_t, TRanges> result;
+        for (const auto& commit : request.commit_offsets()) {
+            EXPECT_FALSE(result.contains(commit.partition_session_id()));
+            auto& ranges = result[commit.partition_session_id()];
+            for (const auto& range : commit.offsets()) {
+                ranges.emplace_back(range.start(), range.end());
+            }
+        }
+        return result;
+    }
+}
+
+TEST(CommitCoalescer, MergesAdjacentRanges) {
+    TCommitCoalescer coalescer;
+    for (std::uint64_t offset = 10; offset < 1000; ++offset) {
+        EXPECT_EQ(coalescer.Add(1, offset, offset + 1), 1u);
+    }
+
+    auto result = Flush(coalescer);
+    EXPECT_EQ(result, (std::map<std::int64_t, TRanges>{{1, {{10, 1000}}}}));
+    EXPECT_TRUE(coalescer.Empty());
+}
+
+TEST(CommitCoalescer, BatchesPartitions) {
+    TCommitCoalescer coalescer;
+    coalescer.Add(1, 0, 5);
+    coalescer.Add(2, 100, 101);
+    coalescer.Add(1, 5, 7);
+    coalescer.Add(2, 105, 106);
+    EXPECT_EQ(coalescer.GetRangesCount(), 3u);
+
+    auto result = Flush(coalescer);
+    EXPECT_EQ(result, (std::map<std::int64_t, TRanges>{
+        {1, {{0, 7}}},
+        {2, {{100, 101}, {105, 106}}},
+    }));
+}
+
+TEST(CommitCoalescer, SortsOutOfOrderRanges) {
+    TCommitCoalescer coalescer;
+    coalescer.Add(1, 20, 30);
+    coalescer.Add(1, 0, 10);
+    coalescer.Add(1, 10, 20);
+    coalescer.Add(1, 40, 50);
+
+    auto result = Flush(coalescer);
+    EXPECT_EQ(result, (std::map<std::int64_t, TRanges>{{1, {{0, 30}, {40, 50}}}}));
+}
+
+TEST(CommitCoalescer, ForgetsIdlePartitions) {
+    TCommitCoalescer coalescer;
+    coalescer.Add(1, 0, 1);
+    coalescer.Add(2, 0, 1);
+    coalescer.Add(3, 0, 1);
+    Flush(coalescer);
+
+    coalescer.Add(3, 1, 2);
+    EXPECT_EQ(Flush(coalescer), (std::map<std::int64_t, TRanges>{{3, {{1, 2}}}}));
+
+    // Partitions 1 and 2 are dropped by the previous flush, the next ones start over
+    coalescer.Add(1, 5, 6);
+    coalescer.Add(3, 2, 3);
+    EXPECT_EQ(Flush(coalescer), (std::map<std::int64_t, TRanges>{{1, {{5, 6}}}, {3, {{2, 3}}}}));
+    EXPECT_TRUE(Flush(coalescer).empty());
+}
+
+TEST(CommitCoalescer, Clear) {
+    TCommitCoalescer coalescer;
+    coalescer.Add(1, 0, 1);
+    coalescer.Add(1, 5, 6);
+    coalescer.Clear();
+    EXPECT_TRUE(coalescer.Empty());
+    EXPECT_TRUE(Flush(coalescer).empty());
+}
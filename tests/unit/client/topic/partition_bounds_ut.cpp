@@ -0,0 +1,174 @@
+#include <src/client/topic/impl/partition_bounds.h>
+
+#include <ydb-cpp-sdk/client/topic/producer.h>
+
+#include <util/digest/murmur.h>
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NYdb::NTopic;
+
+namespace {
+    using TPartitionsIndex = std::map<std::string, std::uint32_t>;
+
+    // The lookup the bound partition chooser did in the index before the flat bounds
+    std::uint32_t FindInIndex(const TPartitionsIndex& index, const std::string& key) {
+        auto lowerBound = index.lower_bound(key);
+        if (lowerBound != index.end() && lowerBound->first == key) {
+            return lowerBound->second;
+        }
+        return std::prev(lowerBound)->second;
+    }
+
+    // Keys next to every bound: the bound itself, its prefixes, extensions and neighbours in the last byte
+    std::vector<std::string> MakeBoundaryKeys(const TPartitionsIndex& index) {
+        std::vector<std::string> keys;
+        for (const auto& [bound, _] : index) {
+            keys.push_back(bound);
+            keys.push_back(bound + '\0');
+            keys.push_back(bound + '\xff');
+            if (!bound.empty()) {
+                keys.push_back(bound.substr(0, bound.size() - 1));
+                auto less = bound;
+                --less.back();
+                keys.push_back(less);
+                auto greater = bound;
+                ++greater.back();
+                keys.push_back(greater);
+            }
+        }
+
+        std::vector<std::string> result;
+        for (auto& key : keys) {
+            if (THashedKey::Fits(key)) {
+                result.push_back(std::move(key));
+            }
+        }
+        return result;
+    }
+
+    void CheckBoundaryKeys(const TPartitionsIndex& index) {
+        TPartitionBounds bounds;
+        bounds.Rebuild(index);
+        ASSERT_FALSE(bounds.Empty());
+
+        for (const auto& key : MakeBoundaryKeys(index)) {
+            EXPECT_EQ(bounds.Find(THashedKey::FromString(key)), FindInIndex(index, key))
+                << "key of " << key.size() << " bytes";
+        }
+    }
+}
+
+TEST(PartitionBounds, KeyRoundTrip) {
+    for (const auto& key : {std::string(), std::string("a"), std::string("\0\0", 2), std::string(16, '\xff'), std::string("0123456789abcde")}) {
+        EXPECT_EQ(THashedKey::FromString(key).ToString(), key);
+    }
+}
+
+TEST(PartitionBounds, KeyOrderMatchesStrings) {
+    const std::vector<std::string> keys = {
+        "",
+        std::string("\0", 1),
+        std::string("\0\0", 2),
+        "\x01",
+        "a",
+        std::string("a\0", 2),
+        std::string("a\0\0", 3),
+        "a\x01",
+        "ab",
+        "abcdefgh",
+        std::string("abcdefgh\0", 9),
+        "abcdefgh\x01",
+        "abcdefghijklmnop",
+        "\x7f",
+        "\x80",
+        std::string(15, '\xff'),
+        std::string(16, '\xff'),
+    };
+    for (const auto& left : keys) {
+        for (const auto& right : keys) {
+            EXPECT_EQ(THashedKey::FromString(left) < THashedKey::FromString(right), left < right);
+            EXPECT_EQ(THashedKey::FromString(left) == THashedKey::FromString(right), left == right);
+        }
+    }
+}
+
+TEST(PartitionBounds, HashMatchesDefaultHasher) {
+    for (const std::string key : {"", "key", "another key"}) {
+        const auto hash = MurmurHash<std::uint64_t>(key.data(), key.size(), std::uint64_t{0});
+        EXPECT_EQ(THashedKey::FromUint64(hash), THashedKey::FromString(TProducerSettings::DefaultPartitioningKeyHasher(key)));
+    }
+}
+
+TEST(PartitionBounds, BoundaryKeys) {
+    CheckBoundaryKeys({
+        {"", 0},
+        {std::string("\0", 1), 1},
+        {"\x01", 2},
+        {"a", 3},
+        {std::string("a\0", 2), 4},
+        {"ab", 5},
+        {"abcdefgh", 6},
+        {std::string("abcdefgh\0", 9), 7},
+        {"abcdefghijklmnop", 8},
+        {"\x80", 9},
+        {std::string(16, '\xff'), 10},
+    });
+}
+
+TEST(PartitionBounds, HashRanges) {
+    // Partitions covering equal ranges of the 8-byte default hash
+    TPartitionsIndex index = {{"", 0}};
+    for (std::uint32_t partitionId = 1; partitionId < 64; ++partitionId) {
+        index.emplace(THashedKey::FromUint64(std::uint64_t{partitionId} << 58).ToString(), partitionId);
+    }
+    CheckBoundaryKeys(index);
+
+    TPartitionBounds bounds;
+    bounds.Rebuild(index);
+    for (int i = 0; i < 10000; ++i) {
+        const auto key = "key" + std::to_string(i);
+        const auto hash = MurmurHash<std::uint64_t>(key.data(), key.size(), std::uint64_t{0});
+        EXPECT_EQ(bounds.Find(THashedKey::FromUint64(hash)), FindInIndex(index, TProducerSettings::DefaultPartitioningKeyHasher(key)));
+    }
+}
+
+TEST(PartitionBounds, RandomKeys) {
+    std::mt19937_64 random(42);
+    auto makeKey = [&] {
+        std::string key(random() % (THashedKey::MAX_SIZE + 1), '\0');
+        for (auto& c : key) {
+            // Few distinct bytes, so that keys share prefixes
+            c = "\x00\x01\x7f\x80\xff"[random() % 5];
+        }
+        return key;
+    };
+
+    TPartitionsIndex index = {{"", 0}};
+    for (std::uint32_t partitionId = 1; partitionId < 100; ++partitionId) {
+        index.emplace(makeKey(), partitionId);
+    }
+    CheckBoundaryKeys(index);
+
+    TPartitionBounds bounds;
+    bounds.Rebuild(index);
+    for (int i = 0; i < 10000; ++i) {
+        const auto key = makeKey();
+        EXPECT_EQ(bounds.Find(THashedKey::FromString(key)), FindInIndex(index, key));
+    }
+}
+
+TEST(PartitionBounds, LongBoundsAreNotFlattened) {
+    TPartitionBounds bounds;
+    bounds.Rebuild({{"", 0}, {"a", 1}});
+    EXPECT_FALSE(bounds.Empty());
+
+    bounds.Rebuild({{"", 0}, {std::string(THashedKey::MAX_SIZE + 1, 'a'), 1}});
+    EXPECT_TRUE(bounds.Empty());
+}
@@ -0,0 +1,177 @@
+#include <src/client/topic/impl/read_memory_pool.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace NYdb::NTopic;
+
+namespace {
+    std::shared_ptr<TReadSessionMemoryPool> CreatePool(size_t maxMemoryUsageBytes) {
+        return std::dynamic_pointer_cast<TReadSessionMemoryPool>(CreateReadSessionMemoryPool(maxMemoryUsageBytes));
+    }
+
+    bool WaitFor(const std::atomic<int>& counter, int value) {
+        for (int i = 0; i < 1000 && counter.load() < value; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return counter.load() >= value;
+    }
+
+    // Reacts to the pool the way a read session does: on wakeup it reads if there is memory, else waits again
+    class TFakeSession {
+    public:
+        TFakeSession(const std::shared_ptr<TReadSessionMemoryPool>& pool, i64 localLimit)
+            : LocalLimit(localLimit)
+        {
+            Reservation = pool->Register([this] {
+                ++Wakeups;
+                std::lock_guard guard(Lock);
+                ContinueReadingImpl();
+            });
+        }
+
+        ~TFakeSession() {
+            Reservation.reset();
+        }
+
+        void Hold(i64 usage) {
+            std::lock_guard guard(Lock);
+            Usage = usage;
+            ContinueReadingImpl();
+        }
+
+        std::atomic<int> Wakeups = 0;
+        std::atomic<int> Reads = 0;
+
+    private:
+        void ContinueReadingImpl() {
+            Reservation->Update(Usage);
+            // Compressed data may take only a part of the memory limit, the rest is kept for decompression
+            if (Usage < std::min(LocalLimit, Reservation->GetLimit()) / 2) {
+                ++Reads;
+            } else {
+                Reservation->WaitForMemory(LocalLimit);
+            }
+        }
+
+    private:
+        const i64 LocalLimit;
+        std::mutex Lock;
+        i64 Usage = 0;
+        std::unique_ptr<TReadSessionMemoryPool::TReservation> Reservation;
+    };
+}
+
+TEST(ReadSessionMemoryPool, AccountsSessionsUsage) {
+    auto pool = CreatePool(1000);
+    auto first = pool->Register([] {});
+    auto second = pool->Register([] {});
+    EXPECT_EQ(pool->GetSessionsCount(), 2u);
+
+    first->Update(300);
+    second->Update(200);
+    EXPECT_EQ(pool->GetMemoryUsage(), 500u);
+
+    first->Update(100);
+    EXPECT_EQ(pool->GetMemoryUsage(), 300u);
+
+    first.reset();
+    EXPECT_EQ(pool->GetSessionsCount(), 1u);
+    EXPECT_EQ(pool->GetMemoryUsage(), 200u);
+}
+
+TEST(ReadSessionMemoryPool, LimitsSessionsByFairShare) {
+    auto pool = CreatePool(1000);
+    auto first = pool->Register([] {});
+    auto second = pool->Register([] {});
+
+    // Idle session may take the whole unused budget
+    EXPECT_EQ(first->GetLimit(), 1000);
+
+    first->Update(900);
+    EXPECT_EQ(first->GetLimit(), 1000);
+    // Session below its fair share is never limited by the others
+    EXPECT_EQ(second->GetLimit(), 500);
+
+    second->Update(500);
+    EXPECT_EQ(first->GetLimit(), 500);
+    EXPECT_GE(second->GetLimit(), 500);
+}
+
+TEST(ReadSessionMemoryPool, WakesWaitersOnRelease) {
+    auto pool = CreatePool(1000);
+    std::atomic<int> wakeups = 0;
+    auto waiter = pool->Register([&wakeups] { ++wakeups; });
+    auto holder = pool->Register([] {});
+
+    holder->Update(400);
+    waiter->Update(600);
+    waiter->WaitForMemory(1000);
+
+    // Allocation of more memory does not wake anybody
+    holder->Update(450);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(wakeups.load(), 0);
+
+    holder->Update(100);
+    EXPECT_TRUE(WaitFor(wakeups, 1));
+
+    // Waiter is woken up once per WaitForMemory
+    holder->Update(0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(wakeups.load(), 1);
+}
+
+TEST(ReadSessionMemoryPool, WakesWaitersOnSessionDestroy) {
+    auto pool = CreatePool(1000);
+    std::atomic<int> wakeups = 0;
+    auto waiter = pool->Register([&wakeups] { ++wakeups; });
+    auto holder = pool->Register([] {});
+
+    holder->Update(400);
+    waiter->Update(600);
+    waiter->WaitForMemory(1000);
+
+    holder.reset();
+    EXPECT_TRUE(WaitFor(wakeups, 1));
+}
+
+TEST(ReadSessionMemoryPool, SessionLimitedByOwnLimitDoesNotWait) {
+    auto pool = CreatePool(1'000'000);
+    // Registered first to be destroyed last, its removal would wake up a waiting session
+    auto other = pool->Register([] {});
+    TFakeSession session(pool, 100);
+
+    // The pool has plenty of memory, the session is stopped by its own limit
+    session.Hold(100);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(session.Wakeups.load(), 0);
+
+    other->Update(1000);
+    other->Update(0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(session.Wakeups.load(), 0);
+    EXPECT_EQ(session.Reads.load(), 0);
+}
+
+TEST(ReadSessionMemoryPool, WokenSessionWaitsAgainWithoutSpinning) {
+    auto pool = CreatePool(1000);
+    auto holder = pool->Register([] {});
+    TFakeSession session(pool, 1'000'000);
+
+    holder->Update(500);
+    session.Hold(500);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(session.Wakeups.load(), 0);
+
+    // The release is not enough to read, the session waits for the next one
+    holder->Update(400);
+    EXPECT_TRUE(WaitFor(session.Wakeups, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(session.Wakeups.load(), 1);
+}
@@ -0,0 +1,155 @@
+#include <src/client/topic/common/work_stealing_executor.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace NYdb::NTopic;
+
+namespace {
+    const auto WAIT_TIMEOUT = std::chrono::seconds(30);
+
+    class TCounter {
+    public:
+        void Increment() {
+            std::lock_guard guard(Lock);
+            ++Value;
+            CondVar.notify_all();
+        }
+
+        bool WaitFor(size_t value) {
+            std::unique_lock lock(Lock);
+            return CondVar.wait_for(lock, WAIT_TIMEOUT, [&] { return Value >= value; });
+        }
+
+        size_t Get() {
+            std::lock_guard guard(Lock);
+            return Value;
+        }
+
+    private:
+        std::mutex Lock;
+        std::condition_variable CondVar;
+        size_t Value = 0;
+    };
+
+    std::shared_ptr<TWorkStealingExecutor> MakeExecutor(size_t threadCount) {
+        auto executor = std::make_shared<TWorkStealingExecutor>(threadCount);
+        executor->Start();
+        return executor;
+    }
+}
+
+TEST(WorkStealingExecutor, CompletesTasks) {
+    constexpr size_t THREADS = 4;
+    constexpr size_t TASKS_PER_THREAD = 10000;
+
+    auto executor = MakeExecutor(4);
+    TCounter counter;
+    std::vector<std::thread> posters;
+    for (size_t i = 0; i < THREADS; ++i) {
+        posters.emplace_back([&] {
+            for (size_t j = 0; j < TASKS_PER_THREAD; ++j) {
+                executor->Post([&] { counter.Increment(); });
+            }
+        });
+    }
+    for (auto& poster : posters) {
+        poster.join();
+    }
+
+    ASSERT_TRUE(counter.WaitFor(THREADS * TASKS_PER_THREAD));
+    EXPECT_EQ(counter.Get(), THREADS * TASKS_PER_THREAD);
+    EXPECT_EQ(executor->GetStats().QueueDepth, 0u);
+}
+
+TEST(WorkStealingExecutor, CompletesNestedTasks) {
+    constexpr size_t FAN_OUT = 10;
+
+    auto executor = MakeExecutor(3);
+    TCounter counter;
+    for (size_t i = 0; i < FAN_OUT; ++i) {
+        executor->Post([&] {
+            // Tasks posted from a worker go to its own queue
+            for (size_t j = 0; j < FAN_OUT; ++j) {
+                executor->Post([&] { counter.Increment(); });
+            }
+        });
+    }
+
+    ASSERT_TRUE(counter.WaitFor(FAN_OUT * FAN_OUT));
+}
+
+TEST(WorkStealingExecutor, StealsFromBusyWorker) {
+    constexpr size_t TASKS = 100;
+
+    auto executor = MakeExecutor(2);
+    TCounter counter;
+    std::mutex threadsLock;
+    std::set<std::thread::id> threads;
+    std::atomic<bool> completed = false;
+    std::thread::id busyThread;
+    TCounter busy;
+    executor->Post([&] {
+        busyThread = std::this_thread::get_id();
+        for (size_t i = 0; i < TASKS; ++i) {
+            executor->Post([&] {
+                {
+                    std::lock_guard guard(threadsLock);
+                    threads.insert(std::this_thread::get_id());
+                }
+                counter.Increment();
+            });
+        }
+        // The tasks are queued to this worker, so they complete only if the other one steals them
+        completed = counter.WaitFor(TASKS);
+        busy.Increment();
+    });
+
+    ASSERT_TRUE(busy.WaitFor(1));
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(threads.size(), 1u);
+    EXPECT_FALSE(threads.contains(busyThread));
+    // The first task itself may be stolen too
+    EXPECT_GE(executor->GetStats().TasksStolen, TASKS);
+}
+
+TEST(WorkStealingExecutor, DestructionWaitsForPostedTasks) {
+    constexpr size_t TASKS = 10000;
+
+    std::atomic<size_t> executed = 0;
+    {
+        auto executor = MakeExecutor(4);
+        for (size_t i = 0; i < TASKS; ++i) {
+            executor->Post([&] { ++executed; });
+        }
+    }
+    EXPECT_EQ(executed.load(), TASKS);
+}
+
+TEST(WorkStealingExecutor, DestructionOfIdleExecutor) {
+    {
+        auto executor = MakeExecutor(4);
+        // Let the workers fall asleep
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    {
+        TWorkStealingExecutor notStarted(4);
+    }
+}
+
+TEST(WorkStealingExecutor, StopKeepsSharedExecutorRunning) {
+    auto executor = MakeExecutor(2);
+    executor->Stop();
+
+    TCounter counter;
+    executor->Post([&] { counter.Increment(); });
+    EXPECT_TRUE(counter.WaitFor(1));
+}
@@ -0,0 +1,105 @@
+#include <ydb-cpp-sdk/client/topic/write_session.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+
+using namespace NYdb::NTopic;
+
+namespace {
+    std::string MakeBody(char c) {
+        // Longer than any small string buffer, so moving keeps the allocation
+        return std::string(1000, c);
+    }
+}
+
+TEST(WriteMessage, ReleaseMovesOwnedBody) {
+    std::string body = MakeBody('a');
+    const char* buffer = body.data();
+    TWriteMessage message(std::move(body));
+    EXPECT_EQ(message.Data.data(), buffer);
+
+    std::string released = message.ReleaseData();
+    EXPECT_EQ(released.data(), buffer);
+    EXPECT_EQ(released, MakeBody('a'));
+    EXPECT_TRUE(message.Data.empty());
+}
+
+TEST(WriteMessage, ReleaseCopiesBorrowedBody) {
+    const std::string body = MakeBody('b');
+    TWriteMessage message(std::string_view{body});
+
+    std::string released = message.ReleaseData();
+    EXPECT_NE(released.data(), body.data());
+    EXPECT_EQ(released, body);
+    EXPECT_TRUE(message.Data.empty());
+}
+
+TEST(WriteMessage, MoveConstructedKeepsBody) {
+    std::string body = MakeBody('c');
+    const char* buffer = body.data();
+    TWriteMessage source(std::move(body));
+    TWriteMessage message(std::move(source));
+    EXPECT_EQ(message.Data, MakeBody('c'));
+
+    TWriteMessage assigned(std::string_view{});
+    assigned = std::move(message);
+    EXPECT_EQ(assigned.Data, MakeBody('c'));
+
+    std::string released = assigned.ReleaseData();
+    EXPECT_EQ(released.data(), buffer);
+    EXPECT_EQ(released, MakeBody('c'));
+}
+
+TEST(WriteMessage, MoveConstructedShortBody) {
+    // Short strings are moved by copying their inline buffer, the view has to follow it
+    TWriteMessage source(std::string("short"));
+    TWriteMessage message(std::move(source));
+    EXPECT_EQ(message.Data, "short");
+    EXPECT_EQ(message.ReleaseData(), "short");
+}
+
+TEST(WriteMessage, CopyOwnsItsBody) {
+    TWriteMessage source(MakeBody('d'));
+    TWriteMessage copy(source);
+    EXPECT_NE(copy.Data.data(), source.Data.data());
+
+    EXPECT_EQ(source.ReleaseData(), MakeBody('d'));
+    EXPECT_EQ(copy.Data, MakeBody('d'));
+    EXPECT_EQ(copy.ReleaseData(), MakeBody('d'));
+}
+
+TEST(WriteMessage, ReassignedDataIsReleased) {
+    const std::string other = MakeBody('f');
+    TWriteMessage message(MakeBody('e'));
+    message.Data = other;
+    EXPECT_EQ(message.ReleaseData(), other);
+}
+
+TEST(WriteMessage, ReassignedDataSurvivesMoveAndCopy) {
+    const std::string other = MakeBody('f');
+    TWriteMessage source(MakeBody('e'));
+    source.Data = other;
+
+    TWriteMessage copy(source);
+    EXPECT_EQ(copy.Data.data(), other.data());
+
+    TWriteMessage moved(std::move(source));
+    EXPECT_EQ(moved.Data.data(), other.data());
+    EXPECT_EQ(moved.ReleaseData(), other);
+    EXPECT_EQ(copy.ReleaseData(), other);
+}
+
+TEST(WriteMessage, DataViewingPartOfBody) {
+    TWriteMessage source(std::string("0123456789"));
+    source.Data = source.Data.substr(2, 5);
+
+    TWriteMessage message(std::move(source));
+    EXPECT_EQ(message.Data, "23456");
+
+    TWriteMessage copy(message);
+    EXPECT_EQ(copy.Data, "23456");
+    EXPECT_EQ(copy.ReleaseData(), "23456");
+    EXPECT_EQ(message.ReleaseData(), "23456");
+}
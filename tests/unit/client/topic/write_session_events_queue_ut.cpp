@@ -0,0 +1,126 @@
+#include <src/client/topic/impl/write_session_impl.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace NYdb;
+using namespace NYdb::NTopic;
+
+namespace {
+    constexpr std::uint64_t PRODUCERS = 8;
+    constexpr std::uint64_t EVENTS_PER_PRODUCER = 20000;
+    const TDuration WAKEUP_TIMEOUT = TDuration::Seconds(30);
+
+    TWriteSessionEvent::TAcksEvent MakeAck(std::uint64_t seqNo) {
+        TWriteSessionEvent::TWriteAck ack;
+        ack.SeqNo = seqNo;
+        ack.State = TWriteSessionEvent::TWriteAck::EES_WRITTEN;
+
+        TWriteSessionEvent::TAcksEvent event;
+        event.Acks.push_back(std::move(ack));
+        return event;
+    }
+
+    // Producers push events concurrently, pausing now and then so that the consumer catches up,
+    // arms the waiter and races with the next push
+    std::vector<std::thread> StartProducers(TWriteSessionEventsQueue& queue, std::atomic<bool>& start) {
+        std::vector<std::thread> producers;
+        for (std::uint64_t producer = 0; producer < PRODUCERS; ++producer) {
+            producers.emplace_back([&queue, &start, producer] {
+                while (!start.load()) {
+                    std::this_thread::yield();
+                }
+                for (std::uint64_t i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+                    queue.PushEvent(MakeAck(producer * EVENTS_PER_PRODUCER + i));
+                    if ((i + producer) % 64 == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        return producers;
+    }
+
+    // Checks that every event is received once and events of each producer keep their order
+    class TReceivedEvents {
+    public:
+        void Add(TWriteSessionEvent::TEvent& event) {
+            auto* acks = std::get_if<TWriteSessionEvent::TAcksEvent>(&event);
+            ASSERT_NE(acks, nullptr);
+            for (const auto& ack : acks->Acks) {
+                const auto producer = ack.SeqNo / EVENTS_PER_PRODUCER;
+                ASSERT_LT(producer, PRODUCERS);
+                ASSERT_EQ(ack.SeqNo % EVENTS_PER_PRODUCER, Next[producer]) << "producer " << producer;
+                ++Next[producer];
+                ++Count;
+            }
+        }
+
+        bool Complete() const {
+            return Count == PRODUCERS * EVENTS_PER_PRODUCER;
+        }
+
+    private:
+        std::vector<std::uint64_t> Next = std::vector<std::uint64_t>(PRODUCERS);
+        std::uint64_t Count = 0;
+    };
+}
+
+TEST(WriteSessionEventsQueue, BlockingConsumer) {
+    TWriteSessionSettings settings;
+    TWriteSessionEventsQueue queue(settings);
+    std::atomic<bool> start = false;
+    auto producers = StartProducers(queue, start);
+
+    TReceivedEvents received;
+    auto consumer = std::async(std::launch::async, [&] {
+        while (!received.Complete()) {
+            for (auto& event : queue.GetEvents(true)) {
+                if (std::holds_alternative<TSessionClosedEvent>(event)) {
+                    return;
+                }
+                received.Add(event);
+            }
+        }
+    });
+
+    start = true;
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    // A missed wakeup leaves the consumer blocked with all events pushed
+    const bool completed = consumer.wait_for(std::chrono::seconds(WAKEUP_TIMEOUT.Seconds())) == std::future_status::ready;
+    if (!completed) {
+        queue.Close(TSessionClosedEvent(EStatus::ABORTED, {}));
+    }
+    consumer.get();
+    EXPECT_TRUE(completed);
+    EXPECT_TRUE(received.Complete());
+}
+
+TEST(WriteSessionEventsQueue, FutureConsumer) {
+    TWriteSessionSettings settings;
+    TWriteSessionEventsQueue queue(settings);
+    std::atomic<bool> start = false;
+    auto producers = StartProducers(queue, start);
+
+    start = true;
+    TReceivedEvents received;
+    while (!received.Complete()) {
+        // Either the pushed event is seen when the waiter is armed, or the producer signals the future
+        ASSERT_TRUE(queue.WaitEvent().Wait(WAKEUP_TIMEOUT));
+        for (auto& event : queue.GetEvents()) {
+            received.Add(event);
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_FALSE(queue.GetEvent().has_value());
+}
@@ -156,6 +156,41 @@ TEST(YdbValue, BuildType) {
         R"(Struct<'Member1':List<Uint32?>,'Member2':Dict<Int64,Tuple<Decimal(8,13),Pg('pgint2','',0,0,0),Utf8?>>>)");
 }
 
+TEST(YdbValue, InternedTypes) {
+    auto buildType = [] {
+        return TTypeBuilder()
+            .BeginStruct()
+            .AddMember("Id").Primitive(EPrimitiveType::Uint64)
+            .AddMember("Tags")
+                .BeginList()
+                    .Primitive(EPrimitiveType::Utf8)
+                .EndList()
+            .EndStruct()
+            .Build();
+    };
+
+    const TType type1 = buildType();
+    const TType type2 = buildType();
+    ASSERT_EQ(&type1.GetProto(), &type2.GetProto());
+    ASSERT_TRUE(TypesEqual(type1, type2));
+
+    const TType other = TTypeBuilder().Optional(type1).Build();
+    ASSERT_FALSE(TypesEqual(type1, other));
+
+    TType modified = type1;
+    modified.GetProto().mutable_struct_type()->mutable_members(0)->mutable_type()->set_type_id(Ydb::Type::INT64);
+    ASSERT_NE(&std::as_const(modified).GetProto(), &type1.GetProto());
+    ASSERT_EQ(FormatType(type1), "Struct<'Id':Uint64,'Tags':List<Utf8>>");
+    ASSERT_EQ(FormatType(modified), "Struct<'Id':Int64,'Tags':List<Utf8>>");
+    ASSERT_FALSE(TypesEqual(type1, modified));
+
+    // Pg types carry fields TypesEqual ignores, those are never shared
+    const TType pg1 = TTypeBuilder().Pg(TPgType("pgint4")).Build();
+    const TType pg2 = TTypeBuilder().Pg(TPgType("pgint4")).Build();
+    ASSERT_NE(&pg1.GetProto(), &pg2.GetProto());
+    ASSERT_TRUE(TypesEqual(pg1, pg2));
+}
+
 TEST(YdbValue, BuildTypeReuse) {
     auto intType = TTypeBuilder()
         .Primitive(EPrimitiveType::Int32)
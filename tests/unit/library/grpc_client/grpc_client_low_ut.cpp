@@ -2,6 +2,8 @@
 
 #include <library/cpp/testing/unittest/registar.h>
 
+#include <thread>
+
 using namespace NYdbGrpc;
 
 class TTestStub {
@@ -59,3 +61,51 @@ Y_UNIT_TEST_SUITE(ChannelPoolTests) {
 
     }
 } // ChannelPoolTests ut suite
+
+Y_UNIT_TEST_SUITE(ContextRegistryTests) {
+    void CreateAndForgetContexts(bool useCompletionQueuePerThread) {
+        TGRpcClientLow client(4, useCompletionQueuePerThread);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&client] {
+                std::vector<IQueueClientContextPtr> contexts;
+                for (int i = 0; i < 1000; ++i) {
+                    auto context = client.CreateContext();
+                    UNIT_ASSERT(context);
+                    UNIT_ASSERT(context->CompletionQueue());
+                    contexts.push_back(context->CreateContext());
+                    contexts.push_back(std::move(context));
+                    if (contexts.size() > 16) {
+                        contexts.clear();
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        client.WaitIdle();
+
+        auto alive = client.CreateContext();
+        UNIT_ASSERT(alive);
+        bool cancelled = false;
+        alive->SubscribeCancel([&cancelled] { cancelled = true; });
+
+        client.Stop();
+        UNIT_ASSERT(cancelled);
+        UNIT_ASSERT(!client.CreateContext());
+
+        alive.reset();
+        client.Stop(true);
+    }
+
+    Y_UNIT_TEST(SharedCompletionQueue) {
+        CreateAndForgetContexts(false);
+    }
+
+    Y_UNIT_TEST(CompletionQueuePerThread) {
+        CreateAndForgetContexts(true);
+    }
+} // ContextRegistryTests ut suite